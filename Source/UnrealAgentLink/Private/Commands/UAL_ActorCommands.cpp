@@ -1,5 +1,6 @@
 #include "UAL_ActorCommands.h"
 #include "UAL_CommandUtils.h"
+#include "UAL_PropertyPathCache.h"
 
 #include "Editor.h"
 #include "Engine/World.h"
@@ -821,16 +822,9 @@ void FUAL_ActorCommands::Handle_SetProperty(const TSharedPtr<FJsonObject>& Paylo
 		TSharedPtr<FJsonObject> Updated = MakeShared<FJsonObject>();
 		TArray<TSharedPtr<FJsonValue>> Errors;
 
+		// 候选属性名仅在查找失败时才收集（按类缓存），成功路径不再遍历全部组件
 		TArray<FString> CandidateNames;
-		UAL_CommandUtils::CollectPropertyNames(Actor, CandidateNames);
-		if (USceneComponent* RootComp = Actor->GetRootComponent())
-		{
-			UAL_CommandUtils::CollectPropertyNames(RootComp, CandidateNames);
-		}
-		for (UActorComponent* Comp : Actor->GetComponents())
-		{
-			UAL_CommandUtils::CollectPropertyNames(Comp, CandidateNames);
-		}
+		bool bCandidatesCollected = false;
 
 		for (const auto& Pair : (*PropsObj)->Values)
 		{
@@ -1144,11 +1138,20 @@ void FUAL_ActorCommands::Handle_SetProperty(const TSharedPtr<FJsonObject>& Paylo
 			}
 
 			// ========== 通用属性处理 ==========
-			UObject* TargetObj = nullptr;
-			FProperty* Prop = UAL_CommandUtils::FindWritablePropertyOnActorHierarchy(Actor, PropName, TargetObj);
-
-			if (!Prop)
+			// 支持嵌套路径（如 RootComponent.RelativeLocation.X），解析结果按类缓存，批量 Actor 复用
+			FUAL_ResolvedProperty Resolved;
+			if (!UAL_CommandUtils::ResolveWritablePropertyOnActorHierarchy(Actor, PropName, Resolved))
 			{
+				if (!bCandidatesCollected)
+				{
+					UAL_CommandUtils::CollectPropertyNames(Actor, CandidateNames);
+					for (UActorComponent* Comp : Actor->GetComponents())
+					{
+						UAL_CommandUtils::CollectPropertyNames(Comp, CandidateNames);
+					}
+					bCandidatesCollected = true;
+				}
+
 				TArray<FString> Suggestions;
 				UAL_CommandUtils::SuggestProperties(PropName, CandidateNames, Suggestions);
 
@@ -1168,12 +1171,19 @@ void FUAL_ActorCommands::Handle_SetProperty(const TSharedPtr<FJsonObject>& Paylo
 				continue;
 			}
 
+			FProperty* Prop = Resolved.Property;
+			UObject* TargetObj = Resolved.OwnerObject;
+
+			// 实际被写入的可能是组件等子对象，需要单独记录到事务中
+			TargetObj->Modify();
+
 			FString TypeError;
-			if (UAL_CommandUtils::SetSimpleProperty(Prop, TargetObj, DesiredValue, TypeError))
+			if (UAL_CommandUtils::SetSimpleProperty(Prop, Resolved.Container, DesiredValue, TypeError))
 			{
 				// 通知引擎属性已更改，触发渲染刷新
 #if WITH_EDITOR
 				FPropertyChangedEvent ChangedEvent(Prop, EPropertyChangeType::ValueSet);
+				ChangedEvent.SetActiveMemberProperty(Resolved.MemberProperty);
 				TargetObj->PostEditChangeProperty(ChangedEvent);
 				
 				// 如果目标对象是组件，还需要标记组件渲染状态为脏
@@ -1182,7 +1192,7 @@ void FUAL_ActorCommands::Handle_SetProperty(const TSharedPtr<FJsonObject>& Paylo
 					Comp->MarkRenderStateDirty();
 				}
 #endif
-				if (TSharedPtr<FJsonValue> JsonValue = UAL_CommandUtils::PropertyToJsonValueCompat(Prop, Prop->ContainerPtrToValuePtr<void>(TargetObj)))
+				if (TSharedPtr<FJsonValue> JsonValue = UAL_CommandUtils::PropertyToJsonValueCompat(Prop, Resolved.GetValuePtr()))
 				{
 					Updated->SetField(PropName, JsonValue);
 				}
@@ -1196,7 +1206,7 @@ void FUAL_ActorCommands::Handle_SetProperty(const TSharedPtr<FJsonObject>& Paylo
 			TSharedPtr<FJsonObject> Err = MakeShared<FJsonObject>();
 			Err->SetStringField(TEXT("property"), PropName);
 			Err->SetStringField(TEXT("error"), TypeError.IsEmpty() ? TEXT("Failed to set property") : TypeError);
-			if (TSharedPtr<FJsonValue> Current = UAL_CommandUtils::PropertyToJsonValueCompat(Prop, Prop->ContainerPtrToValuePtr<void>(TargetObj)))
+			if (TSharedPtr<FJsonValue> Current = UAL_CommandUtils::PropertyToJsonValueCompat(Prop, Resolved.GetValuePtr()))
 			{
 				Err->SetStringField(TEXT("expected_type"), Prop->GetClass()->GetName());
 				Err->SetStringField(TEXT("current_value"), UAL_CommandUtils::JsonValueToString(Current));
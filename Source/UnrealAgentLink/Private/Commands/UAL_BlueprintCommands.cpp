@@ -1,5 +1,6 @@
 #include "UAL_BlueprintCommands.h"
 #include "UAL_CommandUtils.h"
+#include "UAL_BlueprintCompileScheduler.h"
 
 #include "Editor.h"
 #include "Engine/Blueprint.h"
@@ -38,6 +39,8 @@
 #include "K2Node_Self.h"
 #include "Engine/TimelineTemplate.h"
 #include "Logging/TokenizedMessage.h"
+#include "Hash/CityHash.h"
+#include "ScopedTransaction.h"
 #if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
 #include "Misc/UObjectToken.h"
 #endif
@@ -108,6 +111,11 @@ void FUAL_BlueprintCommands::RegisterCommands(TMap<FString, TFunction<void(const
 		Handle_CompileBlueprint(Payload, RequestId);
 	});
 
+	CommandMap.Add(TEXT("blueprint.flush_compiles"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_FlushCompiles(Payload, RequestId);
+	});
+
 	CommandMap.Add(TEXT("blueprint.set_pin_value"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
 	{
 		Handle_SetPinValue(Payload, RequestId);
@@ -127,6 +135,12 @@ void FUAL_BlueprintCommands::RegisterCommands(TMap<FString, TFunction<void(const
 	{
 		Handle_CreateGraphDeclarative(Payload, RequestId);
 	});
+
+	// blueprint.apply_ops - 对已有图表批量编辑（单事务、最多编译一次）
+	CommandMap.Add(TEXT("blueprint.apply_ops"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_ApplyGraphOps(Payload, RequestId);
+	});
 }
 
 // ============================================================================
@@ -398,6 +412,380 @@ static TSharedPtr<FJsonObject> UAL_BuildNodeJson(UEdGraphNode* Node)
 	return NodeObj;
 }
 
+// ============================================================================
+// blueprint.get_graph 增量快照
+// 每个 UEdGraph 维护一个版本号与节点指纹；指纹只覆盖节点 JSON 中会出现的字段，
+// 未变化的节点复用缓存的 JSON，since_version 请求只返回新增/修改/删除的节点与连线。
+// ============================================================================
+
+namespace UALGraphSnapshot
+{
+	// 删除记录最多保留的版本跨度；since_version 早于被裁剪的记录时退化为全量返回
+	constexpr int32 MaxTombstoneVersions = 64;
+
+	struct FNodeEntry
+	{
+		uint64 Fingerprint = 0;
+		int32 AddedVersion = 0;
+		int32 ModifiedVersion = 0;
+		TSharedPtr<FJsonObject> Json;
+	};
+
+	struct FLinkEntry
+	{
+		int32 AddedVersion = 0;
+		TSharedPtr<FJsonObject> Json;
+	};
+
+	struct FTombstone
+	{
+		int32 RemovedVersion = 0;
+		TSharedPtr<FJsonValue> Json;
+	};
+
+	struct FState
+	{
+		TWeakObjectPtr<UEdGraph> Graph;
+		// 快照纪元：编辑器重启或缓存重建后变化，客户端据此判断 since_version 是否仍然有效
+		FGuid Epoch;
+		int32 Version = 0;
+		int32 OldestDeltaVersion = 0;
+
+		TMap<FGuid, FNodeEntry> Nodes;
+		TArray<FGuid> NodeOrder;
+		TMap<FString, FLinkEntry> Links;
+		TArray<FString> LinkOrder;
+
+		TMap<FGuid, FTombstone> RemovedNodes;
+		TMap<FString, FTombstone> RemovedLinks;
+	};
+
+	static TMap<const UEdGraph*, FState>& GetStates()
+	{
+		static TMap<const UEdGraph*, FState> States;
+		return States;
+	}
+
+	static void MixString(uint64& Hash, const FString& Value)
+	{
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*Value), Value.Len() * sizeof(TCHAR), Hash);
+	}
+
+	static void MixInt(uint64& Hash, uint64 Value)
+	{
+		Hash = CityHash128to64(Uint128_64(Hash, Value));
+	}
+
+	static FString GetNodeTitle(const UEdGraphNode* Node, TMap<const UEdGraphNode*, FString>& TitleCache)
+	{
+		if (const FString* Cached = TitleCache.Find(Node))
+		{
+			return *Cached;
+		}
+		return TitleCache.Add(Node, Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+	}
+
+	/** 计算节点指纹（与 UAL_BuildNodeJson 输出字段一一对应，包括连线对端的标题） */
+	static uint64 ComputeFingerprint(UEdGraphNode* Node, TMap<const UEdGraphNode*, FString>& TitleCache)
+	{
+		uint64 Hash = 0;
+		MixInt(Hash, reinterpret_cast<UPTRINT>(Node->GetClass()));
+		MixString(Hash, GetNodeTitle(Node, TitleCache));
+		MixInt(Hash, static_cast<uint32>(Node->NodePosX));
+		MixInt(Hash, static_cast<uint32>(Node->NodePosY));
+
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin)
+			{
+				continue;
+			}
+			MixString(Hash, Pin->PinName.ToString());
+			MixString(Hash, Pin->PinFriendlyName.ToString());
+			MixString(Hash, Pin->PinType.PinCategory.ToString());
+			MixString(Hash, Pin->PinType.PinSubCategory.ToString());
+			MixInt(Hash, reinterpret_cast<UPTRINT>(Pin->PinType.PinSubCategoryObject.Get()));
+			MixInt(Hash, (static_cast<uint64>(Pin->Direction) << 16)
+				| (static_cast<uint64>(Pin->PinType.ContainerType) << 8)
+				| (Pin->PinType.bIsReference ? 2 : 0)
+				| (Pin->PinType.bIsConst ? 1 : 0));
+
+			MixInt(Hash, Pin->LinkedTo.Num());
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				if (!LinkedPin)
+				{
+					continue;
+				}
+				MixString(Hash, LinkedPin->PinName.ToString());
+				MixInt(Hash, static_cast<uint64>(LinkedPin->Direction));
+				if (UEdGraphNode* OwnerNode = LinkedPin->GetOwningNode())
+				{
+					MixInt(Hash, GetTypeHash(OwnerNode->NodeGuid));
+					MixInt(Hash, reinterpret_cast<UPTRINT>(OwnerNode->GetClass()));
+					MixString(Hash, GetNodeTitle(OwnerNode, TitleCache));
+				}
+			}
+		}
+		return Hash;
+	}
+
+	static void PruneTombstones(FState& State)
+	{
+		auto Prune = [&State](auto& Tombstones)
+		{
+			for (auto It = Tombstones.CreateIterator(); It; ++It)
+			{
+				if (State.Version - It.Value().RemovedVersion > MaxTombstoneVersions)
+				{
+					State.OldestDeltaVersion = FMath::Max(State.OldestDeltaVersion, It.Value().RemovedVersion);
+					It.RemoveCurrent();
+				}
+			}
+		};
+		Prune(State.RemovedNodes);
+		Prune(State.RemovedLinks);
+	}
+
+	/**
+	 * 重新扫描图表并更新快照；有任何变化时版本号 +1
+	 * 只计算指纹，变化的节点才重建 JSON
+	 */
+	static FState& Refresh(UEdGraph* Graph)
+	{
+		TMap<const UEdGraph*, FState>& States = GetStates();
+
+		// 清理已被 GC 的图表
+		for (auto It = States.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().Graph.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		FState* StatePtr = States.Find(Graph);
+		if (!StatePtr || StatePtr->Graph.Get() != Graph)
+		{
+			StatePtr = &States.Add(Graph);
+			StatePtr->Graph = Graph;
+			StatePtr->Epoch = FGuid::NewGuid();
+		}
+		FState& State = *StatePtr;
+
+		const int32 NextVersion = State.Version + 1;
+		bool bChanged = State.Version == 0;
+
+		TMap<const UEdGraphNode*, FString> TitleCache;
+		TSet<FGuid> SeenNodes;
+		TSet<FString> SeenLinks;
+		TArray<FGuid> NodeOrder;
+		TArray<FString> LinkOrder;
+		NodeOrder.Reserve(Graph->Nodes.Num());
+
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node)
+			{
+				continue;
+			}
+
+			const FGuid& NodeGuid = Node->NodeGuid;
+			SeenNodes.Add(NodeGuid);
+			NodeOrder.Add(NodeGuid);
+
+			const uint64 Fingerprint = ComputeFingerprint(Node, TitleCache);
+			FNodeEntry* Entry = State.Nodes.Find(NodeGuid);
+			if (!Entry)
+			{
+				Entry = &State.Nodes.Add(NodeGuid);
+				Entry->AddedVersion = NextVersion;
+				Entry->ModifiedVersion = NextVersion;
+				Entry->Fingerprint = Fingerprint;
+				Entry->Json = UAL_BuildNodeJson(Node);
+				State.RemovedNodes.Remove(NodeGuid);
+				bChanged = true;
+			}
+			else if (Entry->Fingerprint != Fingerprint)
+			{
+				Entry->ModifiedVersion = NextVersion;
+				Entry->Fingerprint = Fingerprint;
+				Entry->Json = UAL_BuildNodeJson(Node);
+				bChanged = true;
+			}
+
+			// 连线只统计输出引脚，避免重复
+			for (UEdGraphPin* Pin : Node->Pins)
+			{
+				if (!Pin || Pin->Direction != EGPD_Output)
+				{
+					continue;
+				}
+				for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+				{
+					UEdGraphNode* TargetNode = LinkedPin ? LinkedPin->GetOwningNode() : nullptr;
+					if (!TargetNode)
+					{
+						continue;
+					}
+
+					const FString FromNode = UAL_GuidToString(NodeGuid);
+					const FString ToNode = UAL_GuidToString(TargetNode->NodeGuid);
+					const FString FromPin = Pin->PinName.ToString();
+					const FString ToPin = LinkedPin->PinName.ToString();
+					FString LinkKey = FString::Printf(TEXT("%s.%s->%s.%s"), *FromNode, *FromPin, *ToNode, *ToPin);
+
+					if (SeenLinks.Contains(LinkKey))
+					{
+						continue;
+					}
+					SeenLinks.Add(LinkKey);
+					LinkOrder.Add(LinkKey);
+
+					if (!State.Links.Contains(LinkKey))
+					{
+						TSharedPtr<FJsonObject> LinkObj = MakeShared<FJsonObject>();
+						LinkObj->SetStringField(TEXT("from_node"), FromNode);
+						LinkObj->SetStringField(TEXT("from_pin"), FromPin);
+						LinkObj->SetStringField(TEXT("to_node"), ToNode);
+						LinkObj->SetStringField(TEXT("to_pin"), ToPin);
+
+						FLinkEntry& LinkEntry = State.Links.Add(LinkKey);
+						LinkEntry.AddedVersion = NextVersion;
+						LinkEntry.Json = LinkObj;
+						State.RemovedLinks.Remove(LinkKey);
+						bChanged = true;
+					}
+				}
+			}
+		}
+
+		for (auto It = State.Nodes.CreateIterator(); It; ++It)
+		{
+			if (!SeenNodes.Contains(It.Key()))
+			{
+				FTombstone& Tombstone = State.RemovedNodes.Add(It.Key());
+				Tombstone.RemovedVersion = NextVersion;
+				Tombstone.Json = MakeShared<FJsonValueString>(UAL_GuidToString(It.Key()));
+				It.RemoveCurrent();
+				bChanged = true;
+			}
+		}
+
+		for (auto It = State.Links.CreateIterator(); It; ++It)
+		{
+			if (!SeenLinks.Contains(It.Key()))
+			{
+				FTombstone& Tombstone = State.RemovedLinks.Add(It.Key());
+				Tombstone.RemovedVersion = NextVersion;
+				Tombstone.Json = MakeShared<FJsonValueObject>(It.Value().Json);
+				It.RemoveCurrent();
+				bChanged = true;
+			}
+		}
+
+		State.NodeOrder = MoveTemp(NodeOrder);
+		State.LinkOrder = MoveTemp(LinkOrder);
+
+		if (bChanged)
+		{
+			State.Version = NextVersion;
+			PruneTombstones(State);
+		}
+		return State;
+	}
+
+	/** 全量：按图表顺序输出缓存的节点 / 连线 JSON */
+	static void WriteFull(const FState& State, const TSharedPtr<FJsonObject>& Result)
+	{
+		TArray<TSharedPtr<FJsonValue>> Nodes;
+		Nodes.Reserve(State.NodeOrder.Num());
+		for (const FGuid& NodeGuid : State.NodeOrder)
+		{
+			const FNodeEntry* Entry = State.Nodes.Find(NodeGuid);
+			if (Entry && Entry->Json.IsValid())
+			{
+				Nodes.Add(MakeShared<FJsonValueObject>(Entry->Json));
+			}
+		}
+
+		TArray<TSharedPtr<FJsonValue>> Connections;
+		Connections.Reserve(State.LinkOrder.Num());
+		for (const FString& LinkKey : State.LinkOrder)
+		{
+			if (const FLinkEntry* Entry = State.Links.Find(LinkKey))
+			{
+				Connections.Add(MakeShared<FJsonValueObject>(Entry->Json));
+			}
+		}
+
+		Result->SetBoolField(TEXT("full"), true);
+		Result->SetArrayField(TEXT("nodes"), Nodes);
+		Result->SetNumberField(TEXT("connection_count"), Connections.Num());
+		Result->SetArrayField(TEXT("connections"), Connections);
+	}
+
+	/** 增量：只输出 SinceVersion 之后新增 / 修改 / 删除的节点与连线 */
+	static void WriteDelta(const FState& State, int32 SinceVersion, const TSharedPtr<FJsonObject>& Result)
+	{
+		TArray<TSharedPtr<FJsonValue>> AddedNodes;
+		TArray<TSharedPtr<FJsonValue>> ModifiedNodes;
+		for (const FGuid& NodeGuid : State.NodeOrder)
+		{
+			const FNodeEntry* Entry = State.Nodes.Find(NodeGuid);
+			if (!Entry || !Entry->Json.IsValid())
+			{
+				continue;
+			}
+			if (Entry->AddedVersion > SinceVersion)
+			{
+				AddedNodes.Add(MakeShared<FJsonValueObject>(Entry->Json));
+			}
+			else if (Entry->ModifiedVersion > SinceVersion)
+			{
+				ModifiedNodes.Add(MakeShared<FJsonValueObject>(Entry->Json));
+			}
+		}
+
+		TArray<TSharedPtr<FJsonValue>> AddedLinks;
+		for (const FString& LinkKey : State.LinkOrder)
+		{
+			const FLinkEntry* Entry = State.Links.Find(LinkKey);
+			if (Entry && Entry->AddedVersion > SinceVersion)
+			{
+				AddedLinks.Add(MakeShared<FJsonValueObject>(Entry->Json));
+			}
+		}
+
+		auto CollectRemoved = [SinceVersion](const auto& Tombstones)
+		{
+			TArray<TSharedPtr<FJsonValue>> Out;
+			for (const auto& Pair : Tombstones)
+			{
+				if (Pair.Value.RemovedVersion > SinceVersion)
+				{
+					Out.Add(Pair.Value.Json);
+				}
+			}
+			return Out;
+		};
+
+		const TArray<TSharedPtr<FJsonValue>> RemovedNodes = CollectRemoved(State.RemovedNodes);
+		const TArray<TSharedPtr<FJsonValue>> RemovedLinks = CollectRemoved(State.RemovedLinks);
+
+		Result->SetBoolField(TEXT("full"), false);
+		Result->SetNumberField(TEXT("since_version"), SinceVersion);
+		Result->SetBoolField(TEXT("unchanged"), SinceVersion == State.Version);
+		Result->SetArrayField(TEXT("added_nodes"), AddedNodes);
+		Result->SetArrayField(TEXT("modified_nodes"), ModifiedNodes);
+		Result->SetArrayField(TEXT("removed_nodes"), RemovedNodes);
+		Result->SetArrayField(TEXT("added_connections"), AddedLinks);
+		Result->SetArrayField(TEXT("removed_connections"), RemovedLinks);
+		Result->SetNumberField(TEXT("node_count"), State.NodeOrder.Num());
+		Result->SetNumberField(TEXT("connection_count"), State.LinkOrder.Num());
+	}
+}
+
 // ============================================================================
 // Timeline 专用：创建/复用 TimelineTemplate 并在图表中放置 UK2Node_Timeline
 // ============================================================================
@@ -1733,49 +2121,43 @@ void FUAL_BlueprintCommands::Handle_GetBlueprintGraph(const TSharedPtr<FJsonObje
 		return;
 	}
 
-	TArray<TSharedPtr<FJsonValue>> Nodes;
-	for (UEdGraphNode* Node : Graph->Nodes)
+	// 增量模式：since_version（+ 可选 epoch）有效时只返回差异
+	int32 SinceVersion = -1;
+	const bool bHasSince = Payload->TryGetNumberField(TEXT("since_version"), SinceVersion);
+	FString ClientEpoch;
+	Payload->TryGetStringField(TEXT("epoch"), ClientEpoch);
+
+	const UALGraphSnapshot::FState& Snapshot = UALGraphSnapshot::Refresh(Graph);
+	const FString Epoch = Snapshot.Epoch.ToString(EGuidFormats::Digits);
+
+	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetBoolField(TEXT("ok"), true);
+	Result->SetStringField(TEXT("blueprint_path"), Blueprint->GetPathName());
+	Result->SetStringField(TEXT("graph_name"), Graph->GetName());
+	Result->SetNumberField(TEXT("version"), Snapshot.Version);
+	Result->SetStringField(TEXT("epoch"), Epoch);
+
+	const bool bEpochMatches = ClientEpoch.IsEmpty() || ClientEpoch.Equals(Epoch, ESearchCase::IgnoreCase);
+	const bool bCanDelta = bHasSince
+		&& bEpochMatches
+		&& SinceVersion >= Snapshot.OldestDeltaVersion
+		&& SinceVersion > 0
+		&& SinceVersion <= Snapshot.Version;
+
+	if (bCanDelta)
 	{
-		if (!Node)
-		{
-			continue;
-		}
-		if (TSharedPtr<FJsonObject> NodeObj = UAL_BuildNodeJson(Node))
-		{
-			Nodes.Add(MakeShared<FJsonValueObject>(NodeObj));
-		}
+		UALGraphSnapshot::WriteDelta(Snapshot, SinceVersion, Result);
 	}
-
-	// Collect top-level connections summary (output pins only to avoid duplicates)
-	TArray<TSharedPtr<FJsonValue>> ConnectionsJson;
-	for (UEdGraphNode* N : Graph->Nodes)
+	else
 	{
-		if (!N) continue;
-		for (UEdGraphPin* P : N->Pins)
+		if (bHasSince)
 		{
-			if (!P || P->Direction != EGPD_Output) continue;
-			for (UEdGraphPin* LP : P->LinkedTo)
-			{
-				if (!LP) continue;
-				UEdGraphNode* TN = LP->GetOwningNode();
-				if (!TN) continue;
-				TSharedPtr<FJsonObject> CO = MakeShared<FJsonObject>();
-				CO->SetStringField(TEXT("from_node"), UAL_GuidToString(N->NodeGuid));
-				CO->SetStringField(TEXT("from_pin"), P->PinName.ToString());
-				CO->SetStringField(TEXT("to_node"), UAL_GuidToString(TN->NodeGuid));
-				CO->SetStringField(TEXT("to_pin"), LP->PinName.ToString());
-				ConnectionsJson.Add(MakeShared<FJsonValueObject>(CO));
-			}
+			// 客户端版本已失效（纪元变化 / 过旧 / 超前），返回全量并提示原因
+			Result->SetStringField(TEXT("resync_reason"), !bEpochMatches ? TEXT("epoch_changed") : TEXT("version_out_of_range"));
 		}
+		UALGraphSnapshot::WriteFull(Snapshot, Result);
 	}
 
-	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-	Result->SetBoolField(TEXT("ok"), true);
-	Result->SetStringField(TEXT("blueprint_path"), Blueprint->GetPathName());
-	Result->SetStringField(TEXT("graph_name"), Graph->GetName());
-	Result->SetArrayField(TEXT("nodes"), Nodes);
-	Result->SetNumberField(TEXT("connection_count"), ConnectionsJson.Num());
-	Result->SetArrayField(TEXT("connections"), ConnectionsJson);
 	UAL_CommandUtils::SendResponse(RequestId, 200, Result);
 }
 
@@ -3506,6 +3888,14 @@ void FUAL_BlueprintCommands::Handle_CompileBlueprint(const TSharedPtr<FJsonObjec
 	bool bSave = true;
 	Payload->TryGetBoolField(TEXT("save"), bSave);
 
+	// deferred：进入编译队列合并执行；force：忽略"未变化跳过"；include_dependents：连同依赖它的蓝图一起编译
+	bool bDeferred = false;
+	Payload->TryGetBoolField(TEXT("deferred"), bDeferred);
+	bool bForce = false;
+	Payload->TryGetBoolField(TEXT("force"), bForce);
+	bool bIncludeDependents = false;
+	Payload->TryGetBoolField(TEXT("include_dependents"), bIncludeDependents);
+
 	// 2. 加载蓝图
 	UBlueprint* Blueprint = nullptr;
 	FString ResolvedPath = BlueprintPath;
@@ -3558,116 +3948,37 @@ void FUAL_BlueprintCommands::Handle_CompileBlueprint(const TSharedPtr<FJsonObjec
 		return;
 	}
 
-	// 3. 执行编译（带诊断日志）
-	FCompilerResultsLog ResultsLog;
-	ResultsLog.bSilentMode = true;
-	ResultsLog.bLogInfoOnly = false;
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-	ResultsLog.bAnnotateMentionedNodes = true;
-#endif
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2)
-	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::None, &ResultsLog);
-#else
-	// UE5.0/5.1 兼容
-	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::None, &ResultsLog);
-#endif
-
-	// 3.1 收集 diagnostics（用于 Agent 自修复）
-	TArray<TSharedPtr<FJsonValue>> Diagnostics;
-	for (const TSharedRef<FTokenizedMessage>& Msg : ResultsLog.Messages)
+	// 3. 延迟模式：加入编译队列，同一蓝图的多次请求合并，完成后再回复本请求
+	if (bDeferred)
 	{
-		TSharedPtr<FJsonObject> D = MakeShared<FJsonObject>();
-
-		FString SeverityStr = TEXT("Info");
-		switch (Msg->GetSeverity())
-		{
-		case EMessageSeverity::Error:   SeverityStr = TEXT("Error"); break;
-		case EMessageSeverity::Warning: SeverityStr = TEXT("Warning"); break;
-		case EMessageSeverity::Info:    SeverityStr = TEXT("Info"); break;
-		default:                        SeverityStr = TEXT("Other"); break;
-		}
-		D->SetStringField(TEXT("type"), SeverityStr);
-		D->SetStringField(TEXT("message"), Msg->ToText().ToString());
-
-		// 尝试绑定 node_id（best-effort）
-		FString NodeId;
-		FString PinName;
-		UObject* FoundObj = nullptr;
-
-		for (const TSharedRef<IMessageToken>& Tok : Msg->GetMessageTokens())
-		{
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-			if (Tok->GetType() == EMessageToken::Object)
+		const int32 QueueSize = FUAL_BlueprintCompileScheduler::Get().Enqueue(Blueprint, bForce, bSave, bIncludeDependents,
+			[RequestId](const FUAL_BlueprintCompileResult& CompileResult)
 			{
-				const TSharedRef<FUObjectToken> ObjTok = StaticCastSharedRef<FUObjectToken>(Tok);
-				FoundObj = ObjTok->GetObject().Get();
-				if (FoundObj)
-				{
-					break;
-				}
-			}
-#else
-			// UE5.0: FObjectToken/FUObjectToken 不可用，跳过对象绑定
-			(void)Tok;
-#endif
-		}
-
-		if (UEdGraphNode* AsNode = Cast<UEdGraphNode>(FoundObj))
-		{
-			NodeId = UAL_GuidToString(AsNode->NodeGuid);
-		}
-
-		if (!NodeId.IsEmpty())
-		{
-			D->SetStringField(TEXT("node_id"), NodeId);
-		}
-		if (!PinName.IsEmpty())
-		{
-			D->SetStringField(TEXT("pin"), PinName);
-		}
-
-		Diagnostics.Add(MakeShared<FJsonValueObject>(D));
+				TSharedPtr<FJsonObject> Result = CompileResult.ToJson();
+				Result->SetBoolField(TEXT("deferred"), true);
+				UAL_CommandUtils::SendResponse(RequestId, 200, Result);
+			});
+		UE_LOG(LogUALBlueprint, Verbose, TEXT("Queued compile for %s (queue size %d)"), *Blueprint->GetPathName(), QueueSize);
+		return;
 	}
 
-	// 4. 检查结果状态
-	const bool bCompileSuccess = (Blueprint->Status == BS_UpToDate);
-
-	FString StatusStr;
-	switch (Blueprint->Status)
-	{
-	case BS_UpToDate: StatusStr = TEXT("UpToDate"); break;
-	case BS_Dirty:    StatusStr = TEXT("Dirty"); break;
-	case BS_Error:    StatusStr = TEXT("Error"); break;
-	case BS_Unknown:  StatusStr = TEXT("Unknown"); break;
-	default:          StatusStr = TEXT("Other"); break;
-	}
+	// 4. 立即编译（图表自上次成功编译后未变化时跳过，skipped=true）
+	const FUAL_BlueprintCompileResult CompileResult = FUAL_BlueprintCompileScheduler::Get().CompileNow(Blueprint, bForce, bSave);
+	UAL_CommandUtils::SendResponse(RequestId, 200, CompileResult.ToJson());
+}
 
-	// 5. 保存（仅在请求要求且编译成功时执行，避免写入坏蓝图）
-	bool bSaved = false;
-	if (bSave && bCompileSuccess)
-	{
-		if (UPackage* Package = Blueprint->GetOutermost())
-		{
-			const FString PackageFileName = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
-			FSavePackageArgs SaveArgs;
-			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 7
-			UPackage::Save(Package, Blueprint, *PackageFileName, SaveArgs);
-#else
-			UPackage::SavePackage(Package, Blueprint, *PackageFileName, SaveArgs);
-#endif
-			bSaved = true;
-		}
-	}
+/**
+ * 立即编译延迟队列中的全部蓝图（不等待静默期）
+ */
+void FUAL_BlueprintCommands::Handle_FlushCompiles(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	const int32 PendingCount = FUAL_BlueprintCompileScheduler::Get().GetPendingCount();
+	const int32 FlushedCount = FUAL_BlueprintCompileScheduler::Get().Flush();
 
-	// 6. 返回结果
 	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-	Result->SetBoolField(TEXT("ok"), bCompileSuccess);
-	Result->SetStringField(TEXT("status"), StatusStr);
-	Result->SetBoolField(TEXT("saved"), bSaved);
-	Result->SetStringField(TEXT("path"), Blueprint->GetPathName());
-	Result->SetArrayField(TEXT("diagnostics"), Diagnostics);
-
+	Result->SetBoolField(TEXT("ok"), true);
+	Result->SetNumberField(TEXT("pending_count"), PendingCount);
+	Result->SetNumberField(TEXT("flushed_count"), FlushedCount);
 	UAL_CommandUtils::SendResponse(RequestId, 200, Result);
 }
 
@@ -4456,6 +4767,9 @@ void FUAL_BlueprintCommands::Handle_CreateGraphDeclarative(const TSharedPtr<FJso
 	bool bCompile = true;
 	Payload->TryGetBoolField(TEXT("compile"), bCompile);
 
+	bool bDeferCompile = false;
+	Payload->TryGetBoolField(TEXT("defer_compile"), bDeferCompile);
+
 	const TArray<TSharedPtr<FJsonValue>>* ConnectionsArray = nullptr;
 	Payload->TryGetArrayField(TEXT("connections"), ConnectionsArray);
 
@@ -4709,15 +5023,18 @@ void FUAL_BlueprintCommands::Handle_CreateGraphDeclarative(const TSharedPtr<FJso
 		}
 	}
 
-	// ===== 8. 可选：编译蓝图 =====
+	// ===== 8. 可选：编译蓝图（defer_compile 时交给编译队列，完成后推送 blueprint.compiled）=====
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
 	if (bCompile)
 	{
-		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-		FKismetEditorUtilities::CompileBlueprint(Blueprint);
-	}
-	else
-	{
-		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		if (bDeferCompile)
+		{
+			FUAL_BlueprintCompileScheduler::Get().Enqueue(Blueprint, false, false, false);
+		}
+		else
+		{
+			FUAL_BlueprintCompileScheduler::Get().CompileNow(Blueprint, false, false);
+		}
 	}
 	
 	// ===== 返回结果 =====
@@ -4727,7 +5044,8 @@ void FUAL_BlueprintCommands::Handle_CreateGraphDeclarative(const TSharedPtr<FJso
 	Result->SetStringField(TEXT("graph_name"), Graph->GetName());
 	Result->SetNumberField(TEXT("created_count"), CreatedNodesInfo.Num());
 	Result->SetNumberField(TEXT("connection_count"), ConnectionCount);
-	Result->SetBoolField(TEXT("compiled"), bCompile);
+	Result->SetBoolField(TEXT("compiled"), bCompile && !bDeferCompile);
+	Result->SetBoolField(TEXT("compile_queued"), bCompile && bDeferCompile);
 	Result->SetArrayField(TEXT("nodes"), CreatedNodesInfo);
 	
 	if (Errors.Num() > 0)
@@ -4742,3 +5060,522 @@ void FUAL_BlueprintCommands::Handle_CreateGraphDeclarative(const TSharedPtr<FJso
 	
 	UAL_CommandUtils::SendResponse(RequestId, 200, Result);
 }
+
+// ============================================================================
+// blueprint.apply_ops - 对已有图表批量执行编辑操作（单事务、延迟通知、最多编译一次）
+// ============================================================================
+
+namespace UALApplyOps
+{
+	/** 批处理上下文：别名表、图表缓存、被修改过的图表 */
+	struct FContext
+	{
+		UBlueprint* Blueprint = nullptr;
+		FString DefaultGraphName;
+		TMap<FString, UEdGraph*> Graphs;
+		TSet<UEdGraph*> TouchedGraphs;
+		TMap<FString, UEdGraphNode*> Aliases;
+		bool bStructural = false;
+	};
+
+	static UEdGraph* ResolveGraph(FContext& Ctx, const TSharedPtr<FJsonObject>& Op, FString& OutError)
+	{
+		FString GraphName = Ctx.DefaultGraphName;
+		Op->TryGetStringField(TEXT("graph_name"), GraphName);
+
+		if (UEdGraph** Cached = Ctx.Graphs.Find(GraphName))
+		{
+			return *Cached;
+		}
+
+		UEdGraph* Graph = UAL_FindGraph(Ctx.Blueprint, GraphName);
+		if (!Graph)
+		{
+			OutError = FString::Printf(TEXT("Graph not found: %s"), GraphName.IsEmpty() ? TEXT("EventGraph") : *GraphName);
+			return nullptr;
+		}
+		Ctx.Graphs.Add(GraphName, Graph);
+		return Graph;
+	}
+
+	/** 每个图表只 Modify 一次，并记录下来在批处理结束时统一通知 */
+	static void TouchGraph(FContext& Ctx, UEdGraph* Graph)
+	{
+		if (!Ctx.TouchedGraphs.Contains(Graph))
+		{
+			Graph->Modify();
+			Ctx.TouchedGraphs.Add(Graph);
+		}
+	}
+
+	/** 节点引用：本批次 add_node 定义的别名，或已有节点的 GUID */
+	static UEdGraphNode* ResolveNode(FContext& Ctx, UEdGraph* Graph, const FString& Ref)
+	{
+		if (UEdGraphNode** Aliased = Ctx.Aliases.Find(Ref))
+		{
+			return *Aliased;
+		}
+		return UAL_FindNodeByGuid(Graph, Ref);
+	}
+
+	/** 解析连线端点："ref.Pin" 或 source_node_id/source_pin 风格字段 */
+	static bool ResolvePinEndpoints(FContext& Ctx, UEdGraph* Graph, const TSharedPtr<FJsonObject>& Op, UEdGraphPin*& OutFrom, UEdGraphPin*& OutTo, FString& OutError)
+	{
+		FString FromNodeRef, FromPinName, ToNodeRef, ToPinName;
+		FString FromStr, ToStr;
+		if (Op->TryGetStringField(TEXT("from"), FromStr) && Op->TryGetStringField(TEXT("to"), ToStr))
+		{
+			if (!FromStr.Split(TEXT("."), &FromNodeRef, &FromPinName) || !ToStr.Split(TEXT("."), &ToNodeRef, &ToPinName))
+			{
+				OutError = TEXT("invalid pin path format, expected \"node.Pin\"");
+				return false;
+			}
+		}
+		else
+		{
+			Op->TryGetStringField(TEXT("source_node_id"), FromNodeRef);
+			Op->TryGetStringField(TEXT("source_pin"), FromPinName);
+			Op->TryGetStringField(TEXT("target_node_id"), ToNodeRef);
+			Op->TryGetStringField(TEXT("target_pin"), ToPinName);
+		}
+
+		if (FromNodeRef.IsEmpty() || FromPinName.IsEmpty() || ToNodeRef.IsEmpty() || ToPinName.IsEmpty())
+		{
+			OutError = TEXT("Missing required fields: from/to (or source_node_id/source_pin/target_node_id/target_pin)");
+			return false;
+		}
+
+		UEdGraphNode* FromNode = ResolveNode(Ctx, Graph, FromNodeRef);
+		UEdGraphNode* ToNode = ResolveNode(Ctx, Graph, ToNodeRef);
+		if (!FromNode || !ToNode)
+		{
+			OutError = FString::Printf(TEXT("Node not found: %s"), !FromNode ? *FromNodeRef : *ToNodeRef);
+			return false;
+		}
+
+		OutFrom = UAL_FindPinByName(FromNode, FromPinName);
+		OutTo = UAL_FindPinByName(ToNode, ToPinName);
+		if (!OutFrom || !OutTo)
+		{
+			OutError = FString::Printf(TEXT("Pin not found: %s"), !OutFrom ? *FromPinName : *ToPinName);
+			return false;
+		}
+		return true;
+	}
+
+	static bool ReadPosition(const TSharedPtr<FJsonObject>& Op, int32& OutX, int32& OutY)
+	{
+		const TSharedPtr<FJsonObject>* PosObjPtr = nullptr;
+		if ((Op->TryGetObjectField(TEXT("position"), PosObjPtr) || Op->TryGetObjectField(TEXT("node_position"), PosObjPtr))
+			&& PosObjPtr && (*PosObjPtr).IsValid())
+		{
+			double X = 0.0;
+			double Y = 0.0;
+			(*PosObjPtr)->TryGetNumberField(TEXT("x"), X);
+			(*PosObjPtr)->TryGetNumberField(TEXT("y"), Y);
+			OutX = FMath::RoundToInt(X);
+			OutY = FMath::RoundToInt(Y);
+			return true;
+		}
+		return false;
+	}
+
+	static bool ApplyAddNode(FContext& Ctx, UEdGraph* Graph, const TSharedPtr<FJsonObject>& Op, const TSharedPtr<FJsonObject>& OpResult, FString& OutError)
+	{
+		FString Alias, NodeType, NodeName, TargetClassStr;
+		if (!Op->TryGetStringField(TEXT("alias"), Alias))
+		{
+			Op->TryGetStringField(TEXT("id"), Alias);
+		}
+		if (!Op->TryGetStringField(TEXT("class"), NodeType))
+		{
+			Op->TryGetStringField(TEXT("type"), NodeType);
+		}
+		if (!Op->TryGetStringField(TEXT("member_name"), NodeName))
+		{
+			Op->TryGetStringField(TEXT("name"), NodeName);
+		}
+		Op->TryGetStringField(TEXT("target_class"), TargetClassStr);
+
+		if (NodeType.IsEmpty())
+		{
+			OutError = TEXT("Missing required field: type (or class)");
+			return false;
+		}
+		if (!Alias.IsEmpty() && Ctx.Aliases.Contains(Alias))
+		{
+			OutError = FString::Printf(TEXT("Duplicate alias: %s"), *Alias);
+			return false;
+		}
+		if (NodeName.IsEmpty())
+		{
+			NodeName = TEXT("Default");
+		}
+
+		int32 PosX = 0;
+		int32 PosY = 0;
+		ReadPosition(Op, PosX, PosY);
+
+		UEdGraphNode* NewNode = UAL_CreateNodeInternal(Ctx.Blueprint, Graph, NodeType, NodeName, TargetClassStr, PosX, PosY, OutError);
+		if (!NewNode)
+		{
+			return false;
+		}
+
+		const TSharedPtr<FJsonObject>* PinDefaultsPtr = nullptr;
+		if (Op->TryGetObjectField(TEXT("pin_defaults"), PinDefaultsPtr) && PinDefaultsPtr && (*PinDefaultsPtr).IsValid())
+		{
+			for (const auto& Pair : (*PinDefaultsPtr)->Values)
+			{
+				FString PinValue;
+				if (!Pair.Value.IsValid() || !Pair.Value->TryGetString(PinValue))
+				{
+					continue;
+				}
+				UEdGraphPin* Pin = UAL_FindPinByName(NewNode, Pair.Key);
+				if (!Pin)
+				{
+					OutError = FString::Printf(TEXT("pin_defaults - pin '%s' not found"), *Pair.Key);
+					return false;
+				}
+				Pin->DefaultValue = PinValue;
+			}
+		}
+
+		if (!Alias.IsEmpty())
+		{
+			Ctx.Aliases.Add(Alias, NewNode);
+			OpResult->SetStringField(TEXT("alias"), Alias);
+		}
+		OpResult->SetStringField(TEXT("node_id"), UAL_GuidToString(NewNode->NodeGuid));
+		OpResult->SetStringField(TEXT("class"), NewNode->GetClass()->GetName());
+		OpResult->SetArrayField(TEXT("pins"), UAL_BuildPinsJson(NewNode));
+		Ctx.bStructural = true;
+		return true;
+	}
+
+	static bool ApplyConnect(FContext& Ctx, UEdGraph* Graph, const TSharedPtr<FJsonObject>& Op, bool bConnect, FString& OutError)
+	{
+		const UEdGraphSchema_K2* K2Schema = Cast<UEdGraphSchema_K2>(Graph->GetSchema());
+		if (!K2Schema)
+		{
+			OutError = TEXT("Graph schema is not K2");
+			return false;
+		}
+
+		UEdGraphPin* FromPin = nullptr;
+		UEdGraphPin* ToPin = nullptr;
+		if (!ResolvePinEndpoints(Ctx, Graph, Op, FromPin, ToPin, OutError))
+		{
+			return false;
+		}
+
+		if (bConnect)
+		{
+			const FPinConnectionResponse CanResp = K2Schema->CanCreateConnection(FromPin, ToPin);
+			if (CanResp.Response == CONNECT_RESPONSE_DISALLOW)
+			{
+				OutError = CanResp.Message.ToString();
+				return false;
+			}
+			if (!K2Schema->TryCreateConnection(FromPin, ToPin))
+			{
+				OutError = TEXT("Failed to create connection");
+				return false;
+			}
+		}
+		else
+		{
+			if (!FromPin->LinkedTo.Contains(ToPin))
+			{
+				OutError = TEXT("Pins are not connected");
+				return false;
+			}
+			K2Schema->BreakSinglePinLink(FromPin, ToPin);
+		}
+
+		Ctx.bStructural = true;
+		return true;
+	}
+
+	static bool ApplySetPinValue(FContext& Ctx, UEdGraph* Graph, const TSharedPtr<FJsonObject>& Op, const TSharedPtr<FJsonObject>& OpResult, FString& OutError)
+	{
+		FString NodeRef, PinName, Value;
+		Op->TryGetStringField(TEXT("node_id"), NodeRef);
+		Op->TryGetStringField(TEXT("pin_name"), PinName);
+		if (NodeRef.IsEmpty() || PinName.IsEmpty() || !Op->TryGetStringField(TEXT("value"), Value))
+		{
+			OutError = TEXT("Missing required fields: node_id, pin_name, value");
+			return false;
+		}
+
+		UEdGraphNode* Node = ResolveNode(Ctx, Graph, NodeRef);
+		if (!Node)
+		{
+			OutError = FString::Printf(TEXT("Node not found: %s"), *NodeRef);
+			return false;
+		}
+		UEdGraphPin* Pin = UAL_FindPinByName(Node, PinName);
+		if (!Pin)
+		{
+			OutError = FString::Printf(TEXT("Pin not found: %s"), *PinName);
+			return false;
+		}
+		if (Pin->Direction != EGPD_Input)
+		{
+			OutError = TEXT("Can only set default value for Input pins");
+			return false;
+		}
+
+		Node->Modify();
+		OpResult->SetStringField(TEXT("old_value"), Pin->DefaultValue);
+		Pin->DefaultValue = Value;
+		OpResult->SetStringField(TEXT("node_id"), UAL_GuidToString(Node->NodeGuid));
+		return true;
+	}
+
+	static bool ApplyMoveNode(FContext& Ctx, UEdGraph* Graph, const TSharedPtr<FJsonObject>& Op, const TSharedPtr<FJsonObject>& OpResult, FString& OutError)
+	{
+		FString NodeRef;
+		Op->TryGetStringField(TEXT("node_id"), NodeRef);
+		int32 PosX = 0;
+		int32 PosY = 0;
+		if (NodeRef.IsEmpty() || !ReadPosition(Op, PosX, PosY))
+		{
+			OutError = TEXT("Missing required fields: node_id, position");
+			return false;
+		}
+
+		UEdGraphNode* Node = ResolveNode(Ctx, Graph, NodeRef);
+		if (!Node)
+		{
+			OutError = FString::Printf(TEXT("Node not found: %s"), *NodeRef);
+			return false;
+		}
+
+		Node->Modify();
+		Node->NodePosX = PosX;
+		Node->NodePosY = PosY;
+		OpResult->SetStringField(TEXT("node_id"), UAL_GuidToString(Node->NodeGuid));
+		return true;
+	}
+
+	static bool ApplyDeleteNode(FContext& Ctx, UEdGraph* Graph, const TSharedPtr<FJsonObject>& Op, const TSharedPtr<FJsonObject>& OpResult, FString& OutError)
+	{
+		FString NodeRef;
+		Op->TryGetStringField(TEXT("node_id"), NodeRef);
+		UEdGraphNode* Node = NodeRef.IsEmpty() ? nullptr : ResolveNode(Ctx, Graph, NodeRef);
+		if (!Node)
+		{
+			OutError = FString::Printf(TEXT("Node not found: %s"), *NodeRef);
+			return false;
+		}
+		if (!Node->CanUserDeleteNode())
+		{
+			OutError = FString::Printf(TEXT("Node cannot be deleted: %s"), *Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+			return false;
+		}
+
+		OpResult->SetStringField(TEXT("node_id"), UAL_GuidToString(Node->NodeGuid));
+
+		// 删除后别名不再可用
+		for (auto It = Ctx.Aliases.CreateIterator(); It; ++It)
+		{
+			if (It.Value() == Node)
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		// bDontRecompile = true：批处理结束后统一标记
+		FBlueprintEditorUtils::RemoveNode(Ctx.Blueprint, Node, true);
+		Ctx.bStructural = true;
+		return true;
+	}
+}
+
+void FUAL_BlueprintCommands::Handle_ApplyGraphOps(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	FString BlueprintPath;
+	if (!Payload->TryGetStringField(TEXT("blueprint_path"), BlueprintPath) || BlueprintPath.IsEmpty())
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing required field: blueprint_path"));
+		return;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* OpsArray = nullptr;
+	if (!Payload->TryGetArrayField(TEXT("ops"), OpsArray) || !OpsArray || OpsArray->Num() == 0)
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing or empty required field: ops"));
+		return;
+	}
+
+	// atomic：任一操作失败则撤销整个批次（默认开启）；关闭后跳过失败项继续执行
+	bool bAtomic = true;
+	Payload->TryGetBoolField(TEXT("atomic"), bAtomic);
+
+	bool bCompile = false;
+	Payload->TryGetBoolField(TEXT("compile"), bCompile);
+	bool bDeferCompile = false;
+	Payload->TryGetBoolField(TEXT("defer_compile"), bDeferCompile);
+
+	UALApplyOps::FContext Ctx;
+	Payload->TryGetStringField(TEXT("graph_name"), Ctx.DefaultGraphName);
+
+	FString ResolvedPath;
+	if (!UAL_LoadBlueprintByPathOrName(BlueprintPath, Ctx.Blueprint, ResolvedPath) || !Ctx.Blueprint)
+	{
+		UAL_CommandUtils::SendError(RequestId, 404, FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintPath));
+		return;
+	}
+	UBlueprint* Blueprint = Ctx.Blueprint;
+
+	TArray<TSharedPtr<FJsonValue>> Results;
+	int32 AppliedCount = 0;
+	int32 FailedIndex = INDEX_NONE;
+	FString FailedMessage;
+
+	{
+		FScopedTransaction Transaction(NSLOCTEXT("UALBlueprint", "ApplyGraphOps", "Apply Blueprint Graph Ops"));
+		Blueprint->Modify();
+
+		for (int32 Index = 0; Index < OpsArray->Num(); ++Index)
+		{
+			TSharedPtr<FJsonObject> OpResult = MakeShared<FJsonObject>();
+			OpResult->SetNumberField(TEXT("index"), Index);
+
+			const TSharedPtr<FJsonObject>* OpObjPtr = nullptr;
+			const TSharedPtr<FJsonValue>& OpVal = (*OpsArray)[Index];
+			FString OpName;
+			FString Error;
+			bool bOk = false;
+
+			if (!OpVal.IsValid() || !OpVal->TryGetObject(OpObjPtr) || !OpObjPtr || !(*OpObjPtr).IsValid())
+			{
+				Error = TEXT("Invalid op object");
+			}
+			else
+			{
+				const TSharedPtr<FJsonObject>& Op = *OpObjPtr;
+				Op->TryGetStringField(TEXT("op"), OpName);
+				OpName.ToLowerInline();
+				OpResult->SetStringField(TEXT("op"), OpName);
+
+				UEdGraph* Graph = UALApplyOps::ResolveGraph(Ctx, Op, Error);
+				if (Graph)
+				{
+					UALApplyOps::TouchGraph(Ctx, Graph);
+
+					if (OpName == TEXT("add_node"))
+					{
+						bOk = UALApplyOps::ApplyAddNode(Ctx, Graph, Op, OpResult, Error);
+					}
+					else if (OpName == TEXT("connect") || OpName == TEXT("connect_pins"))
+					{
+						bOk = UALApplyOps::ApplyConnect(Ctx, Graph, Op, true, Error);
+					}
+					else if (OpName == TEXT("disconnect") || OpName == TEXT("break_link"))
+					{
+						bOk = UALApplyOps::ApplyConnect(Ctx, Graph, Op, false, Error);
+					}
+					else if (OpName == TEXT("set_pin_value"))
+					{
+						bOk = UALApplyOps::ApplySetPinValue(Ctx, Graph, Op, OpResult, Error);
+					}
+					else if (OpName == TEXT("move_node"))
+					{
+						bOk = UALApplyOps::ApplyMoveNode(Ctx, Graph, Op, OpResult, Error);
+					}
+					else if (OpName == TEXT("delete_node"))
+					{
+						bOk = UALApplyOps::ApplyDeleteNode(Ctx, Graph, Op, OpResult, Error);
+					}
+					else
+					{
+						Error = FString::Printf(TEXT("Unsupported op: '%s'. Supported: add_node, connect, disconnect, set_pin_value, move_node, delete_node"), *OpName);
+					}
+				}
+			}
+
+			OpResult->SetBoolField(TEXT("ok"), bOk);
+			if (!bOk)
+			{
+				OpResult->SetStringField(TEXT("error"), Error);
+			}
+			Results.Add(MakeShared<FJsonValueObject>(OpResult));
+
+			if (bOk)
+			{
+				AppliedCount++;
+			}
+			else if (FailedIndex == INDEX_NONE)
+			{
+				FailedIndex = Index;
+				FailedMessage = Error;
+				if (bAtomic)
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	// 原子模式下回滚整个事务，图表保持原样，不发送任何变更通知
+	if (bAtomic && FailedIndex != INDEX_NONE)
+	{
+		const bool bRolledBack = GEditor && GEditor->UndoTransaction(false);
+
+		TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
+		Details->SetNumberField(TEXT("failed_index"), FailedIndex);
+		Details->SetBoolField(TEXT("rolled_back"), bRolledBack);
+		Details->SetArrayField(TEXT("results"), Results);
+		UAL_CommandUtils::SendError(RequestId, 400, FString::Printf(TEXT("ops[%d] failed: %s"), FailedIndex, *FailedMessage), Details);
+		return;
+	}
+
+	// 延迟通知：所有操作完成后每个图表只刷新一次，蓝图只标记一次
+	for (UEdGraph* Graph : Ctx.TouchedGraphs)
+	{
+		Graph->NotifyGraphChanged();
+	}
+	if (Ctx.bStructural)
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+	}
+	else if (AppliedCount > 0)
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+	}
+
+	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+
+	// 至多编译一次；defer_compile 时交给编译队列
+	const bool bShouldCompile = bCompile && AppliedCount > 0;
+	if (bShouldCompile && bDeferCompile)
+	{
+		FUAL_BlueprintCompileScheduler::Get().Enqueue(Blueprint, false, false, false);
+	}
+	else if (bShouldCompile)
+	{
+		const FUAL_BlueprintCompileResult CompileResult = FUAL_BlueprintCompileScheduler::Get().CompileNow(Blueprint, false, false);
+		Result->SetStringField(TEXT("status"), CompileResult.Status);
+		Result->SetArrayField(TEXT("diagnostics"), CompileResult.Diagnostics);
+	}
+
+	TSharedPtr<FJsonObject> AliasesObj = MakeShared<FJsonObject>();
+	for (const TPair<FString, UEdGraphNode*>& Pair : Ctx.Aliases)
+	{
+		AliasesObj->SetStringField(Pair.Key, UAL_GuidToString(Pair.Value->NodeGuid));
+	}
+
+	Result->SetBoolField(TEXT("ok"), FailedIndex == INDEX_NONE);
+	Result->SetStringField(TEXT("blueprint_path"), ResolvedPath);
+	Result->SetNumberField(TEXT("applied_count"), AppliedCount);
+	Result->SetNumberField(TEXT("total"), OpsArray->Num());
+	Result->SetBoolField(TEXT("compiled"), bShouldCompile && !bDeferCompile);
+	Result->SetBoolField(TEXT("compile_queued"), bShouldCompile && bDeferCompile);
+	Result->SetObjectField(TEXT("aliases"), AliasesObj);
+	Result->SetArrayField(TEXT("results"), Results);
+
+	UAL_CommandUtils::SendResponse(RequestId, 200, Result);
+}
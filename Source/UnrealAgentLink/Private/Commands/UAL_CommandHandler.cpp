@@ -11,6 +11,9 @@
 #include "UAL_MessageLogCommands.h"
 #include "UAL_WidgetCommands.h"
 #include "UAL_NiagaraCommands.h"
+#include "UAL_AdmissionController.h"
+#include "UAL_ResponseCache.h"
+#include "UAL_LocalServer.h"
 
 
 #include "Async/Async.h"
@@ -34,7 +37,7 @@ TSharedPtr<FJsonObject> FUAL_CommandHandler::BuildProjectInfo() const
 	return FUAL_EditorCommands::BuildProjectInfo();
 }
 
-void FUAL_CommandHandler::ProcessMessage(const FString& JsonPayload)
+void FUAL_CommandHandler::ProcessMessage(const FString& JsonPayload, int32 ClientId)
 {
 	if (!IsInGameThread())
 	{
@@ -43,9 +46,9 @@ void FUAL_CommandHandler::ProcessMessage(const FString& JsonPayload)
 		// 会触发 TaskGraph 递归保护断言崩溃 (++Queue(QueueIndex).RecursionGuard == 1)
 		// 使用 Ticker 可以确保代码在正常的 Tick 上下文中执行，脱离 TaskGraph
 		FTSTicker::GetCoreTicker().AddTicker(
-			FTickerDelegate::CreateLambda([this, Payload = JsonPayload](float DeltaTime) -> bool
+			FTickerDelegate::CreateLambda([this, Payload = JsonPayload, ClientId](float DeltaTime) -> bool
 			{
-				ProcessMessage(Payload);
+				ProcessMessage(Payload, ClientId);
 				return false; // 只执行一次
 			}),
 			0.0f // 立即在下一个 Tick 执行
@@ -87,7 +90,17 @@ void FUAL_CommandHandler::ProcessMessage(const FString& JsonPayload)
 		}
 	}
 
-	UE_LOG(LogUALCommand, Display, TEXT("Recv message type=%s method=%s id=%s"), *Type, *Method, *RequestId);
+	UE_LOG(LogUALCommand, Display, TEXT("Recv message type=%s method=%s id=%s client=%d"), *Type, *Method, *RequestId, ClientId);
+
+	if (ClientId != 0 && Type == TEXT("req"))
+	{
+		// 本地客户端：改写为路由 ID，响应（含异步完成的响应）据此发回该客户端
+		RequestId = FUAL_LocalServer::MakeRoutedId(ClientId, RequestId);
+		if (FUAL_LocalServer::Get().HandleClientRequest(ClientId, Method, ParamsObj ? *ParamsObj : MakeShared<FJsonObject>(), RequestId))
+		{
+			return;
+		}
+	}
 
 	if (Type != TEXT("req"))
 	{
@@ -109,7 +122,16 @@ void FUAL_CommandHandler::ProcessMessage(const FString& JsonPayload)
 		return;
 	}
 
-	(*Handler)(ParamsObj ? *ParamsObj : MakeShared<FJsonObject>(), RequestId);
+	// 准入控制：超出类别速率或帧预算时排队到后续帧，队列满时回复 429
+	// 实际执行时再查响应缓存，排在前面的修改类命令先生效
+	FUAL_AdmissionController::Get().Submit(Method, RequestId,
+		[Func = *Handler, Params = ParamsObj ? *ParamsObj : MakeShared<FJsonObject>(), Method, RequestId]()
+		{
+			FUAL_ResponseCache::Get().Execute(Method, Params, RequestId, [&Func, &Params, &RequestId]()
+			{
+				Func(Params, RequestId);
+			});
+		});
 }
 
 void FUAL_CommandHandler::RegisterCommands()
@@ -2,6 +2,7 @@
 #include "UAL_CommandUtils.h"
 #include "Utils/UAL_PBRMaterialHelper.h"
 #include "Utils/UAL_NormalizedImporter.h"
+#include "Utils/UAL_JobManager.h"
 
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetToolsModule.h"
@@ -230,8 +231,9 @@ void FUAL_ContentBrowserCommands::RegisterCommands(
 	CommandMap.Add(TEXT("content.normalized_import"), &Handle_NormalizedImport);
 	CommandMap.Add(TEXT("content.audit_optimization"), &Handle_AuditOptimization);
 	CommandMap.Add(TEXT("content.rescan"), &Handle_RescanAssets);
+	CommandMap.Add(TEXT("content.configure_textures"), &Handle_ConfigureTextures);
 	
-	UE_LOG(LogUALContentCmd, Log, TEXT("ContentBrowser commands registered: content.search, content.import, content.move, content.delete, content.describe, content.normalized_import, content.audit_optimization, content.rescan"));
+	UE_LOG(LogUALContentCmd, Log, TEXT("ContentBrowser commands registered: content.search, content.import, content.move, content.delete, content.describe, content.normalized_import, content.audit_optimization, content.rescan, content.configure_textures"));
 }
 
 // ============================================================================
@@ -374,129 +376,45 @@ void FUAL_ContentBrowserCommands::Handle_SearchAssets(
 }
 
 
-/**
- * content.import - 导入外部文件
- * 将磁盘上的文件导入到 UE 项目中
- * 使用 UAssetImportTask 实现无弹窗自动化导入（类似 Quixel Bridge）
- */
-void FUAL_ContentBrowserCommands::Handle_ImportAssets(
-	const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+namespace
 {
-	// 解析 files 数组
-	const TArray<TSharedPtr<FJsonValue>>* FilesArray = nullptr;
-	if (!Payload->TryGetArrayField(TEXT("files"), FilesArray) || !FilesArray || FilesArray->Num() == 0)
-	{
-		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing or empty 'files' array"));
-		return;
-	}
-	
-	// 解析目标路径
-	FString DestinationPath = TEXT("/Game/Imported");
-	Payload->TryGetStringField(TEXT("destination_path"), DestinationPath);
-	
-	// 是否覆盖
-	bool bOverwrite = false;
-	Payload->TryGetBoolField(TEXT("overwrite"), bOverwrite);
-	
-	// 缩放参数：用于补偿不同格式的单位差异
-	// OBJ/GLB/glTF 在 UE 5.5+（Interchange）默认 100.0（源文件单位为米，UE 使用厘米）
-	// UE 5.0-5.4 使用传统导入器，不需要缩放补偿
-	// FBX 默认 1.0（FBX 内含单位元数据，引擎自动处理）
-	// 可通过 JSON 显式指定覆盖默认值
-	double ScaleOverride = -1.0; // -1 表示使用格式默认值
-	Payload->TryGetNumberField(TEXT("scale"), ScaleOverride);
-	
-	// 验证 scale 参数：必须 > 0 或为 -1（自动）
-	if (ScaleOverride != -1.0 && ScaleOverride <= 0.0)
-	{
-		UE_LOG(LogUALContentCmd, Warning, TEXT("Invalid scale value %.4f, must be > 0. Using format default."), ScaleOverride);
-		ScaleOverride = -1.0;
-	}
-	
-	// 解析 normalized_names 数组，建立文件名到规范化名称的映射
-	// 格式: [{ "original": "原始文件名.ext", "normalized": "规范化名称" }, ...]
-	TMap<FString, FString> NormalizedNameMap;
-	const TArray<TSharedPtr<FJsonValue>>* NormalizedNamesArray = nullptr;
-	if (Payload->TryGetArrayField(TEXT("normalized_names"), NormalizedNamesArray) && NormalizedNamesArray)
-	{
-		for (const TSharedPtr<FJsonValue>& Item : *NormalizedNamesArray)
-		{
-			const TSharedPtr<FJsonObject>* ItemObj = nullptr;
-			if (Item->TryGetObject(ItemObj) && ItemObj)
-			{
-				FString Original, Normalized;
-				(*ItemObj)->TryGetStringField(TEXT("original"), Original);
-				(*ItemObj)->TryGetStringField(TEXT("normalized"), Normalized);
-				if (!Original.IsEmpty() && !Normalized.IsEmpty())
-				{
-					// 移除扩展名，用文件名（不含扩展名）作为键
-					FString OriginalBaseName = FPaths::GetBaseFilename(Original);
-					NormalizedNameMap.Add(OriginalBaseName, Normalized);
-					UE_LOG(LogUALContentCmd, Log, TEXT("Name mapping: %s -> %s"), *OriginalBaseName, *Normalized);
-				}
-			}
-		}
-	}
-	
-	UE_LOG(LogUALContentCmd, Log, TEXT("content.import: %d files -> %s, overwrite=%d, name_mappings=%d"),
-		FilesArray->Num(), *DestinationPath, bOverwrite, NormalizedNameMap.Num());
-	
-	// 收集导入结果（提前声明，用于汇总视频和普通文件的导入结果）
-	TArray<TSharedPtr<FJsonValue>> ImportedResults;
-	int32 SuccessCount = 0;
-	int32 TotalRequestCount = 0;
-	
-	// === 第一阶段：分离视频文件和其他文件 ===
-	TArray<FString> VideoFiles;
-	TArray<FString> OtherFiles;
-	
-	for (const TSharedPtr<FJsonValue>& FileValue : *FilesArray)
-	{
-		FString FilePath;
-		if (FileValue->TryGetString(FilePath) && !FilePath.IsEmpty())
-		{
-			// 验证文件存在
-			if (!FPaths::FileExists(FilePath))
-			{
-				UE_LOG(LogUALContentCmd, Warning, TEXT("File not found: %s"), *FilePath);
-				continue;
-			}
-			
-			TotalRequestCount++;
-			
-			// 检查是否是视频文件
-			if (IsVideoFile(FilePath))
-			{
-				VideoFiles.Add(FilePath);
-				UE_LOG(LogUALContentCmd, Log, TEXT("Detected video file: %s"), *FilePath);
-			}
-			else
-			{
-				OtherFiles.Add(FilePath);
-			}
-		}
-	}
-	
-	// === 第二阶段：导入视频文件（特殊处理） ===
-	if (VideoFiles.Num() > 0)
-	{
-		UE_LOG(LogUALContentCmd, Log, TEXT("Processing %d video file(s) with special import logic..."), VideoFiles.Num());
-		
-		for (const FString& VideoFilePath : VideoFiles)
+	/**
+	 * content.import 的分步状态：每步导入一个文件（视频文件先于其它文件），
+	 * 最后一步生成 PBR 材质并汇总结果
+	 */
+	struct FUAL_ImportAssetsState
+	{
+		FString DestinationPath;
+		bool bOverwrite = false;
+		double ScaleOverride = -1.0;
+		TMap<FString, FString> NormalizedNameMap;
+
+		TArray<FString> VideoFiles;
+		TArray<FString> OtherFiles;
+		int32 TotalRequestCount = 0;
+		int32 Cursor = 0;
+
+		TArray<TSharedPtr<FJsonValue>> ImportedResults;
+		int32 SuccessCount = 0;
+		// 跨帧保存，用弱引用防止资产在两步之间被回收后悬空
+		TArray<TWeakObjectPtr<UTexture2D>> ImportedTextures;
+		TArray<TWeakObjectPtr<UStaticMesh>> ImportedMeshes;
+
+		void ImportVideo(const FString& VideoFilePath)
 		{
 			UFileMediaSource* ImportedMediaSource = nullptr;
 			FString ImportError;
-			
+		
 			// 查找该视频文件的规范化名称
 			FString VideoBaseName = FPaths::GetBaseFilename(VideoFilePath);
 			const FString* NormalizedVideoName = NormalizedNameMap.Find(VideoBaseName);
 			FString FinalVideoAssetName = NormalizedVideoName ? *NormalizedVideoName : FString();
-			
+		
 			if (!FinalVideoAssetName.IsEmpty())
 			{
 				UE_LOG(LogUALContentCmd, Log, TEXT("Video file normalized name: %s -> %s"), *VideoBaseName, *FinalVideoAssetName);
 			}
-			
+		
 			if (ImportVideoFile(VideoFilePath, DestinationPath, bOverwrite, FinalVideoAssetName, ImportedMediaSource, ImportError))
 			{
 				if (ImportedMediaSource)
@@ -508,7 +426,7 @@ void FUAL_ContentBrowserCommands::Handle_ImportAssets(
 					Item->SetStringField(TEXT("source_file"), VideoFilePath);
 					ImportedResults.Add(MakeShared<FJsonValueObject>(Item));
 					SuccessCount++;
-					
+				
 					UE_LOG(LogUALContentCmd, Log, TEXT("Successfully imported video: %s -> %s"), 
 						*VideoFilePath, *ImportedMediaSource->GetPathName());
 				}
@@ -519,316 +437,480 @@ void FUAL_ContentBrowserCommands::Handle_ImportAssets(
 					*VideoFilePath, *ImportError);
 			}
 		}
-	}
-	
-	// === 第三阶段：导入其他文件（标准导入流程） ===
-	TArray<UAssetImportTask*> ImportTasks;
-	
-	for (const FString& FilePath : OtherFiles)
-	{
-		// 创建导入任务
-		UAssetImportTask* Task = NewObject<UAssetImportTask>();
-		Task->Filename = FilePath;
-		Task->DestinationPath = DestinationPath;
+
+		void ImportFile(const FString& FilePath)
+		{
+			// 创建导入任务
+			UAssetImportTask* Task = NewObject<UAssetImportTask>();
+			Task->Filename = FilePath;
+			Task->DestinationPath = DestinationPath;
 		
-		// 关键设置：禁用所有UI，实现无弹窗导入
-		Task->bAutomated = true;
-		// 不自动保存，避免触发源码管理检出对话框
-		// 资产将保持未保存状态，用户可稍后手动保存
-		Task->bSave = false;
-		Task->bReplaceExisting = bOverwrite;
+			// 关键设置：禁用所有UI，实现无弹窗导入
+			Task->bAutomated = true;
+			// 不自动保存，避免触发源码管理检出对话框
+			// 资产将保持未保存状态，用户可稍后手动保存
+			Task->bSave = false;
+			Task->bReplaceExisting = bOverwrite;
 		
-		// 获取文件扩展名
-		FString Extension = FPaths::GetExtension(FilePath).ToLower();
+			// 获取文件扩展名
+			FString Extension = FPaths::GetExtension(FilePath).ToLower();
 		
-		// 为 FBX 文件配置自动导入选项
-		if (Extension == TEXT("fbx"))
-		{
-			UFbxImportUI* ImportUI = NewObject<UFbxImportUI>();
+			// 为 FBX 文件配置自动导入选项
+			if (Extension == TEXT("fbx"))
+			{
+				UFbxImportUI* ImportUI = NewObject<UFbxImportUI>();
 			
-			// 禁用自动检测，明确指定为静态网格体
-			ImportUI->bAutomatedImportShouldDetectType = false;
-			ImportUI->MeshTypeToImport = FBXIT_StaticMesh;
+				// 禁用自动检测，明确指定为静态网格体
+				ImportUI->bAutomatedImportShouldDetectType = false;
+				ImportUI->MeshTypeToImport = FBXIT_StaticMesh;
 			
-			// 自动导入材质和纹理
-			ImportUI->bImportMaterials = true;
-			ImportUI->bImportTextures = true;
+				// 自动导入材质和纹理
+				ImportUI->bImportMaterials = true;
+				ImportUI->bImportTextures = true;
 			
-			// 应用到任务
-			Task->Options = ImportUI;
+				// 应用到任务
+				Task->Options = ImportUI;
 			
-			UE_LOG(LogUALContentCmd, Log, TEXT("Configured FBX import for: %s"), *FilePath);
-		}
-		else
-		{
-			UE_LOG(LogUALContentCmd, Log, TEXT("Using default import settings for: %s (Extension: %s)"), *FilePath, *Extension);
-		}
-		
-		ImportTasks.Add(Task);
-	}
-	
-	if (ImportTasks.Num() == 0 && VideoFiles.Num() == 0)
-	{
-		UAL_CommandUtils::SendError(RequestId, 400, TEXT("No valid files to import"));
-		return;
-	}
-	// === 第四阶段：执行标准导入任务 ===
-	if (ImportTasks.Num() > 0)
-	{
-		// 获取 AssetTools
-		FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
-		IAssetTools& AssetTools = AssetToolsModule.Get();
-		
-		// 执行批量导入任务（无弹窗）
-		UE_LOG(LogUALContentCmd, Log, TEXT("Executing %d automated import tasks..."), ImportTasks.Num());
-		AssetTools.ImportAssetTasks(ImportTasks);
-	}
-	
-	// 收集标准导入的结果（追加到 ImportedResults）
-	TArray<UTexture2D*> ImportedTextures;
-	TArray<UStaticMesh*> ImportedMeshes;
-	
-	for (UAssetImportTask* Task : ImportTasks)
-	{
-		// 检查任务是否成功（通过ImportedObjectPaths检查）
-		if (Task->ImportedObjectPaths.Num() > 0)
-		{
-			// 获取源文件名（不含扩展名），用于查找规范化名称
-			const FString SourceBaseName = FPaths::GetBaseFilename(Task->Filename);
-			
-			// 复制数组以避免在重命名操作中修改原数组导致崩溃
-			// ("Array has changed during ranged-for iteration" bug fix)
-			TArray<FString> ObjectPathsCopy = Task->ImportedObjectPaths;
-			for (const FString& ObjectPath : ObjectPathsCopy)
+				UE_LOG(LogUALContentCmd, Log, TEXT("Configured FBX import for: %s"), *FilePath);
+			}
+			else
 			{
-				// 检查路径是否为空
-				if (ObjectPath.IsEmpty())
-				{
-					UE_LOG(LogUALContentCmd, Warning, TEXT("Skipping empty ObjectPath in import task for: %s"), *Task->Filename);
-					continue;
-				}
-				
-				// 加载导入的资产
-				UObject* ImportedAsset = LoadObject<UObject>(nullptr, *ObjectPath);
-				if (ImportedAsset)
+				UE_LOG(LogUALContentCmd, Log, TEXT("Using default import settings for: %s (Extension: %s)"), *FilePath, *Extension);
+			}
+
+			// 获取 AssetTools
+			FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
+			IAssetTools& AssetTools = AssetToolsModule.Get();
+
+			// 执行导入任务（无弹窗）
+			UE_LOG(LogUALContentCmd, Log, TEXT("Executing automated import task: %s"), *FilePath);
+			AssetTools.ImportAssetTasks({ Task });
+
+			// 检查任务是否成功（通过ImportedObjectPaths检查）
+			if (Task->ImportedObjectPaths.Num() > 0)
+			{
+				// 获取源文件名（不含扩展名），用于查找规范化名称
+				const FString SourceBaseName = FPaths::GetBaseFilename(Task->Filename);
+			
+				// 复制数组以避免在重命名操作中修改原数组导致崩溃
+				// ("Array has changed during ranged-for iteration" bug fix)
+				TArray<FString> ObjectPathsCopy = Task->ImportedObjectPaths;
+				for (const FString& ObjectPath : ObjectPathsCopy)
 				{
-					FString FinalAssetName = ImportedAsset->GetName();
-					FString FinalAssetPath = ImportedAsset->GetPathName();
-					
-					// 检查是否需要重命名（如果有规范化名称映射）
-					// 首先尝试用当前资产名查找，然后尝试用源文件名查找
-					const FString* NormalizedName = NormalizedNameMap.Find(ImportedAsset->GetName());
-					if (!NormalizedName)
+					// 检查路径是否为空
+					if (ObjectPath.IsEmpty())
 					{
-						NormalizedName = NormalizedNameMap.Find(SourceBaseName);
+						UE_LOG(LogUALContentCmd, Warning, TEXT("Skipping empty ObjectPath in import task for: %s"), *Task->Filename);
+						continue;
 					}
-					
-					if (NormalizedName && !NormalizedName->IsEmpty() && *NormalizedName != ImportedAsset->GetName())
+				
+					// 加载导入的资产
+					UObject* ImportedAsset = LoadObject<UObject>(nullptr, *ObjectPath);
+					if (ImportedAsset)
 					{
-						// 获取资产所在的包路径
-						FString PackagePath = FPackageName::GetLongPackagePath(ImportedAsset->GetOutermost()->GetName());
+						FString FinalAssetName = ImportedAsset->GetName();
+						FString FinalAssetPath = ImportedAsset->GetPathName();
+					
+						// 检查是否需要重命名（如果有规范化名称映射）
+						// 首先尝试用当前资产名查找，然后尝试用源文件名查找
+						const FString* NormalizedName = NormalizedNameMap.Find(ImportedAsset->GetName());
+						if (!NormalizedName)
+						{
+							NormalizedName = NormalizedNameMap.Find(SourceBaseName);
+						}
+					
+						if (NormalizedName && !NormalizedName->IsEmpty() && *NormalizedName != ImportedAsset->GetName())
+						{
+							// 获取资产所在的包路径
+							FString PackagePath = FPackageName::GetLongPackagePath(ImportedAsset->GetOutermost()->GetName());
 						
-						// 冲突检测：检查目标名称是否已存在（内存中或磁盘上）
-						FString TargetPackagePath = PackagePath / *NormalizedName;
-						bool bTargetExists = false;
+							// 冲突检测：检查目标名称是否已存在（内存中或磁盘上）
+							FString TargetPackagePath = PackagePath / *NormalizedName;
+							bool bTargetExists = false;
 						
-						// 优先用 AssetRegistry 检查（能发现磁盘上未加载的资产）
-						FAssetRegistryModule& ARModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-						TArray<FAssetData> ExistingAssets;
-						ARModule.Get().GetAssetsByPackageName(FName(*TargetPackagePath), ExistingAssets);
-						bTargetExists = ExistingAssets.Num() > 0;
+							// 优先用 AssetRegistry 检查（能发现磁盘上未加载的资产）
+							FAssetRegistryModule& ARModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+							TArray<FAssetData> ExistingAssets;
+							ARModule.Get().GetAssetsByPackageName(FName(*TargetPackagePath), ExistingAssets);
+							bTargetExists = ExistingAssets.Num() > 0;
 						
-						// 回退：也检查内存中刚创建但未注册的对象
-						if (!bTargetExists)
-						{
-							FString TargetObjectPath = TargetPackagePath + TEXT(".") + *NormalizedName;
-							bTargetExists = StaticFindObject(UObject::StaticClass(), nullptr, *TargetObjectPath) != nullptr;
-						}
+							// 回退：也检查内存中刚创建但未注册的对象
+							if (!bTargetExists)
+							{
+								FString TargetObjectPath = TargetPackagePath + TEXT(".") + *NormalizedName;
+								bTargetExists = StaticFindObject(UObject::StaticClass(), nullptr, *TargetObjectPath) != nullptr;
+							}
 						
-						if (bTargetExists)
-						{
-							UE_LOG(LogUALContentCmd, Log, TEXT("Skipping rename: target already exists: %s"), *TargetPackagePath);
-						}
-						else
-						{
-							UE_LOG(LogUALContentCmd, Log, TEXT("Renaming asset: %s -> %s"), 
-								*ImportedAsset->GetName(), **NormalizedName);
-							
-							// 使用 AssetTools 重命名资产
-							FAssetToolsModule& AssetToolsMod = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
-							IAssetTools& AssetToolsRef = AssetToolsMod.Get();
-							
-							TArray<FAssetRenameData> RenameData;
-							// 使用 TWeakObjectPtr<UObject> 构造函数，兼容所有 UE5 版本
-							RenameData.Add(FAssetRenameData(ImportedAsset, PackagePath, *NormalizedName));
-							
-							bool bRenameSuccess = AssetToolsRef.RenameAssets(RenameData);
-							if (bRenameSuccess)
+							if (bTargetExists)
 							{
-								FinalAssetName = *NormalizedName;
-								FinalAssetPath = PackagePath / *NormalizedName;
-								UE_LOG(LogUALContentCmd, Log, TEXT("Successfully renamed asset to: %s"), *FinalAssetPath);
+								UE_LOG(LogUALContentCmd, Log, TEXT("Skipping rename: target already exists: %s"), *TargetPackagePath);
 							}
 							else
 							{
-								UE_LOG(LogUALContentCmd, Warning, TEXT("Failed to rename asset: %s -> %s"), 
+								UE_LOG(LogUALContentCmd, Log, TEXT("Renaming asset: %s -> %s"), 
 									*ImportedAsset->GetName(), **NormalizedName);
+							
+								// 使用 AssetTools 重命名资产
+								FAssetToolsModule& AssetToolsMod = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
+								IAssetTools& AssetToolsRef = AssetToolsMod.Get();
+							
+								TArray<FAssetRenameData> RenameData;
+								// 使用 TWeakObjectPtr<UObject> 构造函数，兼容所有 UE5 版本
+								RenameData.Add(FAssetRenameData(ImportedAsset, PackagePath, *NormalizedName));
+							
+								bool bRenameSuccess = AssetToolsRef.RenameAssets(RenameData);
+								if (bRenameSuccess)
+								{
+									FinalAssetName = *NormalizedName;
+									FinalAssetPath = PackagePath / *NormalizedName;
+									UE_LOG(LogUALContentCmd, Log, TEXT("Successfully renamed asset to: %s"), *FinalAssetPath);
+								}
+								else
+								{
+									UE_LOG(LogUALContentCmd, Warning, TEXT("Failed to rename asset: %s -> %s"), 
+										*ImportedAsset->GetName(), **NormalizedName);
+								}
 							}
 						}
-					}
 					
-					TSharedPtr<FJsonObject> Item = MakeShared<FJsonObject>();
-					Item->SetStringField(TEXT("name"), FinalAssetName);
-					Item->SetStringField(TEXT("path"), FinalAssetPath);
-					Item->SetStringField(TEXT("class"), ImportedAsset->GetClass()->GetName());
-					ImportedResults.Add(MakeShared<FJsonValueObject>(Item));
-					SuccessCount++;
+						TSharedPtr<FJsonObject> Item = MakeShared<FJsonObject>();
+						Item->SetStringField(TEXT("name"), FinalAssetName);
+						Item->SetStringField(TEXT("path"), FinalAssetPath);
+						Item->SetStringField(TEXT("class"), ImportedAsset->GetClass()->GetName());
+						ImportedResults.Add(MakeShared<FJsonValueObject>(Item));
+						SuccessCount++;
 					
-					// 🎨 收集纹理和网格体，用于PBR材质生成
-					if (UTexture2D* Texture = Cast<UTexture2D>(ImportedAsset))
-					{
-						ImportedTextures.Add(Texture);
-					}
-					else if (UStaticMesh* Mesh = Cast<UStaticMesh>(ImportedAsset))
-					{
-						ImportedMeshes.Add(Mesh);
-						
-						// 缩放补偿：OBJ/GLB/glTF 在 Interchange（UE 5.5+）下不做单位转换
-						// 导致以米为单位的模型在 UE（厘米）中缩小 100 倍
-						// UE 5.0-5.4 使用传统导入器，不需要补偿
-						FString SourceExt = FPaths::GetExtension(Task->Filename).ToLower();
-						double MeshScale = ScaleOverride;
-						if (MeshScale < 0) // 未显式指定，使用格式默认值
+						// 🎨 收集纹理和网格体，用于PBR材质生成
+						if (UTexture2D* Texture = Cast<UTexture2D>(ImportedAsset))
 						{
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5
-							// UE 5.5+ 使用 Interchange 导入 OBJ/GLB/glTF，不做单位转换
-							if (SourceExt == TEXT("obj") || SourceExt == TEXT("glb") || SourceExt == TEXT("gltf"))
-							{
-								MeshScale = 100.0;
-							}
-							else
+							ImportedTextures.Add(Texture);
+						}
+						else if (UStaticMesh* Mesh = Cast<UStaticMesh>(ImportedAsset))
+						{
+							ImportedMeshes.Add(Mesh);
+						
+							// 缩放补偿：OBJ/GLB/glTF 在 Interchange（UE 5.5+）下不做单位转换
+							// 导致以米为单位的模型在 UE（厘米）中缩小 100 倍
+							// UE 5.0-5.4 使用传统导入器，不需要补偿
+							FString SourceExt = FPaths::GetExtension(Task->Filename).ToLower();
+							double MeshScale = ScaleOverride;
+							if (MeshScale < 0) // 未显式指定，使用格式默认值
 							{
-								MeshScale = 1.0;
-							}
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5
+								// UE 5.5+ 使用 Interchange 导入 OBJ/GLB/glTF，不做单位转换
+								if (SourceExt == TEXT("obj") || SourceExt == TEXT("glb") || SourceExt == TEXT("gltf"))
+								{
+									MeshScale = 100.0;
+								}
+								else
+								{
+									MeshScale = 1.0;
+								}
 #else
-							// UE 5.0-5.4 使用传统导入器，不需要缩放补偿
-							MeshScale = 1.0;
+								// UE 5.0-5.4 使用传统导入器，不需要缩放补偿
+								MeshScale = 1.0;
 #endif
-						}
+							}
 						
-						if (!FMath::IsNearlyEqual(MeshScale, 1.0))
-						{
-							if (Mesh->GetNumSourceModels() > 0)
+							if (!FMath::IsNearlyEqual(MeshScale, 1.0))
 							{
-								// 对所有 LOD 应用缩放，避免 LOD 间尺寸不一致
-								for (int32 LODIdx = 0; LODIdx < Mesh->GetNumSourceModels(); ++LODIdx)
+								if (Mesh->GetNumSourceModels() > 0)
 								{
-									FStaticMeshSourceModel& SourceModel = Mesh->GetSourceModel(LODIdx);
-									SourceModel.BuildSettings.BuildScale3D = FVector(MeshScale);
-								}
-								Mesh->Build();
-								Mesh->MarkPackageDirty();
+									// 对所有 LOD 应用缩放，避免 LOD 间尺寸不一致
+									for (int32 LODIdx = 0; LODIdx < Mesh->GetNumSourceModels(); ++LODIdx)
+									{
+										FStaticMeshSourceModel& SourceModel = Mesh->GetSourceModel(LODIdx);
+										SourceModel.BuildSettings.BuildScale3D = FVector(MeshScale);
+									}
+									Mesh->Build();
+									Mesh->MarkPackageDirty();
 								
-								UE_LOG(LogUALContentCmd, Log, TEXT("Applied scale %.1f to mesh: %s (%d LODs, format: %s)"),
-									MeshScale, *Mesh->GetName(), Mesh->GetNumSourceModels(), *SourceExt);
+									UE_LOG(LogUALContentCmd, Log, TEXT("Applied scale %.1f to mesh: %s (%d LODs, format: %s)"),
+										MeshScale, *Mesh->GetName(), Mesh->GetNumSourceModels(), *SourceExt);
+								}
 							}
 						}
 					}
 				}
 			}
+			else
+			{
+				UE_LOG(LogUALContentCmd, Warning, TEXT("No assets imported from: %s"), *Task->Filename);
+			}
 		}
-		else
+
+		TSharedPtr<FJsonObject> BuildResult()
 		{
-			UE_LOG(LogUALContentCmd, Warning, TEXT("No assets imported from: %s"), *Task->Filename);
-		}
-	}
-	
-	// 🚀 自动生成PBR材质（如果导入了纹理）
-	TArray<UMaterialInstanceConstant*> CreatedMaterials;
-	if (ImportedTextures.Num() > 0)
-	{
-		UE_LOG(LogUALContentCmd, Log, 
-			TEXT("Starting automatic PBR material generation for %d textures..."), 
-			ImportedTextures.Num());
+			TArray<UTexture2D*> ImportedTextureObjects;
+			for (const TWeakObjectPtr<UTexture2D>& Texture : ImportedTextures)
+			{
+				if (Texture.IsValid())
+				{
+					ImportedTextureObjects.Add(Texture.Get());
+				}
+			}
+			TArray<UStaticMesh*> ImportedMeshObjects;
+			for (const TWeakObjectPtr<UStaticMesh>& Mesh : ImportedMeshes)
+			{
+				if (Mesh.IsValid())
+				{
+					ImportedMeshObjects.Add(Mesh.Get());
+				}
+			}
+
+			// 🚀 自动生成PBR材质（如果导入了纹理）
+			TArray<UMaterialInstanceConstant*> CreatedMaterials;
+			if (ImportedTextureObjects.Num() > 0)
+			{
+				UE_LOG(LogUALContentCmd, Log, 
+					TEXT("Starting automatic PBR material generation for %d textures..."), 
+					ImportedTextureObjects.Num());
+	
+				// 配置PBR处理选项
+				FUAL_PBRMaterialOptions PBROptions;
+				PBROptions.bApplyToMesh = true;           // 自动应用到网格体
+				PBROptions.bUseStandardNaming = true;     // 使用标准命名（MI_前缀）
+				PBROptions.bAutoConfigureTextures = true;  // 自动配置纹理设置
+	
+				// 批量处理PBR资产
+				int32 MaterialCount = FUAL_PBRMaterialHelper::BatchProcessPBRAssets(
+					ImportedTextureObjects,
+					ImportedMeshObjects,
+					DestinationPath,
+					PBROptions,
+					CreatedMaterials);
+	
+				if (MaterialCount > 0)
+				{
+					UE_LOG(LogUALContentCmd, Log, 
+						TEXT("✨ Successfully created %d PBR material(s) automatically!"), 
+						MaterialCount);
 		
-		// 配置PBR处理选项
-		FUAL_PBRMaterialOptions PBROptions;
-		PBROptions.bApplyToMesh = true;           // 自动应用到网格体
-		PBROptions.bUseStandardNaming = true;     // 使用标准命名（MI_前缀）
-		PBROptions.bAutoConfigureTextures = true;  // 自动配置纹理设置
+					// 将创建的材质也添加到返回结果中
+					for (UMaterialInstanceConstant* Material : CreatedMaterials)
+					{
+						if (Material)
+						{
+							TSharedPtr<FJsonObject> MatItem = MakeShared<FJsonObject>();
+							MatItem->SetStringField(TEXT("name"), Material->GetName());
+							MatItem->SetStringField(TEXT("path"), Material->GetPathName());
+							MatItem->SetStringField(TEXT("class"), TEXT("MaterialInstanceConstant"));
+							MatItem->SetBoolField(TEXT("auto_generated"), true);
+							ImportedResults.Add(MakeShared<FJsonValueObject>(MatItem));
+							SuccessCount++;
+						}
+					}
+				}
+			}
+
+			// Show notification (Ensure logic runs on GameThread)
+			if (SuccessCount > 0)
+			{
+				// Capture by value
+				AsyncTask(ENamedThreads::GameThread, [SuccessCount = SuccessCount]()
+				{
+					UE_LOG(LogUALContentCmd, Log, TEXT("Handle_ImportAssets: Attempting to show success notification for %d assets"), SuccessCount);
+
+					FString Title = UAL_CommandUtils::LStr(TEXT("导入成功"), TEXT("Import Successful"));
+					FString Msg = FString::Printf(TEXT("%s: %d"), *UAL_CommandUtils::LStr(TEXT("成功导入资产数"), TEXT("Assets imported")), SuccessCount);
 		
-		// 批量处理PBR资产
-		int32 MaterialCount = FUAL_PBRMaterialHelper::BatchProcessPBRAssets(
-			ImportedTextures,
-			ImportedMeshes,
-			DestinationPath,
-			PBROptions,
-			CreatedMaterials);
+					FNotificationInfo Info(FText::FromString(Title));
+					Info.SubText = FText::FromString(Msg);
+					Info.ExpireDuration = 3.0f;
+					Info.bFireAndForget = true;
+					Info.bUseLargeFont = false;
 		
-		if (MaterialCount > 0)
+					TSharedPtr<SNotificationItem> NotificationItem = FSlateNotificationManager::Get().AddNotification(Info);
+					if (NotificationItem.IsValid())
+					{
+						NotificationItem->SetCompletionState(SNotificationItem::CS_Success);
+					}
+					else
+					{
+						UE_LOG(LogUALContentCmd, Warning, TEXT("Handle_ImportAssets: Failed to create notification item"));
+					}
+				});
+			}
+
+			// 返回结果
+			TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+			Response->SetBoolField(TEXT("ok"), SuccessCount > 0);
+			if (SuccessCount == 0)
+			{
+				Response->SetStringField(TEXT("error"), TEXT("Failed to import assets. Possible reasons: 1) File type not supported by installed plugins, 2) Invalid file path. Check Output Log for details."));
+			}
+			Response->SetNumberField(TEXT("imported_count"), SuccessCount);
+			Response->SetNumberField(TEXT("requested_count"), TotalRequestCount);
+			Response->SetArrayField(TEXT("imported"), ImportedResults);
+			return Response;
+		}
+
+		/** 执行一步：每步导入一个文件，全部导入后生成材质并汇总结果 */
+		bool Step(FUAL_JobProgress& Progress)
 		{
-			UE_LOG(LogUALContentCmd, Log, 
-				TEXT("✨ Successfully created %d PBR material(s) automatically!"), 
-				MaterialCount);
-			
-			// 将创建的材质也添加到返回结果中
-			for (UMaterialInstanceConstant* Material : CreatedMaterials)
+			Progress.Total = VideoFiles.Num() + OtherFiles.Num();
+			if (Cursor < VideoFiles.Num())
+			{
+				Progress.Message = FPaths::GetCleanFilename(VideoFiles[Cursor]);
+				ImportVideo(VideoFiles[Cursor]);
+			}
+			else if (Cursor < Progress.Total)
+			{
+				Progress.Message = FPaths::GetCleanFilename(OtherFiles[Cursor - VideoFiles.Num()]);
+				ImportFile(OtherFiles[Cursor - VideoFiles.Num()]);
+			}
+
+			if (Cursor < Progress.Total)
 			{
-				if (Material)
+				Progress.Completed = ++Cursor;
+				if (Cursor < Progress.Total)
 				{
-					TSharedPtr<FJsonObject> MatItem = MakeShared<FJsonObject>();
-					MatItem->SetStringField(TEXT("name"), Material->GetName());
-					MatItem->SetStringField(TEXT("path"), Material->GetPathName());
-					MatItem->SetStringField(TEXT("class"), TEXT("MaterialInstanceConstant"));
-					MatItem->SetBoolField(TEXT("auto_generated"), true);
-					ImportedResults.Add(MakeShared<FJsonValueObject>(MatItem));
-					SuccessCount++;
+					return false;
 				}
 			}
+
+			Progress.Message = TEXT("PBR materials");
+			Progress.Result = BuildResult();
+			// 一个文件都没导入时任务记为失败（job.status 为 failed），结果中仍带有 imported 明细
+			if (SuccessCount == 0)
+			{
+				Progress.Error = TEXT("No files were imported");
+			}
+			return true;
 		}
+	};
+}
+
+/**
+ * content.import - 导入外部文件
+ * 将磁盘上的文件导入到 UE 项目中
+ * 使用 UAssetImportTask 实现无弹窗自动化导入（类似 Quixel Bridge）
+ */
+void FUAL_ContentBrowserCommands::Handle_ImportAssets(
+	const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	// 解析 files 数组
+	const TArray<TSharedPtr<FJsonValue>>* FilesArray = nullptr;
+	if (!Payload->TryGetArrayField(TEXT("files"), FilesArray) || !FilesArray || FilesArray->Num() == 0)
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing or empty 'files' array"));
+		return;
+	}
+	
+	// 解析目标路径
+	FString DestinationPath = TEXT("/Game/Imported");
+	Payload->TryGetStringField(TEXT("destination_path"), DestinationPath);
+	
+	// 是否覆盖
+	bool bOverwrite = false;
+	Payload->TryGetBoolField(TEXT("overwrite"), bOverwrite);
+	
+	// 缩放参数：用于补偿不同格式的单位差异
+	// OBJ/GLB/glTF 在 UE 5.5+（Interchange）默认 100.0（源文件单位为米，UE 使用厘米）
+	// UE 5.0-5.4 使用传统导入器，不需要缩放补偿
+	// FBX 默认 1.0（FBX 内含单位元数据，引擎自动处理）
+	// 可通过 JSON 显式指定覆盖默认值
+	double ScaleOverride = -1.0; // -1 表示使用格式默认值
+	Payload->TryGetNumberField(TEXT("scale"), ScaleOverride);
+	
+	// 验证 scale 参数：必须 > 0 或为 -1（自动）
+	if (ScaleOverride != -1.0 && ScaleOverride <= 0.0)
+	{
+		UE_LOG(LogUALContentCmd, Warning, TEXT("Invalid scale value %.4f, must be > 0. Using format default."), ScaleOverride);
+		ScaleOverride = -1.0;
 	}
 	
-	// Show notification (Ensure logic runs on GameThread)
-	if (SuccessCount > 0)
+	// 解析 normalized_names 数组，建立文件名到规范化名称的映射
+	// 格式: [{ "original": "原始文件名.ext", "normalized": "规范化名称" }, ...]
+	TMap<FString, FString> NormalizedNameMap;
+	const TArray<TSharedPtr<FJsonValue>>* NormalizedNamesArray = nullptr;
+	if (Payload->TryGetArrayField(TEXT("normalized_names"), NormalizedNamesArray) && NormalizedNamesArray)
 	{
-		// Capture by value
-		AsyncTask(ENamedThreads::GameThread, [SuccessCount]()
+		for (const TSharedPtr<FJsonValue>& Item : *NormalizedNamesArray)
 		{
-			UE_LOG(LogUALContentCmd, Log, TEXT("Handle_ImportAssets: Attempting to show success notification for %d assets"), SuccessCount);
+			const TSharedPtr<FJsonObject>* ItemObj = nullptr;
+			if (Item->TryGetObject(ItemObj) && ItemObj)
+			{
+				FString Original, Normalized;
+				(*ItemObj)->TryGetStringField(TEXT("original"), Original);
+				(*ItemObj)->TryGetStringField(TEXT("normalized"), Normalized);
+				if (!Original.IsEmpty() && !Normalized.IsEmpty())
+				{
+					// 移除扩展名，用文件名（不含扩展名）作为键
+					FString OriginalBaseName = FPaths::GetBaseFilename(Original);
+					NormalizedNameMap.Add(OriginalBaseName, Normalized);
+					UE_LOG(LogUALContentCmd, Log, TEXT("Name mapping: %s -> %s"), *OriginalBaseName, *Normalized);
+				}
+			}
+		}
+	}
+	
+	TSharedRef<FUAL_ImportAssetsState> State = MakeShared<FUAL_ImportAssetsState>();
+	State->DestinationPath = DestinationPath;
+	State->bOverwrite = bOverwrite;
+	State->ScaleOverride = ScaleOverride;
+	State->NormalizedNameMap = MoveTemp(NormalizedNameMap);
 
-			FString Title = UAL_CommandUtils::LStr(TEXT("导入成功"), TEXT("Import Successful"));
-			FString Msg = FString::Printf(TEXT("%s: %d"), *UAL_CommandUtils::LStr(TEXT("成功导入资产数"), TEXT("Assets imported")), SuccessCount);
+	// 分离视频文件（特殊处理：复制到 Movies 目录并创建 FileMediaSource）和其他文件
+	for (const TSharedPtr<FJsonValue>& FileValue : *FilesArray)
+	{
+		FString FilePath;
+		if (FileValue->TryGetString(FilePath) && !FilePath.IsEmpty())
+		{
+			// 验证文件存在
+			if (!FPaths::FileExists(FilePath))
+			{
+				UE_LOG(LogUALContentCmd, Warning, TEXT("File not found: %s"), *FilePath);
+				continue;
+			}
 			
-			FNotificationInfo Info(FText::FromString(Title));
-			Info.SubText = FText::FromString(Msg);
-			Info.ExpireDuration = 3.0f;
-			Info.bFireAndForget = true;
-			Info.bUseLargeFont = false;
+			State->TotalRequestCount++;
 			
-			TSharedPtr<SNotificationItem> NotificationItem = FSlateNotificationManager::Get().AddNotification(Info);
-			if (NotificationItem.IsValid())
+			// 检查是否是视频文件
+			if (IsVideoFile(FilePath))
 			{
-				NotificationItem->SetCompletionState(SNotificationItem::CS_Success);
+				State->VideoFiles.Add(FilePath);
+				UE_LOG(LogUALContentCmd, Log, TEXT("Detected video file: %s"), *FilePath);
 			}
 			else
 			{
-				UE_LOG(LogUALContentCmd, Warning, TEXT("Handle_ImportAssets: Failed to create notification item"));
+				State->OtherFiles.Add(FilePath);
 			}
-		});
+		}
+	}
+	
+	if (State->VideoFiles.Num() == 0 && State->OtherFiles.Num() == 0)
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("No valid files to import"));
+		return;
 	}
 
-	// 返回结果
-	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-	Response->SetBoolField(TEXT("ok"), SuccessCount > 0);
-	if (SuccessCount == 0)
+	UE_LOG(LogUALContentCmd, Log, TEXT("content.import: %d files -> %s, overwrite=%d, name_mappings=%d"),
+		FilesArray->Num(), *DestinationPath, bOverwrite, State->NormalizedNameMap.Num());
+
+	bool bAsync = false;
+	Payload->TryGetBoolField(TEXT("async"), bAsync);
+
+	FUAL_JobSpec Spec;
+	Spec.Type = TEXT("content.import");
+	Spec.Step = [State](FUAL_JobProgress& Progress)
+	{
+		return State->Step(Progress);
+	};
+
+	// async: 立即返回 job_id，按时间片逐个导入文件，结果通过 job.completed / job.status 获取
+	if (bAsync)
 	{
-		Response->SetStringField(TEXT("error"), TEXT("Failed to import assets. Possible reasons: 1) File type not supported by installed plugins, 2) Invalid file path. Check Output Log for details."));
+		TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+		Response->SetStringField(TEXT("job_id"), FUAL_JobManager::Get().Start(MoveTemp(Spec)));
+		Response->SetStringField(TEXT("status"), TEXT("running"));
+		UAL_CommandUtils::SendResponse(RequestId, 200, Response);
+		return;
 	}
-	Response->SetNumberField(TEXT("imported_count"), SuccessCount);
-	Response->SetNumberField(TEXT("requested_count"), TotalRequestCount);
-	Response->SetArrayField(TEXT("imported"), ImportedResults);
-	
-	UAL_CommandUtils::SendResponse(RequestId, 200, Response);
+
+	FUAL_JobProgress Progress;
+	FUAL_JobManager::RunInline(Spec, Progress);
+	UAL_CommandUtils::SendResponse(RequestId, 200, Progress.Result);
 }
 
 /**
@@ -1451,6 +1533,131 @@ void FUAL_ContentBrowserCommands::Handle_DescribeAsset(
 	UAL_CommandUtils::SendResponse(RequestId, 200, Response);
 }
 
+namespace
+{
+	/**
+	 * content.normalized_import 的分步状态：每步执行一个导入阶段（规划 / 复制 / 重映射并保存）
+	 */
+	struct FUAL_NormalizedImportState
+	{
+		TArray<FString> FilePaths;
+		FUALImportRuleSet RuleSet;
+		FUALNormalizedImporter Importer;
+		FUALNormalizedImportSession Session;
+		int32 Stage = 0;
+		bool bSuccess = true;
+
+		TSharedPtr<FJsonObject> BuildResult() const
+		{
+			// 构建响应
+			TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+			Response->SetBoolField(TEXT("ok"), bSuccess);
+			Response->SetNumberField(TEXT("total_files"), Session.TotalFiles);
+			Response->SetNumberField(TEXT("success_count"), Session.SuccessCount);
+			Response->SetNumberField(TEXT("failed_count"), Session.FailedCount);
+	
+			// 添加导入的资产信息
+			TArray<TSharedPtr<FJsonValue>> ImportedArray;
+			for (const FUALImportTargetInfo& Info : Session.TargetInfos)
+			{
+				TSharedPtr<FJsonObject> Item = MakeShared<FJsonObject>();
+				Item->SetStringField(TEXT("original_name"), Info.OriginalAssetName);
+				Item->SetStringField(TEXT("normalized_name"), Info.NormalizedAssetName);
+				Item->SetStringField(TEXT("old_path"), Info.OldPackageName.ToString());
+				Item->SetStringField(TEXT("new_path"), Info.NewPackageName.ToString());
+				Item->SetStringField(TEXT("class"), Info.AssetClass);
+				ImportedArray.Add(MakeShared<FJsonValueObject>(Item));
+			}
+			Response->SetArrayField(TEXT("imported"), ImportedArray);
+	
+			// 添加重定向映射
+			TArray<TSharedPtr<FJsonValue>> RedirectArray;
+			for (const auto& Pair : Session.RedirectMap)
+			{
+				TSharedPtr<FJsonObject> Item = MakeShared<FJsonObject>();
+				Item->SetStringField(TEXT("from"), Pair.Key.ToString());
+				Item->SetStringField(TEXT("to"), Pair.Value.ToString());
+				RedirectArray.Add(MakeShared<FJsonValueObject>(Item));
+			}
+			Response->SetArrayField(TEXT("redirects"), RedirectArray);
+	
+			// 添加错误和警告
+			if (Session.Errors.Num() > 0)
+			{
+				TArray<TSharedPtr<FJsonValue>> ErrorArray;
+				for (const FString& Error : Session.Errors)
+				{
+					ErrorArray.Add(MakeShared<FJsonValueString>(Error));
+				}
+				Response->SetArrayField(TEXT("errors"), ErrorArray);
+			}
+	
+			if (Session.Warnings.Num() > 0)
+			{
+				TArray<TSharedPtr<FJsonValue>> WarningArray;
+				for (const FString& Warning : Session.Warnings)
+				{
+					WarningArray.Add(MakeShared<FJsonValueString>(Warning));
+				}
+				Response->SetArrayField(TEXT("warnings"), WarningArray);
+			}
+			return Response;
+		}
+
+		/** 执行一步：按顺序执行一个导入阶段，失败或全部完成后生成结果 */
+		bool Step(FUAL_JobProgress& Progress)
+		{
+			static const TCHAR* StageNames[] = { TEXT("Plan"), TEXT("Copy"), TEXT("Remap") };
+			Progress.Total = (int32)FUALNormalizedImporter::EStage::Done;
+			Progress.Message = StageNames[Stage];
+
+			bSuccess = Importer.ExecuteStage((FUALNormalizedImporter::EStage)Stage, FilePaths, RuleSet, Session);
+			Progress.Completed = ++Stage;
+			if (bSuccess && Stage < Progress.Total)
+			{
+				return false;
+			}
+			bSuccess = bSuccess && Session.FailedCount == 0;
+
+			// Show notification (Ensure logic runs on GameThread)
+			if (bSuccess && Session.SuccessCount > 0)
+			{
+				int32 Count = Session.SuccessCount; // Capture by value
+				AsyncTask(ENamedThreads::GameThread, [Count]()
+				{
+					UE_LOG(LogUALContentCmd, Log, TEXT("Handle_NormalizedImport: Attempting to show success notification for %d assets"), Count);
+
+					FString Title = UAL_CommandUtils::LStr(TEXT("规范化导入成功"), TEXT("Normalized Import Successful"));
+					FString Msg = FString::Printf(TEXT("%s: %d"), *UAL_CommandUtils::LStr(TEXT("成功处理"), TEXT("Processed")), Count);
+
+					FNotificationInfo Info(FText::FromString(Title));
+					Info.SubText = FText::FromString(Msg);
+					Info.ExpireDuration = 3.0f;
+					Info.bFireAndForget = true;
+					Info.bUseLargeFont = false;
+			
+					TSharedPtr<SNotificationItem> NotificationItem = FSlateNotificationManager::Get().AddNotification(Info);
+					if (NotificationItem.IsValid())
+					{
+						NotificationItem->SetCompletionState(SNotificationItem::CS_Success);
+					}
+					else
+					{
+						UE_LOG(LogUALContentCmd, Warning, TEXT("Handle_NormalizedImport: Failed to create notification item"));
+					}
+				});
+			}
+
+			Progress.Result = BuildResult();
+			if (!bSuccess)
+			{
+				Progress.Error = TEXT("Normalized import failed");
+			}
+			return true;
+		}
+	};
+}
+
 /**
  * content.normalized_import - 规范化导入 uasset/umap 资产
  * 将外部工程的资产导入到规范化的目录结构中
@@ -1517,132 +1724,118 @@ void FUAL_ContentBrowserCommands::Handle_NormalizedImport(
 	RuleSet.bAutoRenameOnConflict = bAutoRenameOnConflict;
 	RuleSet.bUseSemanticSuffix = bUseSemanticSuffix;
 	
-	// 执行规范化导入
-	FUALNormalizedImporter Importer;
-	FUALNormalizedImportSession Session;
-	
-	bool bSuccess = Importer.ExecuteNormalizedImport(FilePaths, RuleSet, Session);
-
-	// Show notification (Ensure logic runs on GameThread)
-	if (bSuccess && Session.SuccessCount > 0)
-	{
-		int32 Count = Session.SuccessCount; // Capture by value
-		AsyncTask(ENamedThreads::GameThread, [Count]()
-		{
-			UE_LOG(LogUALContentCmd, Log, TEXT("Handle_NormalizedImport: Attempting to show success notification for %d assets"), Count);
+	TSharedRef<FUAL_NormalizedImportState> State = MakeShared<FUAL_NormalizedImportState>();
+	State->FilePaths = MoveTemp(FilePaths);
+	State->RuleSet = MoveTemp(RuleSet);
 
-			FString Title = UAL_CommandUtils::LStr(TEXT("规范化导入成功"), TEXT("Normalized Import Successful"));
-			FString Msg = FString::Printf(TEXT("%s: %d"), *UAL_CommandUtils::LStr(TEXT("成功处理"), TEXT("Processed")), Count);
+	bool bAsync = false;
+	Payload->TryGetBoolField(TEXT("async"), bAsync);
 
-			FNotificationInfo Info(FText::FromString(Title));
-			Info.SubText = FText::FromString(Msg);
-			Info.ExpireDuration = 3.0f;
-			Info.bFireAndForget = true;
-			Info.bUseLargeFont = false;
-			
-			TSharedPtr<SNotificationItem> NotificationItem = FSlateNotificationManager::Get().AddNotification(Info);
-			if (NotificationItem.IsValid())
-			{
-				NotificationItem->SetCompletionState(SNotificationItem::CS_Success);
-			}
-			else
-			{
-				UE_LOG(LogUALContentCmd, Warning, TEXT("Handle_NormalizedImport: Failed to create notification item"));
-			}
-		});
-	}
-	
-	// 构建响应
-	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-	Response->SetBoolField(TEXT("ok"), bSuccess);
-	Response->SetNumberField(TEXT("total_files"), Session.TotalFiles);
-	Response->SetNumberField(TEXT("success_count"), Session.SuccessCount);
-	Response->SetNumberField(TEXT("failed_count"), Session.FailedCount);
-	
-	// 添加导入的资产信息
-	TArray<TSharedPtr<FJsonValue>> ImportedArray;
-	for (const FUALImportTargetInfo& Info : Session.TargetInfos)
-	{
-		TSharedPtr<FJsonObject> Item = MakeShared<FJsonObject>();
-		Item->SetStringField(TEXT("original_name"), Info.OriginalAssetName);
-		Item->SetStringField(TEXT("normalized_name"), Info.NormalizedAssetName);
-		Item->SetStringField(TEXT("old_path"), Info.OldPackageName.ToString());
-		Item->SetStringField(TEXT("new_path"), Info.NewPackageName.ToString());
-		Item->SetStringField(TEXT("class"), Info.AssetClass);
-		ImportedArray.Add(MakeShared<FJsonValueObject>(Item));
-	}
-	Response->SetArrayField(TEXT("imported"), ImportedArray);
-	
-	// 添加重定向映射
-	TArray<TSharedPtr<FJsonValue>> RedirectArray;
-	for (const auto& Pair : Session.RedirectMap)
-	{
-		TSharedPtr<FJsonObject> Item = MakeShared<FJsonObject>();
-		Item->SetStringField(TEXT("from"), Pair.Key.ToString());
-		Item->SetStringField(TEXT("to"), Pair.Value.ToString());
-		RedirectArray.Add(MakeShared<FJsonValueObject>(Item));
-	}
-	Response->SetArrayField(TEXT("redirects"), RedirectArray);
-	
-	// 添加错误和警告
-	if (Session.Errors.Num() > 0)
+	FUAL_JobSpec Spec;
+	Spec.Type = TEXT("content.normalized_import");
+	Spec.Step = [State](FUAL_JobProgress& Progress)
 	{
-		TArray<TSharedPtr<FJsonValue>> ErrorArray;
-		for (const FString& Error : Session.Errors)
-		{
-			ErrorArray.Add(MakeShared<FJsonValueString>(Error));
-		}
-		Response->SetArrayField(TEXT("errors"), ErrorArray);
-	}
-	
-	if (Session.Warnings.Num() > 0)
+		return State->Step(Progress);
+	};
+
+	// async: 立即返回 job_id，各阶段之间编辑器继续 Tick，结果通过 job.completed / job.status 获取
+	if (bAsync)
 	{
-		TArray<TSharedPtr<FJsonValue>> WarningArray;
-		for (const FString& Warning : Session.Warnings)
-		{
-			WarningArray.Add(MakeShared<FJsonValueString>(Warning));
-		}
-		Response->SetArrayField(TEXT("warnings"), WarningArray);
+		TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+		Response->SetStringField(TEXT("job_id"), FUAL_JobManager::Get().Start(MoveTemp(Spec)));
+		Response->SetStringField(TEXT("status"), TEXT("running"));
+		UAL_CommandUtils::SendResponse(RequestId, 200, Response);
+		return;
 	}
-	
-	UAL_CommandUtils::SendResponse(RequestId, bSuccess ? 200 : 500, Response);
+
+	FUAL_JobProgress Progress;
+	FUAL_JobManager::RunInline(Spec, Progress);
+	UAL_CommandUtils::SendResponse(RequestId, State->bSuccess ? 200 : 500, Progress.Result);
 }
 
-void FUAL_ContentBrowserCommands::Handle_AuditOptimization(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+namespace
 {
-	FString CheckType = TEXT("All");
-	Payload->TryGetStringField(TEXT("check_type"), CheckType);
+	/**
+	 * content.audit_optimization 的分步状态：先一次性查询注册表得到待检查资产，
+	 * 之后每步只加载并检查一个资产
+	 */
+	struct FUAL_AuditOptimizationState
+	{
+		bool bCheckNanite = false;
+		bool bCheckLumen = false;
+		bool bCheckTexture = false;
+		// 同步调用（RunInline）没有 Tick 推进注册表扫描，只能阻塞等待
+		bool bBlockOnRegistry = false;
+		bool bPrepared = false;
+		int32 Cursor = 0;
 
-	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+		bool bNaniteEnabledInConfig = false;
+		TArray<FAssetData> MeshAssets;
+		int32 MeshesWithNanite = 0;
+
+		bool bLumenEnabledInConfig = false;
+		bool bUsingLumenGI = false;
+		TArray<FAssetData> MaterialAssets;
+		int32 MaterialsWithEmissive = 0;
+
+		TArray<FAssetData> TextureAssets;
+		int32 LargeTextures4K = 0;
+		int64 TotalTextureMemory = 0;
+
+		void Prepare(FUAL_JobProgress& Progress)
+		{
+			FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+			IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
 
-	// Nanite 使用情况检测
-	if (CheckType.Equals(TEXT("NaniteUsage"), ESearchCase::IgnoreCase) || CheckType.Equals(TEXT("All"), ESearchCase::IgnoreCase))
-	{
 #if ENGINE_MAJOR_VERSION >= 5
-		TSharedPtr<FJsonObject> NaniteData = MakeShared<FJsonObject>();
-		
-		// 检查配置
-		FString NaniteEnabled;
-		GConfig->GetString(TEXT("/Script/Engine.RendererSettings"), TEXT("r.Nanite.ProjectEnabled"), NaniteEnabled, GEngineIni);
-		bool bNaniteEnabledInConfig = NaniteEnabled.Equals(TEXT("True"), ESearchCase::IgnoreCase) || NaniteEnabled.Equals(TEXT("1"), ESearchCase::IgnoreCase);
-		NaniteData->SetBoolField(TEXT("enabled_in_config"), bNaniteEnabledInConfig);
+			if (bCheckNanite)
+			{
+				FString NaniteEnabled;
+				GConfig->GetString(TEXT("/Script/Engine.RendererSettings"), TEXT("r.Nanite.ProjectEnabled"), NaniteEnabled, GEngineIni);
+				bNaniteEnabledInConfig = NaniteEnabled.Equals(TEXT("True"), ESearchCase::IgnoreCase) || NaniteEnabled.Equals(TEXT("1"), ESearchCase::IgnoreCase);
+
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+				AssetRegistry.GetAssetsByClass(UStaticMesh::StaticClass()->GetClassPathName(), MeshAssets, true);
+#else
+				AssetRegistry.GetAssetsByClass(UStaticMesh::StaticClass()->GetFName(), MeshAssets, true);
+#endif
+			}
 
-		// 扫描资产
-		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-		IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+			if (bCheckLumen)
+			{
+				FString LumenEnabled;
+				FString DynamicGI;
+				GConfig->GetString(TEXT("/Script/Engine.RendererSettings"), TEXT("r.Lumen.Enabled"), LumenEnabled, GEngineIni);
+				GConfig->GetString(TEXT("/Script/Engine.RendererSettings"), TEXT("r.DynamicGlobalIlluminationMethod"), DynamicGI, GEngineIni);
+				bLumenEnabledInConfig = LumenEnabled.Equals(TEXT("True"), ESearchCase::IgnoreCase) || LumenEnabled.Equals(TEXT("1"), ESearchCase::IgnoreCase);
+				bUsingLumenGI = DynamicGI.Contains(TEXT("Lumen"), ESearchCase::IgnoreCase);
 
-		// 确保资产注册表已完全加载
-		AssetRegistry.WaitForCompletion();
+				FARFilter MaterialFilter;
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+				MaterialFilter.ClassPaths.Add(UMaterial::StaticClass()->GetClassPathName());
+				MaterialFilter.ClassPaths.Add(UMaterialInstanceConstant::StaticClass()->GetClassPathName());
+#else
+				MaterialFilter.ClassNames.Add(UMaterial::StaticClass()->GetFName());
+				MaterialFilter.ClassNames.Add(UMaterialInstanceConstant::StaticClass()->GetFName());
+#endif
+				AssetRegistry.GetAssets(MaterialFilter, MaterialAssets);
+			}
+#endif
 
-		TArray<FAssetData> MeshAssets;
+			if (bCheckTexture)
+			{
 #if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-		AssetRegistry.GetAssetsByClass(UStaticMesh::StaticClass()->GetClassPathName(), MeshAssets, true);
+				AssetRegistry.GetAssetsByClass(UTexture2D::StaticClass()->GetClassPathName(), TextureAssets, true);
 #else
-		AssetRegistry.GetAssetsByClass(UStaticMesh::StaticClass()->GetFName(), MeshAssets, true);
+				AssetRegistry.GetAssetsByClass(UTexture2D::StaticClass()->GetFName(), TextureAssets, true);
 #endif
+			}
 
-		int32 MeshesWithNanite = 0;
-		for (const FAssetData& AssetData : MeshAssets)
+			Progress.Total = MeshAssets.Num() + MaterialAssets.Num() + TextureAssets.Num();
+			bPrepared = true;
+		}
+
+		void CheckMesh(const FAssetData& AssetData)
 		{
 			// 加载资产并检查 Nanite 设置
 			UStaticMesh* Mesh = Cast<UStaticMesh>(AssetData.GetAsset());
@@ -1652,60 +1845,7 @@ void FUAL_ContentBrowserCommands::Handle_AuditOptimization(const TSharedPtr<FJso
 			}
 		}
 
-		NaniteData->SetNumberField(TEXT("mesh_count"), MeshAssets.Num());
-		NaniteData->SetNumberField(TEXT("meshes_with_nanite"), MeshesWithNanite);
-
-		if (bNaniteEnabledInConfig && MeshesWithNanite == 0)
-		{
-			NaniteData->SetStringField(TEXT("suggestion"), TEXT("检测到您开启了 Nanite 支持，但场景中没有任何模型使用了 Nanite。建议在 Project Settings 中关闭 Nanite 以剔除相关着色器变体，可显著提升构建速度。"));
-		}
-		else if (bNaniteEnabledInConfig && MeshesWithNanite > 0)
-		{
-			NaniteData->SetStringField(TEXT("suggestion"), FString::Printf(TEXT("检测到 %d 个模型使用了 Nanite，Nanite 功能正在被使用。"), MeshesWithNanite));
-		}
-
-		Result->SetObjectField(TEXT("nanite_usage"), NaniteData);
-#endif
-	}
-
-	// Lumen 使用情况检测
-	if (CheckType.Equals(TEXT("LumenMaterials"), ESearchCase::IgnoreCase) || CheckType.Equals(TEXT("All"), ESearchCase::IgnoreCase))
-	{
-#if ENGINE_MAJOR_VERSION >= 5
-		TSharedPtr<FJsonObject> LumenData = MakeShared<FJsonObject>();
-		
-		// 检查配置
-		FString LumenEnabled;
-		FString DynamicGI;
-		GConfig->GetString(TEXT("/Script/Engine.RendererSettings"), TEXT("r.Lumen.Enabled"), LumenEnabled, GEngineIni);
-		GConfig->GetString(TEXT("/Script/Engine.RendererSettings"), TEXT("r.DynamicGlobalIlluminationMethod"), DynamicGI, GEngineIni);
-		
-		bool bLumenEnabledInConfig = LumenEnabled.Equals(TEXT("True"), ESearchCase::IgnoreCase) || LumenEnabled.Equals(TEXT("1"), ESearchCase::IgnoreCase);
-		bool bUsingLumenGI = DynamicGI.Contains(TEXT("Lumen"), ESearchCase::IgnoreCase);
-		
-		LumenData->SetBoolField(TEXT("enabled_in_config"), bLumenEnabledInConfig);
-		LumenData->SetBoolField(TEXT("using_lumen_gi"), bUsingLumenGI);
-
-		// 扫描材质中的自发光使用（Lumen 特征）
-		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-		IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-		AssetRegistry.WaitForCompletion();
-
-		TArray<FAssetData> MaterialAssets;
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-		FARFilter MaterialFilter;
-		MaterialFilter.ClassPaths.Add(UMaterial::StaticClass()->GetClassPathName());
-		MaterialFilter.ClassPaths.Add(UMaterialInstanceConstant::StaticClass()->GetClassPathName());
-		AssetRegistry.GetAssets(MaterialFilter, MaterialAssets);
-#else
-		FARFilter MaterialFilter;
-		MaterialFilter.ClassNames.Add(UMaterial::StaticClass()->GetFName());
-		MaterialFilter.ClassNames.Add(UMaterialInstanceConstant::StaticClass()->GetFName());
-		AssetRegistry.GetAssets(MaterialFilter, MaterialAssets);
-#endif
-
-		int32 MaterialsWithEmissive = 0;
-		for (const FAssetData& AssetData : MaterialAssets)
+		void CheckMaterial(const FAssetData& AssetData)
 		{
 			// 检查 TagsAndValues 中是否有 Emissive 相关的标签
 			// 或者尝试加载材质检查
@@ -1716,7 +1856,7 @@ void FUAL_ContentBrowserCommands::Handle_AuditOptimization(const TSharedPtr<FJso
 				// 注意：更精确的检查需要遍历材质节点图，这里使用简化方法
 				FLinearColor EmissiveColor;
 				float EmissiveStrength = 0.0f;
-				
+
 				if (Material->GetVectorParameterValue(TEXT("EmissiveColor"), EmissiveColor) ||
 					Material->GetScalarParameterValue(TEXT("EmissiveStrength"), EmissiveStrength))
 				{
@@ -1728,52 +1868,14 @@ void FUAL_ContentBrowserCommands::Handle_AuditOptimization(const TSharedPtr<FJso
 			}
 		}
 
-		LumenData->SetNumberField(TEXT("materials_with_emissive"), MaterialsWithEmissive);
-
-		if (bLumenEnabledInConfig || bUsingLumenGI)
-		{
-			if (MaterialsWithEmissive > 0)
-			{
-				LumenData->SetStringField(TEXT("suggestion"), FString::Printf(TEXT("检测到 %d 个材质使用了自发光，Lumen 功能正在被使用。"), MaterialsWithEmissive));
-			}
-			else
-			{
-				LumenData->SetStringField(TEXT("suggestion"), TEXT("Lumen 已启用，但未检测到使用自发光的材质。如果不需要全局光照，可以考虑禁用 Lumen 以减小包体。"));
-			}
-		}
-
-		Result->SetObjectField(TEXT("lumen_usage"), LumenData);
-#endif
-	}
-
-	// 纹理大小分析
-	if (CheckType.Equals(TEXT("TextureSize"), ESearchCase::IgnoreCase) || CheckType.Equals(TEXT("All"), ESearchCase::IgnoreCase))
-	{
-		TSharedPtr<FJsonObject> TextureData = MakeShared<FJsonObject>();
-		
-		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-		IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-		AssetRegistry.WaitForCompletion();
-
-		TArray<FAssetData> TextureAssets;
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-		AssetRegistry.GetAssetsByClass(UTexture2D::StaticClass()->GetClassPathName(), TextureAssets, true);
-#else
-		AssetRegistry.GetAssetsByClass(UTexture2D::StaticClass()->GetFName(), TextureAssets, true);
-#endif
-
-		int32 TotalTextures = TextureAssets.Num();
-		int32 LargeTextures4K = 0;
-		int64 TotalTextureMemory = 0;
-
-		for (const FAssetData& AssetData : TextureAssets)
+		void CheckTexture(const FAssetData& AssetData)
 		{
 			UTexture2D* Texture = Cast<UTexture2D>(AssetData.GetAsset());
 			if (Texture)
 			{
 				int32 Width = Texture->GetSizeX();
 				int32 Height = Texture->GetSizeY();
-				
+
 				if (Width >= 4096 || Height >= 4096)
 				{
 					LargeTextures4K++;
@@ -1785,20 +1887,163 @@ void FUAL_ContentBrowserCommands::Handle_AuditOptimization(const TSharedPtr<FJso
 			}
 		}
 
-		TextureData->SetNumberField(TEXT("total_textures"), TotalTextures);
-		TextureData->SetNumberField(TEXT("large_textures_4k"), LargeTextures4K);
-		TextureData->SetNumberField(TEXT("estimated_memory_bytes"), TotalTextureMemory);
-		TextureData->SetNumberField(TEXT("estimated_memory_mb"), TotalTextureMemory / (1024 * 1024));
+		/** 执行一步：首步查询资产列表，之后每步检查一个资产，全部完成后生成结果 */
+		bool Step(FUAL_JobProgress& Progress)
+		{
+			if (!bPrepared)
+			{
+				// 资产注册表仍在扫描时逐帧轮询，扫描完成后再查询资产列表
+				IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+				if (AssetRegistry.IsLoadingAssets())
+				{
+					if (!bBlockOnRegistry)
+					{
+						Progress.Message = TEXT("Waiting for asset registry");
+						Progress.bWaiting = true;
+						return false;
+					}
+					AssetRegistry.WaitForCompletion();
+				}
+				Prepare(Progress);
+				Progress.Message = TEXT("Scanning assets");
+				return false;
+			}
+
+			if (Cursor < MeshAssets.Num())
+			{
+				Progress.Message = TEXT("NaniteUsage");
+				CheckMesh(MeshAssets[Cursor]);
+			}
+			else if (Cursor < MeshAssets.Num() + MaterialAssets.Num())
+			{
+				Progress.Message = TEXT("LumenMaterials");
+				CheckMaterial(MaterialAssets[Cursor - MeshAssets.Num()]);
+			}
+			else if (Cursor < Progress.Total)
+			{
+				Progress.Message = TEXT("TextureSize");
+				CheckTexture(TextureAssets[Cursor - MeshAssets.Num() - MaterialAssets.Num()]);
+			}
+
+			if (Cursor < Progress.Total)
+			{
+				Progress.Completed = ++Cursor;
+				if (Cursor < Progress.Total)
+				{
+					return false;
+				}
+			}
+
+			Progress.Result = BuildResult();
+			return true;
+		}
 
-		if (LargeTextures4K > 0)
+		TSharedPtr<FJsonObject> BuildResult() const
 		{
-			TextureData->SetStringField(TEXT("suggestion"), FString::Printf(TEXT("发现 %d 个 4K 或更大的纹理，考虑压缩或降低分辨率以减少包体大小。"), LargeTextures4K));
+			TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+
+#if ENGINE_MAJOR_VERSION >= 5
+			// Nanite 使用情况检测
+			if (bCheckNanite)
+			{
+				TSharedPtr<FJsonObject> NaniteData = MakeShared<FJsonObject>();
+				NaniteData->SetBoolField(TEXT("enabled_in_config"), bNaniteEnabledInConfig);
+				NaniteData->SetNumberField(TEXT("mesh_count"), MeshAssets.Num());
+				NaniteData->SetNumberField(TEXT("meshes_with_nanite"), MeshesWithNanite);
+
+				if (bNaniteEnabledInConfig && MeshesWithNanite == 0)
+				{
+					NaniteData->SetStringField(TEXT("suggestion"), TEXT("检测到您开启了 Nanite 支持，但场景中没有任何模型使用了 Nanite。建议在 Project Settings 中关闭 Nanite 以剔除相关着色器变体，可显著提升构建速度。"));
+				}
+				else if (bNaniteEnabledInConfig && MeshesWithNanite > 0)
+				{
+					NaniteData->SetStringField(TEXT("suggestion"), FString::Printf(TEXT("检测到 %d 个模型使用了 Nanite，Nanite 功能正在被使用。"), MeshesWithNanite));
+				}
+
+				Result->SetObjectField(TEXT("nanite_usage"), NaniteData);
+			}
+
+			// Lumen 使用情况检测
+			if (bCheckLumen)
+			{
+				TSharedPtr<FJsonObject> LumenData = MakeShared<FJsonObject>();
+				LumenData->SetBoolField(TEXT("enabled_in_config"), bLumenEnabledInConfig);
+				LumenData->SetBoolField(TEXT("using_lumen_gi"), bUsingLumenGI);
+				LumenData->SetNumberField(TEXT("materials_with_emissive"), MaterialsWithEmissive);
+
+				if (bLumenEnabledInConfig || bUsingLumenGI)
+				{
+					if (MaterialsWithEmissive > 0)
+					{
+						LumenData->SetStringField(TEXT("suggestion"), FString::Printf(TEXT("检测到 %d 个材质使用了自发光，Lumen 功能正在被使用。"), MaterialsWithEmissive));
+					}
+					else
+					{
+						LumenData->SetStringField(TEXT("suggestion"), TEXT("Lumen 已启用，但未检测到使用自发光的材质。如果不需要全局光照，可以考虑禁用 Lumen 以减小包体。"));
+					}
+				}
+
+				Result->SetObjectField(TEXT("lumen_usage"), LumenData);
+			}
+#endif
+
+			// 纹理大小分析
+			if (bCheckTexture)
+			{
+				TSharedPtr<FJsonObject> TextureData = MakeShared<FJsonObject>();
+				TextureData->SetNumberField(TEXT("total_textures"), TextureAssets.Num());
+				TextureData->SetNumberField(TEXT("large_textures_4k"), LargeTextures4K);
+				TextureData->SetNumberField(TEXT("estimated_memory_bytes"), TotalTextureMemory);
+				TextureData->SetNumberField(TEXT("estimated_memory_mb"), TotalTextureMemory / (1024 * 1024));
+
+				if (LargeTextures4K > 0)
+				{
+					TextureData->SetStringField(TEXT("suggestion"), FString::Printf(TEXT("发现 %d 个 4K 或更大的纹理，考虑压缩或降低分辨率以减少包体大小。"), LargeTextures4K));
+				}
+
+				Result->SetObjectField(TEXT("texture_analysis"), TextureData);
+			}
+
+			return Result;
 		}
+	};
+}
+
+void FUAL_ContentBrowserCommands::Handle_AuditOptimization(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	FString CheckType = TEXT("All");
+	Payload->TryGetStringField(TEXT("check_type"), CheckType);
+
+	bool bAsync = false;
+	Payload->TryGetBoolField(TEXT("async"), bAsync);
+
+	const bool bAll = CheckType.Equals(TEXT("All"), ESearchCase::IgnoreCase);
+	TSharedRef<FUAL_AuditOptimizationState> State = MakeShared<FUAL_AuditOptimizationState>();
+	State->bCheckNanite = bAll || CheckType.Equals(TEXT("NaniteUsage"), ESearchCase::IgnoreCase);
+	State->bCheckLumen = bAll || CheckType.Equals(TEXT("LumenMaterials"), ESearchCase::IgnoreCase);
+	State->bCheckTexture = bAll || CheckType.Equals(TEXT("TextureSize"), ESearchCase::IgnoreCase);
+
+	FUAL_JobSpec Spec;
+	Spec.Type = TEXT("content.audit_optimization");
+	Spec.Step = [State](FUAL_JobProgress& Progress)
+	{
+		return State->Step(Progress);
+	};
 
-		Result->SetObjectField(TEXT("texture_analysis"), TextureData);
+	// async: 立即返回 job_id，逐个资产分帧检查，结果通过 job.completed / job.status 获取
+	if (bAsync)
+	{
+		TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+		Response->SetStringField(TEXT("job_id"), FUAL_JobManager::Get().Start(MoveTemp(Spec)));
+		Response->SetStringField(TEXT("status"), TEXT("running"));
+		UAL_CommandUtils::SendResponse(RequestId, 200, Response);
+		return;
 	}
 
-	UAL_CommandUtils::SendResponse(RequestId, 200, Result);
+	State->bBlockOnRegistry = true;
+	FUAL_JobProgress Progress;
+	FUAL_JobManager::RunInline(Spec, Progress);
+	UAL_CommandUtils::SendResponse(RequestId, 200, Progress.Result);
 }
 
 /**
@@ -1886,3 +2131,118 @@ void FUAL_ContentBrowserCommands::Handle_RescanAssets(
 	Response->SetNumberField(TEXT("scanned"), FilePaths.Num());
 	UAL_CommandUtils::SendResponse(RequestId, 200, Response);
 }
+
+/**
+ * content.configure_textures - 批量配置纹理设置
+ * 属性一次性写入，构建集中提交（异步纹理编译并行执行），进度与 DDC 统计通过事件推送
+ * 
+ * 参数:
+ * - paths: 纹理资产路径数组
+ * - srgb / compression / lod_group: 可选，显式指定时应用到全部纹理；
+ *   都未指定时按命名约定识别 PBR 类型并使用推荐设置
+ */
+void FUAL_ContentBrowserCommands::Handle_ConfigureTextures(
+	const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	const TArray<TSharedPtr<FJsonValue>>* PathsArray = nullptr;
+	if (!Payload->TryGetArrayField(TEXT("paths"), PathsArray) || !PathsArray || PathsArray->Num() == 0)
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing or empty 'paths' array"));
+		return;
+	}
+
+	// 显式设置（枚举名可带或不带前缀，如 TC_Normalmap / Normalmap）
+	auto ParseEnum = [](const UEnum* Enum, const FString& Value, const TCHAR* Prefix) -> int64
+	{
+		int64 Result = Enum->GetValueByNameString(Value);
+		if (Result == INDEX_NONE)
+		{
+			Result = Enum->GetValueByNameString(FString(Prefix) + Value);
+		}
+		return Result;
+	};
+
+	FUAL_TextureSettingsRequest Override;
+	bool bSRGB = false;
+	if (Payload->TryGetBoolField(TEXT("srgb"), bSRGB))
+	{
+		Override.bSRGB = bSRGB;
+	}
+	FString CompressionName;
+	if (Payload->TryGetStringField(TEXT("compression"), CompressionName) && !CompressionName.IsEmpty())
+	{
+		const int64 Value = ParseEnum(StaticEnum<TextureCompressionSettings>(), CompressionName, TEXT("TC_"));
+		if (Value == INDEX_NONE)
+		{
+			UAL_CommandUtils::SendError(RequestId, 400, FString::Printf(TEXT("Unknown compression: %s"), *CompressionName));
+			return;
+		}
+		Override.Compression = (TextureCompressionSettings)Value;
+	}
+	FString LODGroupName;
+	if (Payload->TryGetStringField(TEXT("lod_group"), LODGroupName) && !LODGroupName.IsEmpty())
+	{
+		const int64 Value = ParseEnum(StaticEnum<TextureGroup>(), LODGroupName, TEXT("TEXTUREGROUP_"));
+		if (Value == INDEX_NONE)
+		{
+			UAL_CommandUtils::SendError(RequestId, 400, FString::Printf(TEXT("Unknown lod_group: %s"), *LODGroupName));
+			return;
+		}
+		Override.LODGroup = (TextureGroup)Value;
+	}
+	const bool bUseOverride = Override.bSRGB.IsSet() || Override.Compression.IsSet() || Override.LODGroup.IsSet();
+
+	TArray<FUAL_TextureSettingsRequest> Requests;
+	TArray<TSharedPtr<FJsonValue>> NotFound;
+	Requests.Reserve(PathsArray->Num());
+	for (const TSharedPtr<FJsonValue>& PathValue : *PathsArray)
+	{
+		FString AssetPath;
+		if (!PathValue->TryGetString(AssetPath) || AssetPath.IsEmpty())
+		{
+			continue;
+		}
+		if (!AssetPath.Contains(TEXT(".")))
+		{
+			AssetPath = AssetPath + TEXT(".") + FPackageName::GetShortName(AssetPath);
+		}
+
+		UTexture2D* Texture = LoadObject<UTexture2D>(nullptr, *AssetPath);
+		if (!Texture)
+		{
+			NotFound.Add(MakeShared<FJsonValueString>(AssetPath));
+			continue;
+		}
+
+		if (bUseOverride)
+		{
+			FUAL_TextureSettingsRequest& Request = Requests.Add_GetRef(Override);
+			Request.Texture = Texture;
+		}
+		else
+		{
+			const EUAL_PBRTextureType Type = FUAL_PBRMaterialHelper::ClassifyTexture(Texture->GetName());
+			if (Type != EUAL_PBRTextureType::Unknown)
+			{
+				Requests.Add(FUAL_PBRMaterialHelper::MakeTextureSettingsRequest(Texture, Type));
+			}
+		}
+	}
+
+	const FUAL_TextureSettingsBatch::FSubmitResult Result = FUAL_TextureSettingsBatch::Get().Submit(Requests);
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetBoolField(TEXT("ok"), true);
+	Data->SetStringField(TEXT("job_id"), Result.JobId);
+	Data->SetNumberField(TEXT("total"), Result.Total);
+	Data->SetNumberField(TEXT("changed"), Result.Changed);
+	Data->SetNumberField(TEXT("unchanged"), Result.Unchanged);
+	Data->SetNumberField(TEXT("skipped"), PathsArray->Num() - NotFound.Num() - Result.Total);
+	Data->SetBoolField(TEXT("async_compilation"), Result.bAsyncCompilation);
+	Data->SetArrayField(TEXT("not_found"), NotFound);
+
+	UE_LOG(LogUALContentCmd, Log, TEXT("content.configure_textures: %d requested, %d changed, %d unchanged, %d not found (job %s)"),
+		PathsArray->Num(), Result.Changed, Result.Unchanged, NotFound.Num(), *Result.JobId);
+
+	UAL_CommandUtils::SendResponse(RequestId, 200, Data);
+}
@@ -37,6 +37,14 @@
 #include "IContentBrowserSingleton.h"
 #include "ContentBrowserModule.h"
 #include "HAL/PlatformProcess.h"
+#include "Async/Async.h"
+#include "UnrealClient.h"
+#include "UAL_NetworkManager.h"
+#include "UAL_CaptureStream.h"
+#include "UAL_LocalServer.h"
+#include "UAL_BulkChannel.h"
+#include "UAL_ProjectSnapshot.h"
+#include "ImageWriteQueue.h"
 
 #if PLATFORM_WINDOWS
 #include "Windows/AllowWindowsPlatformTypes.h"
@@ -47,23 +55,35 @@
 DEFINE_LOG_CATEGORY_STATIC(LogUALEditor, Log, All);
 
 /**
- * 截图任务上下文结构体（用于异步定时器回调）
+ * 截图任务上下文
+ * HighResShot 是全局单例请求，同一时刻只允许一个任务在途，其余按 FIFO 排队
  */
 struct FScreenshotTaskContext
 {
 	FString RequestId;
-	FString ScreenshotDir;
-	TMap<FString, FDateTime> FilesBeforeMap;
-	FDateTime CommandExecuteTime;
-	int32 Width;
-	int32 Height;
-	int32 RetryCount;
-	int32 MaxRetries;
-	FTimerHandle TimerHandle;
+	FString FilePath;
+	int32 Width = 0;
+	int32 Height = 0;
+	bool bIncludeBase64 = false;
+	// 通过同机大块数据通道返回 PNG（成功时不再内联 base64）
+	bool bBulk = false;
+
+	// 命令发出时间（FPlatformTime::Seconds）
+	double StartTime = 0.0;
+	// 引擎已处理截图请求（FScreenshotRequest::OnScreenshotRequestProcessed），正在等待写盘队列
+	bool bProcessed = false;
 };
 
-// 静态任务列表（存储正在进行的截图任务）
-static TMap<FString, TSharedPtr<FScreenshotTaskContext>> PendingScreenshotTasks;
+// 截图任务队列（[0] 为在途任务）
+static TArray<TSharedPtr<FScreenshotTaskContext>> PendingScreenshotTasks;
+static bool bScreenshotInFlight = false;
+static FDelegateHandle ScreenshotProcessedHandle;
+static FTickerHandleType ScreenshotTickerHandle;
+
+// 单个截图任务超时（秒）
+static constexpr double UALScreenshotTimeoutSeconds = 30.0;
+// 超时检查间隔（秒）；完成由引擎回调驱动，Ticker 只负责超时
+static constexpr float UALScreenshotTimeoutCheckInterval = 0.5f;
 
 static bool UAL_IsAssetPath(const FString& Path)
 {
@@ -136,119 +156,216 @@ static void UAL_OpenEditorForAsset(UObject* Asset)
 }
 
 /**
- * 定时器回调：检查截图文件是否生成
+ * 将 UE 编辑器窗口恢复并置顶（确保截图时窗口在前台）
  */
-static void CheckScreenshotFile(FString TaskId)
+static void UAL_BringEditorWindowToFront()
 {
-	TSharedPtr<FScreenshotTaskContext>* ContextPtr = PendingScreenshotTasks.Find(TaskId);
-	if (!ContextPtr || !ContextPtr->IsValid())
+	if (!FSlateApplication::IsInitialized())
 	{
-		UE_LOG(LogUALEditor, Warning, TEXT("Screenshot task %s not found"), *TaskId);
 		return;
 	}
-	
-	TSharedPtr<FScreenshotTaskContext> Context = *ContextPtr;
-	Context->RetryCount++;
-	
-	UE_LOG(LogUALEditor, Log, TEXT("Checking screenshot... retry %d/%d"), Context->RetryCount, Context->MaxRetries);
-	
-	// 查找新生成的截图文件
-	TArray<FString> FilesAfter;
-	IFileManager::Get().FindFiles(FilesAfter, *FPaths::Combine(Context->ScreenshotDir, TEXT("HighresScreenshot*.png")), true, false);
-	
-	UE_LOG(LogUALEditor, Log, TEXT("Found %d files in dir, BeforeMap has %d entries, CommandTime: %s"), 
-		FilesAfter.Num(), Context->FilesBeforeMap.Num(), *Context->CommandExecuteTime.ToString());
-	
-	FString NewScreenshotPath;
-	
-	// 策略 1: 优先查找新增的文件名
-	for (const FString& File : FilesAfter)
+
+	TSharedPtr<SWindow> MainWindow = FSlateApplication::Get().GetActiveTopLevelWindow();
+	if (!MainWindow.IsValid())
 	{
-		if (!Context->FilesBeforeMap.Contains(File))
+		// 如果没有活动窗口，尝试获取第一个顶层窗口
+		TArray<TSharedRef<SWindow>> Windows = FSlateApplication::Get().GetInteractiveTopLevelWindows();
+		if (Windows.Num() > 0)
 		{
-			FString FullPath = FPaths::Combine(Context->ScreenshotDir, File);
-			FDateTime FileTime = IFileManager::Get().GetTimeStamp(*FullPath);
-			int64 FileSize = IFileManager::Get().FileSize(*FullPath);
-			
-			UE_LOG(LogUALEditor, Log, TEXT("New file candidate: %s, FileTime: %s, Size: %lld, CommandTime: %s"), 
-				*File, *FileTime.ToString(), FileSize, *Context->CommandExecuteTime.ToString());
-			
-			if (FileTime >= Context->CommandExecuteTime && FileSize > 0)
-			{
-				NewScreenshotPath = FullPath;
-				UE_LOG(LogUALEditor, Log, TEXT("Found NEW file: %s (size: %lld)"), *File, FileSize);
-				break;
-			}
-			else
-			{
-				UE_LOG(LogUALEditor, Warning, TEXT("Skipping file %s: FileTime < CommandTime or Size <= 0"), *File);
-			}
+			MainWindow = Windows[0];
 		}
 	}
-	
-	// 策略 2: 查找时间戳被更新的文件
-	if (NewScreenshotPath.IsEmpty())
+
+	if (MainWindow.IsValid())
 	{
-		for (const FString& File : FilesAfter)
+		// 如果窗口被最小化，先恢复
+		if (MainWindow->GetNativeWindow().IsValid() && MainWindow->GetNativeWindow()->IsMinimized())
 		{
-			FString FullPath = FPaths::Combine(Context->ScreenshotDir, File);
-			FDateTime CurrentTime = IFileManager::Get().GetTimeStamp(*FullPath);
-			FDateTime* PreviousTime = Context->FilesBeforeMap.Find(File);
-			
-			if (PreviousTime && CurrentTime > *PreviousTime && CurrentTime >= Context->CommandExecuteTime)
-			{
-				int64 FileSize = IFileManager::Get().FileSize(*FullPath);
-				if (FileSize > 0)
-				{
-					NewScreenshotPath = FullPath;
-					UE_LOG(LogUALEditor, Log, TEXT("Found UPDATED file: %s (size: %lld)"), *File, FileSize);
-					break;
-				}
-			}
+			MainWindow->Restore();
 		}
+		// 将窗口置顶
+		MainWindow->BringToFront();
+		if (MainWindow->GetNativeWindow().IsValid())
+		{
+			MainWindow->GetNativeWindow()->SetWindowFocus();
+		}
+		UE_LOG(LogUALEditor, Log, TEXT("Editor window brought to front for screenshot"));
 	}
-	
-	// 找到文件 - 发送成功响应
-	if (!NewScreenshotPath.IsEmpty())
+}
+
+static void UAL_StartNextScreenshot();
+
+/**
+ * 截图完成：在工作线程读取文件并做 Base64 编码（或写入大块数据通道），再回到 GameThread 发送响应
+ */
+static void UAL_CompleteScreenshot(const TSharedPtr<FScreenshotTaskContext>& Context)
+{
+	const double ElapsedMs = (FPlatformTime::Seconds() - Context->StartTime) * 1000.0;
+	UE_LOG(LogUALEditor, Log, TEXT("Screenshot captured: %s (%.0f ms)"), *Context->FilePath, ElapsedMs);
+
+	Async(EAsyncExecution::ThreadPool, [Context, ElapsedMs]()
 	{
-		UE_LOG(LogUALEditor, Log, TEXT("Screenshot captured: %s"), *NewScreenshotPath);
-		
 		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-		Data->SetStringField(TEXT("path"), NewScreenshotPath);
-		Data->SetStringField(TEXT("filename"), FPaths::GetCleanFilename(NewScreenshotPath));
+		Data->SetStringField(TEXT("path"), Context->FilePath);
+		Data->SetStringField(TEXT("filename"), FPaths::GetCleanFilename(Context->FilePath));
 		Data->SetNumberField(TEXT("width"), Context->Width);
 		Data->SetNumberField(TEXT("height"), Context->Height);
 		Data->SetBoolField(TEXT("saved"), true);
 		Data->SetBoolField(TEXT("restore_app_window"), true); // 通知客户端恢复应用窗口
-		
-		UAL_CommandUtils::SendResponse(Context->RequestId, 200, Data);
-		
-		// 清理定时器和任务
-		if (GEditor)
+		Data->SetNumberField(TEXT("elapsed_ms"), ElapsedMs);
+
+		if (Context->bIncludeBase64 || Context->bBulk)
 		{
-			GEditor->GetTimerManager()->ClearTimer(Context->TimerHandle);
+			TArray<uint8> FileData;
+			if (FFileHelper::LoadFileToArray(FileData, *Context->FilePath))
+			{
+				TSharedPtr<FJsonObject> BulkHandle;
+				if (Context->bBulk)
+				{
+					BulkHandle = FUAL_BulkChannel::Get().Publish(FileData.GetData(), FileData.Num(), TEXT("image/png"));
+				}
+				if (BulkHandle.IsValid())
+				{
+					Data->SetObjectField(TEXT("bulk"), BulkHandle);
+				}
+				else if (Context->bIncludeBase64)
+				{
+					Data->SetStringField(TEXT("base64"), FBase64::Encode(FileData));
+				}
+			}
 		}
-		PendingScreenshotTasks.Remove(TaskId);
-		return;
+
+		// WebSocket 发送统一在 GameThread 上进行
+		UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateLambda([RequestId = Context->RequestId, Data](float)
+		{
+			UAL_CommandUtils::SendResponse(RequestId, 200, Data);
+			return false;
+		}));
+	});
+}
+
+static void UAL_FinishCurrentScreenshot()
+{
+	if (PendingScreenshotTasks.Num() > 0)
+	{
+		PendingScreenshotTasks.RemoveAt(0);
 	}
-	
-	// 超时 - 发送错误响应
-	if (Context->RetryCount >= Context->MaxRetries)
+	bScreenshotInFlight = false;
+	UAL_StartNextScreenshot();
+}
+
+/** 队列清空后移除探测 Ticker 与引擎委托；下一次入队时重新注册 */
+static bool UAL_KeepScreenshotTicker()
+{
+	if (!bScreenshotInFlight)
 	{
-		UE_LOG(LogUALEditor, Error, TEXT("Screenshot timeout after %d retries"), Context->MaxRetries);
+		ScreenshotTickerHandle.Reset();
+		FScreenshotRequest::OnScreenshotRequestProcessed().Remove(ScreenshotProcessedHandle);
+		ScreenshotProcessedHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+/**
+ * 超时检查：只在引擎始终没有处理截图请求时生效
+ */
+static bool UAL_TickScreenshot(float DeltaTime)
+{
+	if (!bScreenshotInFlight || PendingScreenshotTasks.Num() == 0)
+	{
+		ScreenshotTickerHandle.Reset();
+		return false;
+	}
+
+	TSharedPtr<FScreenshotTaskContext> Context = PendingScreenshotTasks[0];
+	if (FPlatformTime::Seconds() - Context->StartTime > UALScreenshotTimeoutSeconds)
+	{
+		UE_LOG(LogUALEditor, Error, TEXT("Screenshot timeout (processed=%d): %s"), Context->bProcessed ? 1 : 0, *Context->FilePath);
 		UAL_CommandUtils::SendError(Context->RequestId, 500, TEXT("截图超时：HighResShot 未生成截图文件。请确保已打开一个关卡/场景（Level）视口并置于前台，而非材质、蓝图等编辑器窗口。"));
-		
-		// 清理定时器和任务
-		if (GEditor)
+		UAL_FinishCurrentScreenshot();
+		return UAL_KeepScreenshotTicker();
+	}
+	return true;
+}
+
+/**
+ * 写盘队列已排空（GameThread）：文件就绪则回复；任务已超时或被替换时忽略
+ */
+static void UAL_OnScreenshotWritten(const TSharedPtr<FScreenshotTaskContext>& Context)
+{
+	if (!Context.IsValid() || !bScreenshotInFlight || PendingScreenshotTasks.Num() == 0 || PendingScreenshotTasks[0] != Context)
+	{
+		return;
+	}
+
+	if (IFileManager::Get().FileSize(*Context->FilePath) <= 0)
+	{
+		// 处理的是其他截图请求（如用户手动截图），继续等待本任务，超时由 Ticker 负责
+		Context->bProcessed = false;
+		return;
+	}
+
+	UAL_CompleteScreenshot(Context);
+	UAL_FinishCurrentScreenshot();
+	UAL_KeepScreenshotTicker();
+}
+
+static void UAL_OnScreenshotRequestProcessed()
+{
+	if (!bScreenshotInFlight || PendingScreenshotTasks.Num() == 0 || PendingScreenshotTasks[0]->bProcessed)
+	{
+		return;
+	}
+
+	// 引擎已把像素交给 ImageWriteQueue；在队列中插入栅栏，之前入队的 PNG 全部写完后回调
+	TSharedPtr<FScreenshotTaskContext> Context = PendingScreenshotTasks[0];
+	Context->bProcessed = true;
+
+	TWeakPtr<FScreenshotTaskContext> WeakContext = Context;
+	IImageWriteQueue& WriteQueue = FModuleManager::LoadModuleChecked<IImageWriteQueueModule>("ImageWriteQueue").GetWriteQueue();
+	WriteQueue.CreateFence().Then([WeakContext](TFuture<void>)
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakContext]()
 		{
-			GEditor->GetTimerManager()->ClearTimer(Context->TimerHandle);
-		}
-		PendingScreenshotTasks.Remove(TaskId);
+			UAL_OnScreenshotWritten(WeakContext.Pin());
+		});
+	});
+}
+
+static void UAL_StartNextScreenshot()
+{
+	if (bScreenshotInFlight || PendingScreenshotTasks.Num() == 0)
+	{
 		return;
 	}
-	
-	// 继续等待（定时器会自动触发下一次检查）
+
+	if (!ScreenshotProcessedHandle.IsValid())
+	{
+		ScreenshotProcessedHandle = FScreenshotRequest::OnScreenshotRequestProcessed().AddStatic(&UAL_OnScreenshotRequestProcessed);
+	}
+
+	TSharedPtr<FScreenshotTaskContext> Context = PendingScreenshotTasks[0];
+	bScreenshotInFlight = true;
+
+	// 删除同名旧文件，避免把旧文件当作本次结果
+	IFileManager::Get().Delete(*Context->FilePath, false, true, true);
+
+	UAL_BringEditorWindowToFront();
+
+	// 执行 HighResShot，并用本任务独占的文件名覆盖默认命名（无需再扫描目录比对）
+	const FString Command = FString::Printf(TEXT("HighResShot %dx%d"), Context->Width, Context->Height);
+	UE_LOG(LogUALEditor, Log, TEXT("Executing: %s -> %s"), *Command, *Context->FilePath);
+	GEngine->Exec(GEditor->GetWorld(), *Command);
+	FScreenshotRequest::RequestScreenshot(Context->FilePath, false, false);
+	Context->StartTime = FPlatformTime::Seconds();
+
+	if (!ScreenshotTickerHandle.IsValid())
+	{
+		ScreenshotTickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateStatic(&UAL_TickScreenshot), UALScreenshotTimeoutCheckInterval);
+	}
 }
+
 void FUAL_EditorCommands::RegisterCommands(TMap<FString, TFunction<void(const TSharedPtr<FJsonObject>&, const FString)>>& CommandMap)
 {
 	CommandMap.Add(TEXT("editor.screenshot"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
@@ -287,6 +404,11 @@ void FUAL_EditorCommands::RegisterCommands(TMap<FString, TFunction<void(const TS
 		Handle_AnalyzeUProject(Payload, RequestId);
 	});
 
+	CommandMap.Add(TEXT("project.export_snapshot"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_ExportSnapshot(Payload, RequestId);
+	});
+
 	CommandMap.Add(TEXT("editor.capture_app_window"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
 	{
 		Handle_CaptureAppWindow(Payload, RequestId);
@@ -317,6 +439,16 @@ void FUAL_EditorCommands::RegisterCommands(TMap<FString, TFunction<void(const TS
 	{
 		Handle_RevealPath(Payload, RequestId);
 	});
+
+	CommandMap.Add(TEXT("editor.capture_stream"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_CaptureStream(Payload, RequestId);
+	});
+
+	CommandMap.Add(TEXT("editor.capture_stream_ack"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_CaptureStreamAck(Payload, RequestId);
+	});
 }
 
 // ========== 从 UAL_CommandHandler.cpp 迁移以下函数 ==========
@@ -339,96 +471,48 @@ void FUAL_EditorCommands::Handle_TakeScreenshot(const TSharedPtr<FJsonObject>& P
 		Height = FMath::Max((int32)(*Resolution)[1]->AsNumber(), 64);
 	}
 	
-	// 2) 获取截图目录，找到最新文件用于对比
-	const FString ScreenshotDir = FPaths::ConvertRelativePathToFull(
-		FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Screenshots/WindowsEditor")));
-	IFileManager::Get().MakeDirectory(*ScreenshotDir, true);
-	
-	// 记录执行前目录中已有文件及其时间戳
-	TMap<FString, FDateTime> FilesBeforeMap;
-	TArray<FString> FilesBefore;
-	IFileManager::Get().FindFiles(FilesBefore, *FPaths::Combine(ScreenshotDir, TEXT("HighresScreenshot*.png")), true, false);
-	for (const FString& File : FilesBefore)
+	// 2) 目标文件：filepath 可为文件名或绝对路径，默认 Saved/Screenshots/UAL/ 下按时间戳命名
+	FString FilePath;
+	Payload->TryGetStringField(TEXT("filepath"), FilePath);
+	const FString DefaultDir = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Screenshots/UAL")));
+	if (FilePath.IsEmpty())
 	{
-		FString FullPath = FPaths::Combine(ScreenshotDir, File);
-		FilesBeforeMap.Add(File, IFileManager::Get().GetTimeStamp(*FullPath));
+		static int32 ScreenshotCounter = 0;
+		FilePath = FPaths::Combine(DefaultDir, FString::Printf(TEXT("UAL_%s_%d.png"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")), ++ScreenshotCounter));
 	}
-	
-	// 3) 记录命令执行时间点（使用 UTC 时间与文件系统时间戳一致，减去 2 秒容差避免精度问题）
-	FDateTime CommandExecuteTime = FDateTime::UtcNow() - FTimespan::FromSeconds(2);
-	UE_LOG(LogUALEditor, Log, TEXT("Command execute time (with tolerance): %s"), *CommandExecuteTime.ToString());
-	
-	// 3.5) 将 UE 编辑器窗口恢复并置顶（确保截图时窗口在前台）
-	if (FSlateApplication::IsInitialized())
+	else if (FPaths::IsRelative(FilePath))
 	{
-		TSharedPtr<SWindow> MainWindow = FSlateApplication::Get().GetActiveTopLevelWindow();
-		if (!MainWindow.IsValid())
-		{
-			// 如果没有活动窗口，尝试获取第一个顶层窗口
-			TArray<TSharedRef<SWindow>> Windows = FSlateApplication::Get().GetInteractiveTopLevelWindows();
-			if (Windows.Num() > 0)
-			{
-				MainWindow = Windows[0];
-			}
-		}
-		
-		if (MainWindow.IsValid())
+		FilePath = FPaths::Combine(DefaultDir, FilePath);
+	}
+	if (!FilePath.EndsWith(TEXT(".png"), ESearchCase::IgnoreCase))
+	{
+		FilePath += TEXT(".png");
+	}
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+
+	// 同一路径已有在途/排队任务时拒绝，避免两个请求互相覆盖
+	for (const TSharedPtr<FScreenshotTaskContext>& Existing : PendingScreenshotTasks)
+	{
+		if (Existing->FilePath.Equals(FilePath, ESearchCase::IgnoreCase))
 		{
-			// 如果窗口被最小化，先恢复
-			if (MainWindow->GetNativeWindow().IsValid() && MainWindow->GetNativeWindow()->IsMinimized())
-			{
-				MainWindow->Restore();
-			}
-			// 将窗口置顶
-			MainWindow->BringToFront();
-			if (MainWindow->GetNativeWindow().IsValid())
-			{
-				MainWindow->GetNativeWindow()->SetWindowFocus();
-			}
-			UE_LOG(LogUALEditor, Log, TEXT("Editor window brought to front for screenshot"));
+			UAL_CommandUtils::SendError(RequestId, 409, FString::Printf(TEXT("Screenshot already pending for path: %s"), *FilePath));
+			return;
 		}
 	}
-	
-	// 4) 执行 HighResShot 控制台命令
-	FString Command = FString::Printf(TEXT("HighResShot %dx%d"), Width, Height);
-	UE_LOG(LogUALEditor, Log, TEXT("Executing: %s, files before: %d"), *Command, FilesBefore.Num());
-	GEngine->Exec(GEditor->GetWorld(), *Command);
-	
-	// 5) 创建异步任务上下文并设置定时器（非阻塞）
+
+	// 3) 入队：完成由 FScreenshotRequest::OnScreenshotRequestProcessed + 写盘队列栅栏驱动
 	TSharedPtr<FScreenshotTaskContext> Context = MakeShared<FScreenshotTaskContext>();
 	Context->RequestId = RequestId;
-	Context->ScreenshotDir = ScreenshotDir;
-	Context->FilesBeforeMap = FilesBeforeMap;
-	Context->CommandExecuteTime = CommandExecuteTime;
+	Context->FilePath = FilePath;
 	Context->Width = Width;
 	Context->Height = Height;
-	Context->RetryCount = 0;
-	Context->MaxRetries = 15;
-	
-	// 使用 RequestId 作为任务 ID
-	FString TaskId = RequestId;
-	PendingScreenshotTasks.Add(TaskId, Context);
-	
-	// 设置定时器：每 2 秒检查一次，最多检查 15 次（共 30 秒）
-	if (GEditor)
-	{
-		GEditor->GetTimerManager()->SetTimer(
-			Context->TimerHandle,
-			FTimerDelegate::CreateLambda([TaskId]() { CheckScreenshotFile(TaskId); }),
-			2.0f,  // 每 2 秒检查一次
-			true,  // 循环
-			2.0f   // 首次延迟 2 秒（给截图时间生成）
-		);
-		UE_LOG(LogUALEditor, Log, TEXT("Screenshot async timer started for request: %s"), *RequestId);
-	}
-	else
-	{
-		UE_LOG(LogUALEditor, Error, TEXT("Failed to get TimerManager"));
-		UAL_CommandUtils::SendError(RequestId, 500, TEXT("Failed to start screenshot timer"));
-		PendingScreenshotTasks.Remove(TaskId);
-	}
-	
-	// 立即返回，不阻塞（响应将由定时器回调发送）
+	Payload->TryGetBoolField(TEXT("include_base64"), Context->bIncludeBase64);
+	Payload->TryGetBoolField(TEXT("bulk"), Context->bBulk);
+	PendingScreenshotTasks.Add(Context);
+
+	UAL_StartNextScreenshot();
+
+	// 立即返回，不阻塞（响应由截图完成回调发送）
 #else
 	// 非编辑器模式不支持 HighResShot
 	UAL_CommandUtils::SendError(RequestId, 501, TEXT("HighResShot only available in editor mode"));
@@ -1012,6 +1096,61 @@ void FUAL_EditorCommands::Handle_AnalyzeUProject(const TSharedPtr<FJsonObject>&
 	UAL_CommandUtils::SendResponse(RequestId, 200, Result);
 }
 
+/**
+ * project.export_snapshot - 导出项目快照（资产、依赖、蓝图结构、材质参数）到列式二进制文件
+ *
+ * 参数:
+ *   - output: 输出路径（可选，相对路径基于 Saved/UAL/Snapshot）
+ *   - paths: 内容路径数组（可选，默认 /Game）
+ *   - full: 忽略上次快照，重新读取全部包头（可选，默认 false）
+ *   - include_soft: 包含软引用（可选，默认 true）
+ *   - async: 立即返回 job_id（可选，默认 false）
+ */
+void FUAL_EditorCommands::Handle_ExportSnapshot(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	FUAL_ProjectSnapshot::FOptions Options;
+	Payload->TryGetStringField(TEXT("output"), Options.OutputPath);
+	Payload->TryGetBoolField(TEXT("full"), Options.bFull);
+	Payload->TryGetBoolField(TEXT("include_soft"), Options.bIncludeSoftReferences);
+
+	const TArray<TSharedPtr<FJsonValue>>* PathsArray = nullptr;
+	if (Payload->TryGetArrayField(TEXT("paths"), PathsArray) && PathsArray)
+	{
+		for (const TSharedPtr<FJsonValue>& PathValue : *PathsArray)
+		{
+			FString Path;
+			if (PathValue->TryGetString(Path) && !Path.IsEmpty())
+			{
+				Options.PackagePaths.Add(Path);
+			}
+		}
+	}
+
+	bool bAsync = false;
+	Payload->TryGetBoolField(TEXT("async"), bAsync);
+
+	FUAL_JobSpec Spec = FUAL_ProjectSnapshot::CreateJob(Options);
+
+	// async: 立即返回 job_id，分批收集与扫描，结果通过 job.completed / job.status 获取
+	if (bAsync)
+	{
+		TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+		Response->SetStringField(TEXT("job_id"), FUAL_JobManager::Get().Start(MoveTemp(Spec)));
+		Response->SetStringField(TEXT("status"), TEXT("running"));
+		UAL_CommandUtils::SendResponse(RequestId, 200, Response);
+		return;
+	}
+
+	FUAL_JobProgress Progress;
+	FUAL_JobManager::RunInline(Spec, Progress);
+	if (!Progress.Error.IsEmpty())
+	{
+		UAL_CommandUtils::SendError(RequestId, 500, Progress.Error);
+		return;
+	}
+	UAL_CommandUtils::SendResponse(RequestId, 200, Progress.Result);
+}
+
 void FUAL_EditorCommands::Handle_CaptureAppWindow(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
 {
     // --- 前半部分逻辑保持不变 (获取 SlateApp, 查找 TargetWindow) ---
@@ -1407,4 +1546,87 @@ void FUAL_EditorCommands::Handle_RevealPath(const TSharedPtr<FJsonObject>& Paylo
 #endif
 }
 
+void FUAL_EditorCommands::Handle_CaptureStream(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	// 帧以二进制消息经服务器连接推送，监听模式的 NDJSON 连接无法承载，也不能让本地客户端改动服务器端的推流
+	int32 LocalClientId = 0;
+	FString OriginalId;
+	if (FUAL_LocalServer::ParseRoutedId(RequestId, LocalClientId, OriginalId))
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("editor.capture_stream is only available on the server connection"));
+		return;
+	}
+
+	FUAL_CaptureStream& Stream = FUAL_CaptureStream::Get();
 
+	bool bEnabled = true;
+	if (Payload.IsValid())
+	{
+		Payload->TryGetBoolField(TEXT("enabled"), bEnabled);
+	}
+
+	if (!bEnabled)
+	{
+		Stream.Stop();
+		UAL_CommandUtils::SendResponse(RequestId, 200, Stream.GetStatsJson());
+		return;
+	}
+
+	FUAL_CaptureStream::FSettings Settings;
+	if (Payload.IsValid())
+	{
+		double Number = 0.0;
+		if (Payload->TryGetNumberField(TEXT("fps"), Number))
+		{
+			Settings.Fps = static_cast<float>(Number);
+		}
+		if (Payload->TryGetNumberField(TEXT("max_width"), Number))
+		{
+			Settings.MaxWidth = static_cast<int32>(Number);
+		}
+		if (Payload->TryGetNumberField(TEXT("quality"), Number))
+		{
+			Settings.Quality = static_cast<int32>(Number);
+		}
+		if (Payload->TryGetNumberField(TEXT("max_unacked"), Number))
+		{
+			Settings.MaxUnacked = static_cast<int32>(Number);
+		}
+		Payload->TryGetBoolField(TEXT("skip_unchanged"), Settings.bSkipUnchanged);
+	}
+
+	FString Error;
+	if (!Stream.Start(Settings, Error))
+	{
+		UAL_CommandUtils::SendError(RequestId, 500, Error);
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Data = Stream.GetStatsJson();
+	Data->SetStringField(TEXT("frame_magic"), TEXT("UALF"));
+	Data->SetNumberField(TEXT("frame_header_size"), 20);
+	Data->SetStringField(TEXT("frame_format"), TEXT("jpeg"));
+	UAL_CommandUtils::SendResponse(RequestId, 200, Data);
+}
+
+void FUAL_EditorCommands::Handle_CaptureStreamAck(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	int32 LocalClientId = 0;
+	FString OriginalId;
+	if (FUAL_LocalServer::ParseRoutedId(RequestId, LocalClientId, OriginalId))
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("editor.capture_stream_ack is only available on the server connection"));
+		return;
+	}
+
+	double Seq = 0.0;
+	if (!Payload.IsValid() || !Payload->TryGetNumberField(TEXT("seq"), Seq) || Seq < 0.0)
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing 'seq' field"));
+		return;
+	}
+
+	FUAL_CaptureStream& Stream = FUAL_CaptureStream::Get();
+	Stream.Ack(static_cast<uint32>(Seq));
+	UAL_CommandUtils::SendResponse(RequestId, 200, Stream.GetStatsJson());
+}
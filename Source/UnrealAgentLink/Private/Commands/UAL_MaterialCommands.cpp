@@ -1,5 +1,9 @@
 #include "UAL_MaterialCommands.h"
 #include "UAL_CommandUtils.h"
+#include "UAL_FuzzyMatch.h"
+#include "UAL_MaterialGraphCache.h"
+#include "UAL_MaterialCompileScheduler.h"
+#include "UAL_MaterialCatalog.h"
 #include "Utils/UAL_PBRMaterialHelper.h"
 
 #include "Materials/MaterialInterface.h"
@@ -46,9 +50,30 @@
 #include "ScopedTransaction.h"
 #include "MaterialEditorUtilities.h"
 #include "MaterialGraph/MaterialGraph.h"
+#include "Misc/PackageName.h"
+#include "HAL/IConsoleManager.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogUALMaterial, Log, All);
 
+static TAutoConsoleVariable<int32> CVarMaterialCatalogLoadBudget(
+	TEXT("ual.MaterialCatalogLoadBudget"),
+	64,
+	TEXT("material.list 每次请求最多为建立参数索引而加载的根材质数量"),
+	ECVF_Default);
+
+/**
+ * 读取图表编辑命令的 defer_compile 参数。
+ * 为 true 时节点级的 PostEditChangeProperty 照常执行（刷新图表显示），
+ * 只把材质级的 PreEditChange/PostEditChange 交给 FUAL_MaterialCompileScheduler：
+ * 静默期内的多次编辑合并为一次编译，完成后推送 material.compiled。
+ */
+static bool ShouldDeferCompile(const TSharedPtr<FJsonObject>& Payload)
+{
+	bool bDeferCompile = false;
+	Payload->TryGetBoolField(TEXT("defer_compile"), bDeferCompile);
+	return bDeferCompile;
+}
+
 /**
  * 注册所有材质相关命令
  */
@@ -96,6 +121,11 @@ void FUAL_MaterialCommands::RegisterCommands(
 		Handle_CompileMaterial(Payload, RequestId);
 	});
 
+	CommandMap.Add(TEXT("material.flush_compiles"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_FlushMaterialCompiles(Payload, RequestId);
+	});
+
 	CommandMap.Add(TEXT("material.set_node_value"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
 	{
 		Handle_SetMaterialNodeValue(Payload, RequestId);
@@ -651,53 +681,25 @@ void FUAL_MaterialCommands::Handle_GetMaterialGraph(
 	bool bIncludeValues = true;
 	Payload->TryGetBoolField(TEXT("include_values"), bIncludeValues);
 
-	// 4. 构建响应
+	// 增量模式：since_version（+ 可选 epoch）有效时只返回差异
+	int32 SinceVersion = -1;
+	const bool bHasSince = Payload->TryGetNumberField(TEXT("since_version"), SinceVersion);
+	FString ClientEpoch;
+	Payload->TryGetStringField(TEXT("epoch"), ClientEpoch);
+	bool bForceRefresh = false;
+	Payload->TryGetBoolField(TEXT("refresh"), bForceRefresh);
+
+	// 4. 从快照缓存构建响应（变更计数未变化时不遍历表达式）
+	const FUAL_MaterialGraphCache::FSnapshot& Snapshot = FUAL_MaterialGraphCache::Get().Refresh(Material, bForceRefresh);
+	const FString Epoch = Snapshot.Epoch.ToString(EGuidFormats::Digits);
+
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("material_path"), Material->GetPathName());
 	Data->SetStringField(TEXT("material_name"), Material->GetName());
+	Data->SetNumberField(TEXT("version"), Snapshot.Version);
+	Data->SetStringField(TEXT("epoch"), Epoch);
 
-	// 5. 遍历所有材质表达式节点
-	TArray<TSharedPtr<FJsonValue>> NodesJson;
-	TArray<TSharedPtr<FJsonValue>> ConnectionsJson;
-	TMap<UMaterialExpression*, FString> ExpressionToId;
-
-	int32 NodeIndex = 0;
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-	for (UMaterialExpression* Expression : Material->GetExpressions())
-#else
-	for (UMaterialExpression* Expression : Material->Expressions)
-#endif
-	{
-		if (!Expression) continue;
-
-		// 生成节点 ID
-		FString NodeId = FString::Printf(TEXT("%s_%d"), *Expression->GetClass()->GetName(), NodeIndex++);
-		ExpressionToId.Add(Expression, NodeId);
-
-		TSharedPtr<FJsonObject> NodeObj = MakeShared<FJsonObject>();
-		NodeObj->SetStringField(TEXT("node_id"), NodeId);
-		NodeObj->SetStringField(TEXT("class"), Expression->GetClass()->GetName());
-		NodeObj->SetStringField(TEXT("display_name"), Expression->GetName());
-
-		// 位置
-		TSharedPtr<FJsonObject> PosObj = MakeShared<FJsonObject>();
-		PosObj->SetNumberField(TEXT("x"), Expression->MaterialExpressionEditorX);
-		PosObj->SetNumberField(TEXT("y"), Expression->MaterialExpressionEditorY);
-		NodeObj->SetObjectField(TEXT("position"), PosObj);
-
-		// 描述（如果有）
-		if (!Expression->Desc.IsEmpty())
-		{
-			NodeObj->SetStringField(TEXT("description"), Expression->Desc);
-		}
-
-		NodesJson.Add(MakeShared<FJsonValueObject>(NodeObj));
-	}
-
-	Data->SetArrayField(TEXT("nodes"), NodesJson);
-	Data->SetNumberField(TEXT("node_count"), NodesJson.Num());
-
-	// 6. 材质主节点可用引脚
+	// 5. 材质主节点可用引脚
 	TArray<TSharedPtr<FJsonValue>> MaterialPins;
 	MaterialPins.Add(MakeShared<FJsonValueString>(TEXT("BaseColor")));
 	MaterialPins.Add(MakeShared<FJsonValueString>(TEXT("Metallic")));
@@ -712,92 +714,31 @@ void FUAL_MaterialCommands::Handle_GetMaterialGraph(
 	MaterialPins.Add(MakeShared<FJsonValueString>(TEXT("AmbientOcclusion")));
 	Data->SetArrayField(TEXT("material_pins"), MaterialPins);
 
-	// 7. Collect connections from expression inputs and material main node
-	auto AddConn = [&](const FString& FromId, const FString& FromPin,
-					   const FString& ToId, const FString& ToPin)
-	{
-		TSharedPtr<FJsonObject> C = MakeShared<FJsonObject>();
-		C->SetStringField(TEXT("from_node"), FromId);
-		C->SetStringField(TEXT("from_pin"), FromPin);
-		C->SetStringField(TEXT("to_node"), ToId);
-		C->SetStringField(TEXT("to_pin"), ToPin);
-		ConnectionsJson.Add(MakeShared<FJsonValueObject>(C));
-	};
+	// 6. 节点与连线：全量或增量
+	const bool bEpochMatches = ClientEpoch.IsEmpty() || ClientEpoch.Equals(Epoch, ESearchCase::IgnoreCase);
+	const bool bCanDelta = bHasSince
+		&& bEpochMatches
+		&& SinceVersion >= Snapshot.OldestDeltaVersion
+		&& SinceVersion > 0
+		&& SinceVersion <= Snapshot.Version;
 
-	// 7a. Node-to-node connections
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-	for (UMaterialExpression* Expr : Material->GetExpressions())
-#else
-	for (UMaterialExpression* Expr : Material->Expressions)
-#endif
+	if (bCanDelta)
 	{
-		if (!Expr) continue;
-		const FString* ToId = ExpressionToId.Find(Expr);
-		if (!ToId) continue;
-
-		const TArray<FExpressionInput*> Inputs = Expr->GetInputs();
-		for (int32 i = 0; i < Inputs.Num(); ++i)
-		{
-			FExpressionInput* In = Inputs[i];
-			if (!In || !In->Expression) continue;
-			const FString* FromId = ExpressionToId.Find(In->Expression);
-			if (!FromId) continue;
-
-			FString InName = Expr->GetInputName(i).ToString();
-			if (InName.IsEmpty()) InName = FString::Printf(TEXT("Input_%d"), i);
-			AddConn(*FromId, FString::Printf(TEXT("Output_%d"), In->OutputIndex), *ToId, InName);
-		}
+		FUAL_MaterialGraphCache::WriteDelta(Snapshot, SinceVersion, Data);
 	}
-
-	// 7b. Material main node connections
-	struct FMatPin { const TCHAR* Name; FExpressionInput* In; };
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-	auto* ED = Material->GetEditorOnlyData();
-	FMatPin MatPins[] = {
-		{TEXT("BaseColor"),           &ED->BaseColor},
-		{TEXT("Metallic"),            &ED->Metallic},
-		{TEXT("Specular"),            &ED->Specular},
-		{TEXT("Roughness"),           &ED->Roughness},
-		{TEXT("EmissiveColor"),       &ED->EmissiveColor},
-		{TEXT("Opacity"),             &ED->Opacity},
-		{TEXT("OpacityMask"),         &ED->OpacityMask},
-		{TEXT("Normal"),              &ED->Normal},
-		{TEXT("WorldPositionOffset"), &ED->WorldPositionOffset},
-		{TEXT("SubsurfaceColor"),     &ED->SubsurfaceColor},
-		{TEXT("AmbientOcclusion"),    &ED->AmbientOcclusion},
-	};
-#else
-	FMatPin MatPins[] = {
-		{TEXT("BaseColor"),           &Material->BaseColor},
-		{TEXT("Metallic"),            &Material->Metallic},
-		{TEXT("Specular"),            &Material->Specular},
-		{TEXT("Roughness"),           &Material->Roughness},
-		{TEXT("EmissiveColor"),       &Material->EmissiveColor},
-		{TEXT("Opacity"),             &Material->Opacity},
-		{TEXT("OpacityMask"),         &Material->OpacityMask},
-		{TEXT("Normal"),              &Material->Normal},
-		{TEXT("WorldPositionOffset"), &Material->WorldPositionOffset},
-		{TEXT("SubsurfaceColor"),     &Material->SubsurfaceColor},
-		{TEXT("AmbientOcclusion"),    &Material->AmbientOcclusion},
-	};
-#endif
-	for (const FMatPin& MP : MatPins)
+	else
 	{
-		if (MP.In && MP.In->Expression)
+		if (bHasSince)
 		{
-			const FString* FromId = ExpressionToId.Find(MP.In->Expression);
-			if (FromId)
-			{
-				AddConn(*FromId, FString::Printf(TEXT("Output_%d"), MP.In->OutputIndex), TEXT("Material"), MP.Name);
-			}
+			// 客户端版本已失效（纪元变化 / 过旧 / 超前），返回全量并提示原因
+			Data->SetStringField(TEXT("resync_reason"), !bEpochMatches ? TEXT("epoch_changed") : TEXT("version_out_of_range"));
 		}
+		FUAL_MaterialGraphCache::WriteFull(Snapshot, Data);
 	}
 
-	Data->SetNumberField(TEXT("connection_count"), ConnectionsJson.Num());
-	Data->SetArrayField(TEXT("connections"), ConnectionsJson);
-
-	UE_LOG(LogUALMaterial, Log, TEXT("Got material graph: %s (%d nodes, %d connections)"),
-		*Material->GetName(), NodesJson.Num(), ConnectionsJson.Num());
+	UE_LOG(LogUALMaterial, Log, TEXT("Got material graph: %s v%d (%d nodes, %d connections%s)"),
+		*Material->GetName(), Snapshot.Version, Snapshot.NodeOrder.Num(), Snapshot.LinkOrder.Num(),
+		bCanDelta ? TEXT(", delta") : TEXT(""));
 
 	UAL_CommandUtils::SendResponse(RequestId, 200, Data);
 }
@@ -833,6 +774,10 @@ void FUAL_MaterialCommands::Handle_AddMaterialNode(
 		return;
 	}
 
+	// 编辑前的图表版本，响应中返回自该版本以来受影响的节点
+	const int32 BaseGraphVersion = FUAL_MaterialGraphCache::Get().Refresh(Material).Version;
+	const bool bDeferCompile = ShouldDeferCompile(Payload);
+
 	// 3. 解析可选参数
 	FString NodeName;
 	Payload->TryGetStringField(TEXT("node_name"), NodeName);
@@ -906,7 +851,10 @@ void FUAL_MaterialCommands::Handle_AddMaterialNode(
 	// 5. 创建表达式并添加到材质
 	FScopedTransaction Transaction(NSLOCTEXT("UALMaterial", "AddNode", "Add Material Node"));
 
-	Material->PreEditChange(nullptr);
+	if (!bDeferCompile)
+	{
+		Material->PreEditChange(nullptr);
+	}
 	Material->Modify();
 
 	NewExpression = NewObject<UMaterialExpression>(Material, ExpressionClass);
@@ -967,13 +915,20 @@ void FUAL_MaterialCommands::Handle_AddMaterialNode(
 	}
 
 	// 标记材质已修改并刷新编辑器
-	FPropertyChangedEvent PropertyChangedEvent(nullptr, EPropertyChangeType::ValueSet);
-	Material->PostEditChangeProperty(PropertyChangedEvent);
-	
-	// 强制刷新材质编辑器图表和逻辑
-	if (Material && Material->MaterialGraph)
+	if (bDeferCompile)
 	{
-		FMaterialEditorUtilities::UpdateMaterialAfterGraphChange(Material->MaterialGraph);
+		FUAL_MaterialCompileScheduler::Get().MarkDirty(Material);
+	}
+	else
+	{
+		FPropertyChangedEvent PropertyChangedEvent(nullptr, EPropertyChangeType::ValueSet);
+		Material->PostEditChangeProperty(PropertyChangedEvent);
+
+		// 强制刷新材质编辑器图表和逻辑
+		if (Material->MaterialGraph)
+		{
+			FMaterialEditorUtilities::UpdateMaterialAfterGraphChange(Material->MaterialGraph);
+		}
 	}
 	
 	Material->MarkPackageDirty();
@@ -989,12 +944,8 @@ void FUAL_MaterialCommands::Handle_AddMaterialNode(
 		}
 	}
 
-	// 8. 生成节点 ID
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-	FString NodeId = FString::Printf(TEXT("%s_%d"), *NewExpression->GetClass()->GetName(), Material->GetExpressions().Num() - 1);
-#else
-	FString NodeId = FString::Printf(TEXT("%s_%d"), *NewExpression->GetClass()->GetName(), Material->Expressions.Num() - 1);
-#endif
+	// 8. 节点 ID：表达式对象名，与 material.get_graph 一致，不随其它节点增删变化
+	FString NodeId = NewExpression->GetName();
 
 	// 9. 构建响应
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
@@ -1022,6 +973,9 @@ void FUAL_MaterialCommands::Handle_AddMaterialNode(
 		Data->SetBoolField(TEXT("texture_applied"), bTextureApplied);
 	}
 
+	FUAL_MaterialGraphCache::Get().WriteEditResult(Material, BaseGraphVersion, Data);
+	Data->SetBoolField(TEXT("compile_queued"), bDeferCompile);
+
 	UE_LOG(LogUALMaterial, Log, TEXT("Added node %s to material %s"), 
 		*NodeId, *Material->GetName());
 
@@ -1063,6 +1017,9 @@ void FUAL_MaterialCommands::Handle_ConnectMaterialPins(
 		return;
 	}
 
+	const int32 BaseGraphVersion = FUAL_MaterialGraphCache::Get().Refresh(Material).Version;
+	const bool bDeferCompile = ShouldDeferCompile(Payload);
+
 	// 3. 查找源节点（支持两种 ID 格式：计算的索引 ID 和 UE 对象实际名称）
 	UMaterialExpression* SourceExpression = nullptr;
 	int32 NodeIndex = 0;
@@ -1102,7 +1059,10 @@ void FUAL_MaterialCommands::Handle_ConnectMaterialPins(
 		// 使用 FScopedTransaction 管理事务
 		FScopedTransaction Transaction(NSLOCTEXT("UALMaterial", "ConnectPins", "Connect Material Pins"));
 		
-		Material->PreEditChange(nullptr);
+		if (!bDeferCompile)
+		{
+			Material->PreEditChange(nullptr);
+		}
 		Material->Modify();
 
 		// 映射 target_pin 到材质属性
@@ -1223,13 +1183,20 @@ void FUAL_MaterialCommands::Handle_ConnectMaterialPins(
 		}
 
 		// 标记材质已修改并刷新编辑器
-		FPropertyChangedEvent PropertyChangedEvent(nullptr, EPropertyChangeType::ValueSet);
-		Material->PostEditChangeProperty(PropertyChangedEvent);
-		
-		// 强制刷新材质编辑器图表和逻辑
-		if (Material && Material->MaterialGraph)
+		if (bDeferCompile)
 		{
-			FMaterialEditorUtilities::UpdateMaterialAfterGraphChange(Material->MaterialGraph);
+			FUAL_MaterialCompileScheduler::Get().MarkDirty(Material);
+		}
+		else
+		{
+			FPropertyChangedEvent PropertyChangedEvent(nullptr, EPropertyChangeType::ValueSet);
+			Material->PostEditChangeProperty(PropertyChangedEvent);
+
+			// 强制刷新材质编辑器图表和逻辑
+			if (Material->MaterialGraph)
+			{
+				FMaterialEditorUtilities::UpdateMaterialAfterGraphChange(Material->MaterialGraph);
+			}
 		}
 		
 		Material->MarkPackageDirty();
@@ -1252,6 +1219,9 @@ void FUAL_MaterialCommands::Handle_ConnectMaterialPins(
 		ConnObj->SetStringField(TEXT("to"), FString::Printf(TEXT("Material.%s"), *TargetPin));
 		Data->SetObjectField(TEXT("connection"), ConnObj);
 
+		FUAL_MaterialGraphCache::Get().WriteEditResult(Material, BaseGraphVersion, Data);
+		Data->SetBoolField(TEXT("compile_queued"), bDeferCompile);
+
 		UE_LOG(LogUALMaterial, Log, TEXT("Connected %s.%s -> Material.%s in %s"), 
 			*SourceNode, *SourcePin, *TargetPin, *Material->GetName());
 
@@ -1289,16 +1259,22 @@ void FUAL_MaterialCommands::Handle_CompileMaterial(
 		return;
 	}
 
-	// 3. 触发编译
-	UMaterial* Material = Cast<UMaterial>(MaterialInterface);
-	if (Material)
+	// 3. 触发编译：deferred 时只标记为脏，与其它编辑合并；否则立即提交（着色器异步编译）
+	//    两种方式完成后都会推送 material.compiled 事件（耗时、着色器任务数、错误）
+	bool bDeferred = false;
+	Payload->TryGetBoolField(TEXT("deferred"), bDeferred);
+
+	FUAL_MaterialCompileScheduler& Scheduler = FUAL_MaterialCompileScheduler::Get();
+	if (bDeferred)
 	{
-		// 强制重新编译
-		Material->ForceRecompileForRendering();
+		Scheduler.MarkDirty(MaterialInterface);
 	}
-
-	// Post edit change 会触发编译
-	MaterialInterface->PostEditChange();
+	else
+	{
+		// 显式编译命令：强制重新编译，即使材质未被判定为已修改
+		Scheduler.CompileNow(MaterialInterface, true);
+	}
+	UMaterial* Material = Cast<UMaterial>(MaterialInterface);
 
 	// 4. 获取编译错误和警告
 	TArray<TSharedPtr<FJsonValue>> ErrorsJson;
@@ -1342,7 +1318,10 @@ void FUAL_MaterialCommands::Handle_CompileMaterial(
 
 	// 5. 构建响应
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetBoolField(TEXT("compiled"), true);
+	Data->SetBoolField(TEXT("compiled"), !bDeferred);
+	Data->SetBoolField(TEXT("deferred"), bDeferred);
+	Data->SetNumberField(TEXT("pending_count"), Scheduler.GetPendingCount());
+	Data->SetNumberField(TEXT("in_flight_count"), Scheduler.GetInFlightCount());
 	Data->SetBoolField(TEXT("has_errors"), bHasErrors);
 	Data->SetStringField(TEXT("material_path"), MaterialInterface->GetPathName());
 	Data->SetStringField(TEXT("material_name"), MaterialInterface->GetName());
@@ -1356,12 +1335,31 @@ void FUAL_MaterialCommands::Handle_CompileMaterial(
 	}
 	else
 	{
-		UE_LOG(LogUALMaterial, Log, TEXT("Compiled material successfully: %s"), *MaterialInterface->GetName());
+		UE_LOG(LogUALMaterial, Log, TEXT("%s material compile: %s"),
+			bDeferred ? TEXT("Queued") : TEXT("Submitted"), *MaterialInterface->GetName());
 	}
 
 	UAL_CommandUtils::SendResponse(RequestId, 200, Data);
 }
 
+// ============================================================================
+// Handle_FlushMaterialCompiles - 立即提交延迟编译队列
+// ============================================================================
+void FUAL_MaterialCommands::Handle_FlushMaterialCompiles(
+	const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	FUAL_MaterialCompileScheduler& Scheduler = FUAL_MaterialCompileScheduler::Get();
+	const int32 PendingCount = Scheduler.GetPendingCount();
+	const int32 SubmittedCount = Scheduler.Flush();
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetBoolField(TEXT("ok"), true);
+	Data->SetNumberField(TEXT("pending_count"), PendingCount);
+	Data->SetNumberField(TEXT("submitted_count"), SubmittedCount);
+	Data->SetNumberField(TEXT("in_flight_count"), Scheduler.GetInFlightCount());
+	UAL_CommandUtils::SendResponse(RequestId, 200, Data);
+}
+
 // ============================================================================
 // Handle_SetMaterialNodeValue - 设置材质节点值
 // ============================================================================
@@ -1393,6 +1391,9 @@ void FUAL_MaterialCommands::Handle_SetMaterialNodeValue(
 		return;
 	}
 
+	const int32 BaseGraphVersion = FUAL_MaterialGraphCache::Get().Refresh(Material).Version;
+	const bool bDeferCompile = ShouldDeferCompile(Payload);
+
 	// 3. 查找目标节点（支持两种 ID 格式：计算的索引 ID 和 UE 对象实际名称）
 	UMaterialExpression* TargetExpression = nullptr;
 	int32 NodeIndex = 0;
@@ -1436,7 +1437,10 @@ void FUAL_MaterialCommands::Handle_SetMaterialNodeValue(
 	FScopedTransaction Transaction(NSLOCTEXT("UALMaterial", "SetNodeValue", "Set Material Node Value"));
 	
 	// 在修改值之前调用 PreEdit 和 Modify
-	Material->PreEditChange(nullptr);
+	if (!bDeferCompile)
+	{
+		Material->PreEditChange(nullptr);
+	}
 	Material->Modify();
 	TargetExpression->Modify();
 
@@ -1515,17 +1519,24 @@ void FUAL_MaterialCommands::Handle_SetMaterialNodeValue(
 	{
 		// 广播变更并刷新编辑器
 		FPropertyChangedEvent PropertyChangedEvent(nullptr, EPropertyChangeType::ValueSet);
-		
-		// 必须刷新具体的节点 (这会让节点在图表中刷新显示)
+
+		// 必须刷新具体的节点 (这会让节点在图表中刷新显示)，延迟编译时也不能省略
 		TargetExpression->PostEditChangeProperty(PropertyChangedEvent);
-		
-		// 最后再通知材质 (触发整体编译)
-		Material->PostEditChangeProperty(PropertyChangedEvent);
-		
-		// 强制刷新材质编辑器图表和逻辑
-		if (Material && Material->MaterialGraph)
+
+		if (bDeferCompile)
 		{
-			FMaterialEditorUtilities::UpdateMaterialAfterGraphChange(Material->MaterialGraph);
+			FUAL_MaterialCompileScheduler::Get().MarkDirty(Material);
+		}
+		else
+		{
+			// 最后再通知材质 (触发整体编译)
+			Material->PostEditChangeProperty(PropertyChangedEvent);
+
+			// 强制刷新材质编辑器图表和逻辑
+			if (Material->MaterialGraph)
+			{
+				FMaterialEditorUtilities::UpdateMaterialAfterGraphChange(Material->MaterialGraph);
+			}
 		}
 		
 		Material->MarkPackageDirty();
@@ -1545,6 +1556,12 @@ void FUAL_MaterialCommands::Handle_SetMaterialNodeValue(
 		Transaction.Cancel();
 	}
 
+	if (bModified)
+	{
+		FUAL_MaterialGraphCache::Get().WriteEditResult(Material, BaseGraphVersion, Data);
+		Data->SetBoolField(TEXT("compile_queued"), bDeferCompile);
+	}
+
 	UE_LOG(LogUALMaterial, Log, TEXT("Set value for node %s in material %s"), 
 		*NodeId, *Material->GetName());
 
@@ -1582,6 +1599,9 @@ void FUAL_MaterialCommands::Handle_DeleteMaterialNode(
 		return;
 	}
 
+	const int32 BaseGraphVersion = FUAL_MaterialGraphCache::Get().Refresh(Material).Version;
+	const bool bDeferCompile = ShouldDeferCompile(Payload);
+
 	// 3. 查找目标节点（支持两种 ID 格式：计算的索引 ID 和 UE 对象实际名称）
 	UMaterialExpression* TargetExpression = nullptr;
 	int32 NodeIndex = 0;
@@ -1616,7 +1636,10 @@ void FUAL_MaterialCommands::Handle_DeleteMaterialNode(
 	// 4. 从材质中移除节点
 	FScopedTransaction Transaction(NSLOCTEXT("UALMaterial", "DeleteNode", "Delete Material Node"));
 	
-	Material->PreEditChange(nullptr);
+	if (!bDeferCompile)
+	{
+		Material->PreEditChange(nullptr);
+	}
 	Material->Modify();
 	
 #if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
@@ -1626,13 +1649,20 @@ void FUAL_MaterialCommands::Handle_DeleteMaterialNode(
 #endif
 
 	// 5. 标记材质已修改并刷新编辑器
-	FPropertyChangedEvent PropertyChangedEvent(nullptr, EPropertyChangeType::ValueSet);
-	Material->PostEditChangeProperty(PropertyChangedEvent);
-	
-	// 强制刷新材质编辑器图表和逻辑
-	if (Material && Material->MaterialGraph)
+	if (bDeferCompile)
 	{
-		FMaterialEditorUtilities::UpdateMaterialAfterGraphChange(Material->MaterialGraph);
+		FUAL_MaterialCompileScheduler::Get().MarkDirty(Material);
+	}
+	else
+	{
+		FPropertyChangedEvent PropertyChangedEvent(nullptr, EPropertyChangeType::ValueSet);
+		Material->PostEditChangeProperty(PropertyChangedEvent);
+
+		// 强制刷新材质编辑器图表和逻辑
+		if (Material->MaterialGraph)
+		{
+			FMaterialEditorUtilities::UpdateMaterialAfterGraphChange(Material->MaterialGraph);
+		}
 	}
 	
 	Material->MarkPackageDirty();
@@ -1653,6 +1683,9 @@ void FUAL_MaterialCommands::Handle_DeleteMaterialNode(
 	Data->SetStringField(TEXT("node_id"), NodeId);
 	Data->SetNumberField(TEXT("disconnected_count"), 0); // 简化版本
 
+	FUAL_MaterialGraphCache::Get().WriteEditResult(Material, BaseGraphVersion, Data);
+	Data->SetBoolField(TEXT("compile_queued"), bDeferCompile);
+
 	UE_LOG(LogUALMaterial, Log, TEXT("Deleted node %s from material %s"), 
 		*NodeId, *Material->GetName());
 
@@ -1714,18 +1747,49 @@ TArray<FString> FUAL_MaterialCommands::FindSimilarAssets(const FString& PartialP
 	AssetRegistry.GetAssetsByClass(FName(*AssetClass), AssetDataList);
 #endif
 	
-	for (const FAssetData& AssetData : AssetDataList)
+	auto GetObjectPathString = [](const FAssetData& AssetData) -> FString
 	{
-		FString AssetName = AssetData.AssetName.ToString();
-		// 简单的模糊匹配：名称包含搜索词
-		if (AssetName.Contains(SearchName, ESearchCase::IgnoreCase))
-		{
 #if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-			Results.Add(AssetData.GetSoftObjectPath().ToString());
+		return AssetData.GetSoftObjectPath().ToString();
 #else
-			Results.Add(AssetData.ObjectPath.ToString());
+		return AssetData.ObjectPath.ToString();
 #endif
-			if (Results.Num() >= 5) break; // 最多返回5个
+	};
+
+	constexpr int32 MaxResults = 5; // 最多返回5个
+	TArray<FString> AssetNames;
+	AssetNames.Reserve(AssetDataList.Num());
+	
+	for (const FAssetData& AssetData : AssetDataList)
+	{
+		FString AssetName = AssetData.AssetName.ToString();
+		// 优先：名称包含搜索词
+		if (Results.Num() < MaxResults && AssetName.Contains(SearchName, ESearchCase::IgnoreCase))
+		{
+			Results.Add(GetObjectPathString(AssetData));
+		}
+		AssetNames.Add(MoveTemp(AssetName));
+	}
+
+	// 不足时按编辑距离补充拼写相近的资产（位并行 + 阈值截断，大项目也只需一次线性扫描）
+	if (Results.Num() < MaxResults && !SearchName.IsEmpty())
+	{
+		const int32 MaxDistance = FMath::Max(2, SearchName.Len() / 3);
+		// 按下标取回资产：不同目录下的同名资产各自对应正确的路径
+		TArray<int32> ClosestIndices;
+		FUAL_FuzzyMatcher::FindClosestIndices(SearchName, AssetNames, MaxResults, ClosestIndices, MaxDistance);
+
+		for (const int32 Index : ClosestIndices)
+		{
+			const FString ObjectPath = GetObjectPathString(AssetDataList[Index]);
+			if (!Results.Contains(ObjectPath))
+			{
+				Results.Add(ObjectPath);
+			}
+			if (Results.Num() >= MaxResults)
+			{
+				break;
+			}
 		}
 	}
 	
@@ -2286,9 +2350,6 @@ void FUAL_MaterialCommands::Handle_ListMaterials(
 		SearchPath = TEXT("/Game");
 	}
 	
-	FString NameFilter;
-	Payload->TryGetStringField(TEXT("name_filter"), NameFilter);
-	
 	FString MaterialType = TEXT("all");
 	Payload->TryGetStringField(TEXT("material_type"), MaterialType);
 	
@@ -2297,96 +2358,134 @@ void FUAL_MaterialCommands::Handle_ListMaterials(
 	if (MaxResults <= 0) MaxResults = 50;
 	if (MaxResults > 200) MaxResults = 200;
 	
-	// 2. 获取资产注册表
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+	FUAL_MaterialCatalog::FQuery Query;
+	Query.SearchPath = SearchPath;
+	Query.MaxResults = MaxResults;
+	Query.bIncludeMaterials = MaterialType == TEXT("all") || MaterialType == TEXT("material");
+	Query.bIncludeInstances = MaterialType == TEXT("all") || MaterialType == TEXT("instance");
+	Payload->TryGetStringField(TEXT("name_filter"), Query.NameFilter);
+	Payload->TryGetStringField(TEXT("blend_mode"), Query.BlendMode);
+	Payload->TryGetStringField(TEXT("param_type"), Query.ParamType);
+	Payload->TryGetStringField(TEXT("cursor"), Query.Cursor);
+	Payload->TryGetBoolField(TEXT("parent_recursive"), Query.bParentRecursive);
+	// total_count 需要扫描整个目录，按需开启
+	Payload->TryGetBoolField(TEXT("include_total"), Query.bCountMatches);
 	
-	// 3. 搜索材质
-	TArray<TSharedPtr<FJsonValue>> MaterialsJson;
-	int32 TotalCount = 0;
+	FString ParamName;
+	if (Payload->TryGetStringField(TEXT("param_name"), ParamName) && !ParamName.IsEmpty())
+	{
+		Query.ParamName = FName(*ParamName);
+	}
 	
-	// 搜索 Material
-	if (MaterialType == TEXT("all") || MaterialType == TEXT("material"))
+	FString ParentPath;
+	if (Payload->TryGetStringField(TEXT("parent"), ParentPath) && !ParentPath.IsEmpty())
 	{
-		TArray<FAssetData> MaterialAssets;
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-		AssetRegistry.GetAssetsByClass(FTopLevelAssetPath(TEXT("/Script/Engine.Material")), MaterialAssets);
-#else
-		AssetRegistry.GetAssetsByClass(FName(TEXT("Material")), MaterialAssets);
-#endif
-		
-		for (const FAssetData& AssetData : MaterialAssets)
+		// 接受包路径（/Game/M_Base）或对象路径（/Game/M_Base.M_Base）
+		ParentPath = NormalizePath(ParentPath);
+		if (!ParentPath.Contains(TEXT(".")))
 		{
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-			FString AssetPath = AssetData.GetSoftObjectPath().ToString();
-#else
-			FString AssetPath = AssetData.ObjectPath.ToString();
-#endif
-			if (!AssetPath.StartsWith(SearchPath)) continue;
-			
-			FString AssetName = AssetData.AssetName.ToString();
-			if (!NameFilter.IsEmpty())
-			{
-				// 简单通配符匹配
-				FString FilterPattern = NameFilter.Replace(TEXT("*"), TEXT(""));
-				if (!AssetName.Contains(FilterPattern, ESearchCase::IgnoreCase)) continue;
-			}
-			
-			if (MaterialsJson.Num() >= MaxResults) break;
-			
-			TSharedPtr<FJsonObject> MatObj = MakeShared<FJsonObject>();
-			MatObj->SetStringField(TEXT("path"), AssetPath);
-			MatObj->SetStringField(TEXT("name"), AssetName);
-			MatObj->SetStringField(TEXT("type"), TEXT("Material"));
-			MaterialsJson.Add(MakeShared<FJsonValueObject>(MatObj));
-			TotalCount++;
+			ParentPath = ParentPath + TEXT(".") + FPackageName::GetShortName(ParentPath);
 		}
+		Query.ParentPath = ParentPath;
 	}
 	
-	// 搜索 MaterialInstance
-	if (MaterialType == TEXT("all") || MaterialType == TEXT("instance"))
+	bool bIncludeParams = false;
+	Payload->TryGetBoolField(TEXT("include_params"), bIncludeParams);
+	Query.bNeedParams = bIncludeParams;
+	
+	// 参数未建立索引的根材质按需加载，每次请求的加载数量有上限，未能判断的条目计入 unresolved_count
+	Query.LoadBudget = CVarMaterialCatalogLoadBudget.GetValueOnGameThread();
+	Payload->TryGetNumberField(TEXT("max_loads"), Query.LoadBudget);
+	
+	// 2. 查询目录索引（首次调用从资产注册表标签建立，之后随注册表事件 / 保存增量更新）
+	const double StartTime = FPlatformTime::Seconds();
+	FUAL_MaterialCatalog& Catalog = FUAL_MaterialCatalog::Get();
+	const FUAL_MaterialCatalog::FQueryResult Result = Catalog.Query(Query);
+	
+	// 3. 构建条目
+	TArray<TSharedPtr<FJsonValue>> MaterialsJson;
+	MaterialsJson.Reserve(Result.Indices.Num());
+	for (const int32 Index : Result.Indices)
 	{
-		TArray<FAssetData> InstanceAssets;
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-		AssetRegistry.GetAssetsByClass(FTopLevelAssetPath(TEXT("/Script/Engine.MaterialInstanceConstant")), InstanceAssets);
-#else
-		AssetRegistry.GetAssetsByClass(FName(TEXT("MaterialInstanceConstant")), InstanceAssets);
-#endif
+		const FUAL_MaterialCatalog::FEntry& Entry = Catalog.GetEntry(Index);
+		
+		TSharedPtr<FJsonObject> MatObj = MakeShared<FJsonObject>();
+		MatObj->SetStringField(TEXT("path"), Entry.Path);
+		MatObj->SetStringField(TEXT("name"), Entry.Name.ToString());
+		MatObj->SetStringField(TEXT("type"), Entry.bIsInstance ? TEXT("MaterialInstance") : TEXT("Material"));
 		
-		for (const FAssetData& AssetData : InstanceAssets)
+		const FString BlendMode = Catalog.GetEffectiveBlendMode(Index);
+		if (!BlendMode.IsEmpty())
 		{
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-			FString AssetPath = AssetData.GetSoftObjectPath().ToString();
-#else
-			FString AssetPath = AssetData.ObjectPath.ToString();
-#endif
-			if (!AssetPath.StartsWith(SearchPath)) continue;
-			
-			FString AssetName = AssetData.AssetName.ToString();
-			if (!NameFilter.IsEmpty())
+			MatObj->SetStringField(TEXT("blend_mode"), BlendMode);
+		}
+		if (Entry.bIsInstance)
+		{
+			MatObj->SetStringField(TEXT("parent"), Entry.ParentPath);
+		}
+		
+		if (bIncludeParams)
+		{
+			if (Entry.bIsInstance)
 			{
-				FString FilterPattern = NameFilter.Replace(TEXT("*"), TEXT(""));
-				if (!AssetName.Contains(FilterPattern, ESearchCase::IgnoreCase)) continue;
+				TArray<TSharedPtr<FJsonValue>> ChainJson;
+				for (const FString& ChainPath : Catalog.GetParentChain(Index))
+				{
+					ChainJson.Add(MakeShared<FJsonValueString>(ChainPath));
+				}
+				MatObj->SetArrayField(TEXT("parent_chain"), ChainJson);
 			}
 			
-			if (MaterialsJson.Num() >= MaxResults) break;
+			auto ParamsToJson = [](const TArray<FUAL_MaterialCatalog::FParam>& Params)
+			{
+				TArray<TSharedPtr<FJsonValue>> ParamsJson;
+				for (const FUAL_MaterialCatalog::FParam& Param : Params)
+				{
+					TSharedPtr<FJsonObject> ParamObj = MakeShared<FJsonObject>();
+					ParamObj->SetStringField(TEXT("name"), Param.Name.ToString());
+					ParamObj->SetStringField(TEXT("type"), FUAL_MaterialCatalog::ParamTypeToString(Param.Type));
+					ParamsJson.Add(MakeShared<FJsonValueObject>(ParamObj));
+				}
+				return ParamsJson;
+			};
 			
-			TSharedPtr<FJsonObject> MatObj = MakeShared<FJsonObject>();
-			MatObj->SetStringField(TEXT("path"), AssetPath);
-			MatObj->SetStringField(TEXT("name"), AssetName);
-			MatObj->SetStringField(TEXT("type"), TEXT("MaterialInstance"));
-			MaterialsJson.Add(MakeShared<FJsonValueObject>(MatObj));
-			TotalCount++;
+			// 可用参数来自根材质；实例被加载过时额外给出其覆盖的参数
+			const TArray<FUAL_MaterialCatalog::FParam>* Params = Catalog.GetEffectiveParams(Index);
+			MatObj->SetBoolField(TEXT("params_indexed"), Params != nullptr);
+			if (Params)
+			{
+				MatObj->SetArrayField(TEXT("parameters"), ParamsToJson(*Params));
+			}
+			if (Entry.bIsInstance && Entry.bParamsIndexed)
+			{
+				MatObj->SetArrayField(TEXT("overridden_parameters"), ParamsToJson(Entry.Params));
+			}
 		}
+		
+		MaterialsJson.Add(MakeShared<FJsonValueObject>(MatObj));
 	}
 	
 	// 4. 构建响应
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetArrayField(TEXT("materials"), MaterialsJson);
-	Data->SetNumberField(TEXT("total_count"), TotalCount);
+	if (Query.bCountMatches)
+	{
+		Data->SetNumberField(TEXT("total_count"), Result.MatchedCount);
+	}
+	Data->SetNumberField(TEXT("returned_count"), MaterialsJson.Num());
 	Data->SetStringField(TEXT("search_path"), SearchPath);
+	Data->SetStringField(TEXT("next_cursor"), Result.NextCursor);
+	Data->SetBoolField(TEXT("has_more"), !Result.NextCursor.IsEmpty());
+	Data->SetNumberField(TEXT("unresolved_count"), Result.UnresolvedCount);
+	Data->SetNumberField(TEXT("load_count"), Result.LoadCount);
+	Data->SetNumberField(TEXT("query_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 	
-	UE_LOG(LogUALMaterial, Log, TEXT("Listed %d materials in %s"), TotalCount, *SearchPath);
+	TSharedPtr<FJsonObject> CatalogStats = MakeShared<FJsonObject>();
+	Catalog.WriteStats(CatalogStats);
+	Data->SetObjectField(TEXT("catalog"), CatalogStats);
+	
+	UE_LOG(LogUALMaterial, Log, TEXT("Listed %d materials in %s (%d loads)"),
+		MaterialsJson.Num(), *SearchPath, Result.LoadCount);
 	
 	UAL_CommandUtils::SendResponse(RequestId, 200, Data);
 }
@@ -2451,29 +2550,11 @@ void FUAL_MaterialCommands::Handle_PreviewMaterial(
 		
 		if (bIncludeGraphSummary)
 		{
-			// 统计节点数量
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-			int32 NodeCount = Material->GetExpressions().Num();
-#else
-			int32 NodeCount = Material->Expressions.Num();
-#endif
-			Data->SetNumberField(TEXT("node_count"), NodeCount);
-			
-			// 统计贴图数量
-			int32 TextureCount = 0;
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-			for (UMaterialExpression* Expr : Material->GetExpressions())
-#else
-			for (UMaterialExpression* Expr : Material->Expressions)
-#endif
-			{
-				if (Cast<UMaterialExpressionTextureSample>(Expr) || 
-				    Cast<UMaterialExpressionTextureSampleParameter2D>(Expr))
-				{
-					TextureCount++;
-				}
-			}
-			Data->SetNumberField(TEXT("texture_count"), TextureCount);
+			// 节点 / 贴图数量取自图表快照缓存
+			const FUAL_MaterialGraphCache::FSnapshot& Snapshot = FUAL_MaterialGraphCache::Get().Refresh(Material);
+			Data->SetNumberField(TEXT("node_count"), Snapshot.NodeOrder.Num());
+			Data->SetNumberField(TEXT("texture_count"), Snapshot.TextureSampleCount);
+			Data->SetNumberField(TEXT("graph_version"), Snapshot.Version);
 		}
 	}
 	else if (MaterialInstance)
@@ -6,12 +6,36 @@
 #include "IMessageLogListing.h"
 #include "Logging/TokenizedMessage.h"
 #include "Modules/ModuleManager.h"
+#include "HAL/IConsoleManager.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogUALMessageLog, Log, All);
 
+static TAutoConsoleVariable<int32> CVarMessageLogDebounceMs(
+	TEXT("ual.MessageLogDebounceMs"),
+	200,
+	TEXT("Coalesce message log changes for this many milliseconds before sending messagelog.changed"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMessageLogMaxDelta(
+	TEXT("ual.MessageLogMaxDelta"),
+	500,
+	TEXT("Max messages carried by one messagelog.changed event, older additions are skipped and counted"),
+	ECVF_Default);
+
 // ========== 订阅管理 ==========
-// 存储已订阅的类别及其委托句柄
-static TMap<FName, FDelegateHandle> SubscribedCategories;
+// 每个类别的订阅状态：已推送到第几条、最后一条消息（用于判断列表是否被清空或替换）、事件序号
+struct FUAL_MessageLogSubscription
+{
+	FDelegateHandle Handle;
+	int32 SentCount = 0;
+	TWeakPtr<FTokenizedMessage> SentTail;
+	int64 Sequence = 0;
+	bool bDirty = false;
+	double FirstDirtyTime = 0.0;
+};
+
+static TMap<FName, FUAL_MessageLogSubscription> SubscribedCategories;
+static FTickerHandleType PendingTickerHandle;
 
 void FUAL_MessageLogCommands::RegisterCommands(TMap<FString, FHandlerFunc>& CommandMap)
 {
@@ -34,6 +58,11 @@ void FUAL_MessageLogCommands::RegisterCommands(TMap<FString, FHandlerFunc>& Comm
 	{
 		Handle_Unsubscribe(Payload, RequestId);
 	});
+
+	CommandMap.Add(TEXT("messagelog.resync"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_Resync(Payload, RequestId);
+	});
 }
 
 FString FUAL_MessageLogCommands::SeverityToString(int32 Severity)
@@ -189,40 +218,32 @@ void FUAL_MessageLogCommands::Handle_Subscribe(const TSharedPtr<FJsonObject>& Pa
 	}
 
 	TSharedRef<IMessageLogListing> Listing = MessageLogModule.GetLogListing(CategoryName);
+	const TArray<TSharedRef<FTokenizedMessage>>& Messages = Listing->GetFilteredMessages();
 
-	// 绑定变化事件
-	FDelegateHandle Handle = Listing->OnDataChanged().AddLambda([CategoryName]()
+	// 变化只标记脏并记录时间，合并窗口结束后由 Ticker 统一发送增量
+	FUAL_MessageLogSubscription& Subscription = SubscribedCategories.Add(CategoryName);
+	Subscription.SentCount = Messages.Num();
+	Subscription.SentTail = Messages.Num() > 0 ? TWeakPtr<FTokenizedMessage>(Messages.Last()) : TWeakPtr<FTokenizedMessage>();
+	Subscription.Handle = Listing->OnDataChanged().AddLambda([CategoryName]()
 	{
-		if (!FUAL_NetworkManager::Get().IsConnected())
+		FUAL_MessageLogSubscription* State = SubscribedCategories.Find(CategoryName);
+		if (!State || State->bDirty)
 		{
 			return;
 		}
-
-		FMessageLogModule& Module = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
-		TSharedRef<IMessageLogListing> List = Module.GetLogListing(CategoryName);
-		const TArray<TSharedRef<FTokenizedMessage>>& Msgs = List->GetFilteredMessages();
-
-		TArray<TSharedPtr<FJsonValue>> MsgsArray;
-		int32 Limit = FMath::Min(Msgs.Num(), 50); // 推送最多50条
-		for (int32 i = 0; i < Limit; ++i)
+		State->bDirty = true;
+		State->FirstDirtyTime = FPlatformTime::Seconds();
+		if (!PendingTickerHandle.IsValid())
 		{
-			MsgsArray.Add(MakeShared<FJsonValueObject>(SerializeMessage(Msgs[i])));
+			PendingTickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateStatic(&FUAL_MessageLogCommands::TickPendingChanges), 0.0f);
 		}
-
-		TSharedPtr<FJsonObject> EventPayload = MakeShared<FJsonObject>();
-		EventPayload->SetStringField(TEXT("category"), CategoryName.ToString());
-		EventPayload->SetNumberField(TEXT("count"), MsgsArray.Num());
-		EventPayload->SetArrayField(TEXT("messages"), MsgsArray);
-
-		UAL_CommandUtils::SendEvent(TEXT("messagelog.changed"), EventPayload);
-		UE_LOG(LogUALMessageLog, Log, TEXT("messagelog.changed event sent for %s (%d messages)"), *CategoryName.ToString(), MsgsArray.Num());
 	});
 
-	SubscribedCategories.Add(CategoryName, Handle);
-
 	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
 	Result->SetStringField(TEXT("category"), CategoryStr);
 	Result->SetBoolField(TEXT("subscribed"), true);
+	Result->SetNumberField(TEXT("seq"), (double)Subscription.Sequence);
+	Result->SetNumberField(TEXT("total"), Messages.Num());
 
 	UE_LOG(LogUALMessageLog, Log, TEXT("messagelog.subscribe: subscribed to %s"), *CategoryStr);
 	UAL_CommandUtils::SendResponse(RequestId, 200, Result);
@@ -249,8 +270,8 @@ void FUAL_MessageLogCommands::Handle_Unsubscribe(const TSharedPtr<FJsonObject>&
 	FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
 	TSharedRef<IMessageLogListing> Listing = MessageLogModule.GetLogListing(CategoryName);
 
-	// 解绑委托
-	Listing->OnDataChanged().Remove(SubscribedCategories[CategoryName]);
+	// 解绑委托，未发送的合并变化随订阅一起丢弃
+	Listing->OnDataChanged().Remove(SubscribedCategories[CategoryName].Handle);
 	SubscribedCategories.Remove(CategoryName);
 
 	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -260,3 +281,163 @@ void FUAL_MessageLogCommands::Handle_Unsubscribe(const TSharedPtr<FJsonObject>&
 	UE_LOG(LogUALMessageLog, Log, TEXT("messagelog.unsubscribe: unsubscribed from %s"), *CategoryStr);
 	UAL_CommandUtils::SendResponse(RequestId, 200, Result);
 }
+
+// ========== messagelog.resync ==========
+void FUAL_MessageLogCommands::Handle_Resync(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	FString CategoryStr;
+	if (!Payload->TryGetStringField(TEXT("category"), CategoryStr))
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing field: category"));
+		return;
+	}
+
+	FName CategoryName(*CategoryStr);
+	FUAL_MessageLogSubscription* Subscription = SubscribedCategories.Find(CategoryName);
+	if (!Subscription)
+	{
+		UAL_CommandUtils::SendError(RequestId, 404, FString::Printf(TEXT("Not subscribed to: %s"), *CategoryStr));
+		return;
+	}
+
+	int32 Limit = 1000;
+	Payload->TryGetNumberField(TEXT("limit"), Limit);
+
+	FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
+	TSharedRef<IMessageLogListing> Listing = MessageLogModule.GetLogListing(CategoryName);
+	const TArray<TSharedRef<FTokenizedMessage>>& Messages = Listing->GetFilteredMessages();
+
+	// 返回最后 Limit 条，与增量事件的追加顺序一致
+	const int32 First = FMath::Max(0, Messages.Num() - FMath::Max(0, Limit));
+	TArray<TSharedPtr<FJsonValue>> MessagesArray;
+	MessagesArray.Reserve(Messages.Num() - First);
+	for (int32 i = First; i < Messages.Num(); ++i)
+	{
+		MessagesArray.Add(MakeShared<FJsonValueObject>(SerializeMessage(Messages[i])));
+	}
+
+	// 快照已包含当前全部消息：重置增量基线，待发送的合并变化一并作废
+	Subscription->SentCount = Messages.Num();
+	Subscription->SentTail = Messages.Num() > 0 ? TWeakPtr<FTokenizedMessage>(Messages.Last()) : TWeakPtr<FTokenizedMessage>();
+	Subscription->bDirty = false;
+
+	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetStringField(TEXT("category"), CategoryStr);
+	Result->SetNumberField(TEXT("seq"), (double)Subscription->Sequence);
+	Result->SetNumberField(TEXT("total"), Messages.Num());
+	Result->SetNumberField(TEXT("first_index"), First);
+	Result->SetNumberField(TEXT("count"), MessagesArray.Num());
+	Result->SetArrayField(TEXT("messages"), MessagesArray);
+
+	UE_LOG(LogUALMessageLog, Log, TEXT("messagelog.resync: %s returned %d/%d messages at seq %lld"),
+		*CategoryStr, MessagesArray.Num(), Messages.Num(), Subscription->Sequence);
+	UAL_CommandUtils::SendResponse(RequestId, 200, Result);
+}
+
+// ========== messagelog.changed（合并发送） ==========
+bool FUAL_MessageLogCommands::TickPendingChanges(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double Window = FMath::Max(0, CVarMessageLogDebounceMs.GetValueOnGameThread()) / 1000.0;
+
+	bool bStillPending = false;
+	for (TPair<FName, FUAL_MessageLogSubscription>& Pair : SubscribedCategories)
+	{
+		FUAL_MessageLogSubscription& Subscription = Pair.Value;
+		if (!Subscription.bDirty)
+		{
+			continue;
+		}
+		if (Now - Subscription.FirstDirtyTime < Window)
+		{
+			bStillPending = true;
+			continue;
+		}
+		Subscription.bDirty = false;
+		SendDelta(Pair.Key, Subscription);
+	}
+
+	if (!bStillPending)
+	{
+		PendingTickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FUAL_MessageLogCommands::SendDelta(const FName& CategoryName, FUAL_MessageLogSubscription& Subscription)
+{
+	// 由 SendEvent 发给 WebSocket（断线期间进入重放缓冲）与订阅了该事件的本地客户端
+	FMessageLogModule& Module = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
+	TSharedRef<IMessageLogListing> List = Module.GetLogListing(CategoryName);
+	const TArray<TSharedRef<FTokenizedMessage>>& Msgs = List->GetFilteredMessages();
+
+	// 已发送的最后一条仍在原位置：只追加了新消息；否则列表被清空 / 换页 / 过滤，从头重发
+	bool bReset = true;
+	if (Subscription.SentCount == 0)
+	{
+		bReset = false;
+	}
+	else if (Subscription.SentCount <= Msgs.Num())
+	{
+		const TSharedPtr<FTokenizedMessage> Tail = Subscription.SentTail.Pin();
+		bReset = !Tail.IsValid() || Tail.Get() != &Msgs[Subscription.SentCount - 1].Get();
+	}
+
+	const int32 Begin = bReset ? 0 : Subscription.SentCount;
+	if (!bReset && Begin == Msgs.Num())
+	{
+		// 只有消息内容或状态变化，没有新增
+		return;
+	}
+
+	const int32 MaxDelta = FMath::Max(1, CVarMessageLogMaxDelta.GetValueOnGameThread());
+	const int32 First = FMath::Max(Begin, Msgs.Num() - MaxDelta);
+
+	TArray<TSharedPtr<FJsonValue>> MsgsArray;
+	MsgsArray.Reserve(Msgs.Num() - First);
+	for (int32 i = First; i < Msgs.Num(); ++i)
+	{
+		MsgsArray.Add(MakeShared<FJsonValueObject>(SerializeMessage(Msgs[i])));
+	}
+
+	Subscription.SentCount = Msgs.Num();
+	Subscription.SentTail = Msgs.Num() > 0 ? TWeakPtr<FTokenizedMessage>(Msgs.Last()) : TWeakPtr<FTokenizedMessage>();
+	++Subscription.Sequence;
+
+	TSharedPtr<FJsonObject> EventPayload = MakeShared<FJsonObject>();
+	EventPayload->SetStringField(TEXT("category"), CategoryName.ToString());
+	EventPayload->SetNumberField(TEXT("seq"), (double)Subscription.Sequence);
+	EventPayload->SetBoolField(TEXT("reset"), bReset);
+	EventPayload->SetNumberField(TEXT("first_index"), First);
+	EventPayload->SetNumberField(TEXT("skipped"), First - Begin);
+	EventPayload->SetNumberField(TEXT("total"), Msgs.Num());
+	EventPayload->SetNumberField(TEXT("count"), MsgsArray.Num());
+	EventPayload->SetArrayField(TEXT("messages"), MsgsArray);
+
+	UAL_CommandUtils::SendEvent(TEXT("messagelog.changed"), EventPayload);
+	UE_LOG(LogUALMessageLog, Verbose, TEXT("messagelog.changed seq %lld sent for %s (%d new messages, reset=%d)"),
+		Subscription.Sequence, *CategoryName.ToString(), MsgsArray.Num(), bReset ? 1 : 0);
+}
+
+void FUAL_MessageLogCommands::Shutdown()
+{
+	if (PendingTickerHandle.IsValid())
+	{
+		UAL_CORE_TICKER.RemoveTicker(PendingTickerHandle);
+		PendingTickerHandle.Reset();
+	}
+
+	if (SubscribedCategories.Num() > 0 && FModuleManager::Get().IsModuleLoaded("MessageLog"))
+	{
+		FMessageLogModule& MessageLogModule = FModuleManager::GetModuleChecked<FMessageLogModule>("MessageLog");
+		for (const TPair<FName, FUAL_MessageLogSubscription>& Pair : SubscribedCategories)
+		{
+			if (MessageLogModule.IsRegisteredLogListing(Pair.Key))
+			{
+				MessageLogModule.GetLogListing(Pair.Key)->OnDataChanged().Remove(Pair.Value.Handle);
+			}
+		}
+	}
+	SubscribedCategories.Empty();
+}
@@ -1,5 +1,13 @@
 #include "UAL_SystemCommands.h"
 #include "UAL_CommandUtils.h"
+#include "UAL_NetworkManager.h"
+#include "UAL_LogStore.h"
+#include "UAL_PythonRuntime.h"
+#include "UAL_JobManager.h"
+#include "UAL_AdmissionController.h"
+#include "UAL_ResponseCache.h"
+#include "UAL_LocalServer.h"
+#include "UAL_BulkChannel.h"
 
 #include "IPythonScriptPlugin.h"
 #include "Editor.h"
@@ -33,6 +41,58 @@ extern ENGINE_API float GAverageGPUTime;
 
 DEFINE_LOG_CATEGORY_STATIC(LogUALSystem, Log, All);
 
+namespace
+{
+	/**
+	 * 回复 Python 运行时调用结果：
+	 * ok / result（JSON 值）/ error（traceback）/ logs / timing
+	 */
+	void SendPythonResult(const FString& RequestId, const FUAL_PythonCallResult& CallResult, const TSharedPtr<FJsonObject>& Extra = nullptr)
+	{
+		if (!CallResult.Data.IsValid())
+		{
+			TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+			Data->SetBoolField(TEXT("ok"), false);
+			Data->SetStringField(TEXT("error"), CallResult.Error);
+			if (CallResult.Logs.Num() > 0)
+			{
+				Data->SetArrayField(TEXT("logs"), CallResult.Logs);
+			}
+			UAL_CommandUtils::SendResponse(RequestId, FUAL_PythonRuntime::IsAvailable() ? 500 : 503, Data);
+			return;
+		}
+
+		// 运行时返回的字段原样透传，计时字段归入 timing
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		TSharedPtr<FJsonObject> Timing = MakeShared<FJsonObject>();
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : CallResult.Data->Values)
+		{
+			if (Field.Key.EndsWith(TEXT("_ms")) || Field.Key == TEXT("cache_hit"))
+			{
+				Timing->SetField(Field.Key, Field.Value);
+			}
+			else
+			{
+				Data->SetField(Field.Key, Field.Value);
+			}
+		}
+		Timing->SetNumberField(TEXT("total_ms"), CallResult.TotalMs);
+		Data->SetObjectField(TEXT("timing"), Timing);
+		if (CallResult.Logs.Num() > 0)
+		{
+			Data->SetArrayField(TEXT("logs"), CallResult.Logs);
+		}
+		if (Extra.IsValid())
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Extra->Values)
+			{
+				Data->SetField(Field.Key, Field.Value);
+			}
+		}
+		UAL_CommandUtils::SendResponse(RequestId, CallResult.bSuccess ? 200 : 500, Data);
+	}
+}
+
 void FUAL_SystemCommands::RegisterCommands(TMap<FString, TFunction<void(const TSharedPtr<FJsonObject>&, const FString)>>& CommandMap)
 {
 	CommandMap.Add(TEXT("cmd.run_python"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
@@ -64,6 +124,56 @@ void FUAL_SystemCommands::RegisterCommands(TMap<FString, TFunction<void(const TS
 	{
 		Handle_GetProjectInfo(Payload, RequestId);
 	});
+
+	CommandMap.Add(TEXT("python.register_module"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_PythonRegisterModule(Payload, RequestId);
+	});
+
+	CommandMap.Add(TEXT("python.call"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_PythonCall(Payload, RequestId);
+	});
+
+	CommandMap.Add(TEXT("python.reset_session"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_PythonResetSession(Payload, RequestId);
+	});
+
+	CommandMap.Add(TEXT("python.stats"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_PythonStats(Payload, RequestId);
+	});
+
+	CommandMap.Add(TEXT("job.list"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_ListJobs(Payload, RequestId);
+	});
+
+	CommandMap.Add(TEXT("job.status"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_JobStatus(Payload, RequestId);
+	});
+
+	CommandMap.Add(TEXT("job.cancel"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_CancelJob(Payload, RequestId);
+	});
+
+	CommandMap.Add(TEXT("log.query"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_QueryLog(Payload, RequestId);
+	});
+
+	CommandMap.Add(TEXT("bulk.open"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_BulkOpen(Payload, RequestId);
+	});
+
+	CommandMap.Add(TEXT("bulk.release"), [](const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+	{
+		Handle_BulkRelease(Payload, RequestId);
+	});
 }
 
 // ========== 从 UAL_CommandHandler.cpp 迁移以下函数 ==========
@@ -81,6 +191,17 @@ void FUAL_SystemCommands::Handle_RunPython(const TSharedPtr<FJsonObject>& Payloa
 		return;
 	}
 
+	// 指定会话时走常驻运行时：独立命名空间 + 按脚本哈希缓存字节码
+	FString Session;
+	if (Payload->TryGetStringField(TEXT("session"), Session) && !Session.IsEmpty())
+	{
+		TSharedPtr<FJsonObject> Extra = MakeShared<FJsonObject>();
+		Extra->SetStringField(TEXT("session"), Session);
+		SendPythonResult(RequestId, FUAL_PythonRuntime::Get().Run(Session, Script), Extra);
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	bool bExecuted = false;
 
@@ -120,9 +241,66 @@ void FUAL_SystemCommands::Handle_RunPython(const TSharedPtr<FJsonObject>& Payloa
 #endif
 
 	Data->SetBoolField(TEXT("ok"), bExecuted);
+	Data->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 	UAL_CommandUtils::SendResponse(RequestId, bExecuted ? 200 : 500, Data);
 }
 
+void FUAL_SystemCommands::Handle_PythonRegisterModule(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	FString ModuleName;
+	FString Source;
+	if (!Payload->TryGetStringField(TEXT("name"), ModuleName) || ModuleName.IsEmpty())
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing field: name"));
+		return;
+	}
+	if (!Payload->TryGetStringField(TEXT("source"), Source))
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing field: source"));
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Extra = MakeShared<FJsonObject>();
+	Extra->SetStringField(TEXT("name"), ModuleName);
+	SendPythonResult(RequestId, FUAL_PythonRuntime::Get().RegisterModule(ModuleName, Source), Extra);
+}
+
+void FUAL_SystemCommands::Handle_PythonCall(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	FString Function;
+	if (!Payload->TryGetStringField(TEXT("function"), Function) || Function.IsEmpty())
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing field: function"));
+		return;
+	}
+
+	FString Session = TEXT("default");
+	Payload->TryGetStringField(TEXT("session"), Session);
+
+	TSharedPtr<FJsonObject> Extra = MakeShared<FJsonObject>();
+	Extra->SetStringField(TEXT("function"), Function);
+	SendPythonResult(RequestId, FUAL_PythonRuntime::Get().Call(Session, Function, Payload->TryGetField(TEXT("args"))), Extra);
+}
+
+void FUAL_SystemCommands::Handle_PythonResetSession(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	FString Session;
+	if (!Payload->TryGetStringField(TEXT("session"), Session) || Session.IsEmpty())
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing field: session"));
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Extra = MakeShared<FJsonObject>();
+	Extra->SetStringField(TEXT("session"), Session);
+	SendPythonResult(RequestId, FUAL_PythonRuntime::Get().ResetSession(Session), Extra);
+}
+
+void FUAL_SystemCommands::Handle_PythonStats(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	SendPythonResult(RequestId, FUAL_PythonRuntime::Get().GetStats());
+}
+
 void FUAL_SystemCommands::Handle_ExecConsole(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
 {
 	FString Command;
@@ -201,6 +379,16 @@ void FUAL_SystemCommands::Handle_GetPerformanceStats(const TSharedPtr<FJsonObjec
 	Data->SetNumberField(TEXT("render_thread_ms"), RenderThreadMs);
 	Data->SetNumberField(TEXT("rhi_thread_ms"), RHIMs);
 	Data->SetNumberField(TEXT("gpu_ms"), GPUMs);
+	// 命令准入控制：各类别放行 / 排队 / 拒绝计数
+	Data->SetObjectField(TEXT("admission"), FUAL_AdmissionController::Get().GetStats());
+	// 只读查询响应缓存：命中率与失效次数
+	Data->SetObjectField(TEXT("response_cache"), FUAL_ResponseCache::Get().GetStats());
+	// 与服务端的链路：RTT、重连与收发量
+	Data->SetObjectField(TEXT("link"), FUAL_NetworkManager::Get().GetLinkStats());
+	// 监听模式下的本地客户端
+	Data->SetObjectField(TEXT("local_server"), FUAL_LocalServer::Get().GetStats());
+	// 同机大块数据通道
+	Data->SetObjectField(TEXT("bulk"), FUAL_BulkChannel::Get().GetStats());
 
 	UAL_CommandUtils::SendResponse(RequestId, 200, Data);
 }
@@ -331,3 +519,193 @@ void FUAL_SystemCommands::Handle_GetProjectInfo(const TSharedPtr<FJsonObject>& P
 	
 	UAL_CommandUtils::SendResponse(RequestId, 200, Response);
 }
+
+void FUAL_SystemCommands::Handle_QueryLog(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	FUAL_LogStore::FQuery Query;
+
+	double Number = 0.0;
+	if (Payload->TryGetNumberField(TEXT("since"), Number))
+	{
+		Query.SinceUnixMs = (int64)Number;
+	}
+	if (Payload->TryGetNumberField(TEXT("until"), Number))
+	{
+		Query.UntilUnixMs = (int64)Number;
+	}
+	if (Payload->TryGetNumberField(TEXT("last_seconds"), Number) && Number > 0.0)
+	{
+		const int64 NowMs = (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds();
+		Query.SinceUnixMs = FMath::Max(Query.SinceUnixMs, NowMs - (int64)(Number * 1000.0));
+	}
+	if (Payload->TryGetNumberField(TEXT("before_seq"), Number) && Number > 0.0)
+	{
+		Query.BeforeSeq = (uint32)Number;
+	}
+
+	int32 Limit = 200;
+	Payload->TryGetNumberField(TEXT("limit"), Limit);
+	Query.Limit = FMath::Clamp(Limit, 1, 2000);
+
+	// 分类：category 字符串或 categories 数组
+	FString Category;
+	if (Payload->TryGetStringField(TEXT("category"), Category) && !Category.IsEmpty())
+	{
+		Query.Categories.Add(FName(*Category));
+	}
+	const TArray<TSharedPtr<FJsonValue>>* CategoryArray = nullptr;
+	if (Payload->TryGetArrayField(TEXT("categories"), CategoryArray))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *CategoryArray)
+		{
+			const FString Name = Value.IsValid() ? Value->AsString() : FString();
+			if (!Name.IsEmpty())
+			{
+				Query.Categories.Add(FName(*Name));
+			}
+		}
+	}
+
+	FString Verbosity;
+	if (Payload->TryGetStringField(TEXT("verbosity"), Verbosity) && !Verbosity.IsEmpty())
+	{
+		if (!FUAL_LogStore::ParseVerbosity(Verbosity, Query.MaxVerbosity))
+		{
+			UAL_CommandUtils::SendError(RequestId, 400, FString::Printf(TEXT("Invalid verbosity: %s"), *Verbosity));
+			return;
+		}
+	}
+
+	Payload->TryGetStringField(TEXT("contains"), Query.Contains);
+	Payload->TryGetStringField(TEXT("regex"), Query.Regex);
+	const TArray<TSharedPtr<FJsonValue>>* WordArray = nullptr;
+	if (Payload->TryGetArrayField(TEXT("words"), WordArray))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *WordArray)
+		{
+			const FString Word = Value.IsValid() ? Value->AsString() : FString();
+			if (!Word.IsEmpty())
+			{
+				Query.Words.Add(Word);
+			}
+		}
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	FUAL_LogStore::FQueryResult Result = FUAL_LogStore::Get().Query(Query);
+	const double QueryMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	TArray<TSharedPtr<FJsonValue>> EntryArray;
+	EntryArray.Reserve(Result.Entries.Num());
+	for (const FUAL_LogStore::FResultEntry& Entry : Result.Entries)
+	{
+		TSharedPtr<FJsonObject> EntryObj = MakeShared<FJsonObject>();
+		EntryObj->SetNumberField(TEXT("seq"), Entry.Seq);
+		EntryObj->SetNumberField(TEXT("time"), (double)Entry.UnixMs);
+		EntryObj->SetStringField(TEXT("category"), Entry.Category.ToString());
+		EntryObj->SetStringField(TEXT("level"), FUAL_LogStore::VerbosityToString(Entry.Verbosity));
+		EntryObj->SetStringField(TEXT("text"), Entry.Text);
+		EntryArray.Add(MakeShared<FJsonValueObject>(EntryObj));
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetArrayField(TEXT("entries"), EntryArray);
+	Data->SetNumberField(TEXT("count"), EntryArray.Num());
+	Data->SetBoolField(TEXT("has_more"), Result.bHasMore);
+	if (Result.bHasMore && Result.Entries.Num() > 0)
+	{
+		Data->SetNumberField(TEXT("next_before_seq"), Result.Entries[0].Seq);
+	}
+	Data->SetNumberField(TEXT("scanned"), Result.Scanned);
+	Data->SetStringField(TEXT("index"), Result.IndexUsed);
+	Data->SetNumberField(TEXT("query_ms"), QueryMs);
+
+	TSharedPtr<FJsonObject> StoreStats = MakeShared<FJsonObject>();
+	FUAL_LogStore::Get().WriteStats(StoreStats);
+	Data->SetObjectField(TEXT("store"), StoreStats);
+
+	UAL_CommandUtils::SendResponse(RequestId, 200, Data);
+}
+
+void FUAL_SystemCommands::Handle_ListJobs(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	bool bIncludeFinished = false;
+	Payload->TryGetBoolField(TEXT("include_finished"), bIncludeFinished);
+
+	const TArray<TSharedPtr<FJsonValue>> Jobs = FUAL_JobManager::Get().ListJobs(bIncludeFinished);
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetArrayField(TEXT("jobs"), Jobs);
+	Data->SetNumberField(TEXT("count"), Jobs.Num());
+	UAL_CommandUtils::SendResponse(RequestId, 200, Data);
+}
+
+void FUAL_SystemCommands::Handle_JobStatus(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	FString JobId;
+	if (!Payload->TryGetStringField(TEXT("job_id"), JobId) || JobId.IsEmpty())
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing field: job_id"));
+		return;
+	}
+
+	const TSharedPtr<FJsonObject> Job = FUAL_JobManager::Get().DescribeJob(JobId, true);
+	if (!Job.IsValid())
+	{
+		UAL_CommandUtils::SendError(RequestId, 404, FString::Printf(TEXT("Job not found: %s"), *JobId));
+		return;
+	}
+	UAL_CommandUtils::SendResponse(RequestId, 200, Job);
+}
+
+void FUAL_SystemCommands::Handle_CancelJob(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	FString JobId;
+	if (!Payload->TryGetStringField(TEXT("job_id"), JobId) || JobId.IsEmpty())
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing field: job_id"));
+		return;
+	}
+
+	if (!FUAL_JobManager::Get().Cancel(JobId))
+	{
+		// 已结束的任务返回 409，便于客户端区分
+		const bool bKnown = FUAL_JobManager::Get().DescribeJob(JobId, false).IsValid();
+		UAL_CommandUtils::SendError(RequestId, bKnown ? 409 : 404,
+			FString::Printf(bKnown ? TEXT("Job already finished: %s") : TEXT("Job not found: %s"), *JobId));
+		return;
+	}
+
+	UAL_CommandUtils::SendResponse(RequestId, 200, FUAL_JobManager::Get().DescribeJob(JobId, false));
+}
+
+void FUAL_SystemCommands::Handle_BulkOpen(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	UAL_CommandUtils::SendResponse(RequestId, 200, FUAL_BulkChannel::Get().Open());
+}
+
+void FUAL_SystemCommands::Handle_BulkRelease(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Ids = nullptr;
+	if (!Payload->TryGetArrayField(TEXT("ids"), Ids))
+	{
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing field: ids"));
+		return;
+	}
+
+	// 已过期或重复释放的句柄不算错误，只在结果中计数
+	int32 ReleasedCount = 0;
+	for (const TSharedPtr<FJsonValue>& Value : *Ids)
+	{
+		double Id = 0.0;
+		if (Value.IsValid() && Value->TryGetNumber(Id) && Id > 0.0 && FUAL_BulkChannel::Get().Release((uint64)Id))
+		{
+			++ReleasedCount;
+		}
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetNumberField(TEXT("released"), ReleasedCount);
+	Data->SetNumberField(TEXT("unknown"), Ids->Num() - ReleasedCount);
+	UAL_CommandUtils::SendResponse(RequestId, 200, Data);
+}
@@ -44,11 +44,8 @@
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
 
-// Rendering (for Preview)
-#include "Slate/WidgetRenderer.h"
-#include "Engine/TextureRenderTarget2D.h"
-#include "IImageWrapperModule.h"
-#include "IImageWrapper.h"
+// Preview
+#include "UAL_WidgetPreviewService.h"
 #include "Misc/FileHelper.h"
 #include "HAL/PlatformFileManager.h"
 
@@ -1281,105 +1278,117 @@ void FUAL_WidgetCommands::Handle_AddChild(const TSharedPtr<FJsonObject>& Payload
 void FUAL_WidgetCommands::Handle_Preview(const TSharedPtr<FJsonObject>& Payload, const FString RequestId)
 {
 #if WITH_EDITOR
+	// path（单个）或 paths（批量）二选一
+	TArray<FString> Paths;
 	FString Path;
-	if (!Payload->TryGetStringField(TEXT("path"), Path))
+	const bool bSingle = Payload->TryGetStringField(TEXT("path"), Path);
+	if (bSingle)
 	{
-		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing required field: path"));
-		return;
+		Paths.Add(Path);
 	}
-	
-	int32 Width = 1920;
-	int32 Height = 1080;
-	Payload->TryGetNumberField(TEXT("width"), Width);
-	Payload->TryGetNumberField(TEXT("height"), Height);
-	
-	FString Error;
-	UWidgetBlueprint* WidgetBP = LoadWidgetBlueprint(Path, Error);
-	if (!WidgetBP)
+	else
 	{
-		UAL_CommandUtils::SendError(RequestId, 404, Error);
-		return;
+		const TArray<TSharedPtr<FJsonValue>>* PathValues = nullptr;
+		if (Payload->TryGetArrayField(TEXT("paths"), PathValues))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *PathValues)
+			{
+				FString Item;
+				if (Value.IsValid() && Value->TryGetString(Item) && !Item.IsEmpty())
+				{
+					Paths.Add(Item);
+				}
+			}
+		}
 	}
-	
-	// 编译蓝图确保最新
-	FKismetEditorUtilities::CompileBlueprint(WidgetBP);
-	
-	// 获取生成类
-	UClass* WidgetClass = WidgetBP->GeneratedClass;
-	if (!WidgetClass || !WidgetClass->IsChildOf(UUserWidget::StaticClass()))
+
+	if (Paths.Num() == 0)
 	{
-		UAL_CommandUtils::SendError(RequestId, 500, TEXT("Widget Blueprint has no valid generated class"));
+		UAL_CommandUtils::SendError(RequestId, 400, TEXT("Missing required field: path or paths"));
 		return;
 	}
 	
-	// 创建临时 Widget 实例
-	UWorld* PreviewWorld = GEditor->GetEditorWorldContext().World();
-	if (!PreviewWorld)
+	int32 Width = 1920;
+	int32 Height = 1080;
+	Payload->TryGetNumberField(TEXT("width"), Width);
+	Payload->TryGetNumberField(TEXT("height"), Height);
+	Width = FMath::Clamp(Width, 1, 8192);
+	Height = FMath::Clamp(Height, 1, 8192);
+
+	bool bLayoutOnly = false;
+	FString Mode;
+	if (Payload->TryGetStringField(TEXT("mode"), Mode))
 	{
-		UAL_CommandUtils::SendError(RequestId, 500, TEXT("No editor world available for preview"));
-		return;
+		bLayoutOnly = Mode.Equals(TEXT("layout"), ESearchCase::IgnoreCase);
 	}
+
+	bool bBulk = false;
+	Payload->TryGetBoolField(TEXT("bulk"), bBulk);
 	
-	UUserWidget* TempWidget = CreateWidget<UUserWidget>(PreviewWorld, WidgetClass);
-	if (!TempWidget)
+	TArray<FUAL_WidgetPreviewJob> Jobs;
+	for (const FString& AssetPath : Paths)
 	{
-		UAL_CommandUtils::SendError(RequestId, 500, TEXT("Failed to create widget instance for preview"));
-		return;
+		FString Error;
+		UWidgetBlueprint* WidgetBP = LoadWidgetBlueprint(AssetPath, Error);
+		if (!WidgetBP && bSingle)
+		{
+			UAL_CommandUtils::SendError(RequestId, 404, Error);
+			return;
+		}
+
+		// 批量模式下加载失败的条目由服务回填错误结果，保持结果顺序与请求一致
+		FUAL_WidgetPreviewJob& Job = Jobs.AddDefaulted_GetRef();
+		Job.WidgetBlueprint = WidgetBP;
+		Job.AssetPath = AssetPath;
+		Job.Size = FIntPoint(Width, Height);
+		Job.bLayoutOnly = bLayoutOnly;
+		Job.bBulk = bBulk;
 	}
-	
-	// 强制布局计算
-	TempWidget->ForceLayoutPrepass();
-	
-	// 使用 FWidgetRenderer 渲染到 RenderTarget
-	FWidgetRenderer WidgetRenderer(true);
-	
-	UTextureRenderTarget2D* RenderTarget = NewObject<UTextureRenderTarget2D>();
-	RenderTarget->InitAutoFormat(Width, Height);
-	RenderTarget->UpdateResourceImmediate();
-	
-	WidgetRenderer.DrawWidget(RenderTarget, TempWidget->TakeWidget(), FVector2D(Width, Height), 0.0f);
-	
-	// 保存到文件
-	FString OutputDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Screenshots/UAL"));
-	IFileManager::Get().MakeDirectory(*OutputDir, true);
-	
-	FString Filename = FString::Printf(TEXT("widget_preview_%s_%lld.png"), 
-		*FPaths::GetBaseFilename(Path), FDateTime::Now().GetTicks());
-	FString OutputPath = FPaths::Combine(OutputDir, Filename);
-	
-	// 读取像素数据
-	TArray<FColor> Bitmap;
-	FTextureRenderTargetResource* RTResource = RenderTarget->GameThread_GetRenderTargetResource();
-	if (RTResource && RTResource->ReadPixels(Bitmap))
+
+	const double StartTime = FPlatformTime::Seconds();
+	FUAL_WidgetPreviewService::Get().Submit(MoveTemp(Jobs), [RequestId, bSingle, StartTime](const TArray<TSharedPtr<FJsonObject>>& Results)
 	{
-		// 保存为 PNG
-		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
-		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-		
-		if (ImageWrapper->SetRaw(Bitmap.GetData(), Bitmap.Num() * sizeof(FColor), Width, Height, ERGBFormat::BGRA, 8))
+		const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		if (bSingle)
 		{
-			const TArray64<uint8>& PNGData = ImageWrapper->GetCompressed();
-			if (PNGData.Num() > 0)
+			TSharedPtr<FJsonObject> Result = Results[0];
+			if (!Result->GetBoolField(TEXT("ok")))
 			{
-				FFileHelper::SaveArrayToFile(PNGData, *OutputPath);
+				UAL_CommandUtils::SendError(RequestId, 500, Result->GetStringField(TEXT("error")));
+				return;
 			}
+			Result->SetNumberField(TEXT("elapsed_ms"), ElapsedMs);
+			UE_LOG(LogUALWidget, Log, TEXT("widget.preview: path=%s, mode=%s"),
+				*Result->GetStringField(TEXT("asset")), *Result->GetStringField(TEXT("mode")));
+			UAL_CommandUtils::SendResponse(RequestId, 200, Result);
+			return;
 		}
-	}
-	
-	// 清理临时实例
-	TempWidget->RemoveFromParent();
-	TempWidget->ConditionalBeginDestroy();
-	
-	// 返回结果
-	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-	Result->SetBoolField(TEXT("ok"), true);
-	Result->SetStringField(TEXT("path"), OutputPath);
-	Result->SetNumberField(TEXT("width"), Width);
-	Result->SetNumberField(TEXT("height"), Height);
-	
-	UE_LOG(LogUALWidget, Log, TEXT("widget.preview: path=%s, output=%s"), *Path, *OutputPath);
-	
-	UAL_CommandUtils::SendResponse(RequestId, 200, Result);
+
+		int32 Succeeded = 0;
+		TArray<TSharedPtr<FJsonValue>> ResultValues;
+		for (const TSharedPtr<FJsonObject>& Result : Results)
+		{
+			if (Result->GetBoolField(TEXT("ok")))
+			{
+				++Succeeded;
+			}
+			ResultValues.Add(MakeShared<FJsonValueObject>(Result));
+		}
+
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetBoolField(TEXT("ok"), Succeeded == Results.Num());
+		Data->SetNumberField(TEXT("count"), Results.Num());
+		Data->SetNumberField(TEXT("succeeded"), Succeeded);
+		Data->SetNumberField(TEXT("failed"), Results.Num() - Succeeded);
+		Data->SetNumberField(TEXT("elapsed_ms"), ElapsedMs);
+		Data->SetArrayField(TEXT("results"), ResultValues);
+		Data->SetObjectField(TEXT("stats"), FUAL_WidgetPreviewService::Get().GetStatsJson());
+
+		UE_LOG(LogUALWidget, Log, TEXT("widget.preview: batch of %d finished (%d ok) in %.0f ms"),
+			Results.Num(), Succeeded, ElapsedMs);
+		UAL_CommandUtils::SendResponse(RequestId, 200, Data);
+	});
 #else
 	UAL_CommandUtils::SendError(RequestId, 501, TEXT("widget.preview is only available in editor mode"));
 #endif
@@ -9,10 +9,26 @@
 #include "HAL/PlatformProcess.h"
 #include "ToolMenus.h"
 #include "UAL_NetworkManager.h"
+#include "UAL_LocalServer.h"
 #include "UAL_CommandHandler.h"
 #include "UAL_LogInterceptor.h"
 #include "UAL_ContentBrowserExt.h"
 #include "UAL_LevelViewportExt.h"
+#include "UAL_PropertyPathCache.h"
+#include "UAL_BlueprintCompileScheduler.h"
+#include "UAL_CaptureStream.h"
+#include "UAL_WidgetPreviewService.h"
+#include "UAL_MaterialGraphCache.h"
+#include "UAL_MaterialCompileScheduler.h"
+#include "UAL_MaterialCatalog.h"
+#include "UAL_TextureSettingsBatch.h"
+#include "UAL_LogStore.h"
+#include "UAL_MessageLogCommands.h"
+#include "UAL_PythonRuntime.h"
+#include "UAL_JobManager.h"
+#include "UAL_AdmissionController.h"
+#include "UAL_ResponseCache.h"
+#include "UAL_BulkChannel.h"
 #include "Async/Async.h"
 #include "Containers/Ticker.h"
 #include "Serialization/JsonWriter.h"
@@ -57,6 +73,10 @@ void FUnrealAgentLinkModule::StartupModule()
 	FUAL_NetworkManager::Get().OnConnected().AddRaw(this, &FUnrealAgentLinkModule::HandleSocketConnected);
 	FUAL_NetworkManager::Get().Init(DefaultUrl);
 
+	// 监听模式：ual.LocalServerPort 非 0 时本地工具可直接连接编辑器
+	FUAL_LocalServer::Get().OnMessageReceived().AddRaw(this, &FUnrealAgentLinkModule::HandleLocalMessage);
+	FUAL_LocalServer::Get().Init();
+
 	// 注册内容浏览器菜单扩展
 	if (ContentBrowserExt)
 	{
@@ -108,7 +128,11 @@ void FUnrealAgentLinkModule::ShutdownModule()
 
 	FUAL_NetworkManager::Get().OnMessageReceived().RemoveAll(this);
 	FUAL_NetworkManager::Get().OnConnected().RemoveAll(this);
+	FUAL_CaptureStream::Get().Shutdown();
+	// 队列中未编译的蓝图以 Cancelled 回复挂起的请求，需在断开连接前执行
+	FUAL_BlueprintCompileScheduler::Get().Shutdown();
 	FUAL_NetworkManager::Get().Shutdown();
+	FUAL_LocalServer::Get().Shutdown();
 
 	if (GLog && LogInterceptor.IsValid())
 	{
@@ -117,6 +141,20 @@ void FUnrealAgentLinkModule::ShutdownModule()
 	LogInterceptor.Reset();
 	CommandHandler.Reset();
 
+	FUAL_PropertyPathCache::Get().Shutdown();
+	FUAL_WidgetPreviewService::Get().Shutdown();
+	FUAL_MaterialGraphCache::Get().Shutdown();
+	FUAL_MaterialCompileScheduler::Get().Shutdown();
+	FUAL_MaterialCatalog::Get().Shutdown();
+	FUAL_TextureSettingsBatch::Get().Shutdown();
+	FUAL_LogStore::Get().Shutdown();
+	FUAL_MessageLogCommands::Shutdown();
+	FUAL_PythonRuntime::Get().Shutdown();
+	FUAL_JobManager::Get().Shutdown();
+	FUAL_AdmissionController::Get().Shutdown();
+	FUAL_ResponseCache::Get().Shutdown();
+	FUAL_BulkChannel::Get().Shutdown();
+
 	if (ContentBrowserExt)
 	{
 		ContentBrowserExt->Unregister();
@@ -182,6 +220,15 @@ void FUnrealAgentLinkModule::HandleSocketMessage(const FString& Data)
 	);
 }
 
+void FUnrealAgentLinkModule::HandleLocalMessage(const FString& Data, int32 ClientId)
+{
+	// 本地客户端消息由 Ticker 回调触发，已处于正常 Tick 上下文，直接处理
+	if (CommandHandler)
+	{
+		CommandHandler->ProcessMessage(Data, ClientId);
+	}
+}
+
 void FUnrealAgentLinkModule::HandleSocketConnected()
 {
 	// 同样使用 Ticker 切回 GameThread，保持一致性
@@ -209,7 +256,8 @@ void FUnrealAgentLinkModule::HandleSocketConnected()
 			const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutJson);
 			FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
 
-			FUAL_NetworkManager::Get().SendMessage(OutJson);
+			// 每次连接都会重新发送当前项目信息，无需重放
+			FUAL_NetworkManager::Get().SendMessage(OutJson, false);
 			return false; // 只执行一次
 		}),
 		0.0f
@@ -1,84 +1,363 @@
+
 #include "UAL_LogInterceptor.h"
 
 #include "UAL_NetworkManager.h"
+#include "UAL_LocalServer.h"
+#include "UAL_LogStore.h"
 
-#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
 #include "Logging/LogVerbosity.h"
+#include "Misc/DateTime.h"
 #include "Misc/OutputDeviceHelper.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Serialization/JsonWriter.h"
-#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 #include "HAL/IConsoleManager.h"
 
-/**
- * 将日志级别转换为字符串（跨版本兼容）
- * 
- * 使用手动映射方式，避免不同UE版本间FLogVerbosity API差异
- */
-static FString UALVerbosityToString(ELogVerbosity::Type Verbosity)
+// 控制台变量开关，默认关闭日志转发，需手动开启：ual.ForwardLogs 1
+static TAutoConsoleVariable<int32> CVarForwardLogs(
+	TEXT("ual.ForwardLogs"),
+	0,
+	TEXT("Forward UE logs to Unreal Box (0=off, 1=on)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarForwardLogsVerbosity(
+	TEXT("ual.ForwardLogsVerbosity"),
+	ELogVerbosity::VeryVerbose,
+	TEXT("Forward only logs at or above this verbosity (1=Fatal, 2=Error, 3=Warning, 4=Display, 5=Log, 6=Verbose, 7=VeryVerbose)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<FString> CVarForwardLogsCategories(
+	TEXT("ual.ForwardLogsCategories"),
+	TEXT(""),
+	TEXT("Comma separated log categories to forward (empty = all)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<FString> CVarForwardLogsExcludeCategories(
+	TEXT("ual.ForwardLogsExcludeCategories"),
+	TEXT(""),
+	TEXT("Comma separated log categories never forwarded"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarForwardLogsRateLimit(
+	TEXT("ual.ForwardLogsRateLimit"),
+	500,
+	TEXT("Max forwarded log lines per second, extra lines are dropped and counted (0 = unlimited)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarForwardLogsFlushMs(
+	TEXT("ual.ForwardLogsFlushMs"),
+	100,
+	TEXT("Interval in milliseconds between batched log.entries messages"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarForwardLogsBufferSize(
+	TEXT("ual.ForwardLogsBufferSize"),
+	8192,
+	TEXT("Log forwarding ring buffer capacity (rounded up to a power of two, read at startup)"),
+	ECVF_ReadOnly);
+
+namespace
+{
+	// 单批最多发送的条数，避免一次消息过大
+	constexpr int32 UALMaxEntriesPerBatch = 2048;
+}
+
+FUAL_LogInterceptor::FUAL_LogInterceptor()
 {
-	switch (Verbosity)
+	Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max(256, CVarForwardLogsBufferSize.GetValueOnAnyThread()));
+	Slots = MakeUnique<FSlot[]>(Capacity);
+	for (uint64 Index = 0; Index < Capacity; ++Index)
 	{
-	case ELogVerbosity::Fatal:       return TEXT("Fatal");
-	case ELogVerbosity::Error:       return TEXT("Error");
-	case ELogVerbosity::Warning:     return TEXT("Warning");
-	case ELogVerbosity::Display:     return TEXT("Display");
-	case ELogVerbosity::Log:         return TEXT("Log");
-	case ELogVerbosity::Verbose:     return TEXT("Verbose");
-	case ELogVerbosity::VeryVerbose: return TEXT("VeryVerbose");
-	default:                         return TEXT("Unknown");
+		Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+	}
+
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("UAL_LogFlusher"), 0, TPri_BelowNormal);
+}
+
+FUAL_LogInterceptor::~FUAL_LogInterceptor()
+{
+	Shutdown();
+}
+
+void FUAL_LogInterceptor::Shutdown()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+	if (WakeEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+	}
+}
+
+void FUAL_LogInterceptor::Stop()
+{
+	bStopping = true;
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
 	}
 }
 
 void FUAL_LogInterceptor::Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category)
 {
-	// 控制台变量开关，默认关闭日志转发，需手动开启：ual.ForwardLogs 1
-	static TAutoConsoleVariable<int32> CVarForwardLogs(
-		TEXT("ual.ForwardLogs"),
-		0,
-		TEXT("Forward UE logs to Unreal Box (0=off, 1=on)"),
-		ECVF_Default);
+	if (!bIsCaptureEnabled)
+	{
+		return;
+	}
 
-	if (!bIsCaptureEnabled || CVarForwardLogs.GetValueOnAnyThread() == 0)
+	const bool bStoreEnabled = FUAL_LogStore::IsEnabled();
+	const bool bForwardEnabled = CVarForwardLogs.GetValueOnAnyThread() != 0;
+	if (!bStoreEnabled && !bForwardEnabled)
 	{
 		return;
 	}
 
-	// 避免将网络层自身的日志再次发出去，造成递归与卡死
+	const ELogVerbosity::Type Level = (ELogVerbosity::Type)(Verbosity & ELogVerbosity::VerbosityMask);
+	const bool bStore = bStoreEnabled && Level <= FUAL_LogStore::GetMaxVerbosity();
+
+	// 避免将网络层自身的日志再次发出去，造成递归与卡死（本地存储不受影响）
+	// 是否有接收方（WebSocket / 本地客户端）由后台线程在 Flush 时判断：这里可能在任意线程、任意锁内调用，不能加锁
 	static const FName NetworkLogCategory(TEXT("LogUALNetwork"));
-	if (Category == NetworkLogCategory)
+	const bool bForward = bForwardEnabled
+		&& Category != NetworkLogCategory
+		&& Level <= CVarForwardLogsVerbosity.GetValueOnAnyThread();
+
+	if (!bStore && !bForward)
 	{
 		return;
 	}
 
-	// 未连接时直接丢弃日志，避免无网时不停重入 SendMessage
-	if (!FUAL_NetworkManager::Get().IsConnected())
+	if (!TryEnqueue(V, Level, Category, bStore, bForward))
 	{
-		return;
+		OverflowDrops.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+bool FUAL_LogInterceptor::TryEnqueue(const TCHAR* Text, ELogVerbosity::Type Verbosity, const FName& Category, bool bStore, bool bForward)
+{
+	// 有界多生产者队列：每个槽位的序号表示其可写 / 可读状态，生产者只通过 CAS 抢占位置
+	uint64 Pos = EnqueuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		FSlot& Slot = Slots[Pos & (Capacity - 1)];
+		const uint64 Sequence = Slot.Sequence.load(std::memory_order_acquire);
+		const int64 Diff = (int64)Sequence - (int64)Pos;
+		if (Diff == 0)
+		{
+			if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+			{
+				Slot.Text = Text;
+				Slot.Category = Category;
+				Slot.Verbosity = Verbosity;
+				Slot.Time = FPlatformTime::Seconds();
+				Slot.bStore = bStore;
+				Slot.bForward = bForward;
+				Slot.Sequence.store(Pos + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (Diff < 0)
+		{
+			// 缓冲区已满
+			return false;
+		}
+		else
+		{
+			Pos = EnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+bool FUAL_LogInterceptor::TryDequeue(FEntry& OutEntry)
+{
+	FSlot& Slot = Slots[DequeuePos & (Capacity - 1)];
+	if (Slot.Sequence.load(std::memory_order_acquire) != DequeuePos + 1)
+	{
+		return false;
+	}
+
+	OutEntry.Text = MoveTemp(Slot.Text);
+	OutEntry.Category = Slot.Category;
+	OutEntry.Verbosity = Slot.Verbosity;
+	OutEntry.Time = Slot.Time;
+	OutEntry.bStore = Slot.bStore;
+	OutEntry.bForward = Slot.bForward;
+	Slot.Sequence.store(DequeuePos + Capacity, std::memory_order_release);
+	++DequeuePos;
+	return true;
+}
+
+uint32 FUAL_LogInterceptor::Run()
+{
+	LastRefillTime = FPlatformTime::Seconds();
+	while (!bStopping)
+	{
+		WakeEvent->Wait(FMath::Max(10, CVarForwardLogsFlushMs.GetValueOnAnyThread()));
+		if (!bStopping)
+		{
+			Flush();
+		}
 	}
+	return 0;
+}
 
-	const FString Message = FString(V);
-	const FString CategoryName = Category.ToString();
-	const FString VerbosityName = UALVerbosityToString(Verbosity);
+void FUAL_LogInterceptor::RefreshCategoryFilters()
+{
+	auto Parse = [](const FString& Source, TSet<FName>& OutSet)
+	{
+		OutSet.Reset();
+		TArray<FString> Parts;
+		Source.ParseIntoArray(Parts, TEXT(","), true);
+		for (const FString& Part : Parts)
+		{
+			const FString Trimmed = Part.TrimStartAndEnd();
+			if (!Trimmed.IsEmpty())
+			{
+				OutSet.Add(FName(*Trimmed));
+			}
+		}
+	};
 
-	AsyncTask(ENamedThreads::GameThread, [Message, CategoryName, VerbosityName]()
+	const FString Include = CVarForwardLogsCategories.GetValueOnAnyThread();
+	if (Include != IncludeCategoriesSource)
+	{
+		IncludeCategoriesSource = Include;
+		Parse(Include, IncludeCategories);
+	}
+	const FString Exclude = CVarForwardLogsExcludeCategories.GetValueOnAnyThread();
+	if (Exclude != ExcludeCategoriesSource)
 	{
-		TSharedPtr<FJsonObject> Payload = MakeShared<FJsonObject>();
-		Payload->SetStringField(TEXT("text"), Message);
-		Payload->SetStringField(TEXT("category"), CategoryName);
-		Payload->SetStringField(TEXT("level"), VerbosityName);
+		ExcludeCategoriesSource = Exclude;
+		Parse(Exclude, ExcludeCategories);
+	}
+}
 
-		TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-		Root->SetStringField(TEXT("ver"), TEXT("1.0"));
-		Root->SetStringField(TEXT("type"), TEXT("evt"));
-		Root->SetStringField(TEXT("method"), TEXT("log.entry"));
-		Root->SetObjectField(TEXT("payload"), Payload);
+void FUAL_LogInterceptor::Flush()
+{
+	RefreshCategoryFilters();
 
-		FString OutJson;
-		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutJson);
-		FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+	// 令牌桶：每秒补充 RateLimit 个，最多积累 1 秒的量
+	const int32 RateLimit = CVarForwardLogsRateLimit.GetValueOnAnyThread();
+	const double Now = FPlatformTime::Seconds();
+	if (RateLimit > 0)
+	{
+		RateTokens = FMath::Min((double)RateLimit, RateTokens + (Now - LastRefillTime) * RateLimit);
+	}
+	LastRefillTime = Now;
 
-		FUAL_NetworkManager::Get().SendMessage(OutJson);
-	});
+	// 按接收方分别决定：WebSocket 已连接，或有已握手的本地客户端
+	const bool bConnected = FUAL_NetworkManager::Get().IsConnected();
+	const bool bHasLocalClients = FUAL_LocalServer::Get().HasClients();
+	const bool bHasSink = bConnected || bHasLocalClients;
+
+	// 每次最多取出一整圈，本地存储需要完整日志，不能像转发那样只取一批
+	TArray<FUAL_LogStore::FIncoming> StoreBatch;
+	TArray<FEntry> Batch;
+	FEntry Entry;
+	for (uint64 Drained = 0; Drained < Capacity && TryDequeue(Entry); ++Drained)
+	{
+		if (Entry.bStore)
+		{
+			FUAL_LogStore::FIncoming& Stored = StoreBatch.AddDefaulted_GetRef();
+			Stored.Text = Entry.bForward ? Entry.Text : MoveTemp(Entry.Text);
+			Stored.Category = Entry.Category;
+			Stored.Time = Entry.Time;
+			Stored.Verbosity = Entry.Verbosity;
+		}
+
+		if (!Entry.bForward || !bHasSink)
+		{
+			continue;
+		}
+		if (IncludeCategories.Num() > 0 && !IncludeCategories.Contains(Entry.Category))
+		{
+			continue;
+		}
+		if (ExcludeCategories.Contains(Entry.Category))
+		{
+			continue;
+		}
+		if (RateLimit > 0)
+		{
+			if (RateTokens < 1.0)
+			{
+				++RateLimitedDrops;
+				continue;
+			}
+			RateTokens -= 1.0;
+		}
+		Batch.Add(MoveTemp(Entry));
+		if (Batch.Num() >= UALMaxEntriesPerBatch)
+		{
+			SendBatch(Batch, Now, bConnected, bHasLocalClients);
+			Batch.Reset();
+		}
+	}
+
+	FUAL_LogStore::Get().AddBatch(StoreBatch);
+
+	const uint64 Overflow = OverflowDrops.load(std::memory_order_relaxed);
+	const bool bHasNewDrops = Overflow != ReportedOverflowDrops || RateLimitedDrops != ReportedRateLimitedDrops;
+	if (bHasSink && (Batch.Num() > 0 || bHasNewDrops))
+	{
+		SendBatch(Batch, Now, bConnected, bHasLocalClients);
+	}
 }
 
+void FUAL_LogInterceptor::SendBatch(const TArray<FEntry>& Batch, double Now, bool bToServer, bool bToLocalClients)
+{
+	const uint64 Overflow = OverflowDrops.load(std::memory_order_relaxed);
+	const uint64 NewOverflow = Overflow - ReportedOverflowDrops;
+	const uint64 NewRateLimited = RateLimitedDrops - ReportedRateLimitedDrops;
+	ReportedOverflowDrops = Overflow;
+	ReportedRateLimitedDrops = RateLimitedDrops;
+
+	// 入队时记录的是单调时钟，换算为 Unix 毫秒
+	const double UnixNowMs = (double)(FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds();
+
+	FString OutJson;
+	OutJson.Reserve(128 + Batch.Num() * 160);
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutJson);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("ver"), TEXT("1.0"));
+	Writer->WriteValue(TEXT("type"), TEXT("evt"));
+	Writer->WriteValue(TEXT("method"), TEXT("log.entries"));
+	Writer->WriteObjectStart(TEXT("payload"));
+	Writer->WriteArrayStart(TEXT("entries"));
+	for (const FEntry& Item : Batch)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("time"), FMath::RoundToDouble(UnixNowMs - (Now - Item.Time) * 1000.0));
+		Writer->WriteValue(TEXT("category"), Item.Category.ToString());
+		Writer->WriteValue(TEXT("level"), FUAL_LogStore::VerbosityToString(Item.Verbosity));
+		Writer->WriteValue(TEXT("text"), Item.Text);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteValue(TEXT("dropped_overflow"), (double)NewOverflow);
+	Writer->WriteValue(TEXT("dropped_rate_limited"), (double)NewRateLimited);
+	Writer->WriteValue(TEXT("dropped_total"), (double)(Overflow + RateLimitedDrops));
+	Writer->WriteObjectEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	// 断线期间的日志不进入重放缓冲（可通过 log.query 补查）
+	if (bToServer)
+	{
+		FUAL_NetworkManager::Get().SendMessage(OutJson, false);
+	}
+	if (bToLocalClients)
+	{
+		FUAL_LocalServer::Get().BroadcastEvent(TEXT("log.entries"), OutJson);
+	}
+}
@@ -0,0 +1,436 @@
+#include "UAL_BulkChannel.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <Windows.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALBulk, Log, All);
+
+static TAutoConsoleVariable<int32> CVarBulkChannel(
+	TEXT("ual.BulkChannel"),
+	1,
+	TEXT("Allow large binary results to be returned through the same-host shared memory channel when a request asks for it"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarBulkChannelMB(
+	TEXT("ual.BulkChannelMB"),
+	64,
+	TEXT("Size of the shared memory region in MB (read when the region is created)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarBulkLeaseSec(
+	TEXT("ual.BulkLeaseSec"),
+	30.0f,
+	TEXT("Seconds before an unreleased bulk block may be overwritten (shared memory) or deleted (file fallback)"),
+	ECVF_Default);
+
+namespace
+{
+	constexpr uint32 UALBulkVersion = 1;
+	constexpr int64 UALBulkHeaderBytes = 64;
+	constexpr int64 UALBulkBlockHeaderBytes = 32;
+	constexpr int64 UALBulkAlignment = 64;
+
+	// 头部 / 块头的魔数（小端读出为 "UALB" / "UALK"）
+	constexpr uint32 UALBulkRegionMagic = 'U' | ('A' << 8) | ('L' << 16) | ('B' << 24);
+	constexpr uint32 UALBulkBlockMagic = 'U' | ('A' << 8) | ('L' << 16) | ('K' << 24);
+
+	FString GetFallbackDir()
+	{
+		return FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UAL/Bulk")));
+	}
+}
+
+FUAL_BulkChannel& FUAL_BulkChannel::Get()
+{
+	static FUAL_BulkChannel Instance;
+	return Instance;
+}
+
+bool FUAL_BulkChannel::IsEnabled()
+{
+	return CVarBulkChannel.GetValueOnAnyThread() != 0;
+}
+
+// ============================================================================
+// 共享内存区
+// ============================================================================
+
+bool FUAL_BulkChannel::EnsureRegion()
+{
+	if (RegionBase)
+	{
+		return true;
+	}
+	if (bRegionFailed)
+	{
+		return false;
+	}
+
+	const int64 Size = (int64)FMath::Clamp(CVarBulkChannelMB.GetValueOnAnyThread(), 1, 4096) * 1024 * 1024;
+	const uint32 Pid = FPlatformProcess::GetCurrentProcessId();
+	const FString BaseName = FString::Printf(TEXT("UAL_Bulk_%u"), Pid);
+
+#if PLATFORM_WINDOWS
+	// 引擎的 MapNamedSharedMemoryRegion 在 Windows 上使用 Global\ 命名空间，普通权限无法创建，这里直接使用会话内的 Local\ 命名空间
+	const FString Name = FString::Printf(TEXT("Local\\%s"), *BaseName);
+	HANDLE Mapping = ::CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+		(DWORD)((uint64)Size >> 32), (DWORD)((uint64)Size & 0xFFFFFFFF), *Name);
+	void* Address = Mapping ? ::MapViewOfFile(Mapping, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)Size) : nullptr;
+	if (!Address)
+	{
+		UE_LOG(LogUALBulk, Warning, TEXT("Failed to create shared memory %s (error %u), falling back to temp files"), *Name, ::GetLastError());
+		if (Mapping)
+		{
+			::CloseHandle(Mapping);
+		}
+		bRegionFailed = true;
+		return false;
+	}
+	RegionHandle = Mapping;
+	RegionBase = static_cast<uint8*>(Address);
+#else
+	// Unix / Mac 上对应 shm_open("/" + 名称)
+	const FString Name = FString::Printf(TEXT("/%s"), *BaseName);
+	FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(BaseName, true,
+		static_cast<uint32>(FPlatformMemory::ESharedMemoryAccess::Read) | static_cast<uint32>(FPlatformMemory::ESharedMemoryAccess::Write),
+		(SIZE_T)Size);
+	if (!Region || !Region->GetAddress())
+	{
+		UE_LOG(LogUALBulk, Warning, TEXT("Failed to create shared memory %s, falling back to temp files"), *Name);
+		if (Region)
+		{
+			FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+		}
+		bRegionFailed = true;
+		return false;
+	}
+	RegionHandle = Region;
+	RegionBase = static_cast<uint8*>(Region->GetAddress());
+#endif
+
+	RegionName = Name;
+	RegionSize = Size;
+
+	uint8 Header[UALBulkHeaderBytes] = {};
+	const uint64 RegionSize64 = (uint64)Size;
+	const uint64 DataOffset = (uint64)UALBulkHeaderBytes;
+	FMemory::Memcpy(Header + 0, &UALBulkRegionMagic, 4);
+	FMemory::Memcpy(Header + 4, &UALBulkVersion, 4);
+	FMemory::Memcpy(Header + 8, &RegionSize64, 8);
+	FMemory::Memcpy(Header + 16, &DataOffset, 8);
+	FMemory::Memcpy(Header + 24, &Pid, 4);
+	FMemory::Memcpy(RegionBase, Header, UALBulkHeaderBytes);
+
+	UE_LOG(LogUALBulk, Log, TEXT("Bulk channel ready: %s (%lld MB)"), *RegionName, Size / (1024 * 1024));
+	return true;
+}
+
+void FUAL_BulkChannel::CloseRegion()
+{
+	if (!RegionBase)
+	{
+		return;
+	}
+
+#if PLATFORM_WINDOWS
+	::UnmapViewOfFile(RegionBase);
+	::CloseHandle(static_cast<HANDLE>(RegionHandle));
+#else
+	FPlatformMemory::UnmapNamedSharedMemoryRegion(static_cast<FPlatformMemory::FSharedMemoryRegion*>(RegionHandle));
+#endif
+
+	RegionHandle = nullptr;
+	RegionBase = nullptr;
+	RegionSize = 0;
+	Blocks.Reset();
+}
+
+// ============================================================================
+// 分配与回收
+// ============================================================================
+
+void FUAL_BulkChannel::Reclaim(double Now)
+{
+	int32 NumFree = 0;
+	while (NumFree < Blocks.Num() && (Blocks[NumFree].bReleased || Blocks[NumFree].ExpireTime <= Now))
+	{
+		if (!Blocks[NumFree].bReleased)
+		{
+			++Expired;
+		}
+		++NumFree;
+	}
+	if (NumFree > 0)
+	{
+		Blocks.RemoveAt(0, NumFree, false);
+	}
+
+	for (int32 Index = FileBlocks.Num() - 1; Index >= 0; --Index)
+	{
+		if (FileBlocks[Index].ExpireTime <= Now)
+		{
+			IFileManager::Get().Delete(*FileBlocks[Index].Path, false, false, true);
+			FileBlocks.RemoveAtSwap(Index, 1, false);
+			++Expired;
+		}
+	}
+}
+
+bool FUAL_BulkChannel::Allocate(int64 Need, int64& OutOffset) const
+{
+	const int64 Capacity = RegionSize - UALBulkHeaderBytes;
+	if (Need > Capacity)
+	{
+		return false;
+	}
+
+	if (Blocks.Num() == 0)
+	{
+		OutOffset = 0;
+		return true;
+	}
+
+	// 占用区间为 [Tail, Head)，最新的块位于最旧的块之前时说明已绕回
+	const int64 Tail = Blocks[0].Offset;
+	const int64 Head = Blocks.Last().Offset + Blocks.Last().AllocSize;
+	const bool bWrapped = Blocks.Last().Offset < Tail;
+
+	if (!bWrapped)
+	{
+		if (Capacity - Head >= Need)
+		{
+			OutOffset = Head;
+			return true;
+		}
+		if (Tail >= Need)
+		{
+			OutOffset = 0;
+			return true;
+		}
+		return false;
+	}
+
+	if (Tail - Head >= Need)
+	{
+		OutOffset = Head;
+		return true;
+	}
+	return false;
+}
+
+TSharedPtr<FJsonObject> FUAL_BulkChannel::Publish(const uint8* Data, int64 Size, const FString& ContentType)
+{
+	if (!IsEnabled() || !Data || Size <= 0)
+	{
+		return nullptr;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const float LeaseSec = FMath::Max(1.0f, CVarBulkLeaseSec.GetValueOnAnyThread());
+	uint64 Id = 0;
+	{
+		FScopeLock Lock(&Mutex);
+		Reclaim(Now);
+		Id = ++NextId;
+
+		if (EnsureRegion())
+		{
+			const int64 Need = Align(UALBulkBlockHeaderBytes + Size, UALBulkAlignment);
+			int64 Offset = 0;
+			if (!Allocate(Need, Offset))
+			{
+				// 未释放的块占满了区域：不覆盖客户端可能仍在读取的数据
+				++Rejected;
+				UE_LOG(LogUALBulk, Verbose, TEXT("Bulk channel full, rejected %lld bytes"), Size);
+				return nullptr;
+			}
+
+			uint8* Block = RegionBase + UALBulkHeaderBytes + Offset;
+			FMemory::Memcpy(Block + UALBulkBlockHeaderBytes, Data, Size);
+
+			// 块头最后写入：读者看到匹配的 id 时数据已完整
+			uint8 BlockHeader[UALBulkBlockHeaderBytes] = {};
+			const uint64 Size64 = (uint64)Size;
+			FMemory::Memcpy(BlockHeader + 0, &UALBulkBlockMagic, 4);
+			FMemory::Memcpy(BlockHeader + 8, &Id, 8);
+			FMemory::Memcpy(BlockHeader + 16, &Size64, 8);
+			FPlatformMisc::MemoryBarrier();
+			FMemory::Memcpy(Block, BlockHeader, UALBulkBlockHeaderBytes);
+
+			FBlock& Entry = Blocks.AddDefaulted_GetRef();
+			Entry.Id = Id;
+			Entry.Offset = Offset;
+			Entry.AllocSize = Need;
+			Entry.ExpireTime = Now + LeaseSec;
+
+			++Published;
+			PublishedBytes += Size;
+
+			TSharedPtr<FJsonObject> Handle = MakeShared<FJsonObject>();
+			Handle->SetStringField(TEXT("kind"), TEXT("shm"));
+			Handle->SetStringField(TEXT("name"), RegionName);
+			Handle->SetNumberField(TEXT("region_size"), (double)RegionSize);
+			Handle->SetNumberField(TEXT("id"), (double)Id);
+			Handle->SetNumberField(TEXT("offset"), (double)(UALBulkHeaderBytes + Offset + UALBulkBlockHeaderBytes));
+			Handle->SetNumberField(TEXT("size"), (double)Size);
+			Handle->SetStringField(TEXT("content_type"), ContentType);
+			Handle->SetNumberField(TEXT("lease_ms"), FMath::RoundToDouble(LeaseSec * 1000.0));
+			return Handle;
+		}
+	}
+
+	// 写文件放在锁外，避免阻塞其他线程的发布与释放
+	return PublishToFile(Id, Data, Size, ContentType);
+}
+
+TSharedPtr<FJsonObject> FUAL_BulkChannel::PublishToFile(uint64 Id, const uint8* Data, int64 Size, const FString& ContentType)
+{
+	const FString Dir = GetFallbackDir();
+	IFileManager::Get().MakeDirectory(*Dir, true);
+	const FString Path = FPaths::Combine(Dir, FString::Printf(TEXT("%u_%llu.bin"), FPlatformProcess::GetCurrentProcessId(), Id));
+	if (!FFileHelper::SaveArrayToFile(TArrayView<const uint8>(Data, (int32)Size), *Path))
+	{
+		UE_LOG(LogUALBulk, Warning, TEXT("Failed to write bulk fallback file %s"), *Path);
+		FScopeLock Lock(&Mutex);
+		++Rejected;
+		return nullptr;
+	}
+
+	const float LeaseSec = FMath::Max(1.0f, CVarBulkLeaseSec.GetValueOnAnyThread());
+	{
+		FScopeLock Lock(&Mutex);
+		FFileBlock& Entry = FileBlocks.AddDefaulted_GetRef();
+		Entry.Id = Id;
+		Entry.Path = Path;
+		Entry.Size = Size;
+		Entry.ExpireTime = FPlatformTime::Seconds() + LeaseSec;
+		++Published;
+		++FileFallbacks;
+		PublishedBytes += Size;
+	}
+
+	TSharedPtr<FJsonObject> Handle = MakeShared<FJsonObject>();
+	Handle->SetStringField(TEXT("kind"), TEXT("file"));
+	Handle->SetStringField(TEXT("path"), Path);
+	Handle->SetNumberField(TEXT("id"), (double)Id);
+	Handle->SetNumberField(TEXT("offset"), 0);
+	Handle->SetNumberField(TEXT("size"), (double)Size);
+	Handle->SetStringField(TEXT("content_type"), ContentType);
+	Handle->SetNumberField(TEXT("lease_ms"), FMath::RoundToDouble(LeaseSec * 1000.0));
+	return Handle;
+}
+
+bool FUAL_BulkChannel::Release(uint64 Id)
+{
+	FScopeLock Lock(&Mutex);
+
+	bool bFound = false;
+	for (FBlock& Block : Blocks)
+	{
+		if (Block.Id == Id && !Block.bReleased)
+		{
+			Block.bReleased = true;
+			bFound = true;
+			break;
+		}
+	}
+
+	if (!bFound)
+	{
+		for (int32 Index = 0; Index < FileBlocks.Num(); ++Index)
+		{
+			if (FileBlocks[Index].Id == Id)
+			{
+				IFileManager::Get().Delete(*FileBlocks[Index].Path, false, false, true);
+				FileBlocks.RemoveAtSwap(Index, 1, false);
+				bFound = true;
+				break;
+			}
+		}
+	}
+
+	if (bFound)
+	{
+		++Released;
+	}
+	Reclaim(FPlatformTime::Seconds());
+	return bFound;
+}
+
+// ============================================================================
+// 查询
+// ============================================================================
+
+TSharedPtr<FJsonObject> FUAL_BulkChannel::Open()
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField(TEXT("enabled"), IsEnabled());
+	Obj->SetNumberField(TEXT("pid"), FPlatformProcess::GetCurrentProcessId());
+	Obj->SetNumberField(TEXT("lease_sec"), FMath::Max(1.0f, CVarBulkLeaseSec.GetValueOnAnyThread()));
+
+	FScopeLock Lock(&Mutex);
+	if (IsEnabled() && EnsureRegion())
+	{
+		Obj->SetStringField(TEXT("kind"), TEXT("shm"));
+		Obj->SetStringField(TEXT("name"), RegionName);
+		Obj->SetNumberField(TEXT("region_size"), (double)RegionSize);
+		Obj->SetNumberField(TEXT("version"), UALBulkVersion);
+		Obj->SetNumberField(TEXT("header_bytes"), UALBulkHeaderBytes);
+		Obj->SetNumberField(TEXT("block_header_bytes"), UALBulkBlockHeaderBytes);
+		Obj->SetNumberField(TEXT("alignment"), UALBulkAlignment);
+	}
+	else
+	{
+		Obj->SetStringField(TEXT("kind"), TEXT("file"));
+		Obj->SetStringField(TEXT("dir"), GetFallbackDir());
+	}
+	return Obj;
+}
+
+TSharedPtr<FJsonObject> FUAL_BulkChannel::GetStats() const
+{
+	FScopeLock Lock(&Mutex);
+
+	int64 UsedBytes = 0;
+	int32 Live = 0;
+	for (const FBlock& Block : Blocks)
+	{
+		UsedBytes += Block.AllocSize;
+		Live += Block.bReleased ? 0 : 1;
+	}
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField(TEXT("enabled"), IsEnabled());
+	Obj->SetStringField(TEXT("kind"), RegionBase ? TEXT("shm") : (bRegionFailed ? TEXT("file") : TEXT("none")));
+	Obj->SetNumberField(TEXT("region_size"), (double)RegionSize);
+	Obj->SetNumberField(TEXT("used_bytes"), (double)UsedBytes);
+	Obj->SetNumberField(TEXT("live_blocks"), Live + FileBlocks.Num());
+	Obj->SetNumberField(TEXT("published"), (double)Published);
+	Obj->SetNumberField(TEXT("published_bytes"), (double)PublishedBytes);
+	Obj->SetNumberField(TEXT("released"), (double)Released);
+	Obj->SetNumberField(TEXT("expired"), (double)Expired);
+	Obj->SetNumberField(TEXT("file_fallbacks"), (double)FileFallbacks);
+	Obj->SetNumberField(TEXT("rejected"), (double)Rejected);
+	return Obj;
+}
+
+void FUAL_BulkChannel::Shutdown()
+{
+	FScopeLock Lock(&Mutex);
+	CloseRegion();
+	for (const FFileBlock& File : FileBlocks)
+	{
+		IFileManager::Get().Delete(*File.Path, false, false, true);
+	}
+	FileBlocks.Empty();
+}
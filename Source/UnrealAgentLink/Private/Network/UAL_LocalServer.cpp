@@ -0,0 +1,696 @@
+#include "UAL_LocalServer.h"
+#include "UAL_CommandUtils.h"
+
+#include "Common/TcpListener.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALLocalServer, Log, All);
+
+static void OnLocalServerConfigChanged(IConsoleVariable* Var)
+{
+	FUAL_LocalServer::Get().ApplyConfig();
+}
+
+static TAutoConsoleVariable<int32> CVarLocalServerPort(
+	TEXT("ual.LocalServerPort"),
+	0,
+	TEXT("TCP port of the in-editor listen server for local tools (newline-delimited JSON); 0 disables it"),
+	FConsoleVariableDelegate::CreateStatic(&OnLocalServerConfigChanged),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLocalServerAllowRemote(
+	TEXT("ual.LocalServerAllowRemote"),
+	0,
+	TEXT("Bind the listen server to all interfaces instead of 127.0.0.1 (takes effect on restart of the listener); clients still need the token from Saved/UnrealAgentLink/LocalServerToken.txt"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLocalServerMaxClients(
+	TEXT("ual.LocalServerMaxClients"),
+	8,
+	TEXT("Maximum number of concurrently connected local clients"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLocalServerMaxPendingKB(
+	TEXT("ual.LocalServerMaxPendingKB"),
+	65536,
+	TEXT("Disconnect a local client whose unsent data exceeds this size in KB (client not reading)"),
+	ECVF_Default);
+
+namespace
+{
+	const TCHAR* const UALRoutedIdPrefix = TEXT("@c");
+
+	// 单条消息上限，超出视为协议错误并断开
+	constexpr int32 UALMaxMessageBytes = 64 * 1024 * 1024;
+	// 每个客户端每帧最多读取的数据量，避免单个客户端占满一帧
+	constexpr int32 UALMaxRecvBytesPerTick = 4 * 1024 * 1024;
+	// 握手前允许的最大消息长度，未认证的客户端不能让编辑器缓存大块数据
+	constexpr int32 UALMaxHandshakeBytes = 4 * 1024;
+
+	FString GetTokenFilePath()
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealAgentLink"), TEXT("LocalServerToken.txt"));
+	}
+}
+
+FUAL_LocalServer& FUAL_LocalServer::Get()
+{
+	static FUAL_LocalServer Instance;
+	return Instance;
+}
+
+// ============================================================================
+// 启停
+// ============================================================================
+
+void FUAL_LocalServer::Init()
+{
+	bInitialized = true;
+	ApplyConfig();
+}
+
+void FUAL_LocalServer::ApplyConfig()
+{
+	// 配置文件中的控制台变量可能早于模块启动生效，此时只记录
+	if (!bInitialized)
+	{
+		return;
+	}
+
+	const int32 Port = FMath::Clamp(CVarLocalServerPort.GetValueOnGameThread(), 0, 65535);
+	if ((Port > 0) == IsRunning() && Port == ListenPort)
+	{
+		return;
+	}
+
+	Stop();
+	if (Port > 0)
+	{
+		Start(Port);
+	}
+}
+
+void FUAL_LocalServer::Start(int32 Port)
+{
+	const bool bAllowRemote = CVarLocalServerAllowRemote.GetValueOnGameThread() != 0;
+	const FIPv4Endpoint Endpoint(bAllowRemote ? FIPv4Address::Any : FIPv4Address(127, 0, 0, 1), Port);
+
+	// 每次启动监听生成新令牌，写入 Saved 目录；客户端必须先用它完成 client.hello 握手
+	Token = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	const FString TokenFile = GetTokenFilePath();
+	if (!FFileHelper::SaveStringToFile(Token, *TokenFile))
+	{
+		UE_LOG(LogUALLocalServer, Error, TEXT("Failed to write the local server token to %s, not listening"), *TokenFile);
+		Token.Reset();
+		ListenPort = Port;
+		return;
+	}
+
+	// 自行创建监听 Socket：绑定失败（端口被占用）可以立即发现
+	ListenSocket = FTcpSocketBuilder(TEXT("UAL local server"))
+		.AsReusable()
+		.BoundToEndpoint(Endpoint)
+		.Listening(8)
+		.Build();
+	if (!ListenSocket)
+	{
+		UE_LOG(LogUALLocalServer, Error, TEXT("Failed to listen on %s"), *Endpoint.ToString());
+		ListenPort = Port;
+		return;
+	}
+
+	Listener = MakeUnique<FTcpListener>(*ListenSocket, FTimespan::FromMilliseconds(100));
+	Listener->OnConnectionAccepted().BindRaw(this, &FUAL_LocalServer::HandleConnectionAccepted);
+	ListenPort = Port;
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_LocalServer::Tick), 0.0f);
+	}
+
+	UE_LOG(LogUALLocalServer, Display, TEXT("Listening for local clients on %s (handshake token in %s)"),
+		*Endpoint.ToString(), *FPaths::ConvertRelativePathToFull(TokenFile));
+}
+
+void FUAL_LocalServer::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		UAL_CORE_TICKER.RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	// 先停监听线程，再销毁监听 Socket
+	Listener.Reset();
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (ListenSocket)
+	{
+		ListenSocket->Close();
+		SocketSubsystem->DestroySocket(ListenSocket);
+		ListenSocket = nullptr;
+	}
+
+	{
+		FScopeLock Lock(&AcceptMutex);
+		for (const TPair<FSocket*, FString>& Pending : PendingAccepts)
+		{
+			Pending.Key->Close();
+			SocketSubsystem->DestroySocket(Pending.Key);
+		}
+		PendingAccepts.Empty();
+	}
+
+	FScopeLock Lock(&ClientsMutex);
+	for (const TPair<int32, TSharedPtr<FClient>>& Pair : Clients)
+	{
+		CloseClient(*Pair.Value);
+	}
+	Clients.Empty();
+	ListenPort = 0;
+
+	if (!Token.IsEmpty())
+	{
+		IFileManager::Get().Delete(*GetTokenFilePath(), false, false, true);
+		Token.Reset();
+	}
+}
+
+void FUAL_LocalServer::Shutdown()
+{
+	bInitialized = false;
+	Stop();
+	MessageReceivedDelegate.Clear();
+}
+
+bool FUAL_LocalServer::HandleConnectionAccepted(FSocket* Socket, const FIPv4Endpoint& Endpoint)
+{
+	FScopeLock Lock(&AcceptMutex);
+	PendingAccepts.Emplace(Socket, Endpoint.ToString());
+	return true;
+}
+
+// ============================================================================
+// 路由 ID
+// ============================================================================
+
+FString FUAL_LocalServer::MakeRoutedId(int32 ClientId, const FString& RequestId)
+{
+	// 无 ID 的请求不需要响应，保持为空
+	if (RequestId.IsEmpty())
+	{
+		return RequestId;
+	}
+	return FString::Printf(TEXT("%s%d/%s"), UALRoutedIdPrefix, ClientId, *RequestId);
+}
+
+bool FUAL_LocalServer::ParseRoutedId(const FString& RoutedId, int32& OutClientId, FString& OutRequestId)
+{
+	if (!RoutedId.StartsWith(UALRoutedIdPrefix, ESearchCase::CaseSensitive))
+	{
+		return false;
+	}
+
+	int32 SlashIndex = INDEX_NONE;
+	if (!RoutedId.FindChar(TEXT('/'), SlashIndex))
+	{
+		return false;
+	}
+
+	const FString ClientPart = RoutedId.Mid(2, SlashIndex - 2);
+	if (ClientPart.IsEmpty() || !ClientPart.IsNumeric())
+	{
+		return false;
+	}
+
+	OutClientId = FCString::Atoi(*ClientPart);
+	OutRequestId = RoutedId.Mid(SlashIndex + 1);
+	return true;
+}
+
+// ============================================================================
+// 收发
+// ============================================================================
+
+bool FUAL_LocalServer::Tick(float DeltaTime)
+{
+	TArray<TPair<FSocket*, FString>> Accepted;
+	{
+		FScopeLock Lock(&AcceptMutex);
+		Accepted = MoveTemp(PendingAccepts);
+		PendingAccepts.Reset();
+	}
+
+	TArray<TPair<int32, FString>> Messages;
+	{
+		FScopeLock Lock(&ClientsMutex);
+
+		for (const TPair<FSocket*, FString>& Pending : Accepted)
+		{
+			FSocket* Socket = Pending.Key;
+			if (Clients.Num() >= FMath::Max(1, CVarLocalServerMaxClients.GetValueOnGameThread()))
+			{
+				++ClientsRejected;
+				UE_LOG(LogUALLocalServer, Warning, TEXT("Rejected local client %s: too many clients"), *Pending.Value);
+				Socket->Close();
+				ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+				continue;
+			}
+
+			Socket->SetNonBlocking(true);
+			Socket->SetNoDelay(true);
+
+			TSharedPtr<FClient> Client = MakeShared<FClient>();
+			Client->Id = NextClientId++;
+			Client->Socket = Socket;
+			Client->Address = Pending.Value;
+			Client->ConnectedTime = FPlatformTime::Seconds();
+			Client->Subscriptions.Add(TEXT("*"));
+			Clients.Add(Client->Id, Client);
+			++ClientsAccepted;
+
+			UE_LOG(LogUALLocalServer, Log, TEXT("Local client %d connected from %s"), Client->Id, *Client->Address);
+
+			AppendFrame(*Client, FString::Printf(
+				TEXT("{\"ver\":\"1.0\",\"type\":\"evt\",\"method\":\"client.welcome\",\"payload\":{\"client_id\":%d,\"project\":\"%s\"}}"),
+				Client->Id, FApp::GetProjectName()));
+		}
+
+		for (auto It = Clients.CreateIterator(); It; ++It)
+		{
+			FClient& Client = *It.Value();
+			if (!Client.bClosing)
+			{
+				TArray<TPair<int32, FString>> ClientMessages;
+				ReceiveFrom(Client, ClientMessages);
+				for (TPair<int32, FString>& Message : ClientMessages)
+				{
+					// 握手完成前的消息一律不进入命令分发
+					if (Client.bAuthenticated)
+					{
+						Messages.Add(MoveTemp(Message));
+					}
+					else if (!Client.bClosing)
+					{
+						HandleHandshake(Client, Message.Value);
+					}
+				}
+			}
+			if (!Client.bClosing)
+			{
+				FlushClient(Client);
+			}
+			if (Client.bClosing)
+			{
+				UE_LOG(LogUALLocalServer, Log, TEXT("Local client %d disconnected (in %lld / out %lld messages)"),
+					Client.Id, Client.MessagesIn, Client.MessagesOut);
+				CloseClient(Client);
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	// 在锁外分发：命令处理中会回复客户端
+	for (const TPair<int32, FString>& Message : Messages)
+	{
+		MessageReceivedDelegate.Broadcast(Message.Value, Message.Key);
+	}
+	return true;
+}
+
+void FUAL_LocalServer::ReceiveFrom(FClient& Client, TArray<TPair<int32, FString>>& OutMessages)
+{
+	uint8 Chunk[16 * 1024];
+	int32 TotalRead = 0;
+	while (TotalRead < UALMaxRecvBytesPerTick)
+	{
+		int32 BytesRead = 0;
+		if (!Client.Socket->Recv(Chunk, sizeof(Chunk), BytesRead))
+		{
+			// 流式 Socket：返回 false 表示对端关闭或出错（无数据可读时返回 true 且读到 0 字节）
+			Client.bClosing = true;
+			break;
+		}
+		if (BytesRead <= 0)
+		{
+			break;
+		}
+		TotalRead += BytesRead;
+		Client.BytesIn += BytesRead;
+
+		const int32 ScanStart = Client.RecvBuffer.Num();
+		Client.RecvBuffer.Append(Chunk, BytesRead);
+
+		int32 LineStart = 0;
+		for (int32 Index = ScanStart; Index < Client.RecvBuffer.Num(); ++Index)
+		{
+			if (Client.RecvBuffer[Index] != '\n')
+			{
+				continue;
+			}
+
+			int32 LineEnd = Index;
+			if (LineEnd > LineStart && Client.RecvBuffer[LineEnd - 1] == '\r')
+			{
+				--LineEnd;
+			}
+			if (LineEnd > LineStart)
+			{
+				const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Client.RecvBuffer.GetData() + LineStart), LineEnd - LineStart);
+				OutMessages.Emplace(Client.Id, FString(Converted.Length(), Converted.Get()));
+				++Client.MessagesIn;
+			}
+			LineStart = Index + 1;
+		}
+		if (LineStart > 0)
+		{
+			Client.RecvBuffer.RemoveAt(0, LineStart);
+		}
+
+		const int32 MaxMessageBytes = Client.bAuthenticated ? UALMaxMessageBytes : UALMaxHandshakeBytes;
+		if (Client.RecvBuffer.Num() > MaxMessageBytes)
+		{
+			UE_LOG(LogUALLocalServer, Warning, TEXT("Local client %d sent a message larger than %d bytes without newline, disconnecting"),
+				Client.Id, MaxMessageBytes);
+			Client.bClosing = true;
+			break;
+		}
+	}
+}
+
+void FUAL_LocalServer::HandleHandshake(FClient& Client, const FString& Message)
+{
+	TSharedPtr<FJsonObject> Root;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+	FString Method, RequestId, ClientToken;
+	if (FJsonSerializer::Deserialize(Reader, Root) && Root.IsValid())
+	{
+		Root->TryGetStringField(TEXT("method"), Method);
+		Root->TryGetStringField(TEXT("id"), RequestId);
+		const TSharedPtr<FJsonObject>* Params = nullptr;
+		if (Root->TryGetObjectField(TEXT("params"), Params))
+		{
+			(*Params)->TryGetStringField(TEXT("token"), ClientToken);
+		}
+	}
+
+	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetStringField(TEXT("ver"), TEXT("1.0"));
+	Response->SetStringField(TEXT("type"), TEXT("res"));
+	Response->SetStringField(TEXT("id"), RequestId);
+
+	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+	const bool bAccepted = Method == TEXT("client.hello") && !Token.IsEmpty() && ClientToken.Equals(Token, ESearchCase::CaseSensitive);
+	if (bAccepted)
+	{
+		Client.bAuthenticated = true;
+		Response->SetNumberField(TEXT("code"), 200);
+		Result->SetNumberField(TEXT("client_id"), Client.Id);
+		Result->SetStringField(TEXT("project"), FApp::GetProjectName());
+	}
+	else
+	{
+		Response->SetNumberField(TEXT("code"), 401);
+		Result->SetStringField(TEXT("message"), Method == TEXT("client.hello")
+			? TEXT("Invalid token")
+			: TEXT("Send client.hello with the token from Saved/UnrealAgentLink/LocalServerToken.txt first"));
+	}
+	Response->SetObjectField(TEXT("result"), Result);
+
+	FString OutputString;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutputString);
+	FJsonSerializer::Serialize(Response.ToSharedRef(), Writer);
+	AppendFrame(Client, OutputString);
+
+	if (bAccepted)
+	{
+		UE_LOG(LogUALLocalServer, Log, TEXT("Local client %d authenticated"), Client.Id);
+		return;
+	}
+
+	// 握手失败直接断开：先尽量把 401 发出去
+	++ClientsRejected;
+	UE_LOG(LogUALLocalServer, Warning, TEXT("Local client %d from %s failed the handshake (method=%s), disconnecting"),
+		Client.Id, *Client.Address, *Method);
+	FlushClient(Client);
+	Client.bClosing = true;
+}
+
+void FUAL_LocalServer::AppendFrame(FClient& Client, const FString& Json)
+{
+	// 序列化结果中字符串内的换行已转义，裸换行只是缩进，去掉后即为单行 JSON
+	const FTCHARToUTF8 Utf8(*Json, Json.Len());
+	const uint8* Src = reinterpret_cast<const uint8*>(Utf8.Get());
+	int32 Newlines = 0;
+	for (int32 Index = 0; Index < Utf8.Length(); ++Index)
+	{
+		Newlines += (Src[Index] == '\n' || Src[Index] == '\r') ? 1 : 0;
+	}
+
+	const int32 Start = Client.SendBuffer.Num();
+	Client.SendBuffer.AddUninitialized(Utf8.Length() - Newlines + 1);
+	uint8* Dest = Client.SendBuffer.GetData() + Start;
+	for (int32 Index = 0; Index < Utf8.Length(); ++Index)
+	{
+		if (Src[Index] != '\n' && Src[Index] != '\r')
+		{
+			*Dest++ = Src[Index];
+		}
+	}
+	*Dest = '\n';
+	++Client.MessagesOut;
+
+	if (Client.SendBuffer.Num() > (int64)FMath::Max(1, CVarLocalServerMaxPendingKB.GetValueOnAnyThread()) * 1024)
+	{
+		UE_LOG(LogUALLocalServer, Warning, TEXT("Local client %d is not reading (%d bytes pending), disconnecting"),
+			Client.Id, Client.SendBuffer.Num());
+		Client.bClosing = true;
+	}
+}
+
+void FUAL_LocalServer::FlushClient(FClient& Client)
+{
+	while (Client.SendBuffer.Num() > 0)
+	{
+		int32 BytesSent = 0;
+		if (!Client.Socket->Send(Client.SendBuffer.GetData(), Client.SendBuffer.Num(), BytesSent))
+		{
+			const ESocketErrors Error = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+			if (Error != SE_EWOULDBLOCK)
+			{
+				Client.bClosing = true;
+			}
+			return;
+		}
+		if (BytesSent <= 0)
+		{
+			return;
+		}
+		Client.BytesOut += BytesSent;
+		Client.SendBuffer.RemoveAt(0, BytesSent, false);
+	}
+}
+
+void FUAL_LocalServer::CloseClient(FClient& Client)
+{
+	if (Client.Socket)
+	{
+		Client.Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Client.Socket);
+		Client.Socket = nullptr;
+	}
+	Client.bClosing = true;
+}
+
+void FUAL_LocalServer::SendToClient(int32 ClientId, const FString& Json)
+{
+	FScopeLock Lock(&ClientsMutex);
+	const TSharedPtr<FClient>* Client = Clients.Find(ClientId);
+	if (!Client || (*Client)->bClosing || !(*Client)->bAuthenticated)
+	{
+		UE_LOG(LogUALLocalServer, Verbose, TEXT("Drop message for disconnected local client %d"), ClientId);
+		return;
+	}
+	AppendFrame(**Client, Json);
+	FlushClient(**Client);
+}
+
+bool FUAL_LocalServer::MatchesSubscription(const FClient& Client, const FString& Method)
+{
+	for (const FString& Pattern : Client.Subscriptions)
+	{
+		if (Pattern == TEXT("*") || Pattern == Method)
+		{
+			return true;
+		}
+		// "job.*" 匹配 job.progress / job.completed
+		if (Pattern.EndsWith(TEXT(".*")) && Method.StartsWith(Pattern.LeftChop(1), ESearchCase::CaseSensitive))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FUAL_LocalServer::HasClients() const
+{
+	FScopeLock Lock(&ClientsMutex);
+	for (const TPair<int32, TSharedPtr<FClient>>& Pair : Clients)
+	{
+		if (Pair.Value->bAuthenticated && !Pair.Value->bClosing)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FUAL_LocalServer::BroadcastEvent(const FString& Method, const FString& Json)
+{
+	FScopeLock Lock(&ClientsMutex);
+	for (const TPair<int32, TSharedPtr<FClient>>& Pair : Clients)
+	{
+		FClient& Client = *Pair.Value;
+		if (!Client.bClosing && Client.bAuthenticated && MatchesSubscription(Client, Method))
+		{
+			AppendFrame(Client, Json);
+			FlushClient(Client);
+		}
+	}
+}
+
+// ============================================================================
+// 客户端控制命令
+// ============================================================================
+
+bool FUAL_LocalServer::HandleClientRequest(int32 ClientId, const FString& Method, const TSharedPtr<FJsonObject>& Params, const FString& RoutedId)
+{
+	const bool bSubscribe = Method == TEXT("client.subscribe");
+	const bool bUnsubscribe = Method == TEXT("client.unsubscribe");
+	// 握手由 Tick 处理，已认证后重复的 client.hello 按 client.info 回复
+	const bool bInfo = Method == TEXT("client.info") || Method == TEXT("client.hello");
+	if (!bSubscribe && !bUnsubscribe && !bInfo)
+	{
+		return false;
+	}
+
+	TArray<FString> Events;
+	const TArray<TSharedPtr<FJsonValue>>* EventsArray = nullptr;
+	if (Params.IsValid() && Params->TryGetArrayField(TEXT("events"), EventsArray))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *EventsArray)
+		{
+			FString Event;
+			if (Value.IsValid() && Value->TryGetString(Event) && !Event.IsEmpty())
+			{
+				Events.AddUnique(Event);
+			}
+		}
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	{
+		FScopeLock Lock(&ClientsMutex);
+		const TSharedPtr<FClient>* Found = Clients.Find(ClientId);
+		if (!Found)
+		{
+			return true;
+		}
+		FClient& Client = **Found;
+
+		if (bSubscribe)
+		{
+			bool bAdd = false;
+			Params->TryGetBoolField(TEXT("add"), bAdd);
+			if (!bAdd)
+			{
+				Client.Subscriptions.Reset();
+			}
+			for (const FString& Event : Events)
+			{
+				Client.Subscriptions.AddUnique(Event);
+			}
+		}
+		else if (bUnsubscribe)
+		{
+			// 不带 events 时取消全部订阅
+			if (EventsArray)
+			{
+				for (const FString& Event : Events)
+				{
+					Client.Subscriptions.Remove(Event);
+				}
+			}
+			else
+			{
+				Client.Subscriptions.Reset();
+			}
+		}
+
+		TArray<TSharedPtr<FJsonValue>> Subscriptions;
+		for (const FString& Event : Client.Subscriptions)
+		{
+			Subscriptions.Add(MakeShared<FJsonValueString>(Event));
+		}
+		Data->SetNumberField(TEXT("client_id"), Client.Id);
+		Data->SetArrayField(TEXT("events"), Subscriptions);
+		if (bInfo)
+		{
+			Data->SetStringField(TEXT("address"), Client.Address);
+			Data->SetNumberField(TEXT("clients"), Clients.Num());
+		}
+	}
+
+	UAL_CommandUtils::SendResponse(RoutedId, 200, Data);
+	return true;
+}
+
+TSharedPtr<FJsonObject> FUAL_LocalServer::GetStats() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField(TEXT("running"), IsRunning());
+	Obj->SetNumberField(TEXT("port"), IsRunning() ? ListenPort : 0);
+	Obj->SetNumberField(TEXT("accepted"), (double)ClientsAccepted);
+	Obj->SetNumberField(TEXT("rejected"), (double)ClientsRejected);
+
+	const double Now = FPlatformTime::Seconds();
+	TArray<TSharedPtr<FJsonValue>> ClientArray;
+	FScopeLock Lock(&ClientsMutex);
+	for (const TPair<int32, TSharedPtr<FClient>>& Pair : Clients)
+	{
+		const FClient& Client = *Pair.Value;
+		TSharedPtr<FJsonObject> ClientObj = MakeShared<FJsonObject>();
+		ClientObj->SetNumberField(TEXT("client_id"), Client.Id);
+		ClientObj->SetStringField(TEXT("address"), Client.Address);
+		ClientObj->SetBoolField(TEXT("authenticated"), Client.bAuthenticated);
+		ClientObj->SetNumberField(TEXT("connected_sec"), Now - Client.ConnectedTime);
+
+		TArray<TSharedPtr<FJsonValue>> Subscriptions;
+		for (const FString& Event : Client.Subscriptions)
+		{
+			Subscriptions.Add(MakeShared<FJsonValueString>(Event));
+		}
+		ClientObj->SetArrayField(TEXT("events"), Subscriptions);
+		ClientObj->SetNumberField(TEXT("messages_in"), (double)Client.MessagesIn);
+		ClientObj->SetNumberField(TEXT("messages_out"), (double)Client.MessagesOut);
+		ClientObj->SetNumberField(TEXT("bytes_in"), (double)Client.BytesIn);
+		ClientObj->SetNumberField(TEXT("bytes_out"), (double)Client.BytesOut);
+		ClientObj->SetNumberField(TEXT("pending_bytes"), Client.SendBuffer.Num());
+		ClientArray.Add(MakeShared<FJsonValueObject>(ClientObj));
+	}
+	Obj->SetArrayField(TEXT("clients"), ClientArray);
+	return Obj;
+}
@@ -5,9 +5,67 @@
 #include "HAL/PlatformProcess.h"
 #include "Serialization/JsonWriter.h"
 #include "Serialization/JsonSerializer.h"
+#include "HAL/IConsoleManager.h"
+#include "Algo/Sort.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogUALNetwork, Log, All);
 
+static TAutoConsoleVariable<float> CVarHeartbeatIntervalSec(
+	TEXT("ual.HeartbeatIntervalSec"),
+	10.0f,
+	TEXT("Interval in seconds between system.heartbeat pings (applied on the next connection)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarHeartbeatTimeoutSec(
+	TEXT("ual.HeartbeatTimeoutSec"),
+	45.0f,
+	TEXT("Reconnect when a server that answers pings has not sent system.pong for this many seconds; <=0 disables"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarReconnectBaseSec(
+	TEXT("ual.ReconnectBaseSec"),
+	1.0f,
+	TEXT("Initial reconnect delay in seconds; doubles after each failed attempt"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarReconnectMaxSec(
+	TEXT("ual.ReconnectMaxSec"),
+	30.0f,
+	TEXT("Upper bound of the reconnect delay in seconds"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarReplayBufferMaxMessages(
+	TEXT("ual.ReplayBufferMaxMessages"),
+	2048,
+	TEXT("Maximum number of outbound messages kept for replay after a reconnect"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarReplayBufferMaxKB(
+	TEXT("ual.ReplayBufferMaxKB"),
+	32768,
+	TEXT("Maximum size in KB (UTF-16) of outbound messages kept for replay after a reconnect"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarResumeTimeoutMs(
+	TEXT("ual.ResumeTimeoutMs"),
+	1500,
+	TEXT("Time to wait for system.resume_ack before replaying only the messages produced while disconnected"),
+	ECVF_Default);
+
+namespace
+{
+	// 保留的 RTT 样本数（用于分位数）
+	constexpr int32 UALMaxRttSamples = 128;
+	// 最多同时等待的心跳，超出后最早的一个计为丢失
+	constexpr int32 UALMaxPingsInFlight = 8;
+	// 连接持续超过该时长才视为稳定，之后断开不再累计退避
+	constexpr double UALStableConnectionSec = 10.0;
+
+	// 预先序列化的心跳 / pong 报文，发送时只拼接 seq 与时间
+	const TCHAR* const UALHeartbeatPrefix = TEXT("{\"ver\":\"1.0\",\"type\":\"evt\",\"method\":\"system.heartbeat\",\"payload\":{\"seq\":");
+	const TCHAR* const UALPongPrefix = TEXT("{\"ver\":\"1.0\",\"type\":\"evt\",\"method\":\"system.pong\",\"payload\":{\"seq\":");
+}
+
 FUAL_NetworkManager& FUAL_NetworkManager::Get()
 {
 	static FUAL_NetworkManager Instance;
@@ -18,10 +76,12 @@ void FUAL_NetworkManager::Init(const FString& ServerUrl)
 {
 	TargetUrl = ServerUrl;
 	bWantsReconnect = true;
+	if (SessionId.IsEmpty())
+	{
+		SessionId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens);
+	}
 
 	Connect();
-	StartReconnectTimer();
-	StartHeartbeatTimer();
 }
 
 void FUAL_NetworkManager::Shutdown()
@@ -29,25 +89,219 @@ void FUAL_NetworkManager::Shutdown()
 	bWantsReconnect = false;
 	StopReconnectTimer();
 	StopHeartbeatTimer();
+	if (ResumeTickerHandle.IsValid())
+	{
+		UAL_CORE_TICKER.RemoveTicker(ResumeTickerHandle);
+		ResumeTickerHandle.Reset();
+	}
 	CleanupSocket();
+
+	FScopeLock Lock(&SendMutex);
+	ReplayBuffer.Empty();
+	ReplayBytes = 0;
+	bResumePending = false;
 }
 
 bool FUAL_NetworkManager::IsConnected() const
 {
+	FScopeLock Lock(&SendMutex);
 	return Socket.IsValid() && Socket->IsConnected();
 }
 
-void FUAL_NetworkManager::SendMessage(const FString& JsonData)
+void FUAL_NetworkManager::SendMessage(const FString& JsonData, bool bReliable)
+{
+	FScopeLock Lock(&SendMutex);
+	if (!bReliable || !JsonData.StartsWith(TEXT("{")))
+	{
+		if (IsConnected())
+		{
+			UE_LOG(LogUALNetwork, Verbose, TEXT("SendMessage: %s"), *JsonData);
+			Socket->Send(JsonData);
+			FPlatformAtomics::InterlockedIncrement(&MessagesOut);
+			FPlatformAtomics::InterlockedAdd(&BytesOut, (int64)JsonData.Len());
+		}
+		else
+		{
+			FPlatformAtomics::InterlockedIncrement(&SendsSkipped);
+			UE_LOG(LogUALNetwork, Verbose, TEXT("SendMessage skipped: socket not connected"));
+		}
+		return;
+	}
+
+	// 在信封开头插入 seq，不重新序列化
+	const int64 Seq = NextOutSeq++;
+	FString Framed = FString::Printf(TEXT("{\"seq\":%lld,"), Seq);
+	Framed.AppendChars(*JsonData + 1, JsonData.Len() - 1);
+
+	// 重连握手未完成时新消息排在待重放消息之后
+	const bool bCanSend = IsConnected() && !bResumePending;
+	if (bCanSend)
+	{
+		UE_LOG(LogUALNetwork, Verbose, TEXT("SendMessage: %s"), *Framed);
+		Socket->Send(Framed);
+		FPlatformAtomics::InterlockedIncrement(&MessagesOut);
+		FPlatformAtomics::InterlockedAdd(&BytesOut, (int64)Framed.Len());
+	}
+	else if (!bWantsReconnect)
+	{
+		FPlatformAtomics::InterlockedIncrement(&SendsSkipped);
+		UE_LOG(LogUALNetwork, Warning, TEXT("SendMessage skipped: socket not connected"));
+		return;
+	}
+	else
+	{
+		UE_LOG(LogUALNetwork, Verbose, TEXT("SendMessage buffered for replay: seq=%lld"), Seq);
+	}
+
+	// 服务端不确认时，已发出的消息无法判断是否送达，只保留未发出的
+	if (!bCanSend || bServerAcks)
+	{
+		AppendReplay(Seq, MoveTemp(Framed), bCanSend);
+	}
+}
+
+void FUAL_NetworkManager::AppendReplay(int64 Seq, FString&& Framed, bool bSent)
+{
+	FReplayEntry& Entry = ReplayBuffer.AddDefaulted_GetRef();
+	Entry.Seq = Seq;
+	Entry.Json = MoveTemp(Framed);
+	Entry.bSent = bSent;
+	ReplayBytes += Entry.Json.Len() * sizeof(TCHAR);
+
+	const int32 MaxMessages = FMath::Max(1, CVarReplayBufferMaxMessages.GetValueOnAnyThread());
+	const int64 MaxBytes = (int64)FMath::Max(1, CVarReplayBufferMaxKB.GetValueOnAnyThread()) * 1024;
+	int32 EvictCount = 0;
+	while (EvictCount < ReplayBuffer.Num() - 1
+		&& (ReplayBuffer.Num() - EvictCount > MaxMessages || ReplayBytes > MaxBytes))
+	{
+		const FReplayEntry& Oldest = ReplayBuffer[EvictCount];
+		ReplayBytes -= Oldest.Json.Len() * sizeof(TCHAR);
+		if (!Oldest.bSent)
+		{
+			if (ReplayDropped == 0)
+			{
+				UE_LOG(LogUALNetwork, Warning, TEXT("Replay buffer full, dropping oldest undelivered messages"));
+			}
+			++ReplayDropped;
+		}
+		++EvictCount;
+	}
+	if (EvictCount > 0)
+	{
+		ReplayBuffer.RemoveAt(0, EvictCount);
+	}
+}
+
+void FUAL_NetworkManager::TrimAcked(int64 AckSeq)
+{
+	AckedSeq = FMath::Max(AckedSeq, AckSeq);
+	int32 TrimCount = 0;
+	while (TrimCount < ReplayBuffer.Num() && ReplayBuffer[TrimCount].Seq <= AckedSeq)
+	{
+		ReplayBytes -= ReplayBuffer[TrimCount].Json.Len() * sizeof(TCHAR);
+		++TrimCount;
+	}
+	if (TrimCount > 0)
+	{
+		ReplayBuffer.RemoveAt(0, TrimCount);
+	}
+}
+
+void FUAL_NetworkManager::BeginResume()
+{
+	FScopeLock Lock(&SendMutex);
+	const int64 FirstSeq = ReplayBuffer.Num() > 0 ? ReplayBuffer[0].Seq : NextOutSeq;
+
+	// 握手消息本身不编号
+	SendMessage(FString::Printf(
+		TEXT("{\"ver\":\"1.0\",\"type\":\"evt\",\"method\":\"system.resume\",\"payload\":{\"session\":\"%s\",\"first_seq\":%lld,\"next_seq\":%lld,\"buffered\":%d}}"),
+		*SessionId, FirstSeq, NextOutSeq, ReplayBuffer.Num()), false);
+
+	if (ReplayBuffer.Num() == 0)
+	{
+		return;
+	}
+
+	bResumePending = true;
+	if (!ResumeTickerHandle.IsValid())
+	{
+		const float TimeoutSec = FMath::Max(0, CVarResumeTimeoutMs.GetValueOnAnyThread()) / 1000.0f;
+		ResumeTickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_NetworkManager::TickResumeTimeout), TimeoutSec);
+	}
+}
+
+bool FUAL_NetworkManager::TickResumeTimeout(float DeltaTime)
+{
+	ResumeTickerHandle.Reset();
+	FinishResume(false, 0);
+	return false;
+}
+
+void FUAL_NetworkManager::FinishResume(bool bServerAck, int64 AckSeq)
+{
+	FScopeLock Lock(&SendMutex);
+	if (!bResumePending)
+	{
+		if (bServerAck)
+		{
+			bServerAcks = true;
+			TrimAcked(AckSeq);
+		}
+		return;
+	}
+	bResumePending = false;
+
+	if (bServerAck)
+	{
+		bServerAcks = true;
+		TrimAcked(AckSeq);
+	}
+
+	// 握手期间又断开：保留缓冲，下次连接重新握手
+	if (!IsConnected())
+	{
+		return;
+	}
+
+	int32 Replayed = 0;
+	for (FReplayEntry& Entry : ReplayBuffer)
+	{
+		// 旧服务端：断线前已发出的消息无法确认，不重放，避免重复
+		if (!bServerAcks && Entry.bSent)
+		{
+			continue;
+		}
+		Socket->Send(Entry.Json);
+		Entry.bSent = true;
+		++Replayed;
+		FPlatformAtomics::InterlockedIncrement(&MessagesOut);
+		FPlatformAtomics::InterlockedAdd(&BytesOut, (int64)Entry.Json.Len());
+	}
+	MessagesReplayed += Replayed;
+
+	if (!bServerAcks)
+	{
+		ReplayBuffer.Reset();
+		ReplayBytes = 0;
+	}
+
+	UE_LOG(LogUALNetwork, Log, TEXT("Resumed session %s: replayed %d message(s)%s"),
+		*SessionId, Replayed, bServerAck ? TEXT("") : TEXT(" (no resume_ack, replayed unsent only)"));
+}
+
+void FUAL_NetworkManager::SendBinary(const void* Data, SIZE_T Size)
 {
 	FScopeLock Lock(&SendMutex);
 	if (IsConnected())
 	{
-		UE_LOG(LogUALNetwork, Verbose, TEXT("SendMessage: %s"), *JsonData);
-		Socket->Send(JsonData);
+		Socket->Send(Data, Size, true);
+		FPlatformAtomics::InterlockedIncrement(&MessagesOut);
+		FPlatformAtomics::InterlockedAdd(&BinaryBytesOut, (int64)Size);
 	}
 	else
 	{
-		UE_LOG(LogUALNetwork, Warning, TEXT("SendMessage skipped: socket not connected"));
+		FPlatformAtomics::InterlockedIncrement(&SendsSkipped);
+		UE_LOG(LogUALNetwork, Verbose, TEXT("SendBinary skipped: socket not connected"));
 	}
 }
 
@@ -64,11 +318,20 @@ void FUAL_NetworkManager::Connect()
 	}
 
 	bIsConnecting = true;
+	{
+		FScopeLock Lock(&StatsMutex);
+		++ConnectAttempts;
+	}
 	UE_LOG(LogUALNetwork, Log, TEXT("Connecting to %s"), *TargetUrl);
 
-	Socket = FWebSocketsModule::Get().CreateWebSocket(TargetUrl);
+	// Socket 只在 GameThread 上替换，其它线程的发送在 SendMutex 下读取
+	const TSharedPtr<IWebSocket> NewSocket = FWebSocketsModule::Get().CreateWebSocket(TargetUrl);
+	{
+		FScopeLock Lock(&SendMutex);
+		Socket = NewSocket;
+	}
 	BindSocketEvents();
-	Socket->Connect();
+	NewSocket->Connect();
 }
 
 void FUAL_NetworkManager::BindSocketEvents()
@@ -86,26 +349,45 @@ void FUAL_NetworkManager::BindSocketEvents()
 
 void FUAL_NetworkManager::CleanupSocket()
 {
-	if (Socket.IsValid())
+	// 先在锁内摘下 Socket：正在其它线程发送的调用结束后才会取到空指针，关闭时不再有人使用旧 Socket
+	TSharedPtr<IWebSocket> OldSocket;
 	{
-		Socket->OnConnected().RemoveAll(this);
-		Socket->OnConnectionError().RemoveAll(this);
-		Socket->OnClosed().RemoveAll(this);
-		Socket->OnMessage().RemoveAll(this);
-		Socket->Close();
+		FScopeLock Lock(&SendMutex);
+		OldSocket = MoveTemp(Socket);
 		Socket.Reset();
 	}
+	if (OldSocket.IsValid())
+	{
+		OldSocket->OnConnected().RemoveAll(this);
+		OldSocket->OnConnectionError().RemoveAll(this);
+		OldSocket->OnClosed().RemoveAll(this);
+		OldSocket->OnMessage().RemoveAll(this);
+		OldSocket->Close();
+	}
 	bIsConnecting = false;
 }
 
-void FUAL_NetworkManager::StartReconnectTimer()
+void FUAL_NetworkManager::ScheduleReconnect()
 {
-	if (ReconnectTickerHandle.IsValid())
+	if (!bWantsReconnect || ReconnectTickerHandle.IsValid())
 	{
 		return;
 	}
 
-	ReconnectTickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_NetworkManager::TickReconnect), 5.0f);
+	// 指数退避 + 抖动：Delay = min(Max, Base * 2^失败次数) * [0.5, 1)，避免多个编辑器同时重连
+	const float BaseSec = FMath::Max(0.1f, CVarReconnectBaseSec.GetValueOnAnyThread());
+	const float MaxSec = FMath::Max(BaseSec, CVarReconnectMaxSec.GetValueOnAnyThread());
+
+	float DelaySec;
+	{
+		FScopeLock Lock(&StatsMutex);
+		const float Backoff = FMath::Min(MaxSec, BaseSec * FMath::Pow(2.0f, (float)FMath::Min(ConsecutiveFailures, 16)));
+		DelaySec = Backoff * (0.5f + 0.5f * FMath::FRand());
+		NextReconnectTime = FPlatformTime::Seconds() + DelaySec;
+	}
+
+	UE_LOG(LogUALNetwork, Log, TEXT("Reconnecting in %.1f s"), DelaySec);
+	ReconnectTickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_NetworkManager::TickReconnect), DelaySec);
 }
 
 void FUAL_NetworkManager::StopReconnectTimer()
@@ -119,17 +401,19 @@ void FUAL_NetworkManager::StopReconnectTimer()
 
 bool FUAL_NetworkManager::TickReconnect(float DeltaTime)
 {
-	if (!bWantsReconnect)
+	// 单次触发：连接失败时由错误回调重新安排
+	ReconnectTickerHandle.Reset();
 	{
-		return false; // 停止 ticker
+		FScopeLock Lock(&StatsMutex);
+		NextReconnectTime = 0.0;
 	}
 
-	if (!IsConnected() && !bIsConnecting)
+	if (bWantsReconnect && !IsConnected() && !bIsConnecting)
 	{
 		UE_LOG(LogUALNetwork, Verbose, TEXT("Reconnect ticker triggering connect"));
 		Connect();
 	}
-	return true; // 继续运行
+	return false;
 }
 
 void FUAL_NetworkManager::StartHeartbeatTimer()
@@ -139,8 +423,9 @@ void FUAL_NetworkManager::StartHeartbeatTimer()
 		return;
 	}
 
-	// 每10秒发送一次心跳（前端配置是15秒检查间隔，45秒超时，所以10秒发送一次足够）
-	HeartbeatTickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_NetworkManager::TickHeartbeat), 10.0f);
+	// 默认每10秒发送一次心跳（前端配置是15秒检查间隔，45秒超时，所以10秒发送一次足够）
+	const float IntervalSec = FMath::Max(1.0f, CVarHeartbeatIntervalSec.GetValueOnAnyThread());
+	HeartbeatTickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_NetworkManager::TickHeartbeat), IntervalSec);
 }
 
 void FUAL_NetworkManager::StopHeartbeatTimer()
@@ -156,30 +441,236 @@ bool FUAL_NetworkManager::TickHeartbeat(float DeltaTime)
 {
 	if (!bWantsReconnect || !IsConnected())
 	{
-		return false; // 停止 ticker
+		// 重新连接后由 HandleOnConnected 再次启动
+		HeartbeatTickerHandle.Reset();
+		return false;
 	}
 
-	// 发送心跳消息
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetStringField(TEXT("ver"), TEXT("1.0"));
-	Root->SetStringField(TEXT("type"), TEXT("evt"));
-	Root->SetStringField(TEXT("method"), TEXT("system.heartbeat"));
-	
-	// payload可以为空，或者包含一些基本信息
-	TSharedPtr<FJsonObject> Payload = MakeShared<FJsonObject>();
-	Root->SetObjectField(TEXT("payload"), Payload);
+	// 服务端支持 pong 时，长时间收不到视为链路已断（TCP 半开等情况下 Socket 仍显示已连接）
+	const float TimeoutSec = CVarHeartbeatTimeoutSec.GetValueOnAnyThread();
+	bool bTimedOut = false;
+	{
+		FScopeLock Lock(&StatsMutex);
+		bTimedOut = TimeoutSec > 0.0f && bPongSeenThisConnection && FPlatformTime::Seconds() - LastPongTime > TimeoutSec;
+		if (bTimedOut)
+		{
+			LastDisconnectReason = TEXT("heartbeat timeout");
+			ConnectedSince = 0.0;
+		}
+	}
+	if (bTimedOut)
+	{
+		UE_LOG(LogUALNetwork, Warning, TEXT("No pong for %.0f s, reconnecting"), TimeoutSec);
+		HeartbeatTickerHandle.Reset();
+		CleanupSocket();
+		ScheduleReconnect();
+		return false;
+	}
 
-	FString OutJson;
-	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutJson);
-	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+	SendPing();
+	return true; // 继续运行
+}
 
-	SendMessage(OutJson);
+void FUAL_NetworkManager::SendPing()
+{
+	const double Now = FPlatformTime::Seconds();
+	int64 Seq;
+	{
+		FScopeLock Lock(&StatsMutex);
+		Seq = ++PingSeq;
+		PingsInFlight.Add(Seq, Now);
+		++PingsSent;
+
+		// 等待中的心跳过多：最早的一个计为丢失
+		while (PingsInFlight.Num() > UALMaxPingsInFlight)
+		{
+			int64 OldestSeq = Seq;
+			for (const TPair<int64, double>& Pair : PingsInFlight)
+			{
+				OldestSeq = FMath::Min(OldestSeq, Pair.Key);
+			}
+			PingsInFlight.Remove(OldestSeq);
+			++PongsMissed;
+		}
+	}
 
-	return true; // 继续运行
+	FString Message(UALHeartbeatPrefix);
+	Message += FString::Printf(TEXT("%lld,\"t\":%.0f}}"), Seq, Now * 1000.0);
+	SendMessage(Message, false);
+}
+
+bool FUAL_NetworkManager::HandleLinkMessage(const FString& Data)
+{
+	// 链路消息都很短：只有包含方法名时才解析，命令消息几乎不产生额外开销
+	if (Data.Len() > 512 || !Data.Contains(TEXT("\"system."), ESearchCase::CaseSensitive))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Data);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		return false;
+	}
+
+	FString Type, Method;
+	Root->TryGetStringField(TEXT("type"), Type);
+	Root->TryGetStringField(TEXT("method"), Method);
+	const bool bPing = Method == TEXT("system.ping");
+	const bool bPong = Method == TEXT("system.pong");
+	const bool bAck = Method == TEXT("system.ack");
+	const bool bResumeAck = Method == TEXT("system.resume_ack");
+	if ((!bPing && !bPong && !bAck && !bResumeAck) || Type != TEXT("evt"))
+	{
+		return false;
+	}
+
+	int64 Seq = -1;
+	const TSharedPtr<FJsonObject>* PayloadObj = nullptr;
+	if (Root->TryGetObjectField(TEXT("payload"), PayloadObj) || Root->TryGetObjectField(TEXT("params"), PayloadObj))
+	{
+		(*PayloadObj)->TryGetNumberField(bResumeAck ? TEXT("ack_seq") : TEXT("seq"), Seq);
+	}
+
+	if (bAck || bResumeAck)
+	{
+		// resume_ack 未给出 ack_seq（服务端不认识本会话）时视为全部未收到
+		if (bResumeAck)
+		{
+			FinishResume(true, FMath::Max<int64>(0, Seq));
+		}
+		else if (Seq >= 0)
+		{
+			FScopeLock Lock(&SendMutex);
+			bServerAcks = true;
+			TrimAcked(Seq);
+		}
+		return true;
+	}
+
+	if (bPing)
+	{
+		FString Message(UALPongPrefix);
+		Message += FString::Printf(TEXT("%lld}}"), Seq);
+		SendMessage(Message, false);
+		return true;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	FScopeLock Lock(&StatsMutex);
+	++PongsReceived;
+	LastPongTime = Now;
+	bPongSeenThisConnection = true;
+
+	double SentTime = 0.0;
+	if (PingsInFlight.RemoveAndCopyValue(Seq, SentTime))
+	{
+		RecordRtt((Now - SentTime) * 1000.0);
+	}
+	return true;
+}
+
+void FUAL_NetworkManager::RecordRtt(double RttMs)
+{
+	LastRttMs = RttMs;
+	if (RttSamples.Num() < UALMaxRttSamples)
+	{
+		RttSamples.Add((float)RttMs);
+	}
+	else
+	{
+		RttSamples[RttWriteIndex] = (float)RttMs;
+		RttWriteIndex = (RttWriteIndex + 1) % UALMaxRttSamples;
+	}
+}
+
+TSharedPtr<FJsonObject> FUAL_NetworkManager::GetLinkStats() const
+{
+	const double Now = FPlatformTime::Seconds();
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField(TEXT("connected"), IsConnected());
+
+	FScopeLock Lock(&StatsMutex);
+	Obj->SetNumberField(TEXT("uptime_sec"), IsConnected() && ConnectedSince > 0.0 ? Now - ConnectedSince : 0.0);
+	Obj->SetNumberField(TEXT("connect_attempts"), ConnectAttempts);
+	Obj->SetNumberField(TEXT("reconnect_count"), ReconnectCount);
+	Obj->SetNumberField(TEXT("consecutive_failures"), ConsecutiveFailures);
+	if (NextReconnectTime > 0.0)
+	{
+		Obj->SetNumberField(TEXT("next_reconnect_in_sec"), FMath::Max(0.0, NextReconnectTime - Now));
+	}
+	if (!LastDisconnectReason.IsEmpty())
+	{
+		Obj->SetStringField(TEXT("last_disconnect_reason"), LastDisconnectReason);
+	}
+
+	TSharedPtr<FJsonObject> Rtt = MakeShared<FJsonObject>();
+	Rtt->SetNumberField(TEXT("samples"), RttSamples.Num());
+	if (RttSamples.Num() > 0)
+	{
+		TArray<float> Sorted = RttSamples;
+		Algo::Sort(Sorted);
+		auto Percentile = [&Sorted](double P)
+		{
+			const int32 Index = FMath::Clamp(FMath::CeilToInt(P * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+			return (double)Sorted[Index];
+		};
+		Rtt->SetNumberField(TEXT("last_ms"), LastRttMs);
+		Rtt->SetNumberField(TEXT("min_ms"), Sorted[0]);
+		Rtt->SetNumberField(TEXT("p50_ms"), Percentile(0.50));
+		Rtt->SetNumberField(TEXT("p90_ms"), Percentile(0.90));
+		Rtt->SetNumberField(TEXT("p99_ms"), Percentile(0.99));
+		Rtt->SetNumberField(TEXT("max_ms"), Sorted.Last());
+	}
+	Obj->SetObjectField(TEXT("rtt"), Rtt);
+
+	Obj->SetNumberField(TEXT("pings_sent"), (double)PingsSent);
+	Obj->SetNumberField(TEXT("pongs_received"), (double)PongsReceived);
+	Obj->SetNumberField(TEXT("pongs_missed"), (double)PongsMissed);
+	Obj->SetBoolField(TEXT("pong_supported"), PongsReceived > 0);
+
+	Obj->SetNumberField(TEXT("messages_in"), (double)FPlatformAtomics::AtomicRead(&MessagesIn));
+	Obj->SetNumberField(TEXT("messages_out"), (double)FPlatformAtomics::AtomicRead(&MessagesOut));
+	Obj->SetNumberField(TEXT("bytes_in"), (double)FPlatformAtomics::AtomicRead(&BytesIn));
+	Obj->SetNumberField(TEXT("bytes_out"), (double)FPlatformAtomics::AtomicRead(&BytesOut));
+	Obj->SetNumberField(TEXT("binary_bytes_out"), (double)FPlatformAtomics::AtomicRead(&BinaryBytesOut));
+	Obj->SetNumberField(TEXT("sends_skipped"), (double)FPlatformAtomics::AtomicRead(&SendsSkipped));
+
+	{
+		FScopeLock SendLock(&SendMutex);
+		int32 Unsent = 0;
+		for (const FReplayEntry& Entry : ReplayBuffer)
+		{
+			Unsent += Entry.bSent ? 0 : 1;
+		}
+
+		TSharedPtr<FJsonObject> Replay = MakeShared<FJsonObject>();
+		Replay->SetStringField(TEXT("session"), SessionId);
+		Replay->SetNumberField(TEXT("next_seq"), (double)NextOutSeq);
+		Replay->SetNumberField(TEXT("acked_seq"), (double)AckedSeq);
+		Replay->SetBoolField(TEXT("server_acks"), bServerAcks);
+		Replay->SetBoolField(TEXT("resume_pending"), bResumePending);
+		Replay->SetNumberField(TEXT("buffered"), ReplayBuffer.Num());
+		Replay->SetNumberField(TEXT("buffered_bytes"), (double)ReplayBytes);
+		Replay->SetNumberField(TEXT("unsent"), Unsent);
+		Replay->SetNumberField(TEXT("replayed"), (double)MessagesReplayed);
+		Replay->SetNumberField(TEXT("dropped"), (double)ReplayDropped);
+		Obj->SetObjectField(TEXT("replay"), Replay);
+	}
+	return Obj;
 }
 
 void FUAL_NetworkManager::HandleOnMessage(const FString& Data)
 {
+	FPlatformAtomics::InterlockedIncrement(&MessagesIn);
+	FPlatformAtomics::InterlockedAdd(&BytesIn, (int64)Data.Len());
+
+	// ping / pong 在收到时立即处理，RTT 不包含切换到 GameThread 的排队时间
+	if (HandleLinkMessage(Data))
+	{
+		return;
+	}
 	MessageReceivedDelegate.Broadcast(Data);
 }
 
@@ -187,6 +678,20 @@ void FUAL_NetworkManager::HandleOnConnected()
 {
 	UE_LOG(LogUALNetwork, Display, TEXT("Connected to %s"), *TargetUrl);
 	bIsConnecting = false;
+	{
+		FScopeLock Lock(&StatsMutex);
+		if (ConnectionCount > 0)
+		{
+			++ReconnectCount;
+		}
+		++ConnectionCount;
+		ConnectedSince = FPlatformTime::Seconds();
+		LastPongTime = ConnectedSince;
+		bPongSeenThisConnection = false;
+		PingsInFlight.Reset();
+	}
+	StartHeartbeatTimer();
+	BeginResume();
 	ConnectedDelegate.Broadcast();
 }
 
@@ -194,9 +699,24 @@ void FUAL_NetworkManager::HandleOnClosed(int32 StatusCode, const FString& Reason
 {
 	UE_LOG(LogUALNetwork, Warning, TEXT("Socket closed (%d): %s Clean=%d"), StatusCode, *Reason, bWasClean);
 	bIsConnecting = false;
+	{
+		FScopeLock Lock(&StatsMutex);
+		LastDisconnectReason = FString::Printf(TEXT("closed (%d) %s"), StatusCode, *Reason);
+		// 稳定运行过的连接断开后按最短退避重连；连上即被关闭（如服务端拒绝）时继续加大退避
+		if (ConnectedSince > 0.0 && FPlatformTime::Seconds() - ConnectedSince >= UALStableConnectionSec)
+		{
+			ConsecutiveFailures = 0;
+		}
+		else
+		{
+			++ConsecutiveFailures;
+		}
+		ConnectedSince = 0.0;
+	}
 	if (bWantsReconnect)
 	{
 		CleanupSocket();
+		ScheduleReconnect();
 	}
 }
 
@@ -204,9 +724,15 @@ void FUAL_NetworkManager::HandleOnConnectionError(const FString& Error)
 {
 	UE_LOG(LogUALNetwork, Error, TEXT("Connection error: %s"), *Error);
 	bIsConnecting = false;
+	{
+		FScopeLock Lock(&StatsMutex);
+		++ConsecutiveFailures;
+		ConnectedSince = 0.0;
+		LastDisconnectReason = FString::Printf(TEXT("error: %s"), *Error);
+	}
 	if (bWantsReconnect)
 	{
 		CleanupSocket();
+		ScheduleReconnect();
 	}
 }
-
@@ -0,0 +1,490 @@
+#include "UAL_AdmissionController.h"
+#include "UAL_CommandUtils.h"
+#include "UAL_LocalServer.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALAdmission, Log, All);
+
+static TAutoConsoleVariable<int32> CVarAdmission(
+	TEXT("ual.Admission"),
+	1,
+	TEXT("Enable per-class rate limits and the per-frame command budget (0 = dispatch every request immediately)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarRateLimitReadPerSec(
+	TEXT("ual.RateLimitReadPerSec"),
+	50.0f,
+	TEXT("Sustained rate of read-only commands (get/describe/list/query) per second, over-rate requests wait in the queue; <=0 disables the limit"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarRateLimitReadBurst(
+	TEXT("ual.RateLimitReadBurst"),
+	100.0f,
+	TEXT("Burst size of read-only commands"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarRateLimitWritePerSec(
+	TEXT("ual.RateLimitWritePerSec"),
+	20.0f,
+	TEXT("Sustained rate of editing commands per second, over-rate requests wait in the queue; <=0 disables the limit"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarRateLimitWriteBurst(
+	TEXT("ual.RateLimitWriteBurst"),
+	40.0f,
+	TEXT("Burst size of editing commands"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarRateLimitHeavyPerSec(
+	TEXT("ual.RateLimitHeavyPerSec"),
+	2.0f,
+	TEXT("Sustained rate of heavy commands (import, compile, screenshot, python, batch ops) per second, over-rate requests wait in the queue; <=0 disables the limit"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarRateLimitHeavyBurst(
+	TEXT("ual.RateLimitHeavyBurst"),
+	8.0f,
+	TEXT("Burst size of heavy commands"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarCommandFrameBudgetMs(
+	TEXT("ual.CommandFrameBudgetMs"),
+	20.0f,
+	TEXT("GameThread time in milliseconds spent dispatching commands per frame before further requests are deferred; <=0 disables the budget"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCommandQueueMax(
+	TEXT("ual.CommandQueueMax"),
+	256,
+	TEXT("Maximum number of requests waiting for the frame budget or a rate-limit token; further requests are rejected with 429"),
+	ECVF_Default);
+
+namespace
+{
+	// 不受限流约束的控制类命令
+	const TCHAR* const UALControlMethods[] = {
+		TEXT("system.get_performance_stats"),
+		TEXT("system.get_project_info"),
+		TEXT("project.info"),
+		TEXT("editor.get_project_info"),
+		TEXT("editor.capture_stream_ack"),
+		TEXT("messagelog.unsubscribe"),
+		TEXT("python.stats"),
+	};
+
+	// 单次执行可能占用 GameThread 数百毫秒以上的命令
+	const TCHAR* const UALHeavyMethods[] = {
+		TEXT("content.import"),
+		TEXT("content.normalized_import"),
+		TEXT("content.audit_optimization"),
+		TEXT("content.configure_textures"),
+		TEXT("content.rescan"),
+		TEXT("level.query_assets"),
+		TEXT("project.export_snapshot"),
+		TEXT("blueprint.compile"),
+		TEXT("blueprint.flush_compiles"),
+		TEXT("material.compile"),
+		TEXT("material.flush_compiles"),
+		TEXT("material.preview"),
+		TEXT("widget.preview"),
+		TEXT("editor.screenshot"),
+		TEXT("editor.capture_app_window"),
+		TEXT("cmd.run_python"),
+		TEXT("project.analyze_uproject"),
+		TEXT("actor.spawn_batch"),
+		TEXT("actor.destroy_batch"),
+		TEXT("system.manage_plugin"),
+	};
+
+	// 方法名第二段以这些前缀开头时视为只读
+	const TCHAR* const UALReadVerbs[] = {
+		TEXT("get"),
+		TEXT("describe"),
+		TEXT("list"),
+		TEXT("query"),
+		TEXT("inspect"),
+		TEXT("search"),
+		TEXT("status"),
+		TEXT("stats"),
+	};
+}
+
+FUAL_AdmissionController& FUAL_AdmissionController::Get()
+{
+	static FUAL_AdmissionController Instance;
+	return Instance;
+}
+
+const TCHAR* FUAL_AdmissionController::ClassToString(EMethodClass Class)
+{
+	switch (Class)
+	{
+	case EMethodClass::Control: return TEXT("control");
+	case EMethodClass::Read:    return TEXT("read");
+	case EMethodClass::Write:   return TEXT("write");
+	case EMethodClass::Heavy:   return TEXT("heavy");
+	default:                    return TEXT("unknown");
+	}
+}
+
+FUAL_AdmissionController::EMethodClass FUAL_AdmissionController::Classify(const FString& Method)
+{
+	if (const EMethodClass* Cached = ClassCache.Find(Method))
+	{
+		return *Cached;
+	}
+
+	EMethodClass Class = EMethodClass::Write;
+	FString Domain, Verb;
+	if (!Method.Split(TEXT("."), &Domain, &Verb))
+	{
+		Verb = Method;
+	}
+
+	if (Domain == TEXT("job") || Domain == TEXT("bulk"))
+	{
+		Class = EMethodClass::Control;
+	}
+	else
+	{
+		for (const TCHAR* Name : UALControlMethods)
+		{
+			if (Method == Name)
+			{
+				Class = EMethodClass::Control;
+				break;
+			}
+		}
+	}
+
+	if (Class == EMethodClass::Write)
+	{
+		for (const TCHAR* Name : UALHeavyMethods)
+		{
+			if (Method == Name)
+			{
+				Class = EMethodClass::Heavy;
+				break;
+			}
+		}
+	}
+
+	if (Class == EMethodClass::Write)
+	{
+		for (const TCHAR* Prefix : UALReadVerbs)
+		{
+			if (Verb.StartsWith(Prefix))
+			{
+				Class = EMethodClass::Read;
+				break;
+			}
+		}
+	}
+
+	ClassCache.Add(Method, Class);
+	return Class;
+}
+
+bool FUAL_AdmissionController::IsReadOnlyMethod(const FString& Method)
+{
+	const EMethodClass Class = Classify(Method);
+	return Class == EMethodClass::Control || Class == EMethodClass::Read;
+}
+
+void FUAL_AdmissionController::GetBucketConfig(EMethodClass Class, double& OutRate, double& OutBurst) const
+{
+	switch (Class)
+	{
+	case EMethodClass::Read:
+		OutRate = CVarRateLimitReadPerSec.GetValueOnGameThread();
+		OutBurst = CVarRateLimitReadBurst.GetValueOnGameThread();
+		break;
+	case EMethodClass::Write:
+		OutRate = CVarRateLimitWritePerSec.GetValueOnGameThread();
+		OutBurst = CVarRateLimitWriteBurst.GetValueOnGameThread();
+		break;
+	case EMethodClass::Heavy:
+		OutRate = CVarRateLimitHeavyPerSec.GetValueOnGameThread();
+		OutBurst = CVarRateLimitHeavyBurst.GetValueOnGameThread();
+		break;
+	default:
+		OutRate = 0.0;
+		OutBurst = 0.0;
+		break;
+	}
+	OutBurst = FMath::Max(1.0, OutBurst);
+}
+
+bool FUAL_AdmissionController::TryConsumeToken(EMethodClass Class, double Now, double& OutRetryAfterMs)
+{
+	double Rate, Burst;
+	GetBucketConfig(Class, Rate, Burst);
+	if (Rate <= 0.0)
+	{
+		return true;
+	}
+
+	FBucket& Bucket = Buckets[(int32)Class];
+	if (Bucket.Tokens < 0.0)
+	{
+		// 首次使用时满桶
+		Bucket.Tokens = Burst;
+	}
+	else
+	{
+		Bucket.Tokens = FMath::Min(Burst, Bucket.Tokens + (Now - Bucket.LastRefillTime) * Rate);
+	}
+	Bucket.LastRefillTime = Now;
+
+	if (Bucket.Tokens >= 1.0)
+	{
+		Bucket.Tokens -= 1.0;
+		return true;
+	}
+
+	OutRetryAfterMs = FMath::CeilToDouble((1.0 - Bucket.Tokens) / Rate * 1000.0);
+	return false;
+}
+
+bool FUAL_AdmissionController::IsFrameBudgetExhausted()
+{
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		FrameBusyMs = 0.0;
+	}
+	const float BudgetMs = CVarCommandFrameBudgetMs.GetValueOnGameThread();
+	return BudgetMs > 0.0f && FrameBusyMs >= BudgetMs;
+}
+
+void FUAL_AdmissionController::Execute(EMethodClass Class, const TFunction<void()>& Dispatch)
+{
+	const double Start = FPlatformTime::Seconds();
+	Dispatch();
+	const double ElapsedMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+	// 处理器执行期间可能跨帧（模态对话框、同步编译等），按结束时所在帧计入
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		FrameBusyMs = 0.0;
+	}
+	FrameBusyMs += ElapsedMs;
+
+	FClassStats& ClassStats = Stats[(int32)Class];
+	++ClassStats.Admitted;
+	ClassStats.BusyMs += ElapsedMs;
+	ClassStats.MaxMs = FMath::Max(ClassStats.MaxMs, ElapsedMs);
+}
+
+void FUAL_AdmissionController::Reject(const FString& Method, const FString& RequestId, EMethodClass Class, const TCHAR* Reason, double RetryAfterMs)
+{
+	UE_LOG(LogUALAdmission, Verbose, TEXT("Reject %s (%s, id=%s): %s, retry after %.0f ms"),
+		*Method, ClassToString(Class), *RequestId, Reason, RetryAfterMs);
+
+	TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
+	Details->SetStringField(TEXT("method"), Method);
+	Details->SetStringField(TEXT("class"), ClassToString(Class));
+	Details->SetStringField(TEXT("reason"), Reason);
+	Details->SetNumberField(TEXT("retry_after_ms"), RetryAfterMs);
+	UAL_CommandUtils::SendError(RequestId, 429,
+		FString::Printf(TEXT("Too many requests: %s (%s)"), *Method, Reason), Details);
+}
+
+void FUAL_AdmissionController::Submit(const FString& Method, const FString& RequestId, TFunction<void()>&& Dispatch)
+{
+	if (CVarAdmission.GetValueOnGameThread() == 0)
+	{
+		Dispatch();
+		return;
+	}
+
+	const EMethodClass Class = Classify(Method);
+	const int32 ClientId = GetClientId(RequestId);
+	const int32 QueueDepth = Pending.Num();
+
+	// control 类只在同一连接没有排队请求时插队：job.status / job.cancel 不能越过创建该任务的请求
+	if (Class == EMethodClass::Control && !HasPendingFromClient(ClientId))
+	{
+		Execute(Class, Dispatch);
+		return;
+	}
+
+	// 已有请求排队时后来者也排队，保持到达顺序；令牌在队列中按顺序领取
+	const double Now = FPlatformTime::Seconds();
+	double RetryAfterMs = 0.0;
+	if (Class != EMethodClass::Control && QueueDepth == 0 && !IsFrameBudgetExhausted() && TryConsumeToken(Class, Now, RetryAfterMs))
+	{
+		Execute(Class, Dispatch);
+		return;
+	}
+
+	if (QueueDepth >= FMath::Max(1, CVarCommandQueueMax.GetValueOnGameThread()))
+	{
+		++Stats[(int32)Class].RejectedQueueFull;
+		// 队列每帧至少前进一个，建议至少等待一帧
+		Reject(Method, RequestId, Class, TEXT("queue_full"), FMath::CeilToDouble(FMath::Max(16.0, FApp::GetDeltaTime() * 1000.0)));
+		return;
+	}
+
+	FPending& Entry = Pending.AddDefaulted_GetRef();
+	Entry.Method = Method;
+	Entry.RequestId = RequestId;
+	Entry.Class = Class;
+	Entry.ClientId = ClientId;
+	Entry.EnqueueTime = Now;
+	Entry.Dispatch = MoveTemp(Dispatch);
+
+	++Stats[(int32)Class].Queued;
+	MaxQueueDepth = FMath::Max(MaxQueueDepth, QueueDepth + 1);
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_AdmissionController::Tick), 0.0f);
+	}
+}
+
+bool FUAL_AdmissionController::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// 按到达顺序执行；某类别令牌不足时该类别后续请求继续等待，其它类别不受影响
+	bool bClassBlocked[(int32)EMethodClass::Num] = {};
+	bool bRateLimited = false;
+	// 本帧有请求仍在等待的连接：其后的 control 类请求不越过它们
+	TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<4>> WaitingClients;
+
+	// 每帧至少执行一个，单个超预算的请求不会让队列停滞
+	bool bFirst = true;
+	for (int32 Index = 0; Index < Pending.Num();)
+	{
+		if (IsFrameBudgetExhausted() && !bFirst)
+		{
+			break;
+		}
+
+		FPending& Entry = Pending[Index];
+		const int32 ClassIndex = (int32)Entry.Class;
+		if (Entry.Class == EMethodClass::Control && WaitingClients.Contains(Entry.ClientId))
+		{
+			++Index;
+			continue;
+		}
+		if (!Entry.bHasToken)
+		{
+			double RetryAfterMs = 0.0;
+			Entry.bHasToken = !bClassBlocked[ClassIndex] && TryConsumeToken(Entry.Class, Now, RetryAfterMs);
+			if (!Entry.bHasToken)
+			{
+				if (!bClassBlocked[ClassIndex] && !Entry.bCountedRateLimited)
+				{
+					Entry.bCountedRateLimited = true;
+					++Stats[ClassIndex].RateLimited;
+				}
+				bClassBlocked[ClassIndex] = true;
+				bRateLimited = true;
+				WaitingClients.Add(Entry.ClientId);
+				++Index;
+				continue;
+			}
+		}
+		bFirst = false;
+
+		// 先移出再执行：处理器内部可能再次提交请求导致数组扩容
+		FPending Ready = MoveTemp(Entry);
+		Pending.RemoveAt(Index);
+
+		MaxQueueWaitMs = FMath::Max(MaxQueueWaitMs, (FPlatformTime::Seconds() - Ready.EnqueueTime) * 1000.0);
+		Execute(Ready.Class, Ready.Dispatch);
+	}
+
+	if (Pending.Num() > 0)
+	{
+		if (!bRateLimited)
+		{
+			++DeferredFrames;
+		}
+		return true;
+	}
+
+	TickerHandle.Reset();
+	return false;
+}
+
+int32 FUAL_AdmissionController::GetClientId(const FString& RequestId)
+{
+	// 本地客户端的请求 ID 已改写为路由 ID，其余请求都来自服务器连接
+	int32 ClientId = 0;
+	FString OriginalId;
+	return FUAL_LocalServer::ParseRoutedId(RequestId, ClientId, OriginalId) ? ClientId : 0;
+}
+
+bool FUAL_AdmissionController::HasPendingFromClient(int32 ClientId) const
+{
+	for (const FPending& Entry : Pending)
+	{
+		if (Entry.ClientId == ClientId)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+TSharedPtr<FJsonObject> FUAL_AdmissionController::GetStats() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField(TEXT("enabled"), CVarAdmission.GetValueOnGameThread() != 0);
+	Obj->SetNumberField(TEXT("frame_budget_ms"), CVarCommandFrameBudgetMs.GetValueOnGameThread());
+	Obj->SetNumberField(TEXT("queue_depth"), Pending.Num());
+	Obj->SetNumberField(TEXT("queue_max"), CVarCommandQueueMax.GetValueOnGameThread());
+	Obj->SetNumberField(TEXT("max_queue_depth"), MaxQueueDepth);
+	Obj->SetNumberField(TEXT("max_queue_wait_ms"), MaxQueueWaitMs);
+	Obj->SetNumberField(TEXT("deferred_frames"), (double)DeferredFrames);
+
+	int64 TotalRejected = 0;
+	TSharedPtr<FJsonObject> Classes = MakeShared<FJsonObject>();
+	for (int32 Index = 0; Index < (int32)EMethodClass::Num; ++Index)
+	{
+		const EMethodClass Class = (EMethodClass)Index;
+		const FClassStats& ClassStats = Stats[Index];
+
+		TSharedPtr<FJsonObject> ClassObj = MakeShared<FJsonObject>();
+		ClassObj->SetNumberField(TEXT("admitted"), (double)ClassStats.Admitted);
+		ClassObj->SetNumberField(TEXT("queued"), (double)ClassStats.Queued);
+		ClassObj->SetNumberField(TEXT("rate_limited"), (double)ClassStats.RateLimited);
+		ClassObj->SetNumberField(TEXT("rejected_queue_full"), (double)ClassStats.RejectedQueueFull);
+		ClassObj->SetNumberField(TEXT("avg_ms"), ClassStats.Admitted > 0 ? ClassStats.BusyMs / ClassStats.Admitted : 0.0);
+		ClassObj->SetNumberField(TEXT("max_ms"), ClassStats.MaxMs);
+		if (Class != EMethodClass::Control)
+		{
+			double Rate, Burst;
+			GetBucketConfig(Class, Rate, Burst);
+			ClassObj->SetNumberField(TEXT("rate_per_sec"), Rate);
+			ClassObj->SetNumberField(TEXT("burst"), Burst);
+			if (Rate > 0.0 && Buckets[Index].Tokens >= 0.0)
+			{
+				const double Tokens = FMath::Min(Burst, Buckets[Index].Tokens + (FPlatformTime::Seconds() - Buckets[Index].LastRefillTime) * Rate);
+				ClassObj->SetNumberField(TEXT("tokens"), Tokens);
+			}
+		}
+		Classes->SetObjectField(ClassToString(Class), ClassObj);
+		TotalRejected += ClassStats.RejectedQueueFull;
+	}
+	Obj->SetObjectField(TEXT("classes"), Classes);
+	Obj->SetNumberField(TEXT("rejected_total"), (double)TotalRejected);
+	return Obj;
+}
+
+void FUAL_AdmissionController::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		UAL_CORE_TICKER.RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	Pending.Empty();
+	ClassCache.Empty();
+}
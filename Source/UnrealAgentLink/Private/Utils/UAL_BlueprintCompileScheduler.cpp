@@ -0,0 +1,561 @@
+#include "UAL_BlueprintCompileScheduler.h"
+#include "UAL_CommandUtils.h"
+
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Logging/TokenizedMessage.h"
+#include "Misc/PackageName.h"
+#include "UObject/SavePackage.h"
+#include "HAL/IConsoleManager.h"
+#include "Hash/CityHash.h"
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+#include "Misc/UObjectToken.h"
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALCompileScheduler, Log, All);
+
+static TAutoConsoleVariable<float> CVarBlueprintCompileDelay(
+	TEXT("ual.BlueprintCompileDelay"),
+	0.5f,
+	TEXT("延迟编译的静默期（秒）：最后一次入队后等待该时长再统一编译"),
+	ECVF_Default);
+
+namespace
+{
+	void MixString(uint64& Hash, const FString& Value)
+	{
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*Value), Value.Len() * sizeof(TCHAR), Hash);
+	}
+
+	void MixInt(uint64& Hash, uint64 Value)
+	{
+		Hash = CityHash128to64(Uint128_64(Hash, Value));
+	}
+
+	void MixPinType(uint64& Hash, const FEdGraphPinType& PinType)
+	{
+		MixString(Hash, PinType.PinCategory.ToString());
+		MixString(Hash, PinType.PinSubCategory.ToString());
+		MixInt(Hash, reinterpret_cast<UPTRINT>(PinType.PinSubCategoryObject.Get()));
+		MixInt(Hash, (static_cast<uint64>(PinType.ContainerType) << 8)
+			| (PinType.bIsReference ? 2 : 0)
+			| (PinType.bIsConst ? 1 : 0));
+	}
+
+	/** 无法编译的条目（蓝图已被删除 / 回收，或模块卸载）也要回复挂起的请求 */
+	FUAL_BlueprintCompileResult MakeFailedResult(const FString& BlueprintPath, const FString& Status, const FString& Message)
+	{
+		FUAL_BlueprintCompileResult Result;
+		Result.BlueprintPath = BlueprintPath;
+		Result.Status = Status;
+
+		TSharedPtr<FJsonObject> Diagnostic = MakeShared<FJsonObject>();
+		Diagnostic->SetStringField(TEXT("type"), TEXT("Error"));
+		Diagnostic->SetStringField(TEXT("message"), Message);
+		Result.Diagnostics.Add(MakeShared<FJsonValueObject>(Diagnostic));
+		return Result;
+	}
+}
+
+TSharedPtr<FJsonObject> FUAL_BlueprintCompileResult::ToJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField(TEXT("ok"), bSuccess);
+	Obj->SetStringField(TEXT("status"), Status);
+	Obj->SetBoolField(TEXT("saved"), bSaved);
+	Obj->SetBoolField(TEXT("skipped"), bSkipped);
+	Obj->SetStringField(TEXT("path"), BlueprintPath);
+	Obj->SetNumberField(TEXT("duration_ms"), DurationMs);
+	Obj->SetArrayField(TEXT("diagnostics"), Diagnostics);
+	return Obj;
+}
+
+FUAL_BlueprintCompileScheduler& FUAL_BlueprintCompileScheduler::Get()
+{
+	static FUAL_BlueprintCompileScheduler Instance;
+	return Instance;
+}
+
+void FUAL_BlueprintCompileScheduler::Shutdown()
+{
+	if (FlushTickerHandle.IsValid())
+	{
+		UAL_CORE_TICKER.RemoveTicker(FlushTickerHandle);
+		FlushTickerHandle.Reset();
+	}
+
+	// 先取出队列再回调，回调中再次入队不会修改正在遍历的容器
+	TMap<TWeakObjectPtr<UBlueprint>, FPendingCompile> Cancelled = MoveTemp(Pending);
+	Pending.Reset();
+	for (const TPair<TWeakObjectPtr<UBlueprint>, FPendingCompile>& Pair : Cancelled)
+	{
+		const FUAL_BlueprintCompileResult Result = MakeFailedResult(Pair.Value.BlueprintPath, TEXT("Cancelled"),
+			TEXT("Compile queue was shut down before this blueprint was compiled"));
+		for (const FOnCompiled& Callback : Pair.Value.Callbacks)
+		{
+			Callback(Result);
+		}
+	}
+	Pending.Empty();
+	LastCompiles.Empty();
+}
+
+TArray<TSharedPtr<FJsonValue>> FUAL_BlueprintCompileScheduler::BuildDiagnostics(const FCompilerResultsLog& ResultsLog)
+{
+	TArray<TSharedPtr<FJsonValue>> Diagnostics;
+	for (const TSharedRef<FTokenizedMessage>& Msg : ResultsLog.Messages)
+	{
+		TSharedPtr<FJsonObject> D = MakeShared<FJsonObject>();
+
+		FString SeverityStr = TEXT("Info");
+		switch (Msg->GetSeverity())
+		{
+		case EMessageSeverity::Error:   SeverityStr = TEXT("Error"); break;
+		case EMessageSeverity::Warning: SeverityStr = TEXT("Warning"); break;
+		case EMessageSeverity::Info:    SeverityStr = TEXT("Info"); break;
+		default:                        SeverityStr = TEXT("Other"); break;
+		}
+		D->SetStringField(TEXT("type"), SeverityStr);
+		D->SetStringField(TEXT("message"), Msg->ToText().ToString());
+
+		// 尝试绑定 node_id（best-effort）
+		UObject* FoundObj = nullptr;
+		for (const TSharedRef<IMessageToken>& Tok : Msg->GetMessageTokens())
+		{
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+			if (Tok->GetType() == EMessageToken::Object)
+			{
+				const TSharedRef<FUObjectToken> ObjTok = StaticCastSharedRef<FUObjectToken>(Tok);
+				FoundObj = ObjTok->GetObject().Get();
+				if (FoundObj)
+				{
+					break;
+				}
+			}
+#else
+			// UE5.0: FObjectToken/FUObjectToken 不可用，跳过对象绑定
+			(void)Tok;
+#endif
+		}
+
+		if (UEdGraphNode* AsNode = Cast<UEdGraphNode>(FoundObj))
+		{
+			D->SetStringField(TEXT("node_id"), AsNode->NodeGuid.ToString(EGuidFormats::DigitsWithHyphens));
+		}
+
+		Diagnostics.Add(MakeShared<FJsonValueObject>(D));
+	}
+	return Diagnostics;
+}
+
+FString FUAL_BlueprintCompileScheduler::StatusToString(EBlueprintStatus Status)
+{
+	switch (Status)
+	{
+	case BS_UpToDate: return TEXT("UpToDate");
+	case BS_Dirty:    return TEXT("Dirty");
+	case BS_Error:    return TEXT("Error");
+	case BS_Unknown:  return TEXT("Unknown");
+	default:          return TEXT("Other");
+	}
+}
+
+uint64 FUAL_BlueprintCompileScheduler::ComputeFingerprint(UBlueprint* Blueprint)
+{
+	// 只覆盖影响编译结果的内容：父类、成员变量、节点类型与引脚（默认值 + 连线），不含节点位置
+	uint64 Hash = 0;
+	MixInt(Hash, reinterpret_cast<UPTRINT>(Blueprint->ParentClass.Get()));
+
+	for (const FBPVariableDescription& Var : Blueprint->NewVariables)
+	{
+		MixString(Hash, Var.VarName.ToString());
+		MixPinType(Hash, Var.VarType);
+		MixString(Hash, Var.DefaultValue);
+		MixInt(Hash, static_cast<uint64>(Var.PropertyFlags));
+	}
+
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+	for (UEdGraph* Graph : Graphs)
+	{
+		if (!Graph)
+		{
+			continue;
+		}
+		MixString(Hash, Graph->GetName());
+
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node)
+			{
+				continue;
+			}
+			MixInt(Hash, reinterpret_cast<UPTRINT>(Node->GetClass()));
+			MixInt(Hash, GetTypeHash(Node->NodeGuid));
+			MixInt(Hash, Node->IsNodeEnabled() ? 1 : 0);
+
+			for (UEdGraphPin* Pin : Node->Pins)
+			{
+				if (!Pin)
+				{
+					continue;
+				}
+				MixString(Hash, Pin->PinName.ToString());
+				MixInt(Hash, static_cast<uint64>(Pin->Direction));
+				MixPinType(Hash, Pin->PinType);
+				MixString(Hash, Pin->DefaultValue);
+				MixString(Hash, Pin->DefaultTextValue.ToString());
+				MixInt(Hash, reinterpret_cast<UPTRINT>(Pin->DefaultObject.Get()));
+
+				for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+				{
+					if (LinkedPin && LinkedPin->GetOwningNode())
+					{
+						MixInt(Hash, GetTypeHash(LinkedPin->GetOwningNode()->NodeGuid));
+						MixString(Hash, LinkedPin->PinName.ToString());
+					}
+				}
+			}
+		}
+	}
+	return Hash;
+}
+
+bool FUAL_BlueprintCompileScheduler::SaveBlueprint(UBlueprint* Blueprint)
+{
+	UPackage* Package = Blueprint ? Blueprint->GetOutermost() : nullptr;
+	if (!Package)
+	{
+		return false;
+	}
+
+	const FString PackageFileName = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 7
+	UPackage::Save(Package, Blueprint, *PackageFileName, SaveArgs);
+#else
+	UPackage::SavePackage(Package, Blueprint, *PackageFileName, SaveArgs);
+#endif
+	return true;
+}
+
+FUAL_BlueprintCompileResult FUAL_BlueprintCompileScheduler::CompileNow(UBlueprint* Blueprint, bool bForce, bool bSave)
+{
+	return CompileInternal(Blueprint, bForce, bSave, false);
+}
+
+FUAL_BlueprintCompileResult FUAL_BlueprintCompileScheduler::CompileInternal(UBlueprint* Blueprint, bool bForce, bool bSave, bool bSkipGarbageCollection)
+{
+	FUAL_BlueprintCompileResult Result;
+	if (!Blueprint)
+	{
+		Result.Status = TEXT("Unknown");
+		return Result;
+	}
+	Result.BlueprintPath = Blueprint->GetPathName();
+
+	const double StartTime = FPlatformTime::Seconds();
+	const uint64 Fingerprint = ComputeFingerprint(Blueprint);
+
+	// 上次成功编译后图表未变化：直接复用上次的结果
+	const FLastCompile* Last = LastCompiles.Find(Blueprint);
+	if (!bForce && Last && Last->Fingerprint == Fingerprint && Blueprint->Status == BS_UpToDate)
+	{
+		Result = Last->Result;
+		Result.bSkipped = true;
+		Result.bSaved = false;
+		if (bSave && Blueprint->GetOutermost() && Blueprint->GetOutermost()->IsDirty())
+		{
+			Result.bSaved = SaveBlueprint(Blueprint);
+		}
+		Result.DurationMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		return Result;
+	}
+
+	FCompilerResultsLog ResultsLog;
+	ResultsLog.bSilentMode = true;
+	ResultsLog.bLogInfoOnly = false;
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+	ResultsLog.bAnnotateMentionedNodes = true;
+#endif
+
+	// 批次内除最后一个蓝图外跳过 GC，避免每个蓝图都做一次完整的垃圾回收
+	const EBlueprintCompileOptions Options = bSkipGarbageCollection
+		? EBlueprintCompileOptions::SkipGarbageCollection
+		: EBlueprintCompileOptions::None;
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, Options, &ResultsLog);
+
+	Result.Diagnostics = BuildDiagnostics(ResultsLog);
+	Result.Status = StatusToString(Blueprint->Status);
+	Result.bSuccess = Blueprint->Status == BS_UpToDate;
+
+	// 保存（仅在编译成功时执行，避免写入坏蓝图）
+	if (bSave && Result.bSuccess)
+	{
+		Result.bSaved = SaveBlueprint(Blueprint);
+	}
+	Result.DurationMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	if (Result.bSuccess)
+	{
+		FLastCompile& Entry = LastCompiles.FindOrAdd(Blueprint);
+		Entry.Fingerprint = Fingerprint;
+		Entry.Result = Result;
+	}
+	else
+	{
+		LastCompiles.Remove(Blueprint);
+	}
+
+	UE_LOG(LogUALCompileScheduler, Verbose, TEXT("Compiled %s: %s (%.1f ms)"), *Result.BlueprintPath, *Result.Status, Result.DurationMs);
+	return Result;
+}
+
+void FUAL_BlueprintCompileScheduler::AddPending(UBlueprint* Blueprint, bool bForce, bool bSave, FOnCompiled OnCompiled)
+{
+	FPendingCompile& Entry = Pending.FindOrAdd(Blueprint);
+	Entry.Blueprint = Blueprint;
+	Entry.BlueprintPath = Blueprint->GetPathName();
+	Entry.bForce |= bForce;
+	Entry.bSave |= bSave;
+	if (OnCompiled)
+	{
+		Entry.Callbacks.Add(MoveTemp(OnCompiled));
+	}
+}
+
+int32 FUAL_BlueprintCompileScheduler::Enqueue(UBlueprint* Blueprint, bool bForce, bool bSave, bool bIncludeDependents, FOnCompiled OnCompiled)
+{
+	if (!Blueprint)
+	{
+		return Pending.Num();
+	}
+
+	AddPending(Blueprint, bForce, bSave, MoveTemp(OnCompiled));
+
+	if (bIncludeDependents)
+	{
+		TArray<UBlueprint*> Dependents;
+		FBlueprintEditorUtils::GetDependentBlueprints(Blueprint, Dependents);
+		for (UBlueprint* Dependent : Dependents)
+		{
+			if (Dependent && Dependent != Blueprint)
+			{
+				AddPending(Dependent, bForce, false, nullptr);
+			}
+		}
+	}
+
+	LastEnqueueTime = FPlatformTime::Seconds();
+	ScheduleFlush();
+	return Pending.Num();
+}
+
+void FUAL_BlueprintCompileScheduler::ScheduleFlush()
+{
+	if (FlushTickerHandle.IsValid())
+	{
+		return;
+	}
+	FlushTickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_BlueprintCompileScheduler::TickFlush), 0.1f);
+}
+
+bool FUAL_BlueprintCompileScheduler::TickFlush(float DeltaTime)
+{
+	if (Pending.Num() == 0)
+	{
+		FlushTickerHandle.Reset();
+		return false;
+	}
+
+	const double Delay = FMath::Max(0.0f, CVarBlueprintCompileDelay.GetValueOnGameThread());
+	if (FPlatformTime::Seconds() - LastEnqueueTime < Delay)
+	{
+		return true;
+	}
+
+	Flush();
+
+	// 回调中再次入队的蓝图：ScheduleFlush 因句柄仍有效而未注册新的 Ticker，由当前 Ticker 继续处理
+	if (Pending.Num() > 0)
+	{
+		return true;
+	}
+	FlushTickerHandle.Reset();
+	return false;
+}
+
+void FUAL_BlueprintCompileScheduler::SortByDependencies(TArray<FPendingCompile>& InOutBatch) const
+{
+	// Kahn 拓扑排序：父类蓝图与被引用的蓝图先编译；成环时按原顺序追加
+	const int32 Count = InOutBatch.Num();
+	TMap<const UBlueprint*, int32> IndexOf;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		IndexOf.Add(InOutBatch[Index].Blueprint.Get(), Index);
+	}
+
+	TArray<TArray<int32>> Dependents;
+	TArray<int32> InDegree;
+	Dependents.SetNum(Count);
+	InDegree.SetNumZeroed(Count);
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		UBlueprint* Blueprint = InOutBatch[Index].Blueprint.Get();
+		TSet<int32> DependencyIndices;
+
+		// 父类链
+		for (UClass* Parent = Blueprint->ParentClass; Parent; Parent = Parent->GetSuperClass())
+		{
+			if (const UBlueprint* ParentBP = Cast<UBlueprint>(Parent->ClassGeneratedBy))
+			{
+				if (const int32* DepIndex = IndexOf.Find(ParentBP))
+				{
+					DependencyIndices.Add(*DepIndex);
+				}
+			}
+		}
+
+		// 图表中引用的其他蓝图
+		TSet<TWeakObjectPtr<UBlueprint>> Dependencies;
+		TSet<TWeakObjectPtr<UStruct>> StructDependencies;
+		FBlueprintEditorUtils::GatherDependencies(Blueprint, Dependencies, StructDependencies);
+		for (const TWeakObjectPtr<UBlueprint>& Dependency : Dependencies)
+		{
+			if (const int32* DepIndex = IndexOf.Find(Dependency.Get()))
+			{
+				DependencyIndices.Add(*DepIndex);
+			}
+		}
+
+		DependencyIndices.Remove(Index);
+		for (int32 DepIndex : DependencyIndices)
+		{
+			Dependents[DepIndex].Add(Index);
+			InDegree[Index]++;
+		}
+	}
+
+	TArray<int32> Order;
+	Order.Reserve(Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (InDegree[Index] == 0)
+		{
+			Order.Add(Index);
+		}
+	}
+	for (int32 Cursor = 0; Cursor < Order.Num(); ++Cursor)
+	{
+		for (int32 Dependent : Dependents[Order[Cursor]])
+		{
+			if (--InDegree[Dependent] == 0)
+			{
+				Order.Add(Dependent);
+			}
+		}
+	}
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (InDegree[Index] > 0)
+		{
+			Order.Add(Index);
+		}
+	}
+
+	TArray<FPendingCompile> Sorted;
+	Sorted.Reserve(Count);
+	for (int32 Index : Order)
+	{
+		Sorted.Add(MoveTemp(InOutBatch[Index]));
+	}
+	InOutBatch = MoveTemp(Sorted);
+}
+
+int32 FUAL_BlueprintCompileScheduler::Flush()
+{
+	if (Pending.Num() == 0)
+	{
+		return 0;
+	}
+
+	// 先取出队列，回调中再次入队的请求留给下一批
+	TArray<FPendingCompile> Batch;
+	TArray<FPendingCompile> Invalid;
+	for (TPair<TWeakObjectPtr<UBlueprint>, FPendingCompile>& Pair : Pending)
+	{
+		if (Pair.Value.Blueprint.IsValid())
+		{
+			Batch.Add(MoveTemp(Pair.Value));
+		}
+		else
+		{
+			Invalid.Add(MoveTemp(Pair.Value));
+		}
+	}
+	Pending.Reset();
+
+	for (const FPendingCompile& Entry : Invalid)
+	{
+		const FUAL_BlueprintCompileResult Result = MakeFailedResult(Entry.BlueprintPath, TEXT("Invalid"),
+			TEXT("Blueprint was deleted or unloaded before the queued compile ran"));
+		for (const FOnCompiled& Callback : Entry.Callbacks)
+		{
+			Callback(Result);
+		}
+	}
+
+	SortByDependencies(Batch);
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 CompiledCount = 0;
+	int32 SkippedCount = 0;
+
+	for (int32 Index = 0; Index < Batch.Num(); ++Index)
+	{
+		FPendingCompile& Entry = Batch[Index];
+		UBlueprint* Blueprint = Entry.Blueprint.Get();
+		if (!Blueprint)
+		{
+			const FUAL_BlueprintCompileResult Result = MakeFailedResult(Entry.BlueprintPath, TEXT("Invalid"),
+				TEXT("Blueprint was deleted or unloaded before the queued compile ran"));
+			for (const FOnCompiled& Callback : Entry.Callbacks)
+			{
+				Callback(Result);
+			}
+			continue;
+		}
+
+		const bool bIsLast = Index == Batch.Num() - 1;
+		const FUAL_BlueprintCompileResult Result = CompileInternal(Blueprint, Entry.bForce, Entry.bSave, !bIsLast);
+		if (Result.bSkipped)
+		{
+			SkippedCount++;
+		}
+		else
+		{
+			CompiledCount++;
+		}
+
+		for (const FOnCompiled& Callback : Entry.Callbacks)
+		{
+			Callback(Result);
+		}
+
+		TSharedPtr<FJsonObject> EventPayload = Result.ToJson();
+		EventPayload->SetNumberField(TEXT("batch_index"), Index);
+		EventPayload->SetNumberField(TEXT("batch_size"), Batch.Num());
+		UAL_CommandUtils::SendEvent(TEXT("blueprint.compiled"), EventPayload);
+	}
+
+	UE_LOG(LogUALCompileScheduler, Log, TEXT("Flushed blueprint compile queue: %d compiled, %d skipped (%.1f ms)"),
+		CompiledCount, SkippedCount, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return CompiledCount + SkippedCount;
+}
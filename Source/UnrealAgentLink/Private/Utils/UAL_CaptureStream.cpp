@@ -0,0 +1,467 @@
+#include "UAL_CaptureStream.h"
+#include "UAL_VersionCompat.h"
+
+#include "Editor.h"
+#include "UnrealClient.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+#include "Async/Async.h"
+#include "Hash/CityHash.h"
+#include "RenderingThread.h"
+#include "RHIGPUReadback.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALCaptureStream, Log, All);
+
+namespace
+{
+	constexpr uint8 UALFrameFormatJpeg = 1;
+	constexpr int32 UALFrameHeaderSize = 20;
+
+	void WriteU16(TArray<uint8>& Out, int32 Offset, uint16 Value)
+	{
+		Out[Offset] = static_cast<uint8>(Value & 0xFF);
+		Out[Offset + 1] = static_cast<uint8>((Value >> 8) & 0xFF);
+	}
+
+	void WriteU32(TArray<uint8>& Out, int32 Offset, uint32 Value)
+	{
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			Out[Offset + Index] = static_cast<uint8>((Value >> (Index * 8)) & 0xFF);
+		}
+	}
+
+	/** 盒式滤波缩小（整数步长内取平均），比最近邻更少闪烁 */
+	void Downscale(const TArray<FColor>& Source, FIntPoint SourceSize, int32 MaxWidth, TArray<FColor>& Out, FIntPoint& OutSize)
+	{
+		if (SourceSize.X <= MaxWidth)
+		{
+			Out = Source;
+			OutSize = SourceSize;
+			return;
+		}
+
+		OutSize.X = MaxWidth;
+		OutSize.Y = FMath::Max(1, FMath::RoundToInt(static_cast<float>(SourceSize.Y) * MaxWidth / SourceSize.X));
+		Out.SetNumUninitialized(OutSize.X * OutSize.Y);
+
+		for (int32 Y = 0; Y < OutSize.Y; ++Y)
+		{
+			const int32 SrcY0 = Y * SourceSize.Y / OutSize.Y;
+			const int32 SrcY1 = FMath::Max(SrcY0 + 1, (Y + 1) * SourceSize.Y / OutSize.Y);
+			for (int32 X = 0; X < OutSize.X; ++X)
+			{
+				const int32 SrcX0 = X * SourceSize.X / OutSize.X;
+				const int32 SrcX1 = FMath::Max(SrcX0 + 1, (X + 1) * SourceSize.X / OutSize.X);
+
+				uint32 R = 0, G = 0, B = 0;
+				for (int32 SY = SrcY0; SY < SrcY1; ++SY)
+				{
+					const FColor* Row = Source.GetData() + SY * SourceSize.X;
+					for (int32 SX = SrcX0; SX < SrcX1; ++SX)
+					{
+						R += Row[SX].R;
+						G += Row[SX].G;
+						B += Row[SX].B;
+					}
+				}
+				const uint32 Count = (SrcY1 - SrcY0) * (SrcX1 - SrcX0);
+				Out[Y * OutSize.X + X] = FColor(R / Count, G / Count, B / Count, 255);
+			}
+		}
+	}
+}
+
+struct FUAL_CaptureStream::FCaptureReadback
+{
+	// 仅在渲染线程创建、轮询与释放
+	TUniquePtr<FRHIGPUTextureReadback> Readback;
+	FIntPoint Size = FIntPoint::ZeroValue;
+	bool bSwapRedBlue = false;
+
+	uint32 Seq = 0;
+	uint32 TimestampMs = 0;
+	int32 Generation = 0;
+	FSettings Settings;
+
+	// 已有尚未执行的轮询命令，避免每帧堆积
+	std::atomic<bool> bPollQueued{false};
+	// 像素已交给编码线程（或回读失败）
+	std::atomic<bool> bDone{false};
+};
+
+FUAL_CaptureStream& FUAL_CaptureStream::Get()
+{
+	static FUAL_CaptureStream Instance;
+	return Instance;
+}
+
+bool FUAL_CaptureStream::Start(const FSettings& InSettings, FString& OutError)
+{
+	if (!GEditor)
+	{
+		OutError = TEXT("Editor not available");
+		return false;
+	}
+
+	Stop();
+
+	FSettings Clamped = InSettings;
+	Clamped.Fps = FMath::Clamp(Clamped.Fps, 0.5f, 30.0f);
+	Clamped.MaxWidth = FMath::Clamp(Clamped.MaxWidth, 64, 3840);
+	Clamped.Quality = FMath::Clamp(Clamped.Quality, 10, 100);
+	Clamped.MaxUnacked = FMath::Max(0, Clamped.MaxUnacked);
+
+	// 模块加载必须在 GameThread 完成，编码线程只使用指针
+	ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+
+	++Generation;
+	InFlightReadback.Reset();
+	NextCaptureTime = 0.0;
+	NextSeq = 0;
+	LastSentSeq = 0;
+	LastAckedSeq = 0;
+	StartTime = FPlatformTime::Seconds();
+	{
+		FScopeLock Lock(&PendingLock);
+		Settings = Clamped;
+		PendingFrame.Reset();
+		PendingSeq = 0;
+		EncodedFrame.Reset();
+		EncodedSeq = 0;
+	}
+	LastFrameHash = 0;
+	FramesCaptured.Reset();
+	FramesSent.Reset();
+	FramesSkippedBusy.Reset();
+	FramesSkippedUnchanged.Reset();
+	FramesDropped.Reset();
+	BytesSent = 0;
+
+	TickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_CaptureStream::TickCapture), 0.0f);
+	UE_LOG(LogUALCaptureStream, Log, TEXT("Capture stream started: %.1f fps, max width %d, quality %d"), Settings.Fps, Settings.MaxWidth, Settings.Quality);
+	return true;
+}
+
+void FUAL_CaptureStream::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		UAL_CORE_TICKER.RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+		UE_LOG(LogUALCaptureStream, Log, TEXT("Capture stream stopped: %d sent, %d dropped"), FramesSent.GetValue(), FramesDropped.GetValue());
+	}
+	++Generation;
+	// 渲染线程上仍在进行的回读会因代次不符被丢弃
+	InFlightReadback.Reset();
+
+	FScopeLock Lock(&PendingLock);
+	PendingFrame.Reset();
+	EncodedFrame.Reset();
+}
+
+void FUAL_CaptureStream::Shutdown()
+{
+	Stop();
+
+	// 回读轮询命令与编码任务都持有 this，模块卸载前等待其全部结束
+	FlushRenderingCommands();
+	while (EncodesInFlight.GetValue() > 0)
+	{
+		FPlatformProcess::Sleep(0.001f);
+	}
+}
+
+bool FUAL_CaptureStream::TickCapture(float DeltaTime)
+{
+	// 编码完成的帧在 GameThread 上发送：WebSocket 发送统一在 GameThread 上进行
+	{
+		TArray<uint8> Frame;
+		uint32 Seq = 0;
+		{
+			FScopeLock Lock(&PendingLock);
+			Frame = MoveTemp(EncodedFrame);
+			EncodedFrame.Reset();
+			Seq = EncodedSeq;
+		}
+		if (Frame.Num() > 0)
+		{
+			SubmitFrame(MoveTemp(Frame), Seq);
+		}
+	}
+
+	// 每帧检查在途回读，就绪后立即交给编码线程
+	if (InFlightReadback.IsValid())
+	{
+		if (InFlightReadback->bDone)
+		{
+			InFlightReadback.Reset();
+		}
+		else
+		{
+			PollReadback(InFlightReadback);
+		}
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now < NextCaptureTime)
+	{
+		return true;
+	}
+	NextCaptureTime = Now + 1.0 / Settings.Fps;
+
+	if (!FUAL_NetworkManager::Get().IsConnected() || !GEditor)
+	{
+		return true;
+	}
+
+	// 上一帧还在回读或编码：跳过本次采集，绝不在 GameThread 上等待
+	if (InFlightReadback.IsValid() || EncodesInFlight.GetValue() > 0)
+	{
+		FramesSkippedBusy.Increment();
+		return true;
+	}
+
+	CaptureFrame();
+	return true;
+}
+
+void FUAL_CaptureStream::CaptureFrame()
+{
+	FViewport* Viewport = GEditor->GetActiveViewport();
+	if (!Viewport)
+	{
+		return;
+	}
+
+	const FIntPoint SourceSize = Viewport->GetSizeXY();
+	if (SourceSize.X <= 0 || SourceSize.Y <= 0)
+	{
+		return;
+	}
+
+	const uint32 TimestampMs = static_cast<uint32>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	// 持有 RHI 引用，视口在回读期间被销毁也不影响拷贝
+	FTexture2DRHIRef Texture = Viewport->GetRenderTargetTexture();
+	const EPixelFormat Format = Texture.IsValid() ? Texture->GetFormat() : PF_Unknown;
+	if (Format != PF_B8G8R8A8 && Format != PF_R8G8B8A8)
+	{
+		// 没有独立渲染目标（直接绘制到窗口后缓冲）或为 HDR 格式：退回同步读取
+		TArray<FColor> Pixels;
+		if (!Viewport->ReadPixels(Pixels) || Pixels.Num() != SourceSize.X * SourceSize.Y)
+		{
+			return;
+		}
+		FramesCaptured.Increment();
+		StartEncode(MoveTemp(Pixels), SourceSize, ++NextSeq, TimestampMs, Generation, Settings);
+		return;
+	}
+	FramesCaptured.Increment();
+
+	FCaptureReadbackPtr Readback = MakeShared<FCaptureReadback, ESPMode::ThreadSafe>();
+	Readback->Size = SourceSize;
+	Readback->bSwapRedBlue = Format == PF_R8G8B8A8;
+	Readback->Seq = ++NextSeq;
+	Readback->TimestampMs = TimestampMs;
+	Readback->Generation = Generation;
+	Readback->Settings = Settings;
+	InFlightReadback = Readback;
+
+	ENQUEUE_RENDER_COMMAND(UALCaptureStreamCopy)([Readback, Texture](FRHICommandListImmediate& RHICmdList)
+	{
+		Readback->Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("UALCaptureStream"));
+		Readback->Readback->EnqueueCopy(RHICmdList, Texture);
+	});
+}
+
+void FUAL_CaptureStream::PollReadback(const FCaptureReadbackPtr& Readback)
+{
+	if (Readback->bPollQueued.exchange(true))
+	{
+		return;
+	}
+
+	ENQUEUE_RENDER_COMMAND(UALCaptureStreamPoll)([this, Readback](FRHICommandListImmediate& RHICmdList)
+	{
+		Readback->bPollQueued = false;
+		if (!Readback->Readback.IsValid() || !Readback->Readback->IsReady())
+		{
+			return;
+		}
+
+		const FIntPoint Size = Readback->Size;
+		TArray<FColor> Pixels;
+		int32 RowPitchInPixels = 0;
+		if (const uint8* Data = static_cast<const uint8*>(UALCompat::LockTextureReadback(*Readback->Readback, RowPitchInPixels)))
+		{
+			if (RowPitchInPixels >= Size.X)
+			{
+				Pixels.SetNumUninitialized(Size.X * Size.Y);
+				for (int32 Y = 0; Y < Size.Y; ++Y)
+				{
+					FMemory::Memcpy(Pixels.GetData() + Y * Size.X, Data + static_cast<int64>(Y) * RowPitchInPixels * sizeof(FColor), Size.X * sizeof(FColor));
+				}
+			}
+			Readback->Readback->Unlock();
+		}
+		Readback->Readback.Reset();
+
+		// RGBA 渲染目标：FColor 为 BGRA 排列，交换 R / B
+		if (Readback->bSwapRedBlue)
+		{
+			for (FColor& Pixel : Pixels)
+			{
+				Swap(Pixel.R, Pixel.B);
+			}
+		}
+
+		if (Pixels.Num() > 0 && Readback->Generation == Generation)
+		{
+			StartEncode(MoveTemp(Pixels), Size, Readback->Seq, Readback->TimestampMs, Readback->Generation, Readback->Settings);
+		}
+		Readback->bDone = true;
+	});
+}
+
+void FUAL_CaptureStream::StartEncode(TArray<FColor>&& Pixels, FIntPoint SourceSize, uint32 Seq, uint32 TimestampMs, int32 InGeneration, const FSettings& FrameSettings)
+{
+	EncodesInFlight.Increment();
+	Async(EAsyncExecution::ThreadPool, [this, Pixels = MoveTemp(Pixels), SourceSize, Seq, TimestampMs, InGeneration, FrameSettings]() mutable
+	{
+		EncodeFrame(MoveTemp(Pixels), SourceSize, Seq, TimestampMs, InGeneration, FrameSettings);
+		EncodesInFlight.Decrement();
+	});
+}
+
+void FUAL_CaptureStream::EncodeFrame(TArray<FColor> Pixels, FIntPoint SourceSize, uint32 Seq, uint32 TimestampMs, int32 InGeneration, const FSettings& FrameSettings)
+{
+	TArray<FColor> Scaled;
+	FIntPoint Size;
+	Downscale(Pixels, SourceSize, FrameSettings.MaxWidth, Scaled, Size);
+
+	// 画面无变化时不发送
+	const uint64 Hash = CityHash64(reinterpret_cast<const char*>(Scaled.GetData()), Scaled.Num() * sizeof(FColor));
+	if (FrameSettings.bSkipUnchanged && Hash == LastFrameHash)
+	{
+		FramesSkippedUnchanged.Increment();
+		return;
+	}
+	LastFrameHash = Hash;
+
+	TSharedPtr<IImageWrapper> Wrapper = ImageWrapperModule ? ImageWrapperModule->CreateImageWrapper(EImageFormat::JPEG) : nullptr;
+	if (!Wrapper.IsValid() || !Wrapper->SetRaw(Scaled.GetData(), Scaled.Num() * sizeof(FColor), Size.X, Size.Y, ERGBFormat::BGRA, 8))
+	{
+		return;
+	}
+
+	TArray<uint8> Encoded;
+	if (!UALCompat::GetCompressedImage(Wrapper, FrameSettings.Quality, Encoded))
+	{
+		return;
+	}
+
+	if (InGeneration != Generation)
+	{
+		return;
+	}
+
+	TArray<uint8> Frame;
+	Frame.SetNumZeroed(UALFrameHeaderSize);
+	Frame[0] = 'U';
+	Frame[1] = 'A';
+	Frame[2] = 'L';
+	Frame[3] = 'F';
+	WriteU32(Frame, 4, Seq);
+	WriteU16(Frame, 8, static_cast<uint16>(Size.X));
+	WriteU16(Frame, 10, static_cast<uint16>(Size.Y));
+	Frame[12] = UALFrameFormatJpeg;
+	WriteU32(Frame, 16, TimestampMs);
+	Frame.Append(Encoded);
+
+	// 交给 GameThread 的 Ticker 发送；停止推流后代次不符，直接丢弃
+	FScopeLock Lock(&PendingLock);
+	if (InGeneration != Generation)
+	{
+		return;
+	}
+	if (EncodedFrame.Num() > 0)
+	{
+		FramesDropped.Increment();
+	}
+	EncodedFrame = MoveTemp(Frame);
+	EncodedSeq = Seq;
+}
+
+void FUAL_CaptureStream::SubmitFrame(TArray<uint8>&& Frame, uint32 Seq)
+{
+	{
+		FScopeLock Lock(&PendingLock);
+		const bool bWindowFull = Settings.MaxUnacked > 0
+			&& LastSentSeq - LastAckedSeq >= static_cast<uint32>(Settings.MaxUnacked);
+		if (bWindowFull)
+		{
+			// 背压：只保留最新一帧，被替换的旧帧计入丢弃
+			if (PendingFrame.Num() > 0)
+			{
+				FramesDropped.Increment();
+			}
+			PendingFrame = MoveTemp(Frame);
+			PendingSeq = Seq;
+			return;
+		}
+		LastSentSeq = Seq;
+	}
+
+	FUAL_NetworkManager::Get().SendBinary(Frame.GetData(), Frame.Num());
+	FramesSent.Increment();
+	BytesSent += Frame.Num();
+}
+
+void FUAL_CaptureStream::Ack(uint32 Seq)
+{
+	TArray<uint8> FrameToSend;
+	{
+		FScopeLock Lock(&PendingLock);
+		// 重启前的旧确认或异常客户端可能确认尚未发送的帧；不截断会使 LastSentSeq - LastAckedSeq 回绕，推流永久阻塞
+		Seq = FMath::Min(Seq, LastSentSeq.load());
+		if (Seq > LastAckedSeq)
+		{
+			LastAckedSeq = Seq;
+		}
+
+		const bool bWindowOpen = Settings.MaxUnacked == 0
+			|| LastSentSeq - LastAckedSeq < static_cast<uint32>(Settings.MaxUnacked);
+		if (!bWindowOpen || PendingFrame.Num() == 0)
+		{
+			return;
+		}
+		FrameToSend = MoveTemp(PendingFrame);
+		PendingFrame.Reset();
+		LastSentSeq = PendingSeq;
+	}
+
+	FUAL_NetworkManager::Get().SendBinary(FrameToSend.GetData(), FrameToSend.Num());
+	FramesSent.Increment();
+	BytesSent += FrameToSend.Num();
+}
+
+TSharedPtr<FJsonObject> FUAL_CaptureStream::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Stats = MakeShared<FJsonObject>();
+	Stats->SetBoolField(TEXT("running"), IsRunning());
+	Stats->SetNumberField(TEXT("fps"), Settings.Fps);
+	Stats->SetNumberField(TEXT("max_width"), Settings.MaxWidth);
+	Stats->SetNumberField(TEXT("quality"), Settings.Quality);
+	Stats->SetNumberField(TEXT("max_unacked"), Settings.MaxUnacked);
+	Stats->SetNumberField(TEXT("frames_captured"), FramesCaptured.GetValue());
+	Stats->SetNumberField(TEXT("frames_sent"), FramesSent.GetValue());
+	Stats->SetNumberField(TEXT("frames_skipped_busy"), FramesSkippedBusy.GetValue());
+	Stats->SetNumberField(TEXT("frames_skipped_unchanged"), FramesSkippedUnchanged.GetValue());
+	Stats->SetNumberField(TEXT("frames_dropped"), FramesDropped.GetValue());
+	Stats->SetNumberField(TEXT("bytes_sent"), static_cast<double>(BytesSent.load()));
+	Stats->SetNumberField(TEXT("last_sent_seq"), LastSentSeq.load());
+	Stats->SetNumberField(TEXT("last_acked_seq"), LastAckedSeq.load());
+	return Stats;
+}
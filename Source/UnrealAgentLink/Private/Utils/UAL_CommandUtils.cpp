@@ -1,5 +1,9 @@
 #include "UAL_CommandUtils.h"
 #include "UAL_NetworkManager.h"
+#include "UAL_PropertyPathCache.h"
+#include "UAL_FuzzyMatch.h"
+#include "UAL_ResponseCache.h"
+#include "UAL_LocalServer.h"
 #include "Internationalization/Internationalization.h"
 #include "Internationalization/Culture.h"
 #include "Engine/World.h"
@@ -15,6 +19,7 @@
 #include "Engine/Blueprint.h"
 #include "Components/SceneComponent.h"
 #include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 #include "JsonObjectConverter.h"
 #include "Algo/Sort.h"
 #include "Misc/EngineVersion.h"
@@ -652,15 +657,15 @@ bool UAL_CommandUtils::CheckPropertyMatch(AActor* Actor, const FString& PropName
 	return false;
 }
 
-bool UAL_CommandUtils::ApplyStructValue(FStructProperty* StructProp, UObject* Target, const TSharedPtr<FJsonValue>& JsonValue)
+bool UAL_CommandUtils::ApplyStructValue(FStructProperty* StructProp, void* Container, const TSharedPtr<FJsonValue>& JsonValue)
 {
-	if (!StructProp || !Target || !JsonValue.IsValid() || JsonValue->Type != EJson::Object)
+	if (!StructProp || !Container || !JsonValue.IsValid() || JsonValue->Type != EJson::Object)
 	{
 		return false;
 	}
 
 	const TSharedPtr<FJsonObject> Obj = JsonValue->AsObject();
-	void* StructPtr = StructProp->ContainerPtrToValuePtr<void>(Target);
+	void* StructPtr = StructProp->ContainerPtrToValuePtr<void>(Container);
 	if (!StructPtr || !Obj.IsValid())
 	{
 		return false;
@@ -707,24 +712,20 @@ bool UAL_CommandUtils::TryCollectProperty(UObject* Obj, const FString& PropName,
 		return false;
 	}
 
-	FProperty* Prop = FindFProperty<FProperty>(Obj->GetClass(), *PropName);
-	if (!Prop)
+	// 支持点分路径（如 RootComponent.RelativeLocation.X），解析结果按类缓存
+	FUAL_ResolvedProperty Resolved;
+	if (!FUAL_PropertyPathCache::Get().Resolve(Obj, PropName, FUAL_PropertyPathCache::EAccess::Read, Resolved))
 	{
 		return false;
 	}
 
-	if (Prop->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated | CPF_EditorOnly | CPF_DisableEditOnInstance))
-	{
-		return false;
-	}
-
-	const void* ValuePtr = Prop->ContainerPtrToValuePtr<void>(Obj);
+	const void* ValuePtr = Resolved.GetValuePtr();
 	if (!ValuePtr)
 	{
 		return false;
 	}
 
-	TSharedPtr<FJsonValue> JsonValue = PropertyToJsonValueCompat(Prop, ValuePtr);
+	TSharedPtr<FJsonValue> JsonValue = PropertyToJsonValueCompat(Resolved.Property, ValuePtr);
 	if (!JsonValue.IsValid())
 	{
 		return false;
@@ -741,85 +742,21 @@ void UAL_CommandUtils::CollectPropertyNames(UObject* Obj, TArray<FString>& OutNa
 		return;
 	}
 
-	for (TFieldIterator<FProperty> It(Obj->GetClass()); It; ++It)
+	for (const FString& Name : FUAL_PropertyPathCache::Get().GetSuggestionCandidates(Obj->GetClass()))
 	{
-		FProperty* Prop = *It;
-		if (!Prop)
-		{
-			continue;
-		}
-		if (Prop->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated | CPF_EditorOnly | CPF_DisableEditOnInstance))
-		{
-			continue;
-		}
-		if (!Prop->HasAnyPropertyFlags(CPF_Edit | CPF_BlueprintVisible | CPF_BlueprintReadOnly))
-		{
-			continue;
-		}
-		OutNames.AddUnique(Prop->GetName());
+		OutNames.AddUnique(Name);
 	}
 }
 
 int32 UAL_CommandUtils::LevenshteinDistance(const FString& A, const FString& B)
 {
-	const int32 LenA = A.Len();
-	const int32 LenB = B.Len();
-	TArray<int32> Prev, Curr;
-	Prev.SetNum(LenB + 1);
-	Curr.SetNum(LenB + 1);
-
-	for (int32 j = 0; j <= LenB; ++j)
-	{
-		Prev[j] = j;
-	}
-
-	for (int32 i = 1; i <= LenA; ++i)
-	{
-		Curr[0] = i;
-		for (int32 j = 1; j <= LenB; ++j)
-		{
-			const int32 Cost = (FChar::ToLower(A[i - 1]) == FChar::ToLower(B[j - 1])) ? 0 : 1;
-			Curr[j] = FMath::Min3(
-				Curr[j - 1] + 1,
-				Prev[j] + 1,
-				Prev[j - 1] + Cost
-			);
-		}
-		Swap(Prev, Curr);
-	}
-	return Prev[LenB];
+	return FUAL_FuzzyMatcher::EditDistance(A, B);
 }
 
 void UAL_CommandUtils::SuggestProperties(const FString& Input, const TArray<FString>& Candidates, TArray<FString>& OutSuggestions, int32 MaxSuggestions)
 {
-	struct FScore
-	{
-		FString Name;
-		int32 Distance = 0;
-	};
-
-	TArray<FScore> Scores;
-	for (const FString& Cand : Candidates)
-	{
-		FScore S;
-		S.Name = Cand;
-		S.Distance = LevenshteinDistance(Input, Cand);
-		Scores.Add(S);
-	}
-
-	Scores.Sort([](const FScore& L, const FScore& R)
-	{
-		if (L.Distance == R.Distance)
-		{
-			return L.Name < R.Name;
-		}
-		return L.Distance < R.Distance;
-	});
-
-	for (int32 i = 0; i < Scores.Num() && OutSuggestions.Num() < MaxSuggestions; ++i)
-	{
-		OutSuggestions.Add(Scores[i].Name);
-	}
+	// 位并行编辑距离 + Top-K 截断，结果顺序与旧版"全量打分后排序"一致
+	FUAL_FuzzyMatcher::FindClosest(Input, Candidates, MaxSuggestions - OutSuggestions.Num(), OutSuggestions);
 }
 
 AActor* UAL_CommandUtils::FindActorByLabel(UWorld* World, const FString& Label)
@@ -1029,71 +966,69 @@ bool UAL_CommandUtils::ShouldIncludeActorAdvanced(
 
 FProperty* UAL_CommandUtils::FindWritableProperty(UObject* Obj, const FString& PropName)
 {
-	if (!Obj)
-	{
-		return nullptr;
-	}
-	FProperty* Prop = FindFProperty<FProperty>(Obj->GetClass(), *PropName);
-	if (!Prop)
+	FUAL_ResolvedProperty Resolved;
+	if (!FUAL_PropertyPathCache::Get().Resolve(Obj, PropName, FUAL_PropertyPathCache::EAccess::Write, Resolved))
 	{
 		return nullptr;
 	}
-	if (Prop->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated | CPF_EditorOnly | CPF_DisableEditOnInstance))
-	{
-		return nullptr;
-	}
-	if (!Prop->HasAnyPropertyFlags(CPF_Edit | CPF_BlueprintVisible | CPF_BlueprintReadOnly))
+	// 旧接口按 (Prop, Obj) 写入，只能返回直接挂在 Obj 上的属性；嵌套路径请使用 ResolveWritablePropertyOnActorHierarchy
+	return Resolved.Container == Obj ? Resolved.Property : nullptr;
+}
+
+FProperty* UAL_CommandUtils::FindWritablePropertyOnActorHierarchy(AActor* Actor, const FString& PropName, UObject*& OutTargetObj)
+{
+	OutTargetObj = nullptr;
+	FUAL_ResolvedProperty Resolved;
+	if (!ResolveWritablePropertyOnActorHierarchy(Actor, PropName, Resolved) || Resolved.Container != Resolved.OwnerObject)
 	{
 		return nullptr;
 	}
-	return Prop;
+	OutTargetObj = Resolved.OwnerObject;
+	return Resolved.Property;
 }
 
-FProperty* UAL_CommandUtils::FindWritablePropertyOnActorHierarchy(AActor* Actor, const FString& PropName, UObject*& OutTargetObj)
+bool UAL_CommandUtils::ResolveWritablePropertyOnActorHierarchy(AActor* Actor, const FString& PropPath, FUAL_ResolvedProperty& OutResolved)
 {
-	OutTargetObj = nullptr;
 	if (!Actor)
 	{
-		return nullptr;
+		return false;
 	}
 
+	FUAL_PropertyPathCache& Cache = FUAL_PropertyPathCache::Get();
+	constexpr FUAL_PropertyPathCache::EAccess Access = FUAL_PropertyPathCache::EAccess::Write;
+
 	// 1) Actor Self
-	if (FProperty* Prop = FindWritableProperty(Actor, PropName))
+	if (Cache.Resolve(Actor, PropPath, Access, OutResolved))
 	{
-		OutTargetObj = Actor;
-		return Prop;
+		return true;
 	}
 
 	// 2) RootComponent
-	if (USceneComponent* RootComp = Actor->GetRootComponent())
+	USceneComponent* RootComp = Actor->GetRootComponent();
+	if (RootComp && Cache.Resolve(RootComp, PropPath, Access, OutResolved))
 	{
-		if (FProperty* Prop = FindWritableProperty(RootComp, PropName))
-		{
-			OutTargetObj = RootComp;
-			return Prop;
-		}
+		return true;
 	}
 
 	// 3) Other Components
 	for (UActorComponent* Comp : Actor->GetComponents())
 	{
-		if (!Comp)
+		if (!Comp || Comp == RootComp)
 		{
 			continue;
 		}
-		if (FProperty* Prop = FindWritableProperty(Comp, PropName))
+		if (Cache.Resolve(Comp, PropPath, Access, OutResolved))
 		{
-			OutTargetObj = Comp;
-			return Prop;
+			return true;
 		}
 	}
 
-	return nullptr;
+	return false;
 }
 
-bool UAL_CommandUtils::SetNumericProperty(FNumericProperty* NumProp, UObject* Obj, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+bool UAL_CommandUtils::SetNumericProperty(FNumericProperty* NumProp, void* Container, const TSharedPtr<FJsonValue>& Value, FString& OutError)
 {
-	if (!NumProp || !Obj || !Value.IsValid())
+	if (!NumProp || !Container || !Value.IsValid())
 	{
 		return false;
 	}
@@ -1103,7 +1038,7 @@ bool UAL_CommandUtils::SetNumericProperty(FNumericProperty* NumProp, UObject* Ob
 		return false;
 	}
 	const double Num = Value->AsNumber();
-	void* Ptr = NumProp->ContainerPtrToValuePtr<void>(Obj);
+	void* Ptr = NumProp->ContainerPtrToValuePtr<void>(Container);
 	if (!Ptr)
 	{
 		return false;
@@ -1119,9 +1054,9 @@ bool UAL_CommandUtils::SetNumericProperty(FNumericProperty* NumProp, UObject* Ob
 	return true;
 }
 
-bool UAL_CommandUtils::SetStructProperty(FStructProperty* StructProp, UObject* Obj, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+bool UAL_CommandUtils::SetStructProperty(FStructProperty* StructProp, void* Container, const TSharedPtr<FJsonValue>& Value, FString& OutError)
 {
-	if (!StructProp || !Obj || !Value.IsValid())
+	if (!StructProp || !Container || !Value.IsValid())
 	{
 		return false;
 	}
@@ -1129,7 +1064,7 @@ bool UAL_CommandUtils::SetStructProperty(FStructProperty* StructProp, UObject* O
 	if (StructProp->Struct == TBaseStructure<FVector>::Get() ||
 		StructProp->Struct == TBaseStructure<FRotator>::Get())
 	{
-		if (!ApplyStructValue(StructProp, Obj, Value))
+		if (!ApplyStructValue(StructProp, Container, Value))
 		{
 			OutError = TEXT("expects object with matching fields");
 			return false;
@@ -1150,7 +1085,7 @@ bool UAL_CommandUtils::SetStructProperty(FStructProperty* StructProp, UObject* O
 		ObjVal->TryGetNumberField(TEXT("g"), G);
 		ObjVal->TryGetNumberField(TEXT("b"), B);
 		ObjVal->TryGetNumberField(TEXT("a"), A);
-		void* Ptr = StructProp->ContainerPtrToValuePtr<void>(Obj);
+		void* Ptr = StructProp->ContainerPtrToValuePtr<void>(Container);
 		if (!Ptr)
 		{
 			return false;
@@ -1191,7 +1126,7 @@ bool UAL_CommandUtils::SetStructProperty(FStructProperty* StructProp, UObject* O
 			A = 255.0;
 		}
 		
-		void* Ptr = StructProp->ContainerPtrToValuePtr<void>(Obj);
+		void* Ptr = StructProp->ContainerPtrToValuePtr<void>(Container);
 		if (!Ptr)
 		{
 			return false;
@@ -1209,9 +1144,9 @@ bool UAL_CommandUtils::SetStructProperty(FStructProperty* StructProp, UObject* O
 	return false;
 }
 
-bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, void* Container, const TSharedPtr<FJsonValue>& Value, FString& OutError)
 {
-	if (!Prop || !Obj || !Value.IsValid())
+	if (!Prop || !Container || !Value.IsValid())
 	{
 		return false;
 	}
@@ -1262,7 +1197,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 				return false;
 			}
 			FNumericProperty* UnderlyingProp = EnumProp->GetUnderlyingProperty();
-			void* Ptr = EnumProp->ContainerPtrToValuePtr<void>(Obj);
+			void* Ptr = EnumProp->ContainerPtrToValuePtr<void>(Container);
 			if (!Ptr || !UnderlyingProp)
 			{
 				return false;
@@ -1274,7 +1209,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 
 	if (FNumericProperty* NumProp = CastField<FNumericProperty>(Prop))
 	{
-		return SetNumericProperty(NumProp, Obj, Value, OutError);
+		return SetNumericProperty(NumProp, Container, Value, OutError);
 	}
 
 	if (FBoolProperty* BoolProp = CastField<FBoolProperty>(Prop))
@@ -1303,7 +1238,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 			return false;
 		}
 		
-		void* Ptr = BoolProp->ContainerPtrToValuePtr<void>(Obj);
+		void* Ptr = BoolProp->ContainerPtrToValuePtr<void>(Container);
 		if (!Ptr)
 		{
 			return false;
@@ -1319,7 +1254,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 			OutError = TEXT("expects a string");
 			return false;
 		}
-		void* Ptr = StrProp->ContainerPtrToValuePtr<void>(Obj);
+		void* Ptr = StrProp->ContainerPtrToValuePtr<void>(Container);
 		if (!Ptr)
 		{
 			return false;
@@ -1335,7 +1270,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 			OutError = TEXT("expects a string");
 			return false;
 		}
-		void* Ptr = NameProp->ContainerPtrToValuePtr<void>(Obj);
+		void* Ptr = NameProp->ContainerPtrToValuePtr<void>(Container);
 		if (!Ptr)
 		{
 			return false;
@@ -1351,7 +1286,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 			OutError = TEXT("expects a string");
 			return false;
 		}
-		void* Ptr = TextProp->ContainerPtrToValuePtr<void>(Obj);
+		void* Ptr = TextProp->ContainerPtrToValuePtr<void>(Container);
 		if (!Ptr)
 		{
 			return false;
@@ -1362,7 +1297,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 
 	if (FStructProperty* StructProp = CastField<FStructProperty>(Prop))
 	{
-		return SetStructProperty(StructProp, Obj, Value, OutError);
+		return SetStructProperty(StructProp, Container, Value, OutError);
 	}
 
 	// === FObjectProperty 支持（硬引用，如 StaticMesh, Material 等） ===
@@ -1386,7 +1321,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 		else if (Value->Type == EJson::Null)
 		{
 			// 允许设置为 null（清空引用）
-			void* Ptr = ObjProp->ContainerPtrToValuePtr<void>(Obj);
+			void* Ptr = ObjProp->ContainerPtrToValuePtr<void>(Container);
 			if (Ptr)
 			{
 				ObjProp->SetPropertyValue(Ptr, nullptr);
@@ -1499,7 +1434,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 		}
 
 		// 设置属性值
-		void* Ptr = ObjProp->ContainerPtrToValuePtr<void>(Obj);
+		void* Ptr = ObjProp->ContainerPtrToValuePtr<void>(Container);
 		if (!Ptr)
 		{
 			OutError = TEXT("Failed to get property value pointer");
@@ -1521,7 +1456,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 		}
 		else if (Value->Type == EJson::Null)
 		{
-			void* Ptr = SoftObjProp->ContainerPtrToValuePtr<void>(Obj);
+			void* Ptr = SoftObjProp->ContainerPtrToValuePtr<void>(Container);
 			if (Ptr)
 			{
 				*static_cast<FSoftObjectPtr*>(Ptr) = FSoftObjectPtr();
@@ -1535,7 +1470,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 			return false;
 		}
 
-		void* Ptr = SoftObjProp->ContainerPtrToValuePtr<void>(Obj);
+		void* Ptr = SoftObjProp->ContainerPtrToValuePtr<void>(Container);
 		if (!Ptr)
 		{
 			return false;
@@ -1559,7 +1494,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 			return false;
 		}
 
-		void* Ptr = SoftClassProp->ContainerPtrToValuePtr<void>(Obj);
+		void* Ptr = SoftClassProp->ContainerPtrToValuePtr<void>(Container);
 		if (!Ptr)
 		{
 			return false;
@@ -1578,7 +1513,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 		}
 		else if (Value->Type == EJson::Null)
 		{
-			void* Ptr = ClassProp->ContainerPtrToValuePtr<void>(Obj);
+			void* Ptr = ClassProp->ContainerPtrToValuePtr<void>(Container);
 			if (Ptr)
 			{
 				ClassProp->SetPropertyValue(Ptr, nullptr);
@@ -1608,7 +1543,7 @@ bool UAL_CommandUtils::SetSimpleProperty(FProperty* Prop, UObject* Obj, const TS
 			return false;
 		}
 
-		void* Ptr = ClassProp->ContainerPtrToValuePtr<void>(Obj);
+		void* Ptr = ClassProp->ContainerPtrToValuePtr<void>(Container);
 		if (!Ptr)
 		{
 			return false;
@@ -1694,10 +1629,17 @@ void UAL_CommandUtils::SendResponse(const FString& RequestId, int32 Code, const
 		return;
 	}
 
+	FUAL_ResponseCache::Get().Capture(RequestId, Code, Data);
+
+	// 本地客户端的请求：还原原始 ID 后发回该客户端
+	int32 LocalClientId = 0;
+	FString OriginalId;
+	const bool bLocal = FUAL_LocalServer::ParseRoutedId(RequestId, LocalClientId, OriginalId);
+
 	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
 	Root->SetStringField(TEXT("ver"), TEXT("1.0"));
 	Root->SetStringField(TEXT("type"), TEXT("res"));
-	Root->SetStringField(TEXT("id"), RequestId);
+	Root->SetStringField(TEXT("id"), bLocal ? OriginalId : RequestId);
 	Root->SetNumberField(TEXT("code"), Code);
 	if (Data.IsValid())
 	{
@@ -1708,6 +1650,46 @@ void UAL_CommandUtils::SendResponse(const FString& RequestId, int32 Code, const
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
 	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
 	
+	if (bLocal)
+	{
+		FUAL_LocalServer::Get().SendToClient(LocalClientId, OutputString);
+		return;
+	}
+	FUAL_NetworkManager::Get().SendMessage(OutputString);
+}
+
+void UAL_CommandUtils::SendRawResponse(const FString& RequestId, int32 Code, const FString& ResultJson)
+{
+	if (RequestId.IsEmpty())
+	{
+		return;
+	}
+
+	int32 LocalClientId = 0;
+	FString OriginalId;
+	const bool bLocal = FUAL_LocalServer::ParseRoutedId(RequestId, LocalClientId, OriginalId);
+
+	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("ver"), TEXT("1.0"));
+	Root->SetStringField(TEXT("type"), TEXT("res"));
+	Root->SetStringField(TEXT("id"), bLocal ? OriginalId : RequestId);
+	Root->SetNumberField(TEXT("code"), Code);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutputString);
+	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+
+	// 去掉结尾的 "}" 后拼接 result，避免重新序列化缓存的结果
+	OutputString.LeftChopInline(1);
+	OutputString += TEXT(",\"result\":");
+	OutputString += ResultJson;
+	OutputString += TEXT("}");
+
+	if (bLocal)
+	{
+		FUAL_LocalServer::Get().SendToClient(LocalClientId, OutputString);
+		return;
+	}
 	FUAL_NetworkManager::Get().SendMessage(OutputString);
 }
 
@@ -1745,4 +1727,5 @@ void UAL_CommandUtils::SendEvent(const FString& Method, const TSharedPtr<FJsonOb
 	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
 	
 	FUAL_NetworkManager::Get().SendMessage(OutputString);
+	FUAL_LocalServer::Get().BroadcastEvent(Method, OutputString);
 }
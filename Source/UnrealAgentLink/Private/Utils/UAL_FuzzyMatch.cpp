@@ -0,0 +1,385 @@
+#include "UAL_FuzzyMatch.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALFuzzy, Log, All);
+
+namespace
+{
+	// 超出预算时的返回值：负预算下 MaxDistance + 1 可能为 0，会被误认为完全匹配
+	FORCEINLINE int32 UALExceeded(int32 MaxDistance)
+	{
+		return (MaxDistance < 0 || MaxDistance == MAX_int32) ? MAX_int32 : MaxDistance + 1;
+	}
+}
+
+FUAL_FuzzyMatcher::FUAL_FuzzyMatcher(const FString& InPattern)
+	: Pattern(InPattern.ToLower())
+{
+	FMemory::Memzero(AsciiPeq, sizeof(AsciiPeq));
+
+	bBitParallel = Pattern.Len() <= 64;
+	if (!bBitParallel)
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < Pattern.Len(); ++Index)
+	{
+		const TCHAR C = Pattern[Index];
+		const uint64 Bit = 1ull << Index;
+		if (static_cast<uint32>(C) < 128)
+		{
+			AsciiPeq[C] |= Bit;
+			continue;
+		}
+
+		TPair<TCHAR, uint64>* Found = ExtendedPeq.FindByPredicate([C](const TPair<TCHAR, uint64>& Pair) { return Pair.Key == C; });
+		if (Found)
+		{
+			Found->Value |= Bit;
+		}
+		else
+		{
+			ExtendedPeq.Emplace(C, Bit);
+		}
+	}
+}
+
+uint64 FUAL_FuzzyMatcher::GetPeq(TCHAR C) const
+{
+	if (static_cast<uint32>(C) < 128)
+	{
+		return AsciiPeq[C];
+	}
+	for (const TPair<TCHAR, uint64>& Pair : ExtendedPeq)
+	{
+		if (Pair.Key == C)
+		{
+			return Pair.Value;
+		}
+	}
+	return 0;
+}
+
+int32 FUAL_FuzzyMatcher::Distance(const FString& Text, int32 MaxDistance) const
+{
+	if (MaxDistance < 0 || !PassesLengthFilter(Text, MaxDistance))
+	{
+		return UALExceeded(MaxDistance);
+	}
+	if (Pattern.Len() == 0 || Text.Len() == 0)
+	{
+		return FMath::Max(Pattern.Len(), Text.Len());
+	}
+	return bBitParallel ? MyersDistance(Text, MaxDistance) : BandedDistance(Text, MaxDistance);
+}
+
+int32 FUAL_FuzzyMatcher::MyersDistance(const FString& Text, int32 MaxDistance) const
+{
+	// Myers / Hyyrö 位并行算法：Pv/Mv 记录当前列的纵向 +1/-1 差分，Score 跟踪最后一行的值
+	const int32 M = Pattern.Len();
+	const int32 N = Text.Len();
+	const uint64 HighBit = 1ull << (M - 1);
+
+	uint64 Pv = ~0ull;
+	uint64 Mv = 0;
+	int32 Score = M;
+
+	for (int32 j = 0; j < N; ++j)
+	{
+		const uint64 Eq = GetPeq(FChar::ToLower(Text[j]));
+		const uint64 Xv = Eq | Mv;
+		const uint64 Xh = (((Eq & Pv) + Pv) ^ Pv) | Eq;
+		uint64 Ph = Mv | ~(Xh | Pv);
+		uint64 Mh = Pv & Xh;
+
+		if (Ph & HighBit)
+		{
+			++Score;
+		}
+		else if (Mh & HighBit)
+		{
+			--Score;
+		}
+
+		// 第 0 行为 D[0][j] = j，横向差分恒为 +1，因此移入 1
+		Ph = (Ph << 1) | 1;
+		Mh <<= 1;
+		Pv = Mh | ~(Xv | Ph);
+		Mv = Ph & Xv;
+
+		// 剩余每一列最多让结果减 1，下界已超过阈值则提前退出
+		if (Score - (N - j - 1) > MaxDistance)
+		{
+			return UALExceeded(MaxDistance);
+		}
+	}
+
+	return Score > MaxDistance ? UALExceeded(MaxDistance) : Score;
+}
+
+int32 FUAL_FuzzyMatcher::BandedDistance(const FString& Text, int32 MaxDistance) const
+{
+	// 模式串超过 64 字符时的退化路径：只计算 |i - j| <= Limit 的对角带
+	const int32 N = Pattern.Len();
+	const int32 M = Text.Len();
+	const int32 Limit = FMath::Min(MaxDistance, FMath::Max(N, M));
+	const int32 Inf = Limit + 1;
+
+	TArray<int32> Prev;
+	TArray<int32> Curr;
+	Prev.SetNumUninitialized(M + 1);
+	Curr.SetNumUninitialized(M + 1);
+	for (int32 j = 0; j <= M; ++j)
+	{
+		Prev[j] = j <= Limit ? j : Inf;
+	}
+
+	for (int32 i = 1; i <= N; ++i)
+	{
+		const int32 Lo = FMath::Max(1, i - Limit);
+		const int32 Hi = FMath::Min(M, i + Limit);
+
+		Curr[0] = i <= Limit ? i : Inf;
+		Curr[Lo - 1] = Lo == 1 ? Curr[0] : Inf;
+		int32 RowMin = Curr[Lo - 1];
+
+		const TCHAR PatternChar = Pattern[i - 1];
+		for (int32 j = Lo; j <= Hi; ++j)
+		{
+			const int32 Cost = PatternChar == FChar::ToLower(Text[j - 1]) ? 0 : 1;
+			const int32 Value = FMath::Min3(Prev[j - 1] + Cost, Prev[j] + 1, Curr[j - 1] + 1);
+			Curr[j] = FMath::Min(Value, Inf);
+			RowMin = FMath::Min(RowMin, Curr[j]);
+		}
+		if (Hi < M)
+		{
+			Curr[Hi + 1] = Inf;
+		}
+
+		if (RowMin > Limit)
+		{
+			return UALExceeded(MaxDistance);
+		}
+		Swap(Prev, Curr);
+	}
+
+	return Prev[M] > Limit ? UALExceeded(MaxDistance) : Prev[M];
+}
+
+float FUAL_FuzzyMatcher::Similarity(const FString& Text) const
+{
+	const int32 MaxLen = FMath::Max(Pattern.Len(), Text.Len());
+	if (MaxLen == 0)
+	{
+		return 1.0f;
+	}
+	return 1.0f - static_cast<float>(Distance(Text)) / static_cast<float>(MaxLen);
+}
+
+int32 FUAL_FuzzyMatcher::EditDistance(const FString& A, const FString& B, int32 MaxDistance)
+{
+	// 以较短的一方作为模式串，尽量走位并行路径
+	return A.Len() <= B.Len()
+		? FUAL_FuzzyMatcher(A).Distance(B, MaxDistance)
+		: FUAL_FuzzyMatcher(B).Distance(A, MaxDistance);
+}
+
+float FUAL_FuzzyMatcher::NameSimilarity(const FString& A, const FString& B)
+{
+	return A.Len() <= B.Len() ? FUAL_FuzzyMatcher(A).Similarity(B) : FUAL_FuzzyMatcher(B).Similarity(A);
+}
+
+void FUAL_FuzzyMatcher::FindClosest(const FString& Input, const TArray<FString>& Candidates, int32 MaxResults, TArray<FString>& OutMatches, int32 MaxDistance)
+{
+	TArray<int32> Indices;
+	FindClosestIndices(Input, Candidates, MaxResults, Indices, MaxDistance);
+	for (const int32 Index : Indices)
+	{
+		OutMatches.Add(Candidates[Index]);
+	}
+}
+
+void FUAL_FuzzyMatcher::FindClosestIndices(const FString& Input, const TArray<FString>& Candidates, int32 MaxResults, TArray<int32>& OutIndices, int32 MaxDistance)
+{
+	if (MaxResults <= 0)
+	{
+		return;
+	}
+
+	struct FScore
+	{
+		const FString* Name = nullptr;
+		int32 Index = INDEX_NONE;
+		int32 Distance = 0;
+	};
+
+	auto IsBetter = [](const FScore& L, const FScore& R)
+	{
+		if (L.Distance == R.Distance)
+		{
+			return *L.Name < *R.Name;
+		}
+		return L.Distance < R.Distance;
+	};
+
+	const FUAL_FuzzyMatcher Matcher(Input);
+	TArray<FScore> Best;
+	Best.Reserve(MaxResults + 1);
+
+	for (int32 CandIndex = 0; CandIndex < Candidates.Num(); ++CandIndex)
+	{
+		const FString& Cand = Candidates[CandIndex];
+		// 已选满时，距离严格大于第 K 名的候选不可能入选（相同距离仍需按名称比较）
+		const int32 Cutoff = Best.Num() == MaxResults ? FMath::Min(MaxDistance, Best.Last().Distance) : MaxDistance;
+		if (!Matcher.PassesLengthFilter(Cand, Cutoff))
+		{
+			continue;
+		}
+
+		FScore Score;
+		Score.Name = &Cand;
+		Score.Index = CandIndex;
+		Score.Distance = Matcher.Distance(Cand, Cutoff);
+		if (Score.Distance > Cutoff)
+		{
+			continue;
+		}
+
+		int32 InsertAt = Best.Num();
+		while (InsertAt > 0 && IsBetter(Score, Best[InsertAt - 1]))
+		{
+			--InsertAt;
+		}
+		if (InsertAt >= MaxResults)
+		{
+			continue;
+		}
+		Best.Insert(Score, InsertAt);
+		if (Best.Num() > MaxResults)
+		{
+			Best.Pop();
+		}
+	}
+
+	for (const FScore& Score : Best)
+	{
+		OutIndices.Add(Score.Index);
+	}
+}
+
+// ==============================================================================
+// 基准测试：ual.BenchmarkFuzzyMatch [Count]
+// ==============================================================================
+
+namespace
+{
+	// 旧版实现（整行分配的 O(n*m) DP），仅用于基准对比
+	int32 UALReferenceLevenshtein(const FString& A, const FString& B)
+	{
+		const int32 LenA = A.Len();
+		const int32 LenB = B.Len();
+		TArray<int32> Prev, Curr;
+		Prev.SetNum(LenB + 1);
+		Curr.SetNum(LenB + 1);
+
+		for (int32 j = 0; j <= LenB; ++j)
+		{
+			Prev[j] = j;
+		}
+
+		for (int32 i = 1; i <= LenA; ++i)
+		{
+			Curr[0] = i;
+			for (int32 j = 1; j <= LenB; ++j)
+			{
+				const int32 Cost = (FChar::ToLower(A[i - 1]) == FChar::ToLower(B[j - 1])) ? 0 : 1;
+				Curr[j] = FMath::Min3(Curr[j - 1] + 1, Prev[j] + 1, Prev[j - 1] + Cost);
+			}
+			Swap(Prev, Curr);
+		}
+		return Prev[LenB];
+	}
+
+	void UALRunFuzzyMatchBenchmark(const TArray<FString>& Args)
+	{
+		const int32 Count = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+		constexpr int32 MaxResults = 5;
+
+		static const TCHAR* Prefixes[] = { TEXT("SM_"), TEXT("T_"), TEXT("M_"), TEXT("MI_"), TEXT("BP_"), TEXT("b"), TEXT("") };
+		static const TCHAR* Words[] = {
+			TEXT("Rock"), TEXT("Wall"), TEXT("Light"), TEXT("Intensity"), TEXT("Relative"), TEXT("Location"),
+			TEXT("Color"), TEXT("Cast"), TEXT("Shadow"), TEXT("Mobility"), TEXT("Visible"), TEXT("Collision"),
+			TEXT("Profile"), TEXT("Material"), TEXT("Scale"), TEXT("Brick"), TEXT("Hero"), TEXT("Door")
+		};
+
+		FRandomStream Random(1337);
+		TArray<FString> Candidates;
+		Candidates.Reserve(Count);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			FString Name = Prefixes[Random.RandRange(0, UE_ARRAY_COUNT(Prefixes) - 1)];
+			const int32 WordCount = Random.RandRange(1, 3);
+			for (int32 W = 0; W < WordCount; ++W)
+			{
+				Name += Words[Random.RandRange(0, UE_ARRAY_COUNT(Words) - 1)];
+			}
+			Name += FString::Printf(TEXT("_%02d"), Random.RandRange(0, 99));
+			Candidates.Add(MoveTemp(Name));
+		}
+
+		const TArray<FString> Queries = {
+			TEXT("Intensty"), TEXT("RelativeLocaton"), TEXT("bCastShadows"), TEXT("SM_RockWal_01"), TEXT("CollisionProfleName")
+		};
+
+		double ReferenceSeconds = 0.0;
+		double FuzzySeconds = 0.0;
+		int32 Mismatches = 0;
+
+		for (const FString& Query : Queries)
+		{
+			// 旧版：逐个计算距离后全排序
+			const double RefStart = FPlatformTime::Seconds();
+			TArray<TPair<int32, const FString*>> Scores;
+			Scores.Reserve(Candidates.Num());
+			for (const FString& Cand : Candidates)
+			{
+				Scores.Emplace(UALReferenceLevenshtein(Query, Cand), &Cand);
+			}
+			Scores.Sort([](const TPair<int32, const FString*>& L, const TPair<int32, const FString*>& R)
+			{
+				return L.Key == R.Key ? *L.Value < *R.Value : L.Key < R.Key;
+			});
+			TArray<FString> Expected;
+			for (int32 Index = 0; Index < Scores.Num() && Expected.Num() < MaxResults; ++Index)
+			{
+				Expected.Add(*Scores[Index].Value);
+			}
+			ReferenceSeconds += FPlatformTime::Seconds() - RefStart;
+
+			const double FuzzyStart = FPlatformTime::Seconds();
+			TArray<FString> Actual;
+			FUAL_FuzzyMatcher::FindClosest(Query, Candidates, MaxResults, Actual);
+			FuzzySeconds += FPlatformTime::Seconds() - FuzzyStart;
+
+			if (Actual != Expected)
+			{
+				++Mismatches;
+				UE_LOG(LogUALFuzzy, Warning, TEXT("Result mismatch for '%s': expected [%s], got [%s]"),
+					*Query, *FString::Join(Expected, TEXT(", ")), *FString::Join(Actual, TEXT(", ")));
+			}
+		}
+
+		UE_LOG(LogUALFuzzy, Display, TEXT("FuzzyMatch benchmark: %d candidates x %d queries | reference DP %.2f ms | bit-parallel %.2f ms | speedup %.1fx | mismatches %d"),
+			Count, Queries.Num(), ReferenceSeconds * 1000.0, FuzzySeconds * 1000.0,
+			FuzzySeconds > 0.0 ? ReferenceSeconds / FuzzySeconds : 0.0, Mismatches);
+	}
+
+	FAutoConsoleCommand GUALFuzzyMatchBenchmarkCommand(
+		TEXT("ual.BenchmarkFuzzyMatch"),
+		TEXT("Benchmark bit-parallel fuzzy matching against the reference Levenshtein DP. Usage: ual.BenchmarkFuzzyMatch [CandidateCount=100000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&UALRunFuzzyMatchBenchmark));
+}
@@ -0,0 +1,264 @@
+#include "UAL_JobManager.h"
+#include "UAL_CommandUtils.h"
+
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALJob, Log, All);
+
+static TAutoConsoleVariable<float> CVarJobBudgetMs(
+	TEXT("ual.JobBudgetMs"),
+	8.0f,
+	TEXT("GameThread time in milliseconds spent on background jobs per tick"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarJobProgressIntervalMs(
+	TEXT("ual.JobProgressIntervalMs"),
+	250,
+	TEXT("Minimum interval in milliseconds between job.progress events of one job"),
+	ECVF_Default);
+
+namespace
+{
+	// 保留的已结束任务数量
+	constexpr int32 UALMaxJobHistory = 32;
+}
+
+FUAL_JobManager& FUAL_JobManager::Get()
+{
+	static FUAL_JobManager Instance;
+	return Instance;
+}
+
+const TCHAR* FUAL_JobManager::StatusToString(EStatus Status)
+{
+	switch (Status)
+	{
+	case EStatus::Running:   return TEXT("running");
+	case EStatus::Succeeded: return TEXT("succeeded");
+	case EStatus::Failed:    return TEXT("failed");
+	case EStatus::Cancelled: return TEXT("cancelled");
+	default:                 return TEXT("unknown");
+	}
+}
+
+FString FUAL_JobManager::Start(FUAL_JobSpec&& Spec)
+{
+	TSharedPtr<FJob> Job = MakeShared<FJob>();
+	Job->JobId = FString::Printf(TEXT("job_%d"), NextJobSerial++);
+	Job->Spec = MoveTemp(Spec);
+	Job->StartTime = FPlatformTime::Seconds();
+	Running.Add(Job);
+
+	UE_LOG(LogUALJob, Log, TEXT("Job %s (%s) started"), *Job->JobId, *Job->Spec.Type);
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_JobManager::Tick), 0.0f);
+	}
+	return Job->JobId;
+}
+
+void FUAL_JobManager::RunInline(FUAL_JobSpec& Spec, FUAL_JobProgress& Progress)
+{
+	while (!Spec.Step(Progress))
+	{
+	}
+}
+
+bool FUAL_JobManager::Tick(float DeltaTime)
+{
+	const double TickStart = FPlatformTime::Seconds();
+	const double Deadline = TickStart + FMath::Max(0.5f, CVarJobBudgetMs.GetValueOnGameThread()) / 1000.0;
+
+	// 轮转执行：每个任务一步，直到预算用完；起点逐帧后移，避免排在前面的任务独占预算
+	// 报告 bWaiting 的任务本帧不再调度，避免空转占满预算
+	TSet<const FJob*> Waiting;
+	bool bFirstStep = true;
+	while (Running.Num() > Waiting.Num() && (bFirstStep || FPlatformTime::Seconds() < Deadline))
+	{
+		RoundRobinCursor = RoundRobinCursor % Running.Num();
+		const TSharedPtr<FJob> Job = Running[RoundRobinCursor];
+		if (Waiting.Contains(Job.Get()))
+		{
+			++RoundRobinCursor;
+			continue;
+		}
+		bFirstStep = false;
+
+		const double StepStart = FPlatformTime::Seconds();
+		Job->Progress.bWaiting = false;
+		const bool bDone = Job->Spec.Step(Job->Progress);
+		Job->BusyMs += (FPlatformTime::Seconds() - StepStart) * 1000.0;
+		++Job->Steps;
+
+		if (bDone)
+		{
+			Running.RemoveAt(RoundRobinCursor);
+			Finish(Job, Job->Progress.Error.IsEmpty() ? EStatus::Succeeded : EStatus::Failed);
+		}
+		else
+		{
+			if (Job->Progress.bWaiting)
+			{
+				Waiting.Add(Job.Get());
+			}
+			++RoundRobinCursor;
+		}
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const double Interval = FMath::Max(0, CVarJobProgressIntervalMs.GetValueOnGameThread()) / 1000.0;
+	for (const TSharedPtr<FJob>& Job : Running)
+	{
+		if (Job->Progress.Completed != Job->LastReportedCompleted && Now - Job->LastProgressTime >= Interval)
+		{
+			SendProgress(*Job);
+		}
+	}
+
+	if (Running.Num() == 0)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FUAL_JobManager::SendProgress(FJob& Job)
+{
+	Job.LastProgressTime = FPlatformTime::Seconds();
+	Job.LastReportedCompleted = Job.Progress.Completed;
+
+	TSharedPtr<FJsonObject> Event = MakeShared<FJsonObject>();
+	Event->SetStringField(TEXT("job_id"), Job.JobId);
+	Event->SetStringField(TEXT("type"), Job.Spec.Type);
+	Event->SetNumberField(TEXT("completed"), Job.Progress.Completed);
+	Event->SetNumberField(TEXT("total"), Job.Progress.Total);
+	Event->SetNumberField(TEXT("progress"), Job.Progress.Total > 0 ? (double)Job.Progress.Completed / Job.Progress.Total : 0.0);
+	if (!Job.Progress.Message.IsEmpty())
+	{
+		Event->SetStringField(TEXT("message"), Job.Progress.Message);
+	}
+	Event->SetNumberField(TEXT("elapsed_ms"), (Job.LastProgressTime - Job.StartTime) * 1000.0);
+	UAL_CommandUtils::SendEvent(TEXT("job.progress"), Event);
+}
+
+void FUAL_JobManager::Finish(const TSharedPtr<FJob>& Job, EStatus Status)
+{
+	Job->Status = Status;
+	Job->EndTime = FPlatformTime::Seconds();
+
+	History.Add(Job);
+	if (History.Num() > UALMaxJobHistory)
+	{
+		History.RemoveAt(0, History.Num() - UALMaxJobHistory);
+	}
+
+	UE_LOG(LogUALJob, Log, TEXT("Job %s (%s) %s: %d steps, busy %.1f ms, wall %.1f ms"),
+		*Job->JobId, *Job->Spec.Type, StatusToString(Status), Job->Steps, Job->BusyMs, (Job->EndTime - Job->StartTime) * 1000.0);
+
+	UAL_CommandUtils::SendEvent(TEXT("job.completed"), ToJson(*Job, true));
+}
+
+bool FUAL_JobManager::Cancel(const FString& JobId)
+{
+	for (int32 Index = 0; Index < Running.Num(); ++Index)
+	{
+		if (Running[Index]->JobId == JobId)
+		{
+			const TSharedPtr<FJob> Job = Running[Index];
+			Running.RemoveAt(Index);
+			if (Job->Spec.OnCancelled)
+			{
+				Job->Spec.OnCancelled();
+			}
+			Finish(Job, EStatus::Cancelled);
+			return true;
+		}
+	}
+	return false;
+}
+
+TSharedPtr<FJsonObject> FUAL_JobManager::ToJson(const FJob& Job, bool bIncludeResult) const
+{
+	const double EndTime = Job.Status == EStatus::Running ? FPlatformTime::Seconds() : Job.EndTime;
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetStringField(TEXT("job_id"), Job.JobId);
+	Obj->SetStringField(TEXT("type"), Job.Spec.Type);
+	Obj->SetStringField(TEXT("status"), StatusToString(Job.Status));
+	Obj->SetNumberField(TEXT("completed"), Job.Progress.Completed);
+	Obj->SetNumberField(TEXT("total"), Job.Progress.Total);
+	Obj->SetNumberField(TEXT("progress"), Job.Progress.Total > 0 ? (double)Job.Progress.Completed / Job.Progress.Total : (Job.Status == EStatus::Succeeded ? 1.0 : 0.0));
+	if (!Job.Progress.Message.IsEmpty())
+	{
+		Obj->SetStringField(TEXT("message"), Job.Progress.Message);
+	}
+	Obj->SetNumberField(TEXT("elapsed_ms"), (EndTime - Job.StartTime) * 1000.0);
+	Obj->SetNumberField(TEXT("busy_ms"), Job.BusyMs);
+	Obj->SetNumberField(TEXT("steps"), Job.Steps);
+	if (!Job.Progress.Error.IsEmpty())
+	{
+		Obj->SetStringField(TEXT("error"), Job.Progress.Error);
+	}
+	// 失败的任务也可能带有部分结果（如导入的错误列表）
+	if (bIncludeResult && Job.Status != EStatus::Running && Job.Progress.Result.IsValid())
+	{
+		Obj->SetObjectField(TEXT("result"), Job.Progress.Result);
+	}
+	return Obj;
+}
+
+TSharedPtr<FJsonObject> FUAL_JobManager::DescribeJob(const FString& JobId, bool bIncludeResult) const
+{
+	for (const TSharedPtr<FJob>& Job : Running)
+	{
+		if (Job->JobId == JobId)
+		{
+			return ToJson(*Job, bIncludeResult);
+		}
+	}
+	for (const TSharedPtr<FJob>& Job : History)
+	{
+		if (Job->JobId == JobId)
+		{
+			return ToJson(*Job, bIncludeResult);
+		}
+	}
+	return nullptr;
+}
+
+TArray<TSharedPtr<FJsonValue>> FUAL_JobManager::ListJobs(bool bIncludeFinished) const
+{
+	TArray<TSharedPtr<FJsonValue>> Result;
+	for (const TSharedPtr<FJob>& Job : Running)
+	{
+		Result.Add(MakeShared<FJsonValueObject>(ToJson(*Job, false)));
+	}
+	if (bIncludeFinished)
+	{
+		for (int32 Index = History.Num() - 1; Index >= 0; --Index)
+		{
+			Result.Add(MakeShared<FJsonValueObject>(ToJson(*History[Index], false)));
+		}
+	}
+	return Result;
+}
+
+void FUAL_JobManager::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		UAL_CORE_TICKER.RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	for (const TSharedPtr<FJob>& Job : Running)
+	{
+		if (Job->Spec.OnCancelled)
+		{
+			Job->Spec.OnCancelled();
+		}
+	}
+	Running.Empty();
+	History.Empty();
+}
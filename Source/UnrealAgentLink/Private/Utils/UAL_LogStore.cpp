@@ -0,0 +1,748 @@
+#include "UAL_LogStore.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/Reverse.h"
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "Internationalization/Regex.h"
+#include "Misc/DateTime.h"
+#include "Misc/ScopeLock.h"
+
+static TAutoConsoleVariable<int32> CVarLogStore(
+	TEXT("ual.LogStore"),
+	1,
+	TEXT("Keep recent UE logs in memory for log.query (0=off, 1=on)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLogStoreVerbosity(
+	TEXT("ual.LogStoreVerbosity"),
+	ELogVerbosity::Log,
+	TEXT("Store only logs at or above this verbosity (1=Fatal, 2=Error, 3=Warning, 4=Display, 5=Log, 6=Verbose, 7=VeryVerbose)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLogStoreMaxEntries(
+	TEXT("ual.LogStoreMaxEntries"),
+	65536,
+	TEXT("Max log lines kept for log.query (rounded up to a power of two, read on first use)"),
+	ECVF_ReadOnly);
+
+static TAutoConsoleVariable<int32> CVarLogStoreMaxKB(
+	TEXT("ual.LogStoreMaxKB"),
+	8192,
+	TEXT("Text memory in KB kept for log.query, oldest lines are evicted first (read on first use)"),
+	ECVF_ReadOnly);
+
+namespace
+{
+	// 单条日志最多保留的字符数，超出部分截断
+	constexpr int32 UALMaxStoredChars = 2048;
+	// 单词最短长度，更短的词不进入索引
+	constexpr int32 UALMinTokenLen = 3;
+
+	bool IsTokenChar(TCHAR Char)
+	{
+		return FChar::IsAlnum(Char) || Char == TEXT('_');
+	}
+
+	/** 小写 FNV-1a，与 Tokenize 共用，保证写入与查询的哈希一致 */
+	uint32 HashToken(const TCHAR* Start, int32 Len)
+	{
+		uint32 Hash = 2166136261u;
+		for (int32 Index = 0; Index < Len; ++Index)
+		{
+			Hash ^= (uint32)FChar::ToLower(Start[Index]);
+			Hash *= 16777619u;
+		}
+		return Hash;
+	}
+
+	/** Word 是否以完整单词出现在 Text 中（不区分大小写） */
+	bool ContainsWholeWord(const FString& Text, const FString& Word)
+	{
+		int32 From = 0;
+		while ((From = Text.Find(Word, ESearchCase::IgnoreCase, ESearchDir::FromStart, From)) != INDEX_NONE)
+		{
+			const int32 End = From + Word.Len();
+			if ((From == 0 || !IsTokenChar(Text[From - 1])) && (End == Text.Len() || !IsTokenChar(Text[End])))
+			{
+				return true;
+			}
+			++From;
+		}
+		return false;
+	}
+
+	/** 已排序序号列表中落在 [Lo, Hi) 的部分 */
+	TArrayView<const uint32> ClipToRange(TArrayView<const uint32> Postings, uint32 Lo, uint32 Hi)
+	{
+		const int32 Begin = Algo::LowerBound(Postings, Lo);
+		const int32 End = Algo::LowerBound(Postings, Hi);
+		return Postings.Slice(Begin, FMath::Max(0, End - Begin));
+	}
+
+	int64 NowUnixMs()
+	{
+		return (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds();
+	}
+}
+
+FUAL_LogStore& FUAL_LogStore::Get()
+{
+	static FUAL_LogStore Instance;
+	return Instance;
+}
+
+bool FUAL_LogStore::IsEnabled()
+{
+	return CVarLogStore.GetValueOnAnyThread() != 0;
+}
+
+ELogVerbosity::Type FUAL_LogStore::GetMaxVerbosity()
+{
+	return (ELogVerbosity::Type)FMath::Clamp(CVarLogStoreVerbosity.GetValueOnAnyThread(), (int32)ELogVerbosity::Fatal, (int32)ELogVerbosity::VeryVerbose);
+}
+
+/**
+ * 将日志级别转换为字符串（跨版本兼容）
+ *
+ * 使用手动映射方式，避免不同UE版本间FLogVerbosity API差异
+ */
+const TCHAR* FUAL_LogStore::VerbosityToString(ELogVerbosity::Type Verbosity)
+{
+	switch (Verbosity)
+	{
+	case ELogVerbosity::Fatal:       return TEXT("Fatal");
+	case ELogVerbosity::Error:       return TEXT("Error");
+	case ELogVerbosity::Warning:     return TEXT("Warning");
+	case ELogVerbosity::Display:     return TEXT("Display");
+	case ELogVerbosity::Log:         return TEXT("Log");
+	case ELogVerbosity::Verbose:     return TEXT("Verbose");
+	case ELogVerbosity::VeryVerbose: return TEXT("VeryVerbose");
+	default:                         return TEXT("Unknown");
+	}
+}
+
+bool FUAL_LogStore::ParseVerbosity(const FString& Name, ELogVerbosity::Type& OutVerbosity)
+{
+	if (Name.IsNumeric())
+	{
+		const int32 Value = FCString::Atoi(*Name);
+		if (Value >= ELogVerbosity::Fatal && Value <= ELogVerbosity::VeryVerbose)
+		{
+			OutVerbosity = (ELogVerbosity::Type)Value;
+			return true;
+		}
+		return false;
+	}
+
+	for (int32 Value = ELogVerbosity::Fatal; Value <= ELogVerbosity::VeryVerbose; ++Value)
+	{
+		if (Name.Equals(VerbosityToString((ELogVerbosity::Type)Value), ESearchCase::IgnoreCase))
+		{
+			OutVerbosity = (ELogVerbosity::Type)Value;
+			return true;
+		}
+	}
+	return false;
+}
+
+void FUAL_LogStore::EnsureAllocated()
+{
+	if (RecordCapacity > 0)
+	{
+		return;
+	}
+
+	RecordCapacity = FMath::RoundUpToPowerOfTwo(FMath::Max(1024, CVarLogStoreMaxEntries.GetValueOnAnyThread()));
+	Records.SetNumZeroed(RecordCapacity);
+	TextArena.SetNumUninitialized(FMath::Max(64, CVarLogStoreMaxKB.GetValueOnAnyThread()) * 1024);
+
+	// 分类 ID 0 保留给驻留表写满后的溢出分类
+	Categories.Add(NAME_None);
+	CategoryIds.Add(NAME_None, 0);
+	CategoryPostings.AddDefaulted();
+
+	BaseUnixMs = NowUnixMs();
+	BaseSeconds = FPlatformTime::Seconds();
+}
+
+void FUAL_LogStore::AddBatch(TArray<FIncoming>& Batch)
+{
+	if (Batch.Num() == 0)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	EnsureAllocated();
+	for (const FIncoming& Item : Batch)
+	{
+		AddLocked(Item);
+	}
+}
+
+uint16 FUAL_LogStore::InternCategory(const FName& Category)
+{
+	if (const uint16* Found = CategoryIds.Find(Category))
+	{
+		return *Found;
+	}
+	if (Categories.Num() > MAX_uint16)
+	{
+		return 0;
+	}
+
+	const uint16 Id = (uint16)Categories.Add(Category);
+	CategoryIds.Add(Category, Id);
+	CategoryPostings.AddDefaulted();
+	return Id;
+}
+
+void FUAL_LogStore::AddLocked(const FIncoming& Item)
+{
+	const FString Text = Item.Text.Len() > UALMaxStoredChars ? Item.Text.Left(UALMaxStoredChars) : Item.Text;
+	const auto Utf8 = StringCast<UTF8CHAR>(*Text, Text.Len());
+	const uint32 Len = (uint32)Utf8.Length();
+
+	if (NextSeq - FirstSeq == RecordCapacity)
+	{
+		EvictOldest();
+	}
+	const uint32 Offset = ReserveText(Len);
+	if (Len > 0)
+	{
+		FMemory::Memcpy(&TextArena[Offset], Utf8.Get(), Len);
+		LiveTextBytes += Len;
+	}
+
+	// 入队时间来自多个生产者，可能有微小乱序；强制单调，时间范围可直接二分
+	const double RelativeMs = FMath::Max(0.0, (Item.Time - BaseSeconds) * 1000.0);
+	const uint32 TimeMs = FMath::Max(LastTimeMs, (uint32)FMath::Min(RelativeMs, (double)MAX_uint32));
+	LastTimeMs = TimeMs;
+
+	const uint32 Seq = NextSeq++;
+	FRecord& Record = Records[Seq & (RecordCapacity - 1)];
+	Record.TimeMs = TimeMs;
+	Record.TextOffset = Offset;
+	Record.TextLen = (uint16)Len;
+	Record.CategoryId = InternCategory(Item.Category);
+	Record.Verbosity = (uint8)Item.Verbosity;
+
+	CategoryPostings[Record.CategoryId].Add(Seq);
+	LevelPostings[Record.Verbosity].Add(Seq);
+
+	TArray<uint32> Tokens;
+	Tokenize(Text, Tokens);
+	for (const uint32 Token : Tokens)
+	{
+		TokenPostings.FindOrAdd(Token).Add(Seq);
+	}
+
+	++TotalAdded;
+}
+
+void FUAL_LogStore::EvictOldest()
+{
+	const FRecord& Oldest = GetRecord(FirstSeq);
+	if (Oldest.TextLen > 0)
+	{
+		LiveTextBytes -= Oldest.TextLen;
+		TextReadPos = Oldest.TextOffset + Oldest.TextLen;
+	}
+	++FirstSeq;
+	++TotalEvicted;
+
+	// 每淘汰一整轮清理一次索引，删除只含过期序号的单词，摊还为 O(1)
+	if (++EvictionsSinceSweep >= RecordCapacity)
+	{
+		SweepPostings();
+	}
+}
+
+uint32 FUAL_LogStore::ReserveText(uint32 Len)
+{
+	if (Len == 0)
+	{
+		return TextWritePos;
+	}
+
+	const uint32 ArenaSize = (uint32)TextArena.Num();
+	for (;;)
+	{
+		if (LiveTextBytes == 0)
+		{
+			TextReadPos = 0;
+			TextWritePos = 0;
+		}
+
+		// 读写位置重合且有数据时表示写满
+		const bool bWrapped = TextWritePos < TextReadPos || (LiveTextBytes > 0 && TextWritePos == TextReadPos);
+		if (!bWrapped)
+		{
+			if (ArenaSize - TextWritePos >= Len)
+			{
+				const uint32 Offset = TextWritePos;
+				TextWritePos += Len;
+				return Offset;
+			}
+			// 尾部放不下：回到开头，尾部剩余空间在读位置越过时一并释放
+			if (TextReadPos >= Len)
+			{
+				TextWritePos = Len;
+				return 0;
+			}
+		}
+		else if (TextReadPos - TextWritePos >= Len)
+		{
+			const uint32 Offset = TextWritePos;
+			TextWritePos += Len;
+			return Offset;
+		}
+
+		EvictOldest();
+	}
+}
+
+FString FUAL_LogStore::GetText(const FRecord& Record) const
+{
+	if (Record.TextLen == 0)
+	{
+		return FString();
+	}
+	const auto Converted = StringCast<TCHAR>((const UTF8CHAR*)&TextArena[Record.TextOffset], Record.TextLen);
+	return FString(Converted.Length(), Converted.Get());
+}
+
+void FUAL_LogStore::Tokenize(const FString& Text, TArray<uint32>& OutTokens)
+{
+	const TCHAR* Chars = *Text;
+	const int32 Len = Text.Len();
+	int32 Index = 0;
+	while (Index < Len)
+	{
+		if (!IsTokenChar(Chars[Index]))
+		{
+			++Index;
+			continue;
+		}
+		const int32 Start = Index;
+		while (Index < Len && IsTokenChar(Chars[Index]))
+		{
+			++Index;
+		}
+		if (Index - Start >= UALMinTokenLen)
+		{
+			OutTokens.Add(HashToken(Chars + Start, Index - Start));
+		}
+	}
+
+	OutTokens.Sort();
+	for (int32 Index2 = OutTokens.Num() - 1; Index2 > 0; --Index2)
+	{
+		if (OutTokens[Index2] == OutTokens[Index2 - 1])
+		{
+			OutTokens.RemoveAt(Index2, 1, false);
+		}
+	}
+}
+
+void FUAL_LogStore::TokenizeQueryInterior(const FString& Text, TArray<uint32>& OutTokens)
+{
+	// 子串两端的单词可能只是更长单词的一部分，只有两侧都被非单词字符包围的才一定是完整单词
+	const TCHAR* Chars = *Text;
+	const int32 Len = Text.Len();
+	int32 Index = 0;
+	while (Index < Len)
+	{
+		if (!IsTokenChar(Chars[Index]))
+		{
+			++Index;
+			continue;
+		}
+		const int32 Start = Index;
+		while (Index < Len && IsTokenChar(Chars[Index]))
+		{
+			++Index;
+		}
+		if (Start > 0 && Index < Len && Index - Start >= UALMinTokenLen)
+		{
+			OutTokens.AddUnique(HashToken(Chars + Start, Index - Start));
+		}
+	}
+}
+
+TArrayView<const uint32> FUAL_LogStore::LivePostings(TArray<uint32>& Postings)
+{
+	const int32 Stale = Algo::LowerBound(Postings, FirstSeq);
+	// 过期前缀超过一半时才真正删除，避免每次查询都搬移数组
+	if (Stale > 64 && Stale * 2 > Postings.Num())
+	{
+		Postings.RemoveAt(0, Stale, false);
+		return TArrayView<const uint32>(Postings);
+	}
+	return TArrayView<const uint32>(Postings).Slice(Stale, Postings.Num() - Stale);
+}
+
+void FUAL_LogStore::SweepPostings()
+{
+	EvictionsSinceSweep = 0;
+
+	auto Trim = [this](TArray<uint32>& Postings)
+	{
+		const int32 Stale = Algo::LowerBound(Postings, FirstSeq);
+		if (Stale > 0)
+		{
+			Postings.RemoveAt(0, Stale, false);
+		}
+	};
+
+	for (TArray<uint32>& Postings : CategoryPostings)
+	{
+		Trim(Postings);
+	}
+	for (TArray<uint32>& Postings : LevelPostings)
+	{
+		Trim(Postings);
+	}
+	for (auto It = TokenPostings.CreateIterator(); It; ++It)
+	{
+		Trim(It.Value());
+		if (It.Value().Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+		else if (It.Value().GetSlack() > It.Value().Num())
+		{
+			It.Value().Shrink();
+		}
+	}
+}
+
+uint32 FUAL_LogStore::FindFirstSeqAtOrAfter(uint32 TimeMs) const
+{
+	uint32 Lo = FirstSeq;
+	uint32 Hi = NextSeq;
+	while (Lo < Hi)
+	{
+		const uint32 Mid = Lo + (Hi - Lo) / 2;
+		if (GetRecord(Mid).TimeMs < TimeMs)
+		{
+			Lo = Mid + 1;
+		}
+		else
+		{
+			Hi = Mid;
+		}
+	}
+	return Lo;
+}
+
+FUAL_LogStore::FQueryResult FUAL_LogStore::Query(const FQuery& InQuery)
+{
+	FQueryResult Result;
+
+	FScopeLock ScopeLock(&Lock);
+	if (RecordCapacity == 0 || FirstSeq == NextSeq)
+	{
+		return Result;
+	}
+
+	// 1. 时间范围与翻页游标换算为序号范围 [Lo, Hi)（时间戳单调）
+	auto ToRelativeMs = [this](int64 UnixMs) -> int64
+	{
+		return FMath::Clamp<int64>(UnixMs - BaseUnixMs, 0, (int64)MAX_uint32);
+	};
+
+	uint32 Lo = FirstSeq;
+	uint32 Hi = NextSeq;
+	if (InQuery.BeforeSeq > 0)
+	{
+		Hi = FMath::Min(Hi, InQuery.BeforeSeq);
+	}
+	if (InQuery.SinceUnixMs > 0)
+	{
+		Lo = FMath::Max(Lo, FindFirstSeqAtOrAfter((uint32)ToRelativeMs(InQuery.SinceUnixMs)));
+	}
+	if (InQuery.UntilUnixMs > 0)
+	{
+		const int64 UntilMs = ToRelativeMs(InQuery.UntilUnixMs);
+		if (UntilMs < (int64)MAX_uint32)
+		{
+			Hi = FMath::Min(Hi, FindFirstSeqAtOrAfter((uint32)UntilMs + 1));
+		}
+	}
+	if (Lo >= Hi)
+	{
+		return Result;
+	}
+
+	// 2. 分类掩码
+	TBitArray<> CategoryMask;
+	const bool bFilterCategory = InQuery.Categories.Num() > 0;
+	TArray<uint16, TInlineAllocator<8>> CategoryFilterIds;
+	if (bFilterCategory)
+	{
+		CategoryMask.Init(false, Categories.Num());
+		for (const FName& Category : InQuery.Categories)
+		{
+			if (const uint16* Id = CategoryIds.Find(Category))
+			{
+				CategoryMask[*Id] = true;
+				CategoryFilterIds.AddUnique(*Id);
+			}
+		}
+		if (CategoryFilterIds.Num() == 0)
+		{
+			Result.IndexUsed = TEXT("category");
+			return Result;
+		}
+	}
+
+	// 3. 必须出现的单词：整词参数 + 子串中的完整单词
+	//    整词参数按单词字符拆分，短词不在索引中只能逐条校验；索引按哈希命中，所有整词都要在原文中再校验一次
+	TArray<FString> WordTerms;
+	TArray<uint32> RequiredTokens;
+	for (const FString& Word : InQuery.Words)
+	{
+		const TCHAR* Chars = *Word;
+		const int32 Len = Word.Len();
+		int32 Index = 0;
+		while (Index < Len)
+		{
+			if (!IsTokenChar(Chars[Index]))
+			{
+				++Index;
+				continue;
+			}
+			const int32 Start = Index;
+			while (Index < Len && IsTokenChar(Chars[Index]))
+			{
+				++Index;
+			}
+			WordTerms.AddUnique(Word.Mid(Start, Index - Start));
+			if (Index - Start >= UALMinTokenLen)
+			{
+				RequiredTokens.AddUnique(HashToken(Chars + Start, Index - Start));
+			}
+		}
+	}
+	TokenizeQueryInterior(InQuery.Contains, RequiredTokens);
+
+	TArray<TArrayView<const uint32>, TInlineAllocator<8>> TokenViews;
+	for (const uint32 Token : RequiredTokens)
+	{
+		TArray<uint32>* Postings = TokenPostings.Find(Token);
+		if (!Postings)
+		{
+			Result.IndexUsed = TEXT("word");
+			return Result;
+		}
+		TokenViews.Add(ClipToRange(LivePostings(*Postings), Lo, Hi));
+	}
+
+	// 4. 选择最短的候选来源：序号范围 / 某个单词 / 分类并集 / 级别并集
+	int32 BestCount = (int32)(Hi - Lo);
+	Result.IndexUsed = TEXT("time");
+	int32 BestTokenIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < TokenViews.Num(); ++Index)
+	{
+		if (TokenViews[Index].Num() < BestCount)
+		{
+			BestCount = TokenViews[Index].Num();
+			BestTokenIndex = Index;
+			Result.IndexUsed = TEXT("word");
+		}
+	}
+
+	TArray<TArrayView<const uint32>, TInlineAllocator<8>> CategoryViews;
+	int32 CategoryCount = 0;
+	for (const uint16 Id : CategoryFilterIds)
+	{
+		CategoryViews.Add(ClipToRange(LivePostings(CategoryPostings[Id]), Lo, Hi));
+		CategoryCount += CategoryViews.Last().Num();
+	}
+
+	TArray<TArrayView<const uint32>, TInlineAllocator<8>> LevelViews;
+	int32 LevelCount = 0;
+	const bool bFilterLevel = InQuery.MaxVerbosity < ELogVerbosity::VeryVerbose;
+	if (bFilterLevel)
+	{
+		for (int32 Level = ELogVerbosity::Fatal; Level <= InQuery.MaxVerbosity; ++Level)
+		{
+			LevelViews.Add(ClipToRange(LivePostings(LevelPostings[Level]), Lo, Hi));
+			LevelCount += LevelViews.Last().Num();
+		}
+	}
+
+	TArray<TArrayView<const uint32>, TInlineAllocator<8>>* UnionViews = nullptr;
+	if (bFilterCategory && CategoryCount < BestCount)
+	{
+		BestCount = CategoryCount;
+		UnionViews = &CategoryViews;
+		Result.IndexUsed = TEXT("category");
+	}
+	if (bFilterLevel && LevelCount < BestCount)
+	{
+		BestCount = LevelCount;
+		UnionViews = &LevelViews;
+		Result.IndexUsed = TEXT("level");
+	}
+
+	TArray<uint32> Candidates;
+	TArrayView<const uint32> CandidateView;
+	const bool bUseRange = BestTokenIndex == INDEX_NONE && UnionViews == nullptr;
+	if (UnionViews)
+	{
+		Candidates.Reserve(BestCount);
+		for (const TArrayView<const uint32>& View : *UnionViews)
+		{
+			Candidates.Append(View.GetData(), View.Num());
+		}
+		if (UnionViews->Num() > 1)
+		{
+			Candidates.Sort();
+		}
+		CandidateView = Candidates;
+	}
+	else if (BestTokenIndex != INDEX_NONE)
+	{
+		CandidateView = TokenViews[BestTokenIndex];
+	}
+
+	// 5. 从新到旧逐条校验，取满 Limit + 1 条用于判断是否还有更早的匹配
+	TOptional<FRegexPattern> Pattern;
+	if (!InQuery.Regex.IsEmpty())
+	{
+		Pattern.Emplace(InQuery.Regex);
+	}
+	const bool bNeedText = !InQuery.Contains.IsEmpty() || Pattern.IsSet() || WordTerms.Num() > 0;
+	const int32 Limit = FMath::Max(1, InQuery.Limit);
+
+	const int32 CandidateCount = bUseRange ? (int32)(Hi - Lo) : CandidateView.Num();
+	for (int32 Index = CandidateCount - 1; Index >= 0; --Index)
+	{
+		const uint32 Seq = bUseRange ? Lo + (uint32)Index : CandidateView[Index];
+		const FRecord& Record = GetRecord(Seq);
+		++Result.Scanned;
+
+		if (Record.Verbosity > InQuery.MaxVerbosity)
+		{
+			continue;
+		}
+		if (bFilterCategory && !CategoryMask[Record.CategoryId])
+		{
+			continue;
+		}
+
+		bool bHasTokens = true;
+		for (int32 TokenIndex = 0; TokenIndex < TokenViews.Num() && bHasTokens; ++TokenIndex)
+		{
+			bHasTokens = TokenIndex == BestTokenIndex || Algo::BinarySearch(TokenViews[TokenIndex], Seq) != INDEX_NONE;
+		}
+		if (!bHasTokens)
+		{
+			continue;
+		}
+
+		FString Text;
+		if (bNeedText)
+		{
+			Text = GetText(Record);
+			if (!InQuery.Contains.IsEmpty() && !Text.Contains(InQuery.Contains, ESearchCase::IgnoreCase))
+			{
+				continue;
+			}
+			bool bHasWords = true;
+			for (int32 TermIndex = 0; TermIndex < WordTerms.Num() && bHasWords; ++TermIndex)
+			{
+				bHasWords = ContainsWholeWord(Text, WordTerms[TermIndex]);
+			}
+			if (!bHasWords)
+			{
+				continue;
+			}
+			if (Pattern.IsSet())
+			{
+				FRegexMatcher Matcher(Pattern.GetValue(), Text);
+				if (!Matcher.FindNext())
+				{
+					continue;
+				}
+			}
+		}
+
+		if (Result.Entries.Num() == Limit)
+		{
+			Result.bHasMore = true;
+			break;
+		}
+
+		FResultEntry& Entry = Result.Entries.AddDefaulted_GetRef();
+		Entry.Seq = Seq;
+		Entry.UnixMs = BaseUnixMs + Record.TimeMs;
+		Entry.Category = Categories[Record.CategoryId];
+		Entry.Verbosity = (ELogVerbosity::Type)Record.Verbosity;
+		Entry.Text = bNeedText ? MoveTemp(Text) : GetText(Record);
+	}
+
+	Algo::Reverse(Result.Entries);
+	return Result;
+}
+
+void FUAL_LogStore::WriteStats(const TSharedPtr<FJsonObject>& Out)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	SIZE_T IndexBytes = TokenPostings.GetAllocatedSize();
+	for (const TPair<uint32, TArray<uint32>>& Pair : TokenPostings)
+	{
+		IndexBytes += Pair.Value.GetAllocatedSize();
+	}
+	for (const TArray<uint32>& Postings : CategoryPostings)
+	{
+		IndexBytes += Postings.GetAllocatedSize();
+	}
+	for (const TArray<uint32>& Postings : LevelPostings)
+	{
+		IndexBytes += Postings.GetAllocatedSize();
+	}
+
+	Out->SetBoolField(TEXT("enabled"), IsEnabled());
+	Out->SetNumberField(TEXT("entries"), NextSeq - FirstSeq);
+	Out->SetNumberField(TEXT("capacity"), RecordCapacity);
+	Out->SetNumberField(TEXT("text_bytes"), LiveTextBytes);
+	Out->SetNumberField(TEXT("text_capacity_bytes"), TextArena.Num());
+	Out->SetNumberField(TEXT("record_bytes"), (double)Records.GetAllocatedSize());
+	Out->SetNumberField(TEXT("index_bytes"), (double)IndexBytes);
+	Out->SetNumberField(TEXT("categories"), FMath::Max(0, Categories.Num() - 1));
+	Out->SetNumberField(TEXT("indexed_words"), TokenPostings.Num());
+	Out->SetNumberField(TEXT("total_added"), (double)TotalAdded);
+	Out->SetNumberField(TEXT("total_evicted"), (double)TotalEvicted);
+	if (FirstSeq != NextSeq)
+	{
+		Out->SetNumberField(TEXT("oldest_seq"), FirstSeq);
+		Out->SetNumberField(TEXT("oldest_time"), (double)(BaseUnixMs + GetRecord(FirstSeq).TimeMs));
+	}
+}
+
+void FUAL_LogStore::Shutdown()
+{
+	FScopeLock ScopeLock(&Lock);
+	Records.Empty();
+	TextArena.Empty();
+	Categories.Empty();
+	CategoryIds.Empty();
+	CategoryPostings.Empty();
+	for (TArray<uint32>& Postings : LevelPostings)
+	{
+		Postings.Empty();
+	}
+	TokenPostings.Empty();
+	RecordCapacity = 0;
+	FirstSeq = NextSeq;
+	TextReadPos = 0;
+	TextWritePos = 0;
+	LiveTextBytes = 0;
+	LastTimeMs = 0;
+	EvictionsSinceSweep = 0;
+}
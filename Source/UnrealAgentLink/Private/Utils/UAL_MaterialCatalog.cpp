@@ -0,0 +1,730 @@
+#include "UAL_MaterialCatalog.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstance.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/PackageName.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "Algo/BinarySearch.h"
+#include "Dom/JsonObject.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALMaterialCatalog, Log, All);
+
+namespace
+{
+	// 父链最大深度，防止异常数据成环
+	constexpr int32 UALMaxParentDepth = 32;
+
+	const FName UALParentTag(TEXT("Parent"));
+	const FName UALBlendModeTag(TEXT("BlendMode"));
+}
+
+FUAL_MaterialCatalog& FUAL_MaterialCatalog::Get()
+{
+	static FUAL_MaterialCatalog Instance;
+	return Instance;
+}
+
+// ============================================================================
+// 构建与同步
+// ============================================================================
+
+void FUAL_MaterialCatalog::EnsureBuilt()
+{
+	if (bBuilt)
+	{
+		return;
+	}
+	bBuilt = true;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	TArray<FAssetData> Assets;
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+	AssetRegistry.GetAssetsByClass(FTopLevelAssetPath(TEXT("/Script/Engine.Material")), Assets);
+	AssetRegistry.GetAssetsByClass(FTopLevelAssetPath(TEXT("/Script/Engine.MaterialInstanceConstant")), Assets);
+#else
+	AssetRegistry.GetAssetsByClass(FName(TEXT("Material")), Assets);
+	AssetRegistry.GetAssetsByClass(FName(TEXT("MaterialInstanceConstant")), Assets);
+#endif
+
+	const double StartTime = FPlatformTime::Seconds();
+	Entries.Reserve(Assets.Num());
+	ByPath.Reserve(Assets.Num());
+	for (const FAssetData& AssetData : Assets)
+	{
+		UpsertFromAssetData(AssetData);
+	}
+
+	BindDelegates();
+
+	UE_LOG(LogUALMaterialCatalog, Log, TEXT("Material catalog built: %d entries in %.1f ms%s"),
+		Entries.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0,
+		AssetRegistry.IsLoadingAssets() ? TEXT(" (asset registry still loading)") : TEXT(""));
+}
+
+void FUAL_MaterialCatalog::BindDelegates()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FUAL_MaterialCatalog::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FUAL_MaterialCatalog::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FUAL_MaterialCatalog::OnAssetRenamed);
+	// 标签变化（如父材质被修改）走同一更新路径
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FUAL_MaterialCatalog::OnAssetAdded);
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FUAL_MaterialCatalog::OnPackageSaved);
+}
+
+void FUAL_MaterialCatalog::Shutdown()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+
+	AssetAddedHandle.Reset();
+	AssetRemovedHandle.Reset();
+	AssetRenamedHandle.Reset();
+	AssetUpdatedHandle.Reset();
+	PackageSavedHandle.Reset();
+
+	Entries.Empty();
+	ByPath.Empty();
+	SortedIndices.Empty();
+	ParamToRoots.Empty();
+	RootToEntries.Empty();
+	bBuilt = false;
+	bOrderDirty = bChainsDirty = bParamIndexDirty = true;
+}
+
+bool FUAL_MaterialCatalog::IsCatalogClass(const FAssetData& AssetData, bool& bOutIsInstance)
+{
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+	const FName ClassName = AssetData.AssetClassPath.GetAssetName();
+#else
+	const FName ClassName = AssetData.AssetClass;
+#endif
+	static const FName MaterialClassName(TEXT("Material"));
+	static const FName InstanceClassName(TEXT("MaterialInstanceConstant"));
+
+	bOutIsInstance = ClassName == InstanceClassName;
+	return bOutIsInstance || ClassName == MaterialClassName;
+}
+
+FString FUAL_MaterialCatalog::GetObjectPathString(const FAssetData& AssetData)
+{
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+	return AssetData.GetSoftObjectPath().ToString();
+#else
+	return AssetData.ObjectPath.ToString();
+#endif
+}
+
+FString FUAL_MaterialCatalog::NormalizeBlendMode(const FString& BlendMode)
+{
+	// 兼容 "BLEND_Translucent" 与 "Translucent" 两种写法
+	FString Result = BlendMode;
+	Result.RemoveFromStart(TEXT("BLEND_"), ESearchCase::IgnoreCase);
+	return Result;
+}
+
+void FUAL_MaterialCatalog::UpsertFromAssetData(const FAssetData& AssetData)
+{
+	bool bIsInstance = false;
+	if (!IsCatalogClass(AssetData, bIsInstance))
+	{
+		return;
+	}
+
+	const FString Path = GetObjectPathString(AssetData);
+	int32 Index = INDEX_NONE;
+	if (const int32* Existing = ByPath.Find(Path))
+	{
+		Index = *Existing;
+	}
+	else
+	{
+		Index = Entries.AddDefaulted();
+		ByPath.Add(Path, Index);
+		bOrderDirty = true;
+		bChainsDirty = true;
+	}
+
+	FEntry& Entry = Entries[Index];
+	Entry.Path = Path;
+	Entry.Name = AssetData.AssetName;
+	Entry.bIsInstance = bIsInstance;
+	Entry.bRemoved = false;
+
+	FString ParentPath;
+	if (bIsInstance)
+	{
+		FString ParentTag;
+		if (AssetData.GetTagValue(UALParentTag, ParentTag) && !ParentTag.IsEmpty() && ParentTag != TEXT("None"))
+		{
+			ParentPath = FPackageName::ExportTextPathToObjectPath(ParentTag);
+		}
+	}
+	if (Entry.ParentPath != ParentPath)
+	{
+		Entry.ParentPath = ParentPath;
+		bChainsDirty = true;
+	}
+
+	FString BlendModeTag;
+	if (!bIsInstance && AssetData.GetTagValue(UALBlendModeTag, BlendModeTag))
+	{
+		Entry.BlendMode = BlendModeTag;
+	}
+
+	// 资产已在内存中时顺带建立参数索引（零额外加载）；否则旧索引可能过期，等待下次按需加载
+	if (UMaterialInterface* Loaded = Cast<UMaterialInterface>(AssetData.FastGetAsset(false)))
+	{
+		IndexParams(Entry, Loaded);
+	}
+	else if (Entry.bParamsIndexed)
+	{
+		Entry.bParamsIndexed = false;
+		Entry.Params.Reset();
+		bParamIndexDirty = true;
+	}
+}
+
+void FUAL_MaterialCatalog::UpsertFromObject(UMaterialInterface* Material)
+{
+	const FString Path = Material->GetPathName();
+	int32 Index = INDEX_NONE;
+	if (const int32* Existing = ByPath.Find(Path))
+	{
+		Index = *Existing;
+	}
+	else
+	{
+		Index = Entries.AddDefaulted();
+		ByPath.Add(Path, Index);
+		bOrderDirty = true;
+		bChainsDirty = true;
+	}
+
+	FEntry& Entry = Entries[Index];
+	Entry.Path = Path;
+	Entry.Name = Material->GetFName();
+	Entry.bIsInstance = Material->IsA<UMaterialInstance>();
+	Entry.bRemoved = false;
+
+	FString ParentPath;
+	if (UMaterialInstance* Instance = Cast<UMaterialInstance>(Material))
+	{
+		if (Instance->Parent)
+		{
+			ParentPath = Instance->Parent->GetPathName();
+		}
+	}
+	if (Entry.ParentPath != ParentPath)
+	{
+		Entry.ParentPath = ParentPath;
+		bChainsDirty = true;
+	}
+
+	IndexParams(Entry, Material);
+}
+
+void FUAL_MaterialCatalog::RemovePath(const FString& Path)
+{
+	int32 Index = INDEX_NONE;
+	if (!ByPath.RemoveAndCopyValue(Path, Index))
+	{
+		return;
+	}
+
+	// 条目原地标记删除，保持其它索引稳定
+	FEntry& Entry = Entries[Index];
+	Entry.bRemoved = true;
+	Entry.Params.Empty();
+	Entry.bParamsIndexed = false;
+	bOrderDirty = true;
+	bChainsDirty = true;
+	bParamIndexDirty = true;
+}
+
+void FUAL_MaterialCatalog::IndexParams(FEntry& Entry, UMaterialInterface* Material)
+{
+	Entry.Params.Reset();
+
+	if (UMaterial* BaseMaterial = Cast<UMaterial>(Material))
+	{
+		Entry.BlendMode = StaticEnum<EBlendMode>()->GetNameStringByValue((int64)BaseMaterial->BlendMode);
+
+		TArray<FMaterialParameterInfo> ParamInfos;
+		TArray<FGuid> ParamIds;
+		auto AddParams = [&Entry, &ParamInfos](EParamType Type)
+		{
+			for (const FMaterialParameterInfo& Info : ParamInfos)
+			{
+				Entry.Params.Add({ Info.Name, Type });
+			}
+		};
+
+		BaseMaterial->GetAllScalarParameterInfo(ParamInfos, ParamIds);
+		AddParams(EParamType::Scalar);
+		ParamInfos.Reset();
+		ParamIds.Reset();
+		BaseMaterial->GetAllVectorParameterInfo(ParamInfos, ParamIds);
+		AddParams(EParamType::Vector);
+		ParamInfos.Reset();
+		ParamIds.Reset();
+		BaseMaterial->GetAllTextureParameterInfo(ParamInfos, ParamIds);
+		AddParams(EParamType::Texture);
+
+		bParamIndexDirty = true;
+	}
+	else if (UMaterialInstance* Instance = Cast<UMaterialInstance>(Material))
+	{
+		// 实例只记录覆盖的参数与混合模式覆盖，可用参数沿父链取根材质
+		for (const FScalarParameterValue& Value : Instance->ScalarParameterValues)
+		{
+			Entry.Params.Add({ Value.ParameterInfo.Name, EParamType::Scalar });
+		}
+		for (const FVectorParameterValue& Value : Instance->VectorParameterValues)
+		{
+			Entry.Params.Add({ Value.ParameterInfo.Name, EParamType::Vector });
+		}
+		for (const FTextureParameterValue& Value : Instance->TextureParameterValues)
+		{
+			Entry.Params.Add({ Value.ParameterInfo.Name, EParamType::Texture });
+		}
+
+		Entry.BlendMode = Instance->BasePropertyOverrides.bOverride_BlendMode
+			? StaticEnum<EBlendMode>()->GetNameStringByValue((int64)Instance->BasePropertyOverrides.BlendMode)
+			: FString();
+	}
+
+	Entry.bParamsIndexed = true;
+}
+
+bool FUAL_MaterialCatalog::EnsureRootParams(int32 RootIndex, int32& InOutLoadBudget, int32& OutLoadCount)
+{
+	if (Entries[RootIndex].bParamsIndexed)
+	{
+		return true;
+	}
+	if (InOutLoadBudget <= 0)
+	{
+		return false;
+	}
+
+	--InOutLoadBudget;
+	++OutLoadCount;
+	++TotalLoadCount;
+
+	// 加载期间可能触发注册表事件导致数组扩容，加载后再取引用
+	const FString Path = Entries[RootIndex].Path;
+	UMaterialInterface* Material = LoadObject<UMaterialInterface>(nullptr, *Path);
+
+	FEntry& Entry = Entries[RootIndex];
+	if (Material)
+	{
+		IndexParams(Entry, Material);
+	}
+	else
+	{
+		// 加载失败也视为已索引（无参数），避免每次查询重复尝试
+		UE_LOG(LogUALMaterialCatalog, Warning, TEXT("Failed to load material for catalog: %s"), *Path);
+		Entry.Params.Reset();
+		Entry.bParamsIndexed = true;
+	}
+	return true;
+}
+
+void FUAL_MaterialCatalog::OnAssetAdded(const FAssetData& AssetData)
+{
+	UpsertFromAssetData(AssetData);
+}
+
+void FUAL_MaterialCatalog::OnAssetRemoved(const FAssetData& AssetData)
+{
+	bool bIsInstance = false;
+	if (IsCatalogClass(AssetData, bIsInstance))
+	{
+		RemovePath(GetObjectPathString(AssetData));
+	}
+}
+
+void FUAL_MaterialCatalog::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	bool bIsInstance = false;
+	if (IsCatalogClass(AssetData, bIsInstance))
+	{
+		RemovePath(OldObjectPath);
+		UpsertFromAssetData(AssetData);
+	}
+}
+
+void FUAL_MaterialCatalog::OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	if (!Package)
+	{
+		return;
+	}
+
+	// 保存时对象必然在内存中：直接从对象刷新参数、父材质与混合模式
+	ForEachObjectWithPackage(Package, [this](UObject* Object)
+	{
+		UMaterialInterface* Material = Cast<UMaterialInterface>(Object);
+		if (Material && Material->IsAsset())
+		{
+			UpsertFromObject(Material);
+		}
+		return true;
+	}, false);
+}
+
+// ============================================================================
+// 派生索引
+// ============================================================================
+
+void FUAL_MaterialCatalog::RebuildOrder()
+{
+	SortedIndices.Reset(ByPath.Num());
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		if (!Entries[Index].bRemoved)
+		{
+			SortedIndices.Add(Index);
+		}
+	}
+	SortedIndices.Sort([this](int32 A, int32 B)
+	{
+		return Entries[A].Path < Entries[B].Path;
+	});
+	bOrderDirty = false;
+}
+
+void FUAL_MaterialCatalog::RebuildChains()
+{
+	for (FEntry& Entry : Entries)
+	{
+		Entry.RootIndex = INDEX_NONE;
+	}
+	RootToEntries.Reset();
+
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		if (Entries[Index].bRemoved)
+		{
+			continue;
+		}
+
+		int32 Current = Index;
+		for (int32 Depth = 0; Depth < UALMaxParentDepth && Current != INDEX_NONE; ++Depth)
+		{
+			const FEntry& CurrentEntry = Entries[Current];
+			if (!CurrentEntry.bIsInstance)
+			{
+				Entries[Index].RootIndex = Current;
+				RootToEntries.FindOrAdd(Current).Add(Index);
+				break;
+			}
+			const int32* Parent = ByPath.Find(CurrentEntry.ParentPath);
+			Current = Parent ? *Parent : INDEX_NONE;
+		}
+	}
+	bChainsDirty = false;
+}
+
+void FUAL_MaterialCatalog::RebuildParamIndex()
+{
+	ParamToRoots.Reset();
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FEntry& Entry = Entries[Index];
+		if (Entry.bRemoved || Entry.bIsInstance || !Entry.bParamsIndexed)
+		{
+			continue;
+		}
+		for (const FParam& Param : Entry.Params)
+		{
+			ParamToRoots.FindOrAdd(Param.Name).AddUnique(Index);
+		}
+	}
+	bParamIndexDirty = false;
+}
+
+// ============================================================================
+// 查询
+// ============================================================================
+
+TArray<FString> FUAL_MaterialCatalog::GetParentChain(int32 Index) const
+{
+	TArray<FString> Chain;
+	const FEntry* Current = &Entries[Index];
+	for (int32 Depth = 0; Depth < UALMaxParentDepth && Current->bIsInstance && !Current->ParentPath.IsEmpty(); ++Depth)
+	{
+		Chain.Add(Current->ParentPath);
+		const int32* Parent = ByPath.Find(Current->ParentPath);
+		if (!Parent)
+		{
+			break;
+		}
+		Current = &Entries[*Parent];
+	}
+	return Chain;
+}
+
+FString FUAL_MaterialCatalog::GetEffectiveBlendMode(int32 Index) const
+{
+	const FEntry& Entry = Entries[Index];
+	if (!Entry.BlendMode.IsEmpty() || !Entry.bIsInstance)
+	{
+		return Entry.BlendMode;
+	}
+	return Entry.RootIndex != INDEX_NONE ? Entries[Entry.RootIndex].BlendMode : FString();
+}
+
+const TArray<FUAL_MaterialCatalog::FParam>* FUAL_MaterialCatalog::GetEffectiveParams(int32 Index) const
+{
+	const int32 RootIndex = Entries[Index].RootIndex;
+	if (RootIndex == INDEX_NONE || !Entries[RootIndex].bParamsIndexed)
+	{
+		return nullptr;
+	}
+	return &Entries[RootIndex].Params;
+}
+
+const TCHAR* FUAL_MaterialCatalog::ParamTypeToString(EParamType Type)
+{
+	switch (Type)
+	{
+	case EParamType::Vector:  return TEXT("vector");
+	case EParamType::Texture: return TEXT("texture");
+	default:                  return TEXT("scalar");
+	}
+}
+
+FUAL_MaterialCatalog::FQueryResult FUAL_MaterialCatalog::Query(const FQuery& InQuery)
+{
+	EnsureBuilt();
+	if (bOrderDirty)
+	{
+		RebuildOrder();
+	}
+	if (bChainsDirty)
+	{
+		RebuildChains();
+	}
+
+	FQueryResult Result;
+	int32 LoadBudget = InQuery.LoadBudget;
+
+	const FString NameFilter = InQuery.NameFilter.Replace(TEXT("*"), TEXT(""));
+	const FString BlendFilter = NormalizeBlendMode(InQuery.BlendMode);
+	const bool bParamFilter = !InQuery.ParamName.IsNone() || !InQuery.ParamType.IsEmpty();
+	const bool bNeedRootParams = bParamFilter || InQuery.bNeedParams || !BlendFilter.IsEmpty();
+
+	// 有参数名过滤时由倒排索引给出候选：含该参数的已索引根材质及尚未索引的根材质下的条目
+	TArray<int32> Candidates;
+	const TArray<int32>* Order = &SortedIndices;
+	if (!InQuery.ParamName.IsNone())
+	{
+		if (bParamIndexDirty)
+		{
+			RebuildParamIndex();
+		}
+		if (const TArray<int32>* Roots = ParamToRoots.Find(InQuery.ParamName))
+		{
+			for (const int32 RootIndex : *Roots)
+			{
+				if (const TArray<int32>* Members = RootToEntries.Find(RootIndex))
+				{
+					Candidates.Append(*Members);
+				}
+			}
+		}
+		for (const TPair<int32, TArray<int32>>& Pair : RootToEntries)
+		{
+			if (!Entries[Pair.Key].bParamsIndexed)
+			{
+				Candidates.Append(Pair.Value);
+			}
+		}
+		Candidates.Sort([this](int32 A, int32 B)
+		{
+			return Entries[A].Path < Entries[B].Path;
+		});
+		Order = &Candidates;
+	}
+
+	auto MatchesParam = [&InQuery](const FEntry& Root)
+	{
+		for (const FParam& Param : Root.Params)
+		{
+			if ((InQuery.ParamName.IsNone() || Param.Name == InQuery.ParamName)
+				&& (InQuery.ParamType.IsEmpty() || InQuery.ParamType.Equals(ParamTypeToString(Param.Type), ESearchCase::IgnoreCase)))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	auto IsUnder = [this, &InQuery](const FEntry& Entry)
+	{
+		if (Entry.ParentPath.IsEmpty())
+		{
+			return false;
+		}
+		if (!InQuery.bParentRecursive)
+		{
+			return Entry.ParentPath.Equals(InQuery.ParentPath, ESearchCase::IgnoreCase);
+		}
+		const FEntry* Current = &Entry;
+		for (int32 Depth = 0; Depth < UALMaxParentDepth && Current->bIsInstance && !Current->ParentPath.IsEmpty(); ++Depth)
+		{
+			if (Current->ParentPath.Equals(InQuery.ParentPath, ESearchCase::IgnoreCase))
+			{
+				return true;
+			}
+			const int32* Parent = ByPath.Find(Current->ParentPath);
+			if (!Parent)
+			{
+				break;
+			}
+			Current = &Entries[*Parent];
+		}
+		return false;
+	};
+
+	const int32 StartPos = InQuery.Cursor.IsEmpty() ? 0
+		: Algo::UpperBoundBy(*Order, InQuery.Cursor, [this](int32 Index) -> const FString& { return Entries[Index].Path; });
+	bool bHasMore = false;
+	bool bPageFull = false;
+
+	// 不统计总数时从游标处开始，页满后遇到下一个可能的匹配即停止
+	for (int32 Pos = InQuery.bCountMatches ? 0 : StartPos; Pos < Order->Num(); ++Pos)
+	{
+		const int32 Index = (*Order)[Pos];
+		const FEntry& Entry = Entries[Index];
+		const bool bInPage = Pos >= StartPos && !bPageFull;
+
+		// 先做不需要加载的过滤
+		if (Entry.bIsInstance ? !InQuery.bIncludeInstances : !InQuery.bIncludeMaterials)
+		{
+			continue;
+		}
+		if (!InQuery.SearchPath.IsEmpty() && !Entry.Path.StartsWith(InQuery.SearchPath))
+		{
+			continue;
+		}
+		if (!NameFilter.IsEmpty() && !Entry.Name.ToString().Contains(NameFilter, ESearchCase::IgnoreCase))
+		{
+			continue;
+		}
+		if (!InQuery.ParentPath.IsEmpty() && !IsUnder(Entry))
+		{
+			continue;
+		}
+
+		if (bNeedRootParams && Entry.RootIndex != INDEX_NONE)
+		{
+			// 根材质的参数 / 混合模式未知时只为本页条目在预算内按需加载（每个根材质只加载一次），页外条目只用已知信息
+			int32 NoLoadBudget = 0;
+			const bool bRootKnown = EnsureRootParams(Entry.RootIndex, bInPage ? LoadBudget : NoLoadBudget, Result.LoadCount);
+			if (!bRootKnown && (bParamFilter || !BlendFilter.IsEmpty()))
+			{
+				if (bInPage)
+				{
+					++Result.UnresolvedCount;
+				}
+				else if (bPageFull)
+				{
+					bHasMore = true;
+					if (!InQuery.bCountMatches)
+					{
+						break;
+					}
+				}
+				continue;
+			}
+		}
+		// 加载可能触发注册表事件使数组扩容，此后重新取条目
+		const FEntry& Current = Entries[Index];
+
+		if (!BlendFilter.IsEmpty() && !NormalizeBlendMode(GetEffectiveBlendMode(Index)).Equals(BlendFilter, ESearchCase::IgnoreCase))
+		{
+			continue;
+		}
+		if (bParamFilter && (Current.RootIndex == INDEX_NONE || !MatchesParam(Entries[Current.RootIndex])))
+		{
+			continue;
+		}
+
+		if (InQuery.bCountMatches)
+		{
+			++Result.MatchedCount;
+		}
+		if (Pos < StartPos)
+		{
+			continue;
+		}
+		if (!bPageFull)
+		{
+			Result.Indices.Add(Index);
+			bPageFull = Result.Indices.Num() >= InQuery.MaxResults;
+		}
+		else
+		{
+			bHasMore = true;
+			if (!InQuery.bCountMatches)
+			{
+				break;
+			}
+		}
+	}
+
+	if (bHasMore && Result.Indices.Num() > 0)
+	{
+		Result.NextCursor = Entries[Result.Indices.Last()].Path;
+	}
+	return Result;
+}
+
+void FUAL_MaterialCatalog::WriteStats(const TSharedPtr<FJsonObject>& Out) const
+{
+	int32 MaterialCount = 0;
+	int32 InstanceCount = 0;
+	int32 IndexedRootCount = 0;
+	for (const FEntry& Entry : Entries)
+	{
+		if (Entry.bRemoved)
+		{
+			continue;
+		}
+		if (Entry.bIsInstance)
+		{
+			++InstanceCount;
+		}
+		else
+		{
+			++MaterialCount;
+			IndexedRootCount += Entry.bParamsIndexed ? 1 : 0;
+		}
+	}
+
+	Out->SetNumberField(TEXT("materials"), MaterialCount);
+	Out->SetNumberField(TEXT("instances"), InstanceCount);
+	Out->SetNumberField(TEXT("indexed_materials"), IndexedRootCount);
+	Out->SetNumberField(TEXT("total_loads"), TotalLoadCount);
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		Out->SetBoolField(TEXT("registry_loading"), AssetRegistryModule->Get().IsLoadingAssets());
+	}
+}
@@ -0,0 +1,238 @@
+#include "UAL_MaterialCompileScheduler.h"
+#include "UAL_CommandUtils.h"
+
+#include "Materials/Material.h"
+#include "Materials/MaterialInterface.h"
+#include "MaterialShared.h"
+#include "MaterialEditorUtilities.h"
+#include "MaterialGraph/MaterialGraph.h"
+#include "ShaderCompiler.h"
+#include "HAL/IConsoleManager.h"
+#include "RHI.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALMaterialCompile, Log, All);
+
+static TAutoConsoleVariable<float> CVarMaterialCompileDelay(
+	TEXT("ual.MaterialCompileDelay"),
+	1.0f,
+	TEXT("材质延迟编译的静默期（秒）：最后一次编辑后等待该时长再统一编译"),
+	ECVF_Default);
+
+FUAL_MaterialCompileScheduler& FUAL_MaterialCompileScheduler::Get()
+{
+	static FUAL_MaterialCompileScheduler Instance;
+	return Instance;
+}
+
+int32 FUAL_MaterialCompileScheduler::MarkDirty(UMaterialInterface* Material)
+{
+	if (!Material)
+	{
+		return Pending.Num();
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	FPendingCompile& Entry = Pending.FindOrAdd(Material);
+	if (!Entry.Material.IsValid())
+	{
+		Entry.Material = Material;
+		Entry.FirstDirtyTime = Now;
+	}
+	++Entry.EditCount;
+
+	LastDirtyTime = Now;
+	ScheduleFlush();
+	return Pending.Num();
+}
+
+void FUAL_MaterialCompileScheduler::CompileNow(UMaterialInterface* Material, bool bForceRecompile)
+{
+	if (!Material)
+	{
+		return;
+	}
+
+	double FirstDirtyTime = FPlatformTime::Seconds();
+	int32 EditCount = 0;
+	FPendingCompile Existing;
+	if (Pending.RemoveAndCopyValue(Material, Existing))
+	{
+		FirstDirtyTime = Existing.FirstDirtyTime;
+		EditCount = Existing.EditCount;
+	}
+	Submit(Material, FirstDirtyTime, EditCount, bForceRecompile);
+}
+
+int32 FUAL_MaterialCompileScheduler::Flush()
+{
+	if (Pending.Num() == 0)
+	{
+		return 0;
+	}
+
+	// 先取出队列，提交过程中产生的新编辑留给下一批
+	TArray<FPendingCompile> Batch;
+	Pending.GenerateValueArray(Batch);
+	Pending.Reset();
+
+	int32 SubmittedCount = 0;
+	for (const FPendingCompile& Entry : Batch)
+	{
+		if (UMaterialInterface* Material = Entry.Material.Get())
+		{
+			Submit(Material, Entry.FirstDirtyTime, Entry.EditCount);
+			++SubmittedCount;
+		}
+	}
+
+	UE_LOG(LogUALMaterialCompile, Log, TEXT("Flushed material compile queue: %d submitted"), SubmittedCount);
+	return SubmittedCount;
+}
+
+void FUAL_MaterialCompileScheduler::Submit(UMaterialInterface* Material, double FirstDirtyTime, int32 EditCount, bool bForceRecompile)
+{
+	const int32 JobsBefore = GShaderCompilingManager ? GShaderCompilingManager->GetNumRemainingJobs() : 0;
+	const double SubmitTime = FPlatformTime::Seconds();
+
+	if (bForceRecompile)
+	{
+		if (UMaterial* BaseMaterial = Cast<UMaterial>(Material))
+		{
+			BaseMaterial->ForceRecompileForRendering();
+		}
+	}
+
+	// PostEditChange 会重建材质资源并把着色器任务交给 ShaderCompilingManager（异步）
+	Material->PreEditChange(nullptr);
+	Material->PostEditChange();
+
+	if (UMaterial* BaseMaterial = Cast<UMaterial>(Material))
+	{
+		if (BaseMaterial->MaterialGraph)
+		{
+			FMaterialEditorUtilities::UpdateMaterialAfterGraphChange(BaseMaterial->MaterialGraph);
+		}
+	}
+
+	const int32 JobsAfter = GShaderCompilingManager ? GShaderCompilingManager->GetNumRemainingJobs() : 0;
+
+	FInFlightCompile& Entry = InFlight.AddDefaulted_GetRef();
+	Entry.Material = Material;
+	Entry.MaterialPath = Material->GetPathName();
+	Entry.FirstDirtyTime = FirstDirtyTime;
+	Entry.SubmitTime = SubmitTime;
+	Entry.SubmitMs = (FPlatformTime::Seconds() - SubmitTime) * 1000.0;
+	Entry.EditCount = EditCount;
+	// 近似值：提交前后 ShaderCompilingManager 队列的增量
+	Entry.ShaderJobs = FMath::Max(0, JobsAfter - JobsBefore);
+
+	if (!InFlightTickerHandle.IsValid())
+	{
+		InFlightTickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_MaterialCompileScheduler::TickInFlight), 0.1f);
+	}
+}
+
+bool FUAL_MaterialCompileScheduler::IsCompilationFinished(UMaterialInterface* Material)
+{
+	const FMaterialResource* Resource = Material->GetMaterialResource(GMaxRHIFeatureLevel);
+	return !Resource || Resource->IsCompilationFinished();
+}
+
+void FUAL_MaterialCompileScheduler::ScheduleFlush()
+{
+	if (FlushTickerHandle.IsValid())
+	{
+		return;
+	}
+	FlushTickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_MaterialCompileScheduler::TickFlush), 0.1f);
+}
+
+bool FUAL_MaterialCompileScheduler::TickFlush(float DeltaTime)
+{
+	if (Pending.Num() == 0)
+	{
+		FlushTickerHandle.Reset();
+		return false;
+	}
+
+	const double Delay = FMath::Max(0.0f, CVarMaterialCompileDelay.GetValueOnGameThread());
+	if (FPlatformTime::Seconds() - LastDirtyTime < Delay)
+	{
+		return true;
+	}
+
+	Flush();
+	FlushTickerHandle.Reset();
+	return false;
+}
+
+bool FUAL_MaterialCompileScheduler::TickInFlight(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	for (int32 Index = 0; Index < InFlight.Num(); ++Index)
+	{
+		FInFlightCompile& Entry = InFlight[Index];
+		UMaterialInterface* Material = Entry.Material.Get();
+		if (Material && !IsCompilationFinished(Material))
+		{
+			continue;
+		}
+
+		TArray<TSharedPtr<FJsonValue>> ErrorsJson;
+		if (Material)
+		{
+			if (const FMaterialResource* Resource = Material->GetMaterialResource(GMaxRHIFeatureLevel))
+			{
+				for (const FString& Error : Resource->GetCompileErrors())
+				{
+					ErrorsJson.Add(MakeShared<FJsonValueString>(Error));
+				}
+			}
+		}
+
+		TSharedPtr<FJsonObject> EventPayload = MakeShared<FJsonObject>();
+		EventPayload->SetStringField(TEXT("material_path"), Entry.MaterialPath);
+		EventPayload->SetBoolField(TEXT("ok"), Material != nullptr && ErrorsJson.Num() == 0);
+		EventPayload->SetNumberField(TEXT("compile_ms"), (Now - Entry.SubmitTime) * 1000.0);
+		EventPayload->SetNumberField(TEXT("submit_ms"), Entry.SubmitMs);
+		EventPayload->SetNumberField(TEXT("queued_ms"), (Entry.SubmitTime - Entry.FirstDirtyTime) * 1000.0);
+		EventPayload->SetNumberField(TEXT("shader_jobs"), Entry.ShaderJobs);
+		EventPayload->SetNumberField(TEXT("coalesced_edits"), Entry.EditCount);
+		EventPayload->SetNumberField(TEXT("remaining_shader_jobs"), GShaderCompilingManager ? GShaderCompilingManager->GetNumRemainingJobs() : 0);
+		EventPayload->SetArrayField(TEXT("errors"), ErrorsJson);
+		if (!Material)
+		{
+			EventPayload->SetStringField(TEXT("error"), TEXT("Material was unloaded before compilation finished"));
+		}
+		UAL_CommandUtils::SendEvent(TEXT("material.compiled"), EventPayload);
+
+		UE_LOG(LogUALMaterialCompile, Log, TEXT("Material compiled: %s (%.0f ms, ~%d shader jobs, %d edits coalesced, %d errors)"),
+			*Entry.MaterialPath, (Now - Entry.SubmitTime) * 1000.0, Entry.ShaderJobs, Entry.EditCount, ErrorsJson.Num());
+
+		InFlight.RemoveAt(Index--);
+	}
+
+	if (InFlight.Num() == 0)
+	{
+		InFlightTickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FUAL_MaterialCompileScheduler::Shutdown()
+{
+	if (FlushTickerHandle.IsValid())
+	{
+		UAL_CORE_TICKER.RemoveTicker(FlushTickerHandle);
+		FlushTickerHandle.Reset();
+	}
+	if (InFlightTickerHandle.IsValid())
+	{
+		UAL_CORE_TICKER.RemoveTicker(InFlightTickerHandle);
+		InFlightTickerHandle.Reset();
+	}
+	Pending.Empty();
+	InFlight.Empty();
+}
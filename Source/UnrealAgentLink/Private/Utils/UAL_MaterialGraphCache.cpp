@@ -0,0 +1,450 @@
+#include "UAL_MaterialGraphCache.h"
+
+#include "Materials/Material.h"
+#include "Materials/MaterialExpression.h"
+#include "Materials/MaterialExpressionTextureSample.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "UObject/UObjectGlobals.h"
+#include "Hash/CityHash.h"
+
+namespace
+{
+	// 删除记录最多保留的版本跨度；since_version 早于被裁剪的记录时退化为全量返回
+	constexpr int32 UALMaxTombstoneVersions = 64;
+
+	void MixString(uint64& Hash, const FString& Value)
+	{
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*Value), Value.Len() * sizeof(TCHAR), Hash);
+	}
+
+	void MixInt(uint64& Hash, uint64 Value)
+	{
+		Hash = CityHash128to64(Uint128_64(Hash, Value));
+	}
+
+	TSharedPtr<FJsonObject> BuildLinkJson(const FString& FromId, const FString& FromPin, const FString& ToId, const FString& ToPin)
+	{
+		TSharedPtr<FJsonObject> Link = MakeShared<FJsonObject>();
+		Link->SetStringField(TEXT("from_node"), FromId);
+		Link->SetStringField(TEXT("from_pin"), FromPin);
+		Link->SetStringField(TEXT("to_node"), ToId);
+		Link->SetStringField(TEXT("to_pin"), ToPin);
+		return Link;
+	}
+}
+
+FUAL_MaterialGraphCache& FUAL_MaterialGraphCache::Get()
+{
+	static FUAL_MaterialGraphCache Instance;
+	return Instance;
+}
+
+void FUAL_MaterialGraphCache::EnsureDelegates()
+{
+	if (!ObjectModifiedHandle.IsValid())
+	{
+		ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FUAL_MaterialGraphCache::OnObjectModified);
+	}
+	if (!ObjectPropertyChangedHandle.IsValid())
+	{
+		ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FUAL_MaterialGraphCache::OnObjectPropertyChanged);
+	}
+	if (!ObjectTransactedHandle.IsValid())
+	{
+		ObjectTransactedHandle = FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FUAL_MaterialGraphCache::OnObjectTransacted);
+	}
+}
+
+void FUAL_MaterialGraphCache::NotifyObjectChanged(UObject* Object)
+{
+	if (!Object || Snapshots.Num() == 0 || !IsInGameThread())
+	{
+		return;
+	}
+
+	// 材质本身或其表达式 / 图表节点（Outer 链上的材质）
+	const UMaterial* Material = Cast<UMaterial>(Object);
+	if (!Material)
+	{
+		Material = Object->GetTypedOuter<UMaterial>();
+	}
+	if (FSnapshot* Snapshot = Material ? Snapshots.Find(Material) : nullptr)
+	{
+		++Snapshot->ChangeCount;
+	}
+}
+
+void FUAL_MaterialGraphCache::OnObjectModified(UObject* Object)
+{
+	NotifyObjectChanged(Object);
+}
+
+void FUAL_MaterialGraphCache::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	NotifyObjectChanged(Object);
+}
+
+void FUAL_MaterialGraphCache::OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event)
+{
+	NotifyObjectChanged(Object);
+}
+
+const FUAL_MaterialGraphCache::FSnapshot& FUAL_MaterialGraphCache::Refresh(UMaterial* Material, bool bForceScan)
+{
+	EnsureDelegates();
+
+	// 清理已被 GC 的材质
+	for (auto It = Snapshots.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Material.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	FSnapshot* SnapshotPtr = Snapshots.Find(Material);
+	if (!SnapshotPtr || SnapshotPtr->Material.Get() != Material)
+	{
+		SnapshotPtr = &Snapshots.Add(Material);
+		SnapshotPtr->Material = Material;
+		SnapshotPtr->Epoch = FGuid::NewGuid();
+	}
+	FSnapshot& Snapshot = *SnapshotPtr;
+
+	if (bForceScan || Snapshot.Version == 0 || Snapshot.ChangeCount != Snapshot.ScannedChangeCount)
+	{
+		Snapshot.ScannedChangeCount = Snapshot.ChangeCount;
+		Scan(Material, Snapshot);
+	}
+	return Snapshot;
+}
+
+void FUAL_MaterialGraphCache::Scan(UMaterial* Material, FSnapshot& Snapshot)
+{
+	const int32 NextVersion = Snapshot.Version + 1;
+	bool bChanged = Snapshot.Version == 0;
+
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+	const auto& Expressions = Material->GetExpressions();
+#else
+	const auto& Expressions = Material->Expressions;
+#endif
+
+	// 第一遍：node_id 为表达式对象名，删除其它节点不会改变已有节点的 ID
+	TMap<const UMaterialExpression*, FString> ExpressionToId;
+	TArray<FName> NodeOrder;
+	NodeOrder.Reserve(Expressions.Num());
+	int32 TextureSampleCount = 0;
+	for (UMaterialExpression* Expression : Expressions)
+	{
+		if (!Expression)
+		{
+			continue;
+		}
+		ExpressionToId.Add(Expression, Expression->GetName());
+		NodeOrder.Add(Expression->GetFName());
+		if (Cast<UMaterialExpressionTextureSample>(Expression))
+		{
+			++TextureSampleCount;
+		}
+	}
+
+	TSet<FName> SeenNodes;
+	TSet<FString> SeenLinks;
+	TArray<FString> LinkOrder;
+
+	auto VisitLink = [&](const FString& FromId, const FString& FromPin, const FString& ToId, const FString& ToPin)
+	{
+		FString LinkKey = FString::Printf(TEXT("%s.%s->%s.%s"), *FromId, *FromPin, *ToId, *ToPin);
+		if (SeenLinks.Contains(LinkKey))
+		{
+			return;
+		}
+		SeenLinks.Add(LinkKey);
+		LinkOrder.Add(LinkKey);
+
+		if (!Snapshot.Links.Contains(LinkKey))
+		{
+			FLinkEntry& LinkEntry = Snapshot.Links.Add(LinkKey);
+			LinkEntry.AddedVersion = NextVersion;
+			LinkEntry.Json = BuildLinkJson(FromId, FromPin, ToId, ToPin);
+			Snapshot.RemovedLinks.Remove(LinkKey);
+			bChanged = true;
+		}
+	};
+
+	// 第二遍：节点指纹 + 节点间连线
+	for (UMaterialExpression* Expression : Expressions)
+	{
+		if (!Expression)
+		{
+			continue;
+		}
+
+		const FName NodeName = Expression->GetFName();
+		const FString& NodeId = ExpressionToId.FindChecked(Expression);
+		SeenNodes.Add(NodeName);
+
+		// 指纹只覆盖节点 JSON 中会出现的字段
+		uint64 Fingerprint = 0;
+		MixInt(Fingerprint, reinterpret_cast<UPTRINT>(Expression->GetClass()));
+		MixInt(Fingerprint, static_cast<uint32>(Expression->MaterialExpressionEditorX));
+		MixInt(Fingerprint, static_cast<uint32>(Expression->MaterialExpressionEditorY));
+		MixString(Fingerprint, Expression->Desc);
+
+		FNodeEntry* Entry = Snapshot.Nodes.Find(NodeName);
+		const bool bIsNew = Entry == nullptr;
+		if (bIsNew || Entry->Fingerprint != Fingerprint)
+		{
+			if (bIsNew)
+			{
+				Entry = &Snapshot.Nodes.Add(NodeName);
+				Entry->AddedVersion = NextVersion;
+				Snapshot.RemovedNodes.Remove(NodeName);
+			}
+			Entry->ModifiedVersion = NextVersion;
+			Entry->Fingerprint = Fingerprint;
+
+			TSharedPtr<FJsonObject> NodeObj = MakeShared<FJsonObject>();
+			NodeObj->SetStringField(TEXT("node_id"), NodeId);
+			NodeObj->SetStringField(TEXT("class"), Expression->GetClass()->GetName());
+			NodeObj->SetStringField(TEXT("display_name"), Expression->GetName());
+
+			TSharedPtr<FJsonObject> PosObj = MakeShared<FJsonObject>();
+			PosObj->SetNumberField(TEXT("x"), Expression->MaterialExpressionEditorX);
+			PosObj->SetNumberField(TEXT("y"), Expression->MaterialExpressionEditorY);
+			NodeObj->SetObjectField(TEXT("position"), PosObj);
+
+			if (!Expression->Desc.IsEmpty())
+			{
+				NodeObj->SetStringField(TEXT("description"), Expression->Desc);
+			}
+			Entry->Json = NodeObj;
+			bChanged = true;
+		}
+
+		const TArray<FExpressionInput*> Inputs = Expression->GetInputs();
+		for (int32 InputIndex = 0; InputIndex < Inputs.Num(); ++InputIndex)
+		{
+			FExpressionInput* Input = Inputs[InputIndex];
+			const FString* FromId = (Input && Input->Expression) ? ExpressionToId.Find(Input->Expression) : nullptr;
+			if (!FromId)
+			{
+				continue;
+			}
+
+			FString InputName = Expression->GetInputName(InputIndex).ToString();
+			if (InputName.IsEmpty())
+			{
+				InputName = FString::Printf(TEXT("Input_%d"), InputIndex);
+			}
+			VisitLink(*FromId, FString::Printf(TEXT("Output_%d"), Input->OutputIndex), NodeId, InputName);
+		}
+	}
+
+	// 材质主节点连线
+	struct FMatPin { const TCHAR* Name; FExpressionInput* In; };
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+	auto* ED = Material->GetEditorOnlyData();
+	FMatPin MatPins[] = {
+		{TEXT("BaseColor"),           &ED->BaseColor},
+		{TEXT("Metallic"),            &ED->Metallic},
+		{TEXT("Specular"),            &ED->Specular},
+		{TEXT("Roughness"),           &ED->Roughness},
+		{TEXT("EmissiveColor"),       &ED->EmissiveColor},
+		{TEXT("Opacity"),             &ED->Opacity},
+		{TEXT("OpacityMask"),         &ED->OpacityMask},
+		{TEXT("Normal"),              &ED->Normal},
+		{TEXT("WorldPositionOffset"), &ED->WorldPositionOffset},
+		{TEXT("SubsurfaceColor"),     &ED->SubsurfaceColor},
+		{TEXT("AmbientOcclusion"),    &ED->AmbientOcclusion},
+	};
+#else
+	FMatPin MatPins[] = {
+		{TEXT("BaseColor"),           &Material->BaseColor},
+		{TEXT("Metallic"),            &Material->Metallic},
+		{TEXT("Specular"),            &Material->Specular},
+		{TEXT("Roughness"),           &Material->Roughness},
+		{TEXT("EmissiveColor"),       &Material->EmissiveColor},
+		{TEXT("Opacity"),             &Material->Opacity},
+		{TEXT("OpacityMask"),         &Material->OpacityMask},
+		{TEXT("Normal"),              &Material->Normal},
+		{TEXT("WorldPositionOffset"), &Material->WorldPositionOffset},
+		{TEXT("SubsurfaceColor"),     &Material->SubsurfaceColor},
+		{TEXT("AmbientOcclusion"),    &Material->AmbientOcclusion},
+	};
+#endif
+	for (const FMatPin& MP : MatPins)
+	{
+		const FString* FromId = (MP.In && MP.In->Expression) ? ExpressionToId.Find(MP.In->Expression) : nullptr;
+		if (FromId)
+		{
+			VisitLink(*FromId, FString::Printf(TEXT("Output_%d"), MP.In->OutputIndex), TEXT("Material"), MP.Name);
+		}
+	}
+
+	for (auto It = Snapshot.Nodes.CreateIterator(); It; ++It)
+	{
+		if (!SeenNodes.Contains(It.Key()))
+		{
+			// 与 nodes 中的 node_id 相同
+			FTombstone& Tombstone = Snapshot.RemovedNodes.Add(It.Key());
+			Tombstone.RemovedVersion = NextVersion;
+			Tombstone.Json = MakeShared<FJsonValueString>(It.Key().ToString());
+			It.RemoveCurrent();
+			bChanged = true;
+		}
+	}
+
+	for (auto It = Snapshot.Links.CreateIterator(); It; ++It)
+	{
+		if (!SeenLinks.Contains(It.Key()))
+		{
+			FTombstone& Tombstone = Snapshot.RemovedLinks.Add(It.Key());
+			Tombstone.RemovedVersion = NextVersion;
+			Tombstone.Json = MakeShared<FJsonValueObject>(It.Value().Json);
+			It.RemoveCurrent();
+			bChanged = true;
+		}
+	}
+
+	Snapshot.NodeOrder = MoveTemp(NodeOrder);
+	Snapshot.LinkOrder = MoveTemp(LinkOrder);
+	Snapshot.TextureSampleCount = TextureSampleCount;
+
+	if (bChanged)
+	{
+		Snapshot.Version = NextVersion;
+		PruneTombstones(Snapshot);
+	}
+}
+
+void FUAL_MaterialGraphCache::PruneTombstones(FSnapshot& Snapshot)
+{
+	auto Prune = [&Snapshot](auto& Tombstones)
+	{
+		for (auto It = Tombstones.CreateIterator(); It; ++It)
+		{
+			if (Snapshot.Version - It.Value().RemovedVersion > UALMaxTombstoneVersions)
+			{
+				Snapshot.OldestDeltaVersion = FMath::Max(Snapshot.OldestDeltaVersion, It.Value().RemovedVersion);
+				It.RemoveCurrent();
+			}
+		}
+	};
+	Prune(Snapshot.RemovedNodes);
+	Prune(Snapshot.RemovedLinks);
+}
+
+void FUAL_MaterialGraphCache::WriteFull(const FSnapshot& Snapshot, const TSharedPtr<FJsonObject>& Result)
+{
+	TArray<TSharedPtr<FJsonValue>> Nodes;
+	Nodes.Reserve(Snapshot.NodeOrder.Num());
+	for (const FName& NodeName : Snapshot.NodeOrder)
+	{
+		const FNodeEntry* Entry = Snapshot.Nodes.Find(NodeName);
+		if (Entry && Entry->Json.IsValid())
+		{
+			Nodes.Add(MakeShared<FJsonValueObject>(Entry->Json));
+		}
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Connections;
+	Connections.Reserve(Snapshot.LinkOrder.Num());
+	for (const FString& LinkKey : Snapshot.LinkOrder)
+	{
+		if (const FLinkEntry* Entry = Snapshot.Links.Find(LinkKey))
+		{
+			Connections.Add(MakeShared<FJsonValueObject>(Entry->Json));
+		}
+	}
+
+	Result->SetBoolField(TEXT("full"), true);
+	Result->SetArrayField(TEXT("nodes"), Nodes);
+	Result->SetNumberField(TEXT("node_count"), Nodes.Num());
+	Result->SetNumberField(TEXT("connection_count"), Connections.Num());
+	Result->SetArrayField(TEXT("connections"), Connections);
+}
+
+void FUAL_MaterialGraphCache::WriteDelta(const FSnapshot& Snapshot, int32 SinceVersion, const TSharedPtr<FJsonObject>& Result)
+{
+	TArray<TSharedPtr<FJsonValue>> AddedNodes;
+	TArray<TSharedPtr<FJsonValue>> ModifiedNodes;
+	for (const FName& NodeName : Snapshot.NodeOrder)
+	{
+		const FNodeEntry* Entry = Snapshot.Nodes.Find(NodeName);
+		if (!Entry || !Entry->Json.IsValid())
+		{
+			continue;
+		}
+		if (Entry->AddedVersion > SinceVersion)
+		{
+			AddedNodes.Add(MakeShared<FJsonValueObject>(Entry->Json));
+		}
+		else if (Entry->ModifiedVersion > SinceVersion)
+		{
+			ModifiedNodes.Add(MakeShared<FJsonValueObject>(Entry->Json));
+		}
+	}
+
+	TArray<TSharedPtr<FJsonValue>> AddedLinks;
+	for (const FString& LinkKey : Snapshot.LinkOrder)
+	{
+		const FLinkEntry* Entry = Snapshot.Links.Find(LinkKey);
+		if (Entry && Entry->AddedVersion > SinceVersion)
+		{
+			AddedLinks.Add(MakeShared<FJsonValueObject>(Entry->Json));
+		}
+	}
+
+	auto CollectRemoved = [SinceVersion](const auto& Tombstones)
+	{
+		TArray<TSharedPtr<FJsonValue>> Out;
+		for (const auto& Pair : Tombstones)
+		{
+			if (Pair.Value.RemovedVersion > SinceVersion)
+			{
+				Out.Add(Pair.Value.Json);
+			}
+		}
+		return Out;
+	};
+
+	Result->SetBoolField(TEXT("full"), false);
+	Result->SetNumberField(TEXT("since_version"), SinceVersion);
+	Result->SetBoolField(TEXT("unchanged"), SinceVersion == Snapshot.Version);
+	Result->SetArrayField(TEXT("added_nodes"), AddedNodes);
+	Result->SetArrayField(TEXT("modified_nodes"), ModifiedNodes);
+	Result->SetArrayField(TEXT("removed_nodes"), CollectRemoved(Snapshot.RemovedNodes));
+	Result->SetArrayField(TEXT("added_connections"), AddedLinks);
+	Result->SetArrayField(TEXT("removed_connections"), CollectRemoved(Snapshot.RemovedLinks));
+	Result->SetNumberField(TEXT("node_count"), Snapshot.NodeOrder.Num());
+	Result->SetNumberField(TEXT("connection_count"), Snapshot.LinkOrder.Num());
+}
+
+void FUAL_MaterialGraphCache::WriteEditResult(UMaterial* Material, int32 BaseVersion, const TSharedPtr<FJsonObject>& Data)
+{
+	if (!Material || !Data.IsValid())
+	{
+		return;
+	}
+
+	const FSnapshot& Snapshot = Refresh(Material, true);
+	Data->SetNumberField(TEXT("graph_version"), Snapshot.Version);
+	Data->SetStringField(TEXT("graph_epoch"), Snapshot.Epoch.ToString(EGuidFormats::Digits));
+
+	TSharedPtr<FJsonObject> Delta = MakeShared<FJsonObject>();
+	WriteDelta(Snapshot, BaseVersion, Delta);
+	Data->SetObjectField(TEXT("graph_delta"), Delta);
+}
+
+void FUAL_MaterialGraphCache::Shutdown()
+{
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+	FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedHandle);
+	ObjectModifiedHandle.Reset();
+	ObjectPropertyChangedHandle.Reset();
+	ObjectTransactedHandle.Reset();
+	Snapshots.Reset();
+}
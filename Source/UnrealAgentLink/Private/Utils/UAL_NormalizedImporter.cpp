@@ -572,6 +572,73 @@ bool FUALNormalizedImporter::ExecuteNormalizedImport(
 {
     OutSession = FUALNormalizedImportSession();
 
+    for (int32 Stage = 0; Stage < (int32)EStage::Done; ++Stage)
+    {
+        if (!ExecuteStage((EStage)Stage, SourceFiles, RuleSet, OutSession))
+        {
+            return false;
+        }
+    }
+    return OutSession.FailedCount == 0;
+}
+
+bool FUALNormalizedImporter::ExecuteStage(
+    EStage Stage,
+    const TArray<FString>& SourceFiles,
+    const FUALImportRuleSet& RuleSet,
+    FUALNormalizedImportSession& Session)
+{
+    switch (Stage)
+    {
+    case EStage::Plan:
+        PlanImport(SourceFiles, RuleSet, Session);
+        return true;
+
+    case EStage::Copy:
+        if (!CopyFilesToTarget(Session))
+        {
+            UE_LOG(LogNormalizedImport, Error, TEXT("文件复制失败"));
+            return false;
+        }
+        return true;
+
+    case EStage::Remap:
+        // CoreRedirects 与 PackageNameResolver 是全局状态，注册、加载修复、保存与清理必须在同一帧内完成
+        if (!SetupAssetRegistryAndResolver(Session))
+        {
+            UE_LOG(LogNormalizedImport, Error, TEXT("AssetRegistry 设置失败"));
+            return false;
+        }
+
+        if (!LoadAndFixReferences(Session))
+        {
+            UE_LOG(LogNormalizedImport, Warning, TEXT("引用修复过程中有警告"));
+        }
+
+        if (!SaveAndCleanup(Session))
+        {
+            UE_LOG(LogNormalizedImport, Error, TEXT("保存失败"));
+            return false;
+        }
+
+        UE_LOG(LogNormalizedImport, Log, TEXT("规范化导入完成: 成功 %d, 失败 %d"),
+            Session.SuccessCount, Session.FailedCount);
+        return true;
+
+    default:
+        return true;
+    }
+}
+
+// ============================================================================
+// 步骤 0 - 1.6: 依赖闭包、目标信息、冲突重命名、重定向映射
+// ============================================================================
+
+void FUALNormalizedImporter::PlanImport(
+    const TArray<FString>& SourceFiles,
+    const FUALImportRuleSet& RuleSet,
+    FUALNormalizedImportSession& OutSession)
+{
     UE_LOG(LogNormalizedImport, Log, TEXT("开始规范化导入，共 %d 个初始文件"), SourceFiles.Num());
 
     // ============================================================================
@@ -806,38 +873,6 @@ bool FUALNormalizedImporter::ExecuteNormalizedImport(
             OutSession.SoftPathRedirectMap.Add(OldPath, NewPath);
         }
     }
-
-    // 步骤 2: 复制文件
-    if (!CopyFilesToTarget(OutSession))
-    {
-        UE_LOG(LogNormalizedImport, Error, TEXT("文件复制失败"));
-        return false;
-    }
-
-    // 步骤 3: 设置 AssetRegistry 和 PackageNameResolver
-    if (!SetupAssetRegistryAndResolver(OutSession))
-    {
-        UE_LOG(LogNormalizedImport, Error, TEXT("AssetRegistry 设置失败"));
-        return false;
-    }
-
-    // 步骤 4: 加载包并修复引用
-    if (!LoadAndFixReferences(OutSession))
-    {
-        UE_LOG(LogNormalizedImport, Warning, TEXT("引用修复过程中有警告"));
-    }
-
-    // 步骤 5: 保存并清理
-    if (!SaveAndCleanup(OutSession))
-    {
-        UE_LOG(LogNormalizedImport, Error, TEXT("保存失败"));
-        return false;
-    }
-
-    UE_LOG(LogNormalizedImport, Log, TEXT("规范化导入完成: 成功 %d, 失败 %d"),
-        OutSession.SuccessCount, OutSession.FailedCount);
-
-    return OutSession.FailedCount == 0;
 }
 
 // ============================================================================
@@ -1,4 +1,5 @@
 #include "Utils/UAL_PBRMaterialHelper.h"
+#include "Utils/UAL_FuzzyMatch.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Materials/MaterialInstanceConstant.h"
 #include "Materials/Material.h"
@@ -7,26 +8,61 @@
 #include "UObject/SavePackage.h"
 #include "UObject/Package.h"
 #include "Misc/PackageName.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogPBRHelper, Log, All);
 
-// ==============================================================================
-// 辅助函数实现
-// ==============================================================================
-
-bool FUAL_PBRMaterialHelper::ContainsAnyKeyword(const FString& Text, const TArray<FString>& Keywords)
+namespace
 {
-	FString LowerText = Text.ToLower();
-	for (const FString& Keyword : Keywords)
+	// 少量纹理时并行调度的开销大于收益
+	constexpr int32 UALParallelAnalyzeThreshold = 256;
+
+	struct FUALKeywordRule
 	{
-		if (LowerText.Contains(Keyword.ToLower()))
-		{
-			return true;
-		}
+		EUAL_PBRTextureType Type;
+		TArray<const TCHAR*> Keywords;
+	};
+
+	/** 关键词表（全部小写，按识别优先级排列），首次使用时构建一次，线程安全 */
+	const TArray<FUALKeywordRule>& UALGetKeywordRules()
+	{
+		static const TArray<FUALKeywordRule> Rules = {
+			{ EUAL_PBRTextureType::Albedo, {
+				TEXT("albedo"), TEXT("basecolor"), TEXT("base_color"), TEXT("diffuse"),
+				TEXT("color"), TEXT("_d."), TEXT("_d_"), TEXT("_a."), TEXT("_a_"),
+				TEXT("_bc."), TEXT("_bc_"), TEXT("_diff.") } },
+			{ EUAL_PBRTextureType::Normal, {
+				TEXT("normal"), TEXT("nrm"), TEXT("nrml"), TEXT("_n."), TEXT("_n_"),
+				TEXT("norm"), TEXT("bump") } },
+			{ EUAL_PBRTextureType::Roughness, {
+				TEXT("rough"), TEXT("_r."), TEXT("_r_"), TEXT("rgh") } },
+			{ EUAL_PBRTextureType::Metallic, {
+				TEXT("metal"), TEXT("_m."), TEXT("_m_"), TEXT("mtl") } },
+			{ EUAL_PBRTextureType::AO, {
+				TEXT("_ao."), TEXT("_ao_"), TEXT("ambient"), TEXT("occlusion"),
+				TEXT("ambientocclusion") } },
+			{ EUAL_PBRTextureType::Height, {
+				TEXT("height"), TEXT("displace"), TEXT("disp"), TEXT("_h."), TEXT("_h_") } },
+			{ EUAL_PBRTextureType::Emissive, {
+				TEXT("emissive"), TEXT("emission"), TEXT("emit"), TEXT("glow") } },
+			{ EUAL_PBRTextureType::Opacity, {
+				TEXT("opacity"), TEXT("alpha"), TEXT("transparent"), TEXT("trans") } },
+			{ EUAL_PBRTextureType::Specular, {
+				TEXT("specular"), TEXT("spec"), TEXT("_s."), TEXT("_s_") } },
+			{ EUAL_PBRTextureType::Subsurface, {
+				TEXT("subsurface"), TEXT("sss"), TEXT("scattering") } },
+		};
+		return Rules;
 	}
-	return false;
 }
 
+// ==============================================================================
+// 辅助函数实现
+// ==============================================================================
+
 FString FUAL_PBRMaterialHelper::RemoveTypeSuffix(const FString& TextureName)
 {
 	// 待实现
@@ -35,8 +71,7 @@ FString FUAL_PBRMaterialHelper::RemoveTypeSuffix(const FString& TextureName)
 
 float FUAL_PBRMaterialHelper::CalculateNameSimilarity(const FString& Name1, const FString& Name2)
 {
-	// 待实现：使用简单的Levenshtein距离
-	return 0.0f;
+	return FUAL_FuzzyMatcher::NameSimilarity(Name1, Name2);
 }
 
 // ==============================================================================
@@ -45,122 +80,22 @@ float FUAL_PBRMaterialHelper::CalculateNameSimilarity(const FString& Name1, cons
 
 EUAL_PBRTextureType FUAL_PBRMaterialHelper::ClassifyTexture(const FString& TextureName)
 {
-	FString LowerName = TextureName.ToLower();
-	
-	// Albedo/BaseColor/Diffuse 检测
-	{
-		TArray<FString> AlbedoKeywords = {
-			TEXT("albedo"), TEXT("basecolor"), TEXT("base_color"), TEXT("diffuse"),
-			TEXT("color"), TEXT("_d."), TEXT("_d_"), TEXT("_a."), TEXT("_a_"),
-			TEXT("_bc."), TEXT("_bc_"), TEXT("_diff.")
-		};
-		if (ContainsAnyKeyword(LowerName, AlbedoKeywords))
-		{
-			return EUAL_PBRTextureType::Albedo;
-		}
-	}
-	
-	// Normal 检测
-	{
-		TArray<FString> NormalKeywords = {
-			TEXT("normal"), TEXT("nrm"), TEXT("nrml"), TEXT("_n."), TEXT("_n_"),
-			TEXT("norm"), TEXT("bump")
-		};
-		if (ContainsAnyKeyword(LowerName, NormalKeywords))
-		{
-			return EUAL_PBRTextureType::Normal;
-		}
-	}
-	
-	// Roughness 检测
-	{
-		TArray<FString> RoughnessKeywords = {
-			TEXT("rough"), TEXT("_r."), TEXT("_r_"), TEXT("rgh")
-		};
-		if (ContainsAnyKeyword(LowerName, RoughnessKeywords))
-		{
-			return EUAL_PBRTextureType::Roughness;
-		}
-	}
-	
-	// Metallic/Metalness 检测
-	{
-		TArray<FString> MetallicKeywords = {
-			TEXT("metal"), TEXT("_m."), TEXT("_m_"), TEXT("mtl")
-		};
-		if (ContainsAnyKeyword(LowerName, MetallicKeywords))
-		{
-			return EUAL_PBRTextureType::Metallic;
-		}
-	}
-	
-	// AO (Ambient Occlusion) 检测
-	{
-		TArray<FString> AOKeywords = {
-			TEXT("_ao."), TEXT("_ao_"), TEXT("ambient"), TEXT("occlusion"),
-			TEXT("ambientocclusion")
-		};
-		if (ContainsAnyKeyword(LowerName, AOKeywords))
-		{
-			return EUAL_PBRTextureType::AO;
-		}
-	}
-	
-	// Height/Displacement 检测
-	{
-		TArray<FString> HeightKeywords = {
-			TEXT("height"), TEXT("displace"), TEXT("disp"), TEXT("_h."), TEXT("_h_")
-		};
-		if (ContainsAnyKeyword(LowerName, HeightKeywords))
-		{
-			return EUAL_PBRTextureType::Height;
-		}
-	}
-	
-	// Emissive 检测
-	{
-		TArray<FString> EmissiveKeywords = {
-			TEXT("emissive"), TEXT("emission"), TEXT("emit"), TEXT("glow")
-		};
-		if (ContainsAnyKeyword(LowerName, EmissiveKeywords))
-		{
-			return EUAL_PBRTextureType::Emissive;
-		}
-	}
-	
-	// Opacity/Alpha 检测
-	{
-		TArray<FString> OpacityKeywords = {
-			TEXT("opacity"), TEXT("alpha"), TEXT("transparent"), TEXT("trans")
-		};
-		if (ContainsAnyKeyword(LowerName, OpacityKeywords))
-		{
-			return EUAL_PBRTextureType::Opacity;
-		}
-	}
-	
-	// Specular 检测
-	{
-		TArray<FString> SpecularKeywords = {
-			TEXT("specular"), TEXT("spec"), TEXT("_s."), TEXT("_s_")
-		};
-		if (ContainsAnyKeyword(LowerName, SpecularKeywords))
-		{
-			return EUAL_PBRTextureType::Specular;
-		}
-	}
-	
-	// Subsurface 检测
+	return ClassifyLowerName(TextureName.ToLower());
+}
+
+EUAL_PBRTextureType FUAL_PBRMaterialHelper::ClassifyLowerName(const FString& LowerName)
+{
+	// 按优先级逐类匹配，首个命中的类型生效
+	for (const FUALKeywordRule& Rule : UALGetKeywordRules())
 	{
-		TArray<FString> SubsurfaceKeywords = {
-			TEXT("subsurface"), TEXT("sss"), TEXT("scattering")
-		};
-		if (ContainsAnyKeyword(LowerName, SubsurfaceKeywords))
+		for (const TCHAR* Keyword : Rule.Keywords)
 		{
-			return EUAL_PBRTextureType::Subsurface;
+			if (LowerName.Contains(Keyword, ESearchCase::CaseSensitive))
+			{
+				return Rule.Type;
+			}
 		}
 	}
-	
 	return EUAL_PBRTextureType::Unknown;
 }
 
@@ -168,8 +103,8 @@ FString FUAL_PBRMaterialHelper::ExtractBaseName(const FString& TextureName)
 {
 	FString BaseName = TextureName;
 	
-	// 移除常见的纹理类型后缀
-	TArray<FString> Suffixes = {
+	// 移除常见的纹理类型后缀（静态表，只构建一次，可并行调用）
+	static const TArray<FString> Suffixes = {
 		TEXT("_Albedo"), TEXT("_BaseColor"), TEXT("_Diffuse"), TEXT("_Color"),
 		TEXT("_Normal"), TEXT("_NRM"), TEXT("_N"),
 		TEXT("_Roughness"), TEXT("_Rough"), TEXT("_R"),
@@ -207,64 +142,139 @@ FString FUAL_PBRMaterialHelper::ExtractBaseName(const FString& TextureName)
 	return BaseName.TrimStartAndEnd();
 }
 
-TArray<FUAL_TextureGroup> FUAL_PBRMaterialHelper::GroupTexturesByAsset(const TArray<UTexture2D*>& Textures)
+FUAL_TextureNameInfo FUAL_PBRMaterialHelper::AnalyzeTextureName(const FString& TextureName)
 {
-	TMap<FString, FUAL_TextureGroup> GroupMap;
-	
-	for (UTexture2D* Texture : Textures)
+	FUAL_TextureNameInfo Info;
+	Info.Name = TextureName;
+	Info.Type = ClassifyLowerName(TextureName.ToLower());
+	Info.BaseName = ExtractBaseName(TextureName);
+
+	// 分桶键：小写并去掉分隔符，"Rock_01" 与 "Rock01" 落在同一个桶
+	Info.BucketKey.Reserve(Info.BaseName.Len());
+	for (const TCHAR C : Info.BaseName)
 	{
-		if (!Texture) continue;
-		
-		FString TextureName = Texture->GetName();
-		EUAL_PBRTextureType Type = ClassifyTexture(TextureName);
-		
-		// 只处理识别的纹理类型
-		if (Type == EUAL_PBRTextureType::Unknown)
+		if (C != TEXT('_') && C != TEXT('-') && C != TEXT(' ') && C != TEXT('.'))
+		{
+			Info.BucketKey.AppendChar(FChar::ToLower(C));
+		}
+	}
+	return Info;
+}
+
+TArray<FUAL_TextureNameInfo> FUAL_PBRMaterialHelper::AnalyzeTextureNames(const TArray<FString>& TextureNames)
+{
+	TArray<FUAL_TextureNameInfo> Infos;
+	Infos.SetNum(TextureNames.Num());
+
+	ParallelFor(TextureNames.Num(), [&TextureNames, &Infos](int32 Index)
+	{
+		Infos[Index] = AnalyzeTextureName(TextureNames[Index]);
+	}, TextureNames.Num() < UALParallelAnalyzeThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	return Infos;
+}
+
+TArray<TArray<int32>> FUAL_PBRMaterialHelper::BucketTextureNames(const TArray<FUAL_TextureNameInfo>& Infos)
+{
+	TArray<TArray<int32>> Groups;
+	TMap<FString, int32> BucketToGroup;
+	BucketToGroup.Reserve(Infos.Num());
+
+	for (int32 Index = 0; Index < Infos.Num(); ++Index)
+	{
+		const FUAL_TextureNameInfo& Info = Infos[Index];
+		if (Info.Type == EUAL_PBRTextureType::Unknown)
 		{
-			UE_LOG(LogPBRHelper, Warning, TEXT("Unknown texture type: %s"), *TextureName);
 			continue;
 		}
-		
-		// 提取基础名称
-		FString BaseName = ExtractBaseName(TextureName);
-		
-		// 如果该基础名称的组不存在，创建新组
-		if (!GroupMap.Contains(BaseName))
+
+		int32* GroupIndex = BucketToGroup.Find(Info.BucketKey);
+		if (!GroupIndex)
 		{
-			FUAL_TextureGroup NewGroup;
-			NewGroup.BaseName = BaseName;
-			GroupMap.Add(BaseName, NewGroup);
+			GroupIndex = &BucketToGroup.Add(Info.BucketKey, Groups.Num());
+			Groups.AddDefaulted();
 		}
-		
-		// 添加到对应组
-		FUAL_TextureGroup& Group = GroupMap[BaseName];
-		
-		// 检查是否已有相同类型的纹理
-		if (Group.Textures.Contains(Type))
+		TArray<int32>& Members = Groups[*GroupIndex];
+
+		const int32 Existing = Members.IndexOfByPredicate([&Infos, &Info](int32 Member)
+		{
+			return Infos[Member].Type == Info.Type;
+		});
+		if (Existing == INDEX_NONE)
 		{
-			UE_LOG(LogPBRHelper, Warning, 
-				TEXT("Duplicate texture type %d for asset '%s', keeping first one"),
-				(int32)Type, *BaseName);
+			Members.Add(Index);
+			continue;
 		}
-		else
+
+		// 同桶同类型重复：只在桶内比较，保留与组内首张纹理命名最接近的一张（相同时保留先出现的）
+		const FString& Reference = Infos[Members[0]].Name;
+		const int32 Current = Members[Existing];
+		if (Current != Members[0]
+			&& CalculateNameSimilarity(Info.Name, Reference) > CalculateNameSimilarity(Infos[Current].Name, Reference))
 		{
-			Group.Textures.Add(Type, Texture);
-			UE_LOG(LogPBRHelper, Log, 
-				TEXT("Grouped texture: %s -> %s (Type: %d)"),
-				*TextureName, *BaseName, (int32)Type);
+			Members[Existing] = Index;
 		}
+		UE_LOG(LogPBRHelper, Verbose, TEXT("Duplicate texture type %d for asset '%s', keeping %s"),
+			(int32)Info.Type, *Infos[Members[0]].BaseName, *Infos[Members[Existing]].Name);
 	}
-	
-	// 转换Map为Array
+
+	return Groups;
+}
+
+TArray<FUAL_TextureGroup> FUAL_PBRMaterialHelper::GroupTexturesByAsset(const TArray<UTexture2D*>& Textures)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// 1. GameThread 上只收集名称，分类在工作线程并行完成
+	TArray<UTexture2D*> ValidTextures;
+	TArray<FString> TextureNames;
+	ValidTextures.Reserve(Textures.Num());
+	TextureNames.Reserve(Textures.Num());
+	for (UTexture2D* Texture : Textures)
+	{
+		if (Texture)
+		{
+			ValidTextures.Add(Texture);
+			TextureNames.Add(Texture->GetName());
+		}
+	}
+
+	const TArray<FUAL_TextureNameInfo> Infos = AnalyzeTextureNames(TextureNames);
+
+	int32 UnknownCount = 0;
+	for (const FUAL_TextureNameInfo& Info : Infos)
+	{
+		if (Info.Type == EUAL_PBRTextureType::Unknown)
+		{
+			++UnknownCount;
+			UE_LOG(LogPBRHelper, Verbose, TEXT("Unknown texture type: %s"), *Info.Name);
+		}
+	}
+	if (UnknownCount > 0)
+	{
+		UE_LOG(LogPBRHelper, Warning, TEXT("%d textures have unknown type and were skipped"), UnknownCount);
+	}
+
+	// 2. 哈希分桶（相似度只在桶内计算）
+	const TArray<TArray<int32>> Buckets = BucketTextureNames(Infos);
+
 	TArray<FUAL_TextureGroup> Result;
-	for (auto& Pair : GroupMap)
+	Result.Reserve(Buckets.Num());
+	for (const TArray<int32>& Members : Buckets)
 	{
-		Result.Add(Pair.Value);
+		FUAL_TextureGroup& Group = Result.AddDefaulted_GetRef();
+		Group.BaseName = Infos[Members[0]].BaseName;
+		for (const int32 Member : Members)
+		{
+			Group.Textures.Add(Infos[Member].Type, ValidTextures[Member]);
+			UE_LOG(LogPBRHelper, Verbose, TEXT("Grouped texture: %s -> %s (Type: %d)"),
+				*Infos[Member].Name, *Group.BaseName, (int32)Infos[Member].Type);
+		}
 	}
-	
-	UE_LOG(LogPBRHelper, Log, TEXT("Grouped %d textures into %d assets"), 
-		Textures.Num(), Result.Num());
-	
+
+	UE_LOG(LogPBRHelper, Log, TEXT("Grouped %d textures into %d assets (%.1f ms)"),
+		Textures.Num(), Result.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
 	return Result;
 }
 
@@ -322,10 +332,12 @@ UMaterialInstanceConstant* FUAL_PBRMaterialHelper::CreatePBRMaterialInstance(
 	// 6. 配置纹理并设置参数
 	if (Options.bAutoConfigureTextures)
 	{
+		TArray<TPair<UTexture2D*, EUAL_PBRTextureType>> TexturesToConfigure;
 		for (const auto& Pair : TextureGroup.Textures)
 		{
-			ConfigureTextureSettings(Pair.Value, Pair.Key);
+			TexturesToConfigure.Emplace(Pair.Value, Pair.Key);
 		}
+		ConfigureTextureSettingsBatch(TexturesToConfigure);
 	}
 	
 	// 7. 设置纹理参数到材质实例
@@ -461,31 +473,25 @@ FString FUAL_PBRMaterialHelper::StandardizeAssetName(const FString& BaseName, co
 	return Prefix + BaseName;
 }
 
-void FUAL_PBRMaterialHelper::ConfigureTextureSettings(UTexture2D* Texture, EUAL_PBRTextureType Type)
+FUAL_TextureSettingsRequest FUAL_PBRMaterialHelper::MakeTextureSettingsRequest(UTexture2D* Texture, EUAL_PBRTextureType Type)
 {
-	if (!Texture) return;
-	
-	bool bModified = false;
+	FUAL_TextureSettingsRequest Request;
+	Request.Texture = Texture;
 	
 	switch (Type)
 	{
 		case EUAL_PBRTextureType::Albedo:
 		case EUAL_PBRTextureType::Emissive:
 			// Albedo和Emissive使用sRGB
-			if (!Texture->SRGB)
-			{
-				Texture->SRGB = true;
-				bModified = true;
-			}
-			Texture->CompressionSettings = TC_Default;
+			Request.bSRGB = true;
+			Request.Compression = TC_Default;
 			break;
 			
 		case EUAL_PBRTextureType::Normal:
 			// 法线贴图特殊设置
-			Texture->SRGB = false;
-			Texture->CompressionSettings = TC_Normalmap;
-			bModified = true;
-			UE_LOG(LogPBRHelper, Log, TEXT("Configured Normal map: %s"), *Texture->GetName());
+			Request.bSRGB = false;
+			Request.Compression = TC_Normalmap;
+			Request.LODGroup = TEXTUREGROUP_WorldNormalMap;
 			break;
 			
 		case EUAL_PBRTextureType::Roughness:
@@ -495,23 +501,41 @@ void FUAL_PBRMaterialHelper::ConfigureTextureSettings(UTexture2D* Texture, EUAL_
 		case EUAL_PBRTextureType::Opacity:
 		case EUAL_PBRTextureType::Specular:
 			// 数据贴图不使用sRGB
-			if (Texture->SRGB)
-			{
-				Texture->SRGB = false;
-				bModified = true;
-			}
-			Texture->CompressionSettings = TC_Default;
+			Request.bSRGB = false;
+			Request.Compression = TC_Default;
 			break;
 			
 		default:
 			break;
 	}
 	
-	if (bModified)
+	return Request;
+}
+
+void FUAL_PBRMaterialHelper::ConfigureTextureSettings(UTexture2D* Texture, EUAL_PBRTextureType Type)
+{
+	if (!Texture) return;
+	
+	ConfigureTextureSettingsBatch({ TPair<UTexture2D*, EUAL_PBRTextureType>(Texture, Type) });
+}
+
+FString FUAL_PBRMaterialHelper::ConfigureTextureSettingsBatch(const TArray<TPair<UTexture2D*, EUAL_PBRTextureType>>& Textures)
+{
+	TArray<FUAL_TextureSettingsRequest> Requests;
+	Requests.Reserve(Textures.Num());
+	for (const TPair<UTexture2D*, EUAL_PBRTextureType>& Pair : Textures)
 	{
-		Texture->UpdateResource();
-		Texture->MarkPackageDirty();
+		if (Pair.Key)
+		{
+			Requests.Add(MakeTextureSettingsRequest(Pair.Key, Pair.Value));
+		}
 	}
+	
+	// 设置未变化的纹理不会重建
+	const FUAL_TextureSettingsBatch::FSubmitResult Result = FUAL_TextureSettingsBatch::Get().Submit(Requests);
+	UE_LOG(LogPBRHelper, Log, TEXT("Configured %d textures: %d changed, %d unchanged"),
+		Requests.Num(), Result.Changed, Result.Unchanged);
+	return Result.JobId;
 }
 
 int32 FUAL_PBRMaterialHelper::BatchProcessPBRAssets(
@@ -544,6 +568,30 @@ int32 FUAL_PBRMaterialHelper::BatchProcessPBRAssets(
 	
 	int32 SuccessCount = 0;
 	
+	// 纹理设置对全部组一次性批量提交，不在逐个创建材质实例时逐张重建
+	FUAL_PBRMaterialOptions InstanceOptions = Options;
+	if (Options.bAutoConfigureTextures)
+	{
+		TArray<TPair<UTexture2D*, EUAL_PBRTextureType>> TexturesToConfigure;
+		for (const FUAL_TextureGroup& Group : TextureGroups)
+		{
+			for (const auto& Pair : Group.Textures)
+			{
+				TexturesToConfigure.Emplace(Pair.Value, Pair.Key);
+			}
+		}
+		ConfigureTextureSettingsBatch(TexturesToConfigure);
+		InstanceOptions.bAutoConfigureTextures = false;
+	}
+	
+	// 网格体名称只取一次，避免每个组重复 GetName
+	TArray<FString> MeshNames;
+	MeshNames.Reserve(ImportedMeshes.Num());
+	for (UStaticMesh* Mesh : ImportedMeshes)
+	{
+		MeshNames.Add(Mesh ? Mesh->GetName() : FString());
+	}
+	
 	// 2. 为每个纹理组创建PBR材质
 	for (const FUAL_TextureGroup& Group : TextureGroups)
 	{
@@ -554,7 +602,7 @@ int32 FUAL_PBRMaterialHelper::BatchProcessPBRAssets(
 			MaterialName,
 			DestinationPath,
 			Group,
-			Options);
+			InstanceOptions);
 		
 		if (Material)
 		{
@@ -569,11 +617,11 @@ int32 FUAL_PBRMaterialHelper::BatchProcessPBRAssets(
 				// 尝试找到名称匹配的网格体
 				UStaticMesh* MatchedMesh = nullptr;
 				
-				for (UStaticMesh* Mesh : ImportedMeshes)
+				for (int32 MeshIndex = 0; MeshIndex < ImportedMeshes.Num(); ++MeshIndex)
 				{
-					if (Mesh && Mesh->GetName().Contains(Group.BaseName))
+					if (ImportedMeshes[MeshIndex] && MeshNames[MeshIndex].Contains(Group.BaseName))
 					{
-						MatchedMesh = Mesh;
+						MatchedMesh = ImportedMeshes[MeshIndex];
 						break;
 					}
 				}
@@ -611,3 +659,107 @@ int32 FUAL_PBRMaterialHelper::BatchProcessPBRAssets(
 	
 	return SuccessCount;
 }
+
+// ==============================================================================
+// 基准测试
+// ==============================================================================
+
+namespace
+{
+	void UALRunPBRGroupingBenchmark(const TArray<FString>& Args)
+	{
+		const int32 Count = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 5000;
+
+		// 模拟一次性导入的贴图包：多种命名约定混合，每个资产 3~6 张贴图，少量无法识别的贴图
+		static const TCHAR* Prefixes[] = { TEXT("T_"), TEXT("TX_"), TEXT("") };
+		static const TCHAR* Words[] = {
+			TEXT("Rock"), TEXT("Wall"), TEXT("Brick"), TEXT("Hero"), TEXT("Door"), TEXT("Crate"),
+			TEXT("Ground"), TEXT("Moss"), TEXT("Bark"), TEXT("Metal"), TEXT("Fabric"), TEXT("Tile")
+		};
+		static const TCHAR* Suffixes[] = {
+			TEXT("_Albedo"), TEXT("_BaseColor"), TEXT("_Normal"), TEXT("_NRM"), TEXT("_Roughness"),
+			TEXT("_Metallic"), TEXT("_AO"), TEXT("_Height"), TEXT("_Emissive"), TEXT("_Opacity"), TEXT("_Mask")
+		};
+
+		FRandomStream Random(1337);
+		TArray<FString> Names;
+		Names.Reserve(Count);
+		while (Names.Num() < Count)
+		{
+			const FString Base = FString::Printf(TEXT("%s%s%s_%02d"),
+				Prefixes[Random.RandRange(0, UE_ARRAY_COUNT(Prefixes) - 1)],
+				Words[Random.RandRange(0, UE_ARRAY_COUNT(Words) - 1)],
+				Words[Random.RandRange(0, UE_ARRAY_COUNT(Words) - 1)],
+				Random.RandRange(0, 99));
+			const int32 MapCount = Random.RandRange(3, 6);
+			for (int32 Map = 0; Map < MapCount && Names.Num() < Count; ++Map)
+			{
+				Names.Add(Base + Suffixes[Random.RandRange(0, UE_ARRAY_COUNT(Suffixes) - 1)]);
+			}
+		}
+
+		// 串行分析（旧流程：逐个分类）
+		const double SerialStart = FPlatformTime::Seconds();
+		TArray<FUAL_TextureNameInfo> SerialInfos;
+		SerialInfos.Reserve(Names.Num());
+		for (const FString& Name : Names)
+		{
+			SerialInfos.Add(FUAL_PBRMaterialHelper::AnalyzeTextureName(Name));
+		}
+		const double SerialSeconds = FPlatformTime::Seconds() - SerialStart;
+
+		// 并行分析
+		const double ParallelStart = FPlatformTime::Seconds();
+		const TArray<FUAL_TextureNameInfo> Infos = FUAL_PBRMaterialHelper::AnalyzeTextureNames(Names);
+		const double ParallelSeconds = FPlatformTime::Seconds() - ParallelStart;
+
+		int32 Mismatches = 0;
+		for (int32 Index = 0; Index < Infos.Num(); ++Index)
+		{
+			Mismatches += (Infos[Index].Type != SerialInfos[Index].Type || Infos[Index].BucketKey != SerialInfos[Index].BucketKey) ? 1 : 0;
+		}
+
+		// 哈希分桶
+		const double BucketStart = FPlatformTime::Seconds();
+		const TArray<TArray<int32>> Buckets = FUAL_PBRMaterialHelper::BucketTextureNames(Infos);
+		const double BucketSeconds = FPlatformTime::Seconds() - BucketStart;
+
+		// 对照：逐个与已有组两两比较名称相似度（组数增长时接近平方复杂度）
+		const double PairwiseStart = FPlatformTime::Seconds();
+		TArray<FString> PairwiseGroups;
+		int64 Comparisons = 0;
+		for (const FUAL_TextureNameInfo& Info : Infos)
+		{
+			if (Info.Type == EUAL_PBRTextureType::Unknown)
+			{
+				continue;
+			}
+			bool bMatched = false;
+			for (const FString& GroupName : PairwiseGroups)
+			{
+				++Comparisons;
+				if (FUAL_FuzzyMatcher::NameSimilarity(Info.BaseName, GroupName) >= 0.95f)
+				{
+					bMatched = true;
+					break;
+				}
+			}
+			if (!bMatched)
+			{
+				PairwiseGroups.Add(Info.BaseName);
+			}
+		}
+		const double PairwiseSeconds = FPlatformTime::Seconds() - PairwiseStart;
+
+		UE_LOG(LogPBRHelper, Display, TEXT("PBR grouping benchmark: %d textures | analyze serial %.2f ms / parallel %.2f ms (mismatches %d) | bucket %.2f ms -> %d groups | pairwise %.2f ms, %lld comparisons -> %d groups | speedup %.1fx"),
+			Names.Num(), SerialSeconds * 1000.0, ParallelSeconds * 1000.0, Mismatches,
+			BucketSeconds * 1000.0, Buckets.Num(),
+			PairwiseSeconds * 1000.0, Comparisons, PairwiseGroups.Num(),
+			(ParallelSeconds + BucketSeconds) > 0.0 ? (SerialSeconds + PairwiseSeconds) / (ParallelSeconds + BucketSeconds) : 0.0);
+	}
+
+	FAutoConsoleCommand GUALPBRGroupingBenchmarkCommand(
+		TEXT("ual.BenchmarkPBRGrouping"),
+		TEXT("Benchmark parallel texture classification and bucketed grouping against serial pairwise grouping. Usage: ual.BenchmarkPBRGrouping [TextureCount=5000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&UALRunPBRGroupingBenchmark));
+}
@@ -67,6 +67,11 @@ bool FUALPackageReader::OpenPackageFile(const FString& InFilePath)
 
 bool FUALPackageReader::SerializeNameMap()
 {
+    if (NameMap.Num() > 0)
+    {
+        return true;
+    }
+
     if (PackageFileSummary.NameCount <= 0)
     {
         return true;
@@ -249,7 +254,41 @@ bool FUALPackageReader::GetAssetClass(FString& OutClassName)
     return false;
 }
 
+bool FUALPackageReader::ReadExports(TArray<FExportInfo>& OutExports)
+{
+    if (!SerializeNameMap() || !SerializeImportMap() || !SerializeExportMap())
+    {
+        return false;
+    }
+
+    OutExports.Reset(ExportMap.Num());
+    for (const FObjectExport& Export : ExportMap)
+    {
+        FExportInfo& Info = OutExports.AddDefaulted_GetRef();
+        Info.ObjectName = Export.ObjectName;
+
+        // 类可能来自导入（引擎 / 其他包中的类），也可能定义在本包内（蓝图生成类的实例）
+        if (Export.ClassIndex.IsImport() && ImportMap.IsValidIndex(Export.ClassIndex.ToImport()))
+        {
+            Info.ClassName = ImportMap[Export.ClassIndex.ToImport()].ObjectName;
+        }
+        else if (Export.ClassIndex.IsExport() && ExportMap.IsValidIndex(Export.ClassIndex.ToExport()))
+        {
+            Info.ClassName = ExportMap[Export.ClassIndex.ToExport()].ObjectName;
+        }
+        else
+        {
+            Info.ClassName = NAME_Class;
+        }
 
+        if (Export.OuterIndex.IsExport())
+        {
+            Info.OuterExport = Export.OuterIndex.ToExport();
+        }
+    }
+
+    return true;
+}
 
 bool FUALPackageReader::ReadDependencies(TArray<FName>& OutDependencies)
 {
@@ -0,0 +1,1007 @@
+#include "UAL_ProjectSnapshot.h"
+#include "UAL_PackageReader.h"
+#include "UAL_MaterialCatalog.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALSnapshot, Log, All);
+
+namespace
+{
+	// 每步在 GameThread 从注册表收集的包数量
+	constexpr int32 UALSnapshotCollectBatch = 256;
+	// 每步并行扫描的包数量（包头读取为主要开销）
+	constexpr int32 UALSnapshotScanBatch = 64;
+
+	constexpr uint32 UALSnapshotMagic = 'U' | ('A' << 8) | ('L' << 16) | ('S' << 24);
+
+	constexpr uint8 UALColumnString = 'S';
+	constexpr uint8 UALColumnU32 = 'U';
+	constexpr uint8 UALColumnU64 = 'Q';
+
+	enum EUALSnapshotPackageFlags : uint32
+	{
+		PackageFlag_HeaderRead   = 1 << 0,
+		PackageFlag_Reused       = 1 << 1,
+		PackageFlag_FileMissing  = 1 << 2,
+		PackageFlag_HeaderFailed = 1 << 3,
+		PackageFlag_HeaderDeps   = 1 << 4,
+	};
+
+	enum EUALSnapshotDependencyKind : uint32
+	{
+		Dependency_Hard   = 0,
+		Dependency_Soft   = 1,
+		Dependency_Header = 2,
+	};
+
+	enum EUALSnapshotMemberKind : uint32
+	{
+		Member_Graph    = 0,
+		Member_Function = 1,
+	};
+
+	const FName UALParentClassTag(TEXT("ParentClass"));
+	const FName UALNativeParentClassTag(TEXT("NativeParentClass"));
+	const FName UALBlueprintTypeTag(TEXT("BlueprintType"));
+	const FName UALGeneratedClassTag(TEXT("GeneratedClass"));
+	const FName UALImplementedInterfacesTag(TEXT("ImplementedInterfaces"));
+
+	const FName UALEdGraphClass(TEXT("EdGraph"));
+	const FName UALFunctionClass(TEXT("Function"));
+	const FName UALSCSNodeClass(TEXT("SCS_Node"));
+	const FName UALCommentNodeClass(TEXT("EdGraphNode_Comment"));
+	const FName UALWorldClass(TEXT("World"));
+
+	FString GetObjectPathString(const FAssetData& AssetData)
+	{
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+		return AssetData.GetSoftObjectPath().ToString();
+#else
+		return AssetData.ObjectPath.ToString();
+#endif
+	}
+
+	FName GetAssetClassName(const FAssetData& AssetData)
+	{
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+		return AssetData.AssetClassPath.GetAssetName();
+#else
+		return AssetData.AssetClass;
+#endif
+	}
+
+	FString GetTagString(const FAssetData& AssetData, FName Tag)
+	{
+		FString Value;
+		AssetData.GetTagValue(Tag, Value);
+		return Value;
+	}
+
+	struct FSnapshotMember
+	{
+		uint32 Kind = Member_Graph;
+		FString Name;
+	};
+
+	/** 从包头得到的数据：只随包文件变化，可从上次快照复用 */
+	struct FHeaderSummary
+	{
+		// PackageFlag_HeaderRead / PackageFlag_HeaderDeps
+		uint32 Flags = 0;
+		FString HeaderClass;
+		TArray<FString> HeaderDeps;
+		uint32 Graphs = 0;
+		uint32 Functions = 0;
+		uint32 Nodes = 0;
+		uint32 Components = 0;
+		TArray<FSnapshotMember> Members;
+	};
+
+	struct FSnapshotPackage
+	{
+		FName Name;
+		FString Filename;
+		// AssetDatas 中的下标
+		TArray<int32> Assets;
+		TArray<FName> HardDeps;
+		TArray<FName> SoftDeps;
+		bool bBlueprint = false;
+
+		// 以下由扫描阶段写入（并行时每个线程只写自己的条目）
+		uint64 Stamp = 0;
+		int64 FileSize = 0;
+		uint32 Flags = 0;
+		FHeaderSummary Header;
+	};
+
+	struct FPreviousPackage
+	{
+		uint64 Stamp = 0;
+		FHeaderSummary Header;
+	};
+
+	struct FSnapshotMaterial
+	{
+		int32 Asset = INDEX_NONE;
+		FString Parent;
+		FString BlendMode;
+		bool bInstance = false;
+		bool bParamsIndexed = false;
+		TArray<TPair<FString, FString>> Params;
+	};
+
+	/** 字符串表键比较区分大小写（FString 默认比较不区分） */
+	struct FCaseSensitiveStringKeyFuncs : TDefaultMapKeyFuncs<FString, uint32, false>
+	{
+		static FORCEINLINE bool Matches(const FString& A, const FString& B)
+		{
+			return A.Equals(B, ESearchCase::CaseSensitive);
+		}
+		static FORCEINLINE uint32 GetKeyHash(const FString& Key)
+		{
+			return FCrc::StrCrc32(*Key);
+		}
+	};
+
+	/**
+	 * 列式文件写入：先按表追加列，最后统一写出字符串表与各表
+	 */
+	class FSnapshotWriter
+	{
+	public:
+		FSnapshotWriter()
+		{
+			Intern(FString());
+		}
+
+		uint32 Intern(const FString& Text)
+		{
+			if (const uint32* Found = StringIndex.Find(Text))
+			{
+				return *Found;
+			}
+			const uint32 Index = Strings.Add(Text);
+			StringIndex.Add(Text, Index);
+			return Index;
+		}
+
+		uint32 Intern(FName Name)
+		{
+			return Name.IsNone() ? 0 : Intern(Name.ToString());
+		}
+
+		void BeginTable(const TCHAR* Name, int32 Rows)
+		{
+			FTable& Table = Tables.AddDefaulted_GetRef();
+			Table.Name = Intern(FString(Name));
+			Table.Rows = (uint32)Rows;
+		}
+
+		template <typename T>
+		void AddColumn(const TCHAR* Name, uint8 Type, const TArray<T>& Values)
+		{
+			static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Snapshot columns are 32 or 64 bit");
+			FTable& Table = Tables.Last();
+			check((uint32)Values.Num() == Table.Rows);
+
+			FColumn& Column = Table.Columns.AddDefaulted_GetRef();
+			Column.Name = Intern(FString(Name));
+			Column.Type = Type;
+			Column.Data.Append(reinterpret_cast<const uint8*>(Values.GetData()), Values.Num() * sizeof(T));
+		}
+
+		int32 NumStrings() const { return Strings.Num(); }
+
+		TArray<uint8> Finish()
+		{
+			TArray<uint8> Out;
+			FMemoryWriter Ar(Out);
+
+			uint32 Magic = UALSnapshotMagic;
+			uint32 Version = FUAL_ProjectSnapshot::FormatVersion;
+			const FDateTime Now = FDateTime::UtcNow();
+			int64 CreatedMs = Now.ToUnixTimestamp() * 1000 + Now.GetMillisecond();
+			uint32 TableCount = Tables.Num();
+			uint32 Reserved = 0;
+			Ar << Magic << Version << CreatedMs << TableCount << Reserved;
+
+			// 字符串表：偏移数组 + 连续的 UTF-8 数据
+			TArray<uint8> Blob;
+			TArray<uint32> Offsets;
+			Offsets.Reserve(Strings.Num() + 1);
+			for (const FString& Text : Strings)
+			{
+				Offsets.Add(Blob.Num());
+				const FTCHARToUTF8 Utf8(*Text, Text.Len());
+				Blob.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+			}
+			Offsets.Add(Blob.Num());
+
+			uint32 StringCount = Strings.Num();
+			Ar << StringCount;
+			Ar.Serialize(Offsets.GetData(), Offsets.Num() * sizeof(uint32));
+			Ar.Serialize(Blob.GetData(), Blob.Num());
+
+			for (FTable& Table : Tables)
+			{
+				uint32 ColumnCount = Table.Columns.Num();
+				Ar << Table.Name << Table.Rows << ColumnCount;
+				for (FColumn& Column : Table.Columns)
+				{
+					uint8 Padding[3] = {};
+					Ar << Column.Name << Column.Type;
+					Ar.Serialize(Padding, sizeof(Padding));
+					Ar.Serialize(Column.Data.GetData(), Column.Data.Num());
+				}
+			}
+			return Out;
+		}
+
+	private:
+		struct FColumn
+		{
+			uint32 Name = 0;
+			uint8 Type = 0;
+			TArray<uint8> Data;
+		};
+
+		struct FTable
+		{
+			uint32 Name = 0;
+			uint32 Rows = 0;
+			TArray<FColumn> Columns;
+		};
+
+		TArray<FString> Strings;
+		TMap<FString, uint32, FDefaultSetAllocator, FCaseSensitiveStringKeyFuncs> StringIndex;
+		TArray<FTable> Tables;
+	};
+
+	/**
+	 * 读取上次的快照（只用于增量复用，格式或版本不符时整体放弃）
+	 */
+	class FSnapshotReader
+	{
+	public:
+		struct FColumnView
+		{
+			uint8 Type = 0;
+			const uint8* Data = nullptr;
+		};
+
+		struct FTableView
+		{
+			uint32 Rows = 0;
+			TMap<FString, FColumnView> Columns;
+
+			const FColumnView* Find(const TCHAR* Name, uint8 Type) const
+			{
+				const FColumnView* Column = Columns.Find(Name);
+				return Column && Column->Type == Type ? Column : nullptr;
+			}
+		};
+
+		bool Load(const FString& Path)
+		{
+			if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+			{
+				return false;
+			}
+
+			int64 Pos = 0;
+			uint32 Magic = 0, Version = 0, TableCount = 0, Reserved = 0;
+			uint64 CreatedMs = 0;
+			if (!Read(Pos, Magic) || !Read(Pos, Version) || !Read(Pos, CreatedMs) || !Read(Pos, TableCount) || !Read(Pos, Reserved)
+				|| Magic != UALSnapshotMagic || Version != FUAL_ProjectSnapshot::FormatVersion)
+			{
+				return false;
+			}
+
+			uint32 StringCount = 0;
+			if (!Read(Pos, StringCount) || StringCount == 0 || Pos + ((int64)StringCount + 1) * sizeof(uint32) > Bytes.Num())
+			{
+				return false;
+			}
+			const int64 OffsetsPos = Pos;
+			const int64 BlobPos = OffsetsPos + ((int64)StringCount + 1) * sizeof(uint32);
+			Strings.Reserve(StringCount);
+			uint32 Begin = 0;
+			Read(Pos, Begin);
+			for (uint32 Index = 0; Index < StringCount; ++Index)
+			{
+				uint32 End = 0;
+				Read(Pos, End);
+				if (End < Begin || BlobPos + End > Bytes.Num())
+				{
+					return false;
+				}
+				const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData() + BlobPos + Begin), End - Begin);
+				Strings.Emplace(Converted.Length(), Converted.Get());
+				Begin = End;
+			}
+			Pos = BlobPos + Begin;
+
+			for (uint32 TableIndex = 0; TableIndex < TableCount; ++TableIndex)
+			{
+				uint32 Name = 0, Rows = 0, ColumnCount = 0;
+				if (!Read(Pos, Name) || !Read(Pos, Rows) || !Read(Pos, ColumnCount) || !Strings.IsValidIndex(Name))
+				{
+					return false;
+				}
+
+				FTableView& Table = Tables.Add(Strings[Name]);
+				Table.Rows = Rows;
+				for (uint32 ColumnIndex = 0; ColumnIndex < ColumnCount; ++ColumnIndex)
+				{
+					uint32 ColumnName = 0;
+					uint8 Type = 0;
+					uint8 Padding[3];
+					if (!Read(Pos, ColumnName) || !Read(Pos, Type) || !Read(Pos, Padding) || !Strings.IsValidIndex(ColumnName))
+					{
+						return false;
+					}
+
+					const int64 Width = Type == UALColumnU64 ? 8 : 4;
+					if (Pos + Rows * Width > Bytes.Num())
+					{
+						return false;
+					}
+					FColumnView& Column = Table.Columns.Add(Strings[ColumnName]);
+					Column.Type = Type;
+					Column.Data = Bytes.GetData() + Pos;
+					Pos += Rows * Width;
+				}
+			}
+			return true;
+		}
+
+		const FTableView* FindTable(const TCHAR* Name) const
+		{
+			return Tables.Find(Name);
+		}
+
+		static uint32 GetU32(const FColumnView& Column, uint32 Row)
+		{
+			uint32 Value = 0;
+			FMemory::Memcpy(&Value, Column.Data + (int64)Row * sizeof(uint32), sizeof(uint32));
+			return Value;
+		}
+
+		static uint64 GetU64(const FColumnView& Column, uint32 Row)
+		{
+			uint64 Value = 0;
+			FMemory::Memcpy(&Value, Column.Data + (int64)Row * sizeof(uint64), sizeof(uint64));
+			return Value;
+		}
+
+		const FString& GetString(const FColumnView& Column, uint32 Row) const
+		{
+			const uint32 Index = GetU32(Column, Row);
+			return Strings.IsValidIndex(Index) ? Strings[Index] : Strings[0];
+		}
+
+	private:
+		template <typename T>
+		bool Read(int64& Pos, T& Out) const
+		{
+			if (Pos + (int64)sizeof(T) > Bytes.Num())
+			{
+				return false;
+			}
+			FMemory::Memcpy(&Out, Bytes.GetData() + Pos, sizeof(T));
+			Pos += sizeof(T);
+			return true;
+		}
+
+		TArray<uint8> Bytes;
+		TArray<FString> Strings;
+		TMap<FString, FTableView> Tables;
+	};
+
+	/**
+	 * 导出任务状态：准备 → 收集（GameThread 分批）→ 扫描（分批并行）→ 写出
+	 */
+	struct FUAL_ProjectSnapshotState
+	{
+		enum class EPhase : uint8
+		{
+			Prepare,
+			Collect,
+			Scan,
+			Write,
+		};
+
+		FUAL_ProjectSnapshot::FOptions Options;
+		EPhase Phase = EPhase::Prepare;
+		int32 Cursor = 0;
+		double StartTime = 0.0;
+
+		TArray<FAssetData> AssetDatas;
+		TArray<FSnapshotPackage> Packages;
+		TArray<FSnapshotMaterial> Materials;
+		TMap<FName, FPreviousPackage> Previous;
+		bool bRegistryLoading = false;
+
+		int32 Reused = 0;
+		int32 HeaderReads = 0;
+		int32 HeaderFailures = 0;
+		int32 MissingFiles = 0;
+
+		bool Step(FUAL_JobProgress& Progress)
+		{
+			switch (Phase)
+			{
+			case EPhase::Prepare:
+				Prepare();
+				Progress.Total = Packages.Num() * 2 + 1;
+				Progress.Message = TEXT("Collecting");
+				Phase = EPhase::Collect;
+				return false;
+
+			case EPhase::Collect:
+				CollectBatch();
+				Progress.Completed = Cursor;
+				if (Cursor >= Packages.Num())
+				{
+					Cursor = 0;
+					Progress.Message = TEXT("Scanning");
+					Phase = EPhase::Scan;
+				}
+				return false;
+
+			case EPhase::Scan:
+				ScanBatch();
+				Progress.Completed = Packages.Num() + Cursor;
+				if (Cursor >= Packages.Num())
+				{
+					Progress.Message = TEXT("Writing");
+					Phase = EPhase::Write;
+				}
+				return false;
+
+			case EPhase::Write:
+			default:
+				Write(Progress);
+				Progress.Completed = Progress.Total;
+				return true;
+			}
+		}
+
+		void Prepare()
+		{
+			StartTime = FPlatformTime::Seconds();
+
+			IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+			bRegistryLoading = AssetRegistry.IsLoadingAssets();
+
+			FARFilter Filter;
+			Filter.bRecursivePaths = true;
+			for (const FString& Path : Options.PackagePaths)
+			{
+				Filter.PackagePaths.Add(FName(*Path));
+			}
+			AssetRegistry.GetAssets(Filter, AssetDatas);
+
+			TMap<FName, int32> PackageIndex;
+			for (int32 Index = 0; Index < AssetDatas.Num(); ++Index)
+			{
+				const FAssetData& AssetData = AssetDatas[Index];
+				int32& Slot = PackageIndex.FindOrAdd(AssetData.PackageName, INDEX_NONE);
+				if (Slot == INDEX_NONE)
+				{
+					Slot = Packages.AddDefaulted();
+					Packages[Slot].Name = AssetData.PackageName;
+				}
+				Packages[Slot].Assets.Add(Index);
+			}
+
+			// 输出顺序稳定，便于客户端比较两次快照
+			Packages.Sort([](const FSnapshotPackage& A, const FSnapshotPackage& B)
+			{
+				return A.Name.LexicalLess(B.Name);
+			});
+
+			CollectMaterials();
+
+			if (!Options.bFull)
+			{
+				LoadPrevious();
+			}
+		}
+
+		/** 材质目录中的父材质、混合模式与参数（参数未建立索引的根材质不加载） */
+		void CollectMaterials()
+		{
+			TMap<FString, int32> AssetByPath;
+			for (int32 Index = 0; Index < AssetDatas.Num(); ++Index)
+			{
+				AssetByPath.Add(GetObjectPathString(AssetDatas[Index]), Index);
+			}
+
+			FUAL_MaterialCatalog& Catalog = FUAL_MaterialCatalog::Get();
+			FUAL_MaterialCatalog::FQuery Query;
+			Query.MaxResults = MAX_int32;
+			const FUAL_MaterialCatalog::FQueryResult Result = Catalog.Query(Query);
+
+			for (const int32 EntryIndex : Result.Indices)
+			{
+				const FUAL_MaterialCatalog::FEntry& Entry = Catalog.GetEntry(EntryIndex);
+				const int32* Asset = AssetByPath.Find(Entry.Path);
+				if (!Asset)
+				{
+					continue;
+				}
+
+				FSnapshotMaterial& Material = Materials.AddDefaulted_GetRef();
+				Material.Asset = *Asset;
+				Material.Parent = Entry.ParentPath;
+				Material.BlendMode = Catalog.GetEffectiveBlendMode(EntryIndex);
+				Material.bInstance = Entry.bIsInstance;
+				if (const TArray<FUAL_MaterialCatalog::FParam>* Params = Catalog.GetEffectiveParams(EntryIndex))
+				{
+					Material.bParamsIndexed = true;
+					for (const FUAL_MaterialCatalog::FParam& Param : *Params)
+					{
+						Material.Params.Emplace(Param.Name.ToString(), FUAL_MaterialCatalog::ParamTypeToString(Param.Type));
+					}
+				}
+			}
+		}
+
+		void LoadPrevious()
+		{
+			FSnapshotReader Reader;
+			if (!Reader.Load(Options.OutputPath))
+			{
+				return;
+			}
+
+			const FSnapshotReader::FTableView* PackageTable = Reader.FindTable(TEXT("packages"));
+			const FSnapshotReader::FTableView* DependencyTable = Reader.FindTable(TEXT("dependencies"));
+			const FSnapshotReader::FTableView* MemberTable = Reader.FindTable(TEXT("members"));
+			if (!PackageTable || !DependencyTable || !MemberTable)
+			{
+				return;
+			}
+
+			const FSnapshotReader::FColumnView* NameCol = PackageTable->Find(TEXT("name"), UALColumnString);
+			const FSnapshotReader::FColumnView* StampCol = PackageTable->Find(TEXT("stamp"), UALColumnU64);
+			const FSnapshotReader::FColumnView* FlagsCol = PackageTable->Find(TEXT("flags"), UALColumnU32);
+			const FSnapshotReader::FColumnView* DepBeginCol = PackageTable->Find(TEXT("dep_begin"), UALColumnU32);
+			const FSnapshotReader::FColumnView* DepCountCol = PackageTable->Find(TEXT("dep_count"), UALColumnU32);
+			const FSnapshotReader::FColumnView* ClassCol = PackageTable->Find(TEXT("header_class"), UALColumnString);
+			const FSnapshotReader::FColumnView* GraphsCol = PackageTable->Find(TEXT("graphs"), UALColumnU32);
+			const FSnapshotReader::FColumnView* FunctionsCol = PackageTable->Find(TEXT("functions"), UALColumnU32);
+			const FSnapshotReader::FColumnView* NodesCol = PackageTable->Find(TEXT("nodes"), UALColumnU32);
+			const FSnapshotReader::FColumnView* ComponentsCol = PackageTable->Find(TEXT("components"), UALColumnU32);
+			const FSnapshotReader::FColumnView* MemberBeginCol = PackageTable->Find(TEXT("member_begin"), UALColumnU32);
+			const FSnapshotReader::FColumnView* MemberCountCol = PackageTable->Find(TEXT("member_count"), UALColumnU32);
+			const FSnapshotReader::FColumnView* TargetCol = DependencyTable->Find(TEXT("target"), UALColumnString);
+			const FSnapshotReader::FColumnView* KindCol = DependencyTable->Find(TEXT("kind"), UALColumnU32);
+			const FSnapshotReader::FColumnView* MemberKindCol = MemberTable->Find(TEXT("kind"), UALColumnU32);
+			const FSnapshotReader::FColumnView* MemberNameCol = MemberTable->Find(TEXT("name"), UALColumnString);
+			if (!NameCol || !StampCol || !FlagsCol || !DepBeginCol || !DepCountCol || !ClassCol || !GraphsCol || !FunctionsCol
+				|| !NodesCol || !ComponentsCol || !MemberBeginCol || !MemberCountCol || !TargetCol || !KindCol || !MemberKindCol || !MemberNameCol)
+			{
+				return;
+			}
+
+			for (uint32 Row = 0; Row < PackageTable->Rows; ++Row)
+			{
+				const uint32 Flags = FSnapshotReader::GetU32(*FlagsCol, Row);
+				if (!(Flags & PackageFlag_HeaderRead))
+				{
+					continue;
+				}
+
+				FPreviousPackage& Prev = Previous.Add(FName(*Reader.GetString(*NameCol, Row)));
+				Prev.Stamp = FSnapshotReader::GetU64(*StampCol, Row);
+				Prev.Header.Flags = Flags & (PackageFlag_HeaderRead | PackageFlag_HeaderDeps);
+				Prev.Header.HeaderClass = Reader.GetString(*ClassCol, Row);
+				Prev.Header.Graphs = FSnapshotReader::GetU32(*GraphsCol, Row);
+				Prev.Header.Functions = FSnapshotReader::GetU32(*FunctionsCol, Row);
+				Prev.Header.Nodes = FSnapshotReader::GetU32(*NodesCol, Row);
+				Prev.Header.Components = FSnapshotReader::GetU32(*ComponentsCol, Row);
+
+				const uint32 MemberBegin = FSnapshotReader::GetU32(*MemberBeginCol, Row);
+				const uint32 MemberEnd = (uint32)FMath::Min<uint64>((uint64)MemberBegin + FSnapshotReader::GetU32(*MemberCountCol, Row), MemberTable->Rows);
+				for (uint32 Member = MemberBegin; Member < MemberEnd; ++Member)
+				{
+					FSnapshotMember& Out = Prev.Header.Members.AddDefaulted_GetRef();
+					Out.Kind = FSnapshotReader::GetU32(*MemberKindCol, Member);
+					Out.Name = Reader.GetString(*MemberNameCol, Member);
+				}
+
+				const uint32 DepBegin = FSnapshotReader::GetU32(*DepBeginCol, Row);
+				const uint32 DepEnd = (uint32)FMath::Min<uint64>((uint64)DepBegin + FSnapshotReader::GetU32(*DepCountCol, Row), DependencyTable->Rows);
+				for (uint32 Dep = DepBegin; Dep < DepEnd; ++Dep)
+				{
+					if (FSnapshotReader::GetU32(*KindCol, Dep) == Dependency_Header)
+					{
+						Prev.Header.HeaderDeps.Add(Reader.GetString(*TargetCol, Dep));
+					}
+				}
+			}
+
+			UE_LOG(LogUALSnapshot, Log, TEXT("Loaded previous snapshot %s (%d packages with header data)"), *Options.OutputPath, Previous.Num());
+		}
+
+		/** GameThread：注册表依赖、文件名、是否为蓝图包 */
+		void CollectBatch()
+		{
+			IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+			const int32 End = FMath::Min(Cursor + UALSnapshotCollectBatch, Packages.Num());
+			for (; Cursor < End; ++Cursor)
+			{
+				FSnapshotPackage& Package = Packages[Cursor];
+
+				bool bMap = false;
+				for (const int32 AssetIndex : Package.Assets)
+				{
+					const FAssetData& AssetData = AssetDatas[AssetIndex];
+					bMap |= GetAssetClassName(AssetData) == UALWorldClass;
+					Package.bBlueprint |= AssetData.TagsAndValues.Contains(UALParentClassTag);
+				}
+
+				FString Filename;
+				const FString& Extension = bMap ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension();
+				if (FPackageName::TryConvertLongPackageNameToFilename(Package.Name.ToString(), Filename, Extension))
+				{
+					Package.Filename = FPaths::ConvertRelativePathToFull(Filename);
+				}
+
+				AssetRegistry.GetDependencies(Package.Name, Package.HardDeps, UE::AssetRegistry::EDependencyCategory::Package,
+					UE::AssetRegistry::EDependencyQuery::Hard);
+				if (Options.bIncludeSoftReferences)
+				{
+					AssetRegistry.GetDependencies(Package.Name, Package.SoftDeps, UE::AssetRegistry::EDependencyCategory::Package,
+						UE::AssetRegistry::EDependencyQuery::Soft);
+				}
+			}
+		}
+
+		/** 并行：保存哈希；蓝图包（注册表仍在扫描时为全部包）读取包头或复用上次结果 */
+		void ScanBatch()
+		{
+			const int32 Begin = Cursor;
+			const int32 End = FMath::Min(Cursor + UALSnapshotScanBatch, Packages.Num());
+			const bool bHeaderDeps = bRegistryLoading;
+
+			ParallelFor(End - Begin, [this, Begin, bHeaderDeps](int32 Offset)
+			{
+				FSnapshotPackage& Package = Packages[Begin + Offset];
+				ScanPackage(Package, Previous.Find(Package.Name), bHeaderDeps);
+			});
+
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				const uint32 Flags = Packages[Index].Flags;
+				Reused += (Flags & PackageFlag_Reused) ? 1 : 0;
+				HeaderReads += ((Flags & PackageFlag_HeaderRead) && !(Flags & PackageFlag_Reused)) ? 1 : 0;
+				HeaderFailures += (Flags & PackageFlag_HeaderFailed) ? 1 : 0;
+				MissingFiles += (Flags & PackageFlag_FileMissing) ? 1 : 0;
+			}
+			Cursor = End;
+		}
+
+		static void ScanPackage(FSnapshotPackage& Package, const FPreviousPackage* Prev, bool bHeaderDeps)
+		{
+			const FFileStatData Stat = Package.Filename.IsEmpty() ? FFileStatData() : IFileManager::Get().GetStatData(*Package.Filename);
+			if (!Stat.bIsValid)
+			{
+				Package.Flags |= PackageFlag_FileMissing;
+				return;
+			}
+
+			// 保存哈希：修改时间 + 大小，包每次保存都会变化
+			const int64 StampSource[2] = { Stat.ModificationTime.GetTicks(), Stat.FileSize };
+			Package.Stamp = CityHash64(reinterpret_cast<const char*>(StampSource), sizeof(StampSource));
+			Package.FileSize = Stat.FileSize;
+
+			if (!Package.bBlueprint && !bHeaderDeps)
+			{
+				return;
+			}
+
+			if (Prev && Prev->Stamp == Package.Stamp && (!bHeaderDeps || (Prev->Header.Flags & PackageFlag_HeaderDeps)))
+			{
+				Package.Header = Prev->Header;
+				Package.Flags |= PackageFlag_Reused | Package.Header.Flags;
+				return;
+			}
+
+			FUALPackageReader Reader;
+			TArray<FUALPackageReader::FExportInfo> Exports;
+			if (!Reader.OpenPackageFile(Package.Filename) || !Reader.ReadExports(Exports))
+			{
+				Package.Flags |= PackageFlag_HeaderFailed;
+				return;
+			}
+
+			FHeaderSummary& Header = Package.Header;
+			Header.Flags = PackageFlag_HeaderRead;
+			Reader.GetAssetClass(Header.HeaderClass);
+
+			for (const FUALPackageReader::FExportInfo& Export : Exports)
+			{
+				if (Export.ClassName == UALEdGraphClass)
+				{
+					++Header.Graphs;
+					Header.Members.Add({ Member_Graph, Export.ObjectName.ToString() });
+				}
+				else if (Export.ClassName == UALFunctionClass)
+				{
+					// 事件图表的入口与委托签名不是用户定义的函数
+					const FString FunctionName = Export.ObjectName.ToString();
+					if (!FunctionName.StartsWith(TEXT("ExecuteUbergraph")) && !FunctionName.EndsWith(TEXT("__DelegateSignature")))
+					{
+						++Header.Functions;
+						Header.Members.Add({ Member_Function, FunctionName });
+					}
+				}
+				else if (Export.ClassName == UALSCSNodeClass)
+				{
+					++Header.Components;
+				}
+				else if (Export.ClassName == UALCommentNodeClass || Export.ClassName.ToString().StartsWith(TEXT("K2Node")))
+				{
+					++Header.Nodes;
+				}
+			}
+
+			// 注册表尚未扫描完成时依赖可能不全，以包头导入表为准
+			TArray<FName> HeaderDeps;
+			if (bHeaderDeps && Reader.ReadDependencies(HeaderDeps))
+			{
+				Header.Flags |= PackageFlag_HeaderDeps;
+				for (const FName& Dep : HeaderDeps)
+				{
+					Header.HeaderDeps.Add(Dep.ToString());
+				}
+			}
+
+			Package.Flags |= Header.Flags;
+		}
+
+		void Write(FUAL_JobProgress& Progress)
+		{
+			FSnapshotWriter Writer;
+			const int32 NumPackages = Packages.Num();
+
+			// packages / dependencies / members
+			TArray<uint32> Names, Flags, DepBegins, DepCounts, HeaderClasses, Graphs, Functions, Nodes, Components, MemberBegins, MemberCounts;
+			TArray<uint64> Stamps, Sizes;
+			TArray<uint32> DepTargets, DepKinds, MemberKinds, MemberNames;
+			for (const FSnapshotPackage& Package : Packages)
+			{
+				Names.Add(Writer.Intern(Package.Name));
+				Stamps.Add(Package.Stamp);
+				Sizes.Add((uint64)Package.FileSize);
+				Flags.Add(Package.Flags);
+
+				DepBegins.Add(DepTargets.Num());
+				for (const FName& Dep : Package.HardDeps)
+				{
+					DepTargets.Add(Writer.Intern(Dep));
+					DepKinds.Add(Dependency_Hard);
+				}
+				for (const FName& Dep : Package.SoftDeps)
+				{
+					DepTargets.Add(Writer.Intern(Dep));
+					DepKinds.Add(Dependency_Soft);
+				}
+				for (const FString& Dep : Package.Header.HeaderDeps)
+				{
+					DepTargets.Add(Writer.Intern(Dep));
+					DepKinds.Add(Dependency_Header);
+				}
+				DepCounts.Add(DepTargets.Num() - DepBegins.Last());
+
+				HeaderClasses.Add(Writer.Intern(Package.Header.HeaderClass));
+				Graphs.Add(Package.Header.Graphs);
+				Functions.Add(Package.Header.Functions);
+				Nodes.Add(Package.Header.Nodes);
+				Components.Add(Package.Header.Components);
+
+				MemberBegins.Add(MemberKinds.Num());
+				for (const FSnapshotMember& Member : Package.Header.Members)
+				{
+					MemberKinds.Add(Member.Kind);
+					MemberNames.Add(Writer.Intern(Member.Name));
+				}
+				MemberCounts.Add(Package.Header.Members.Num());
+			}
+
+			Writer.BeginTable(TEXT("packages"), NumPackages);
+			Writer.AddColumn(TEXT("name"), UALColumnString, Names);
+			Writer.AddColumn(TEXT("stamp"), UALColumnU64, Stamps);
+			Writer.AddColumn(TEXT("size"), UALColumnU64, Sizes);
+			Writer.AddColumn(TEXT("flags"), UALColumnU32, Flags);
+			Writer.AddColumn(TEXT("dep_begin"), UALColumnU32, DepBegins);
+			Writer.AddColumn(TEXT("dep_count"), UALColumnU32, DepCounts);
+			Writer.AddColumn(TEXT("header_class"), UALColumnString, HeaderClasses);
+			Writer.AddColumn(TEXT("graphs"), UALColumnU32, Graphs);
+			Writer.AddColumn(TEXT("functions"), UALColumnU32, Functions);
+			Writer.AddColumn(TEXT("nodes"), UALColumnU32, Nodes);
+			Writer.AddColumn(TEXT("components"), UALColumnU32, Components);
+			Writer.AddColumn(TEXT("member_begin"), UALColumnU32, MemberBegins);
+			Writer.AddColumn(TEXT("member_count"), UALColumnU32, MemberCounts);
+
+			Writer.BeginTable(TEXT("dependencies"), DepTargets.Num());
+			Writer.AddColumn(TEXT("target"), UALColumnString, DepTargets);
+			Writer.AddColumn(TEXT("kind"), UALColumnU32, DepKinds);
+
+			Writer.BeginTable(TEXT("members"), MemberKinds.Num());
+			Writer.AddColumn(TEXT("kind"), UALColumnU32, MemberKinds);
+			Writer.AddColumn(TEXT("name"), UALColumnString, MemberNames);
+
+			// assets / classes / blueprints：按包顺序输出，AssetRows 记录 AssetDatas 下标对应的行号
+			TArray<int32> AssetRows;
+			AssetRows.Init(INDEX_NONE, AssetDatas.Num());
+			TArray<uint32> AssetPaths, AssetNames, AssetClasses, AssetPackages;
+			TMap<FName, uint32> ClassCounts;
+			TArray<uint32> BpAssets, BpParents, BpNativeParents, BpTypes, BpGeneratedClasses, BpInterfaces;
+			for (int32 PackageRow = 0; PackageRow < NumPackages; ++PackageRow)
+			{
+				for (const int32 AssetIndex : Packages[PackageRow].Assets)
+				{
+					const FAssetData& AssetData = AssetDatas[AssetIndex];
+					const FName ClassName = GetAssetClassName(AssetData);
+					AssetRows[AssetIndex] = AssetPaths.Num();
+
+					AssetPaths.Add(Writer.Intern(GetObjectPathString(AssetData)));
+					AssetNames.Add(Writer.Intern(AssetData.AssetName));
+					AssetClasses.Add(Writer.Intern(ClassName));
+					AssetPackages.Add(PackageRow);
+					++ClassCounts.FindOrAdd(ClassName, 0);
+
+					if (AssetData.TagsAndValues.Contains(UALParentClassTag))
+					{
+						BpAssets.Add(AssetRows[AssetIndex]);
+						BpParents.Add(Writer.Intern(GetTagString(AssetData, UALParentClassTag)));
+						BpNativeParents.Add(Writer.Intern(GetTagString(AssetData, UALNativeParentClassTag)));
+						BpTypes.Add(Writer.Intern(GetTagString(AssetData, UALBlueprintTypeTag)));
+						BpGeneratedClasses.Add(Writer.Intern(GetTagString(AssetData, UALGeneratedClassTag)));
+						BpInterfaces.Add(Writer.Intern(GetTagString(AssetData, UALImplementedInterfacesTag)));
+					}
+				}
+			}
+
+			Writer.BeginTable(TEXT("assets"), AssetPaths.Num());
+			Writer.AddColumn(TEXT("path"), UALColumnString, AssetPaths);
+			Writer.AddColumn(TEXT("name"), UALColumnString, AssetNames);
+			Writer.AddColumn(TEXT("class"), UALColumnString, AssetClasses);
+			Writer.AddColumn(TEXT("package"), UALColumnU32, AssetPackages);
+
+			ClassCounts.KeySort([](const FName& A, const FName& B) { return A.LexicalLess(B); });
+			TArray<uint32> ClassNames, ClassAssetCounts;
+			for (const TPair<FName, uint32>& Pair : ClassCounts)
+			{
+				ClassNames.Add(Writer.Intern(Pair.Key));
+				ClassAssetCounts.Add(Pair.Value);
+			}
+			Writer.BeginTable(TEXT("classes"), ClassNames.Num());
+			Writer.AddColumn(TEXT("name"), UALColumnString, ClassNames);
+			Writer.AddColumn(TEXT("assets"), UALColumnU32, ClassAssetCounts);
+
+			Writer.BeginTable(TEXT("blueprints"), BpAssets.Num());
+			Writer.AddColumn(TEXT("asset"), UALColumnU32, BpAssets);
+			Writer.AddColumn(TEXT("parent"), UALColumnString, BpParents);
+			Writer.AddColumn(TEXT("native_parent"), UALColumnString, BpNativeParents);
+			Writer.AddColumn(TEXT("type"), UALColumnString, BpTypes);
+			Writer.AddColumn(TEXT("generated_class"), UALColumnString, BpGeneratedClasses);
+			Writer.AddColumn(TEXT("interfaces"), UALColumnString, BpInterfaces);
+
+			// materials / material_params
+			TArray<uint32> MatAssets, MatParents, MatBlendModes, MatInstances, MatIndexed, ParamBegins, ParamCounts;
+			TArray<uint32> ParamNames, ParamTypes;
+			for (const FSnapshotMaterial& Material : Materials)
+			{
+				MatAssets.Add(AssetRows[Material.Asset]);
+				MatParents.Add(Writer.Intern(Material.Parent));
+				MatBlendModes.Add(Writer.Intern(Material.BlendMode));
+				MatInstances.Add(Material.bInstance ? 1 : 0);
+				MatIndexed.Add(Material.bParamsIndexed ? 1 : 0);
+				ParamBegins.Add(ParamNames.Num());
+				for (const TPair<FString, FString>& Param : Material.Params)
+				{
+					ParamNames.Add(Writer.Intern(Param.Key));
+					ParamTypes.Add(Writer.Intern(Param.Value));
+				}
+				ParamCounts.Add(Material.Params.Num());
+			}
+
+			Writer.BeginTable(TEXT("materials"), MatAssets.Num());
+			Writer.AddColumn(TEXT("asset"), UALColumnU32, MatAssets);
+			Writer.AddColumn(TEXT("parent"), UALColumnString, MatParents);
+			Writer.AddColumn(TEXT("blend_mode"), UALColumnString, MatBlendModes);
+			Writer.AddColumn(TEXT("instance"), UALColumnU32, MatInstances);
+			Writer.AddColumn(TEXT("params_indexed"), UALColumnU32, MatIndexed);
+			Writer.AddColumn(TEXT("param_begin"), UALColumnU32, ParamBegins);
+			Writer.AddColumn(TEXT("param_count"), UALColumnU32, ParamCounts);
+
+			Writer.BeginTable(TEXT("material_params"), ParamNames.Num());
+			Writer.AddColumn(TEXT("name"), UALColumnString, ParamNames);
+			Writer.AddColumn(TEXT("type"), UALColumnString, ParamTypes);
+
+			const int32 StringCount = Writer.NumStrings();
+			const TArray<uint8> Bytes = Writer.Finish();
+
+			// 先写临时文件再替换，写出中途失败不会破坏上次的快照
+			IFileManager::Get().MakeDirectory(*FPaths::GetPath(Options.OutputPath), true);
+			const FString TempPath = Options.OutputPath + TEXT(".tmp");
+			if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*Options.OutputPath, *TempPath, true, true))
+			{
+				IFileManager::Get().Delete(*TempPath, false, false, true);
+				Progress.Error = FString::Printf(TEXT("Failed to write snapshot: %s"), *Options.OutputPath);
+				return;
+			}
+
+			const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			UE_LOG(LogUALSnapshot, Log, TEXT("Project snapshot written: %s (%d packages, %d assets, %d header reads, %d reused, %.0f ms)"),
+				*Options.OutputPath, NumPackages, AssetPaths.Num(), HeaderReads, Reused, ElapsedMs);
+
+			TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+			Result->SetStringField(TEXT("path"), Options.OutputPath);
+			Result->SetStringField(TEXT("format"), TEXT("UALS"));
+			Result->SetNumberField(TEXT("version"), FUAL_ProjectSnapshot::FormatVersion);
+			Result->SetNumberField(TEXT("bytes"), Bytes.Num());
+			Result->SetNumberField(TEXT("packages"), NumPackages);
+			Result->SetNumberField(TEXT("assets"), AssetPaths.Num());
+			Result->SetNumberField(TEXT("classes"), ClassNames.Num());
+			Result->SetNumberField(TEXT("blueprints"), BpAssets.Num());
+			Result->SetNumberField(TEXT("materials"), MatAssets.Num());
+			Result->SetNumberField(TEXT("dependencies"), DepTargets.Num());
+			Result->SetNumberField(TEXT("strings"), StringCount);
+			Result->SetNumberField(TEXT("header_reads"), HeaderReads);
+			Result->SetNumberField(TEXT("reused"), Reused);
+			Result->SetNumberField(TEXT("header_failures"), HeaderFailures);
+			Result->SetNumberField(TEXT("missing_files"), MissingFiles);
+			Result->SetBoolField(TEXT("full"), Options.bFull || Previous.Num() == 0);
+			Result->SetBoolField(TEXT("registry_loading"), bRegistryLoading);
+			Result->SetNumberField(TEXT("elapsed_ms"), ElapsedMs);
+			Progress.Result = Result;
+		}
+	};
+}
+
+FString FUAL_ProjectSnapshot::ResolveOutputPath(const FString& Path)
+{
+	const FString DefaultDir = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UAL/Snapshot")));
+	if (Path.IsEmpty())
+	{
+		return FPaths::Combine(DefaultDir, TEXT("ProjectSnapshot.uals"));
+	}
+	return FPaths::IsRelative(Path) ? FPaths::Combine(DefaultDir, Path) : Path;
+}
+
+FUAL_JobSpec FUAL_ProjectSnapshot::CreateJob(const FOptions& Options)
+{
+	TSharedRef<FUAL_ProjectSnapshotState> State = MakeShared<FUAL_ProjectSnapshotState>();
+	State->Options = Options;
+	State->Options.OutputPath = ResolveOutputPath(Options.OutputPath);
+	if (State->Options.PackagePaths.Num() == 0)
+	{
+		State->Options.PackagePaths.Add(TEXT("/Game"));
+	}
+
+	FUAL_JobSpec Spec;
+	Spec.Type = TEXT("project.export_snapshot");
+	Spec.Step = [State](FUAL_JobProgress& Progress)
+	{
+		return State->Step(Progress);
+	};
+	return Spec;
+}
@@ -0,0 +1,284 @@
+#include "UAL_PropertyPathCache.h"
+
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
+#include "Editor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALPropertyPath, Log, All);
+
+namespace
+{
+	// 与 TryCollectProperty / FindWritableProperty 原有过滤规则保持一致
+	constexpr EPropertyFlags UALHiddenPropertyFlags = CPF_Transient | CPF_Deprecated | CPF_EditorOnly | CPF_DisableEditOnInstance;
+	constexpr EPropertyFlags UALEditablePropertyFlags = CPF_Edit | CPF_BlueprintVisible | CPF_BlueprintReadOnly;
+
+	// 防止对象引用成环导致无限跳转
+	constexpr int32 UALMaxPropertyPathHops = 8;
+
+	// 每个类最多缓存的未命中路径数，超出后不再缓存（客户端拼错的路径无穷多）
+	constexpr int32 UALMaxNegativePathsPerClass = 256;
+}
+
+FUAL_PropertyPathCache& FUAL_PropertyPathCache::Get()
+{
+	static FUAL_PropertyPathCache Instance;
+	return Instance;
+}
+
+void FUAL_PropertyPathCache::Invalidate()
+{
+	if (Entries.Num() > 0)
+	{
+		UE_LOG(LogUALPropertyPath, Verbose, TEXT("Invalidate property path cache (%d classes)"), Entries.Num());
+	}
+	Entries.Reset();
+}
+
+void FUAL_PropertyPathCache::Shutdown()
+{
+	UnbindInvalidationDelegates();
+	Entries.Empty();
+}
+
+void FUAL_PropertyPathCache::BindInvalidationDelegates()
+{
+	if (bDelegatesBound)
+	{
+		return;
+	}
+	bDelegatesBound = true;
+
+#if WITH_EDITOR
+	// 蓝图重编译会在同一个 UClass 上重建 FProperty，缓存的指针必须全部丢弃
+	if (GEditor)
+	{
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddLambda([this]()
+		{
+			Invalidate();
+		});
+	}
+	ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddRaw(this, &FUAL_PropertyPathCache::HandleObjectsReplaced);
+#endif
+}
+
+void FUAL_PropertyPathCache::UnbindInvalidationDelegates()
+{
+	if (!bDelegatesBound)
+	{
+		return;
+	}
+	bDelegatesBound = false;
+
+#if WITH_EDITOR
+	if (GEditor && BlueprintCompiledHandle.IsValid())
+	{
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+	}
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+#endif
+	BlueprintCompiledHandle.Reset();
+	ObjectsReplacedHandle.Reset();
+}
+
+void FUAL_PropertyPathCache::HandleObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap)
+{
+	Invalidate();
+}
+
+FUAL_PropertyPathCache::FClassEntry& FUAL_PropertyPathCache::FindOrAddEntry(const UClass* Class)
+{
+	BindInvalidationDelegates();
+
+	FClassEntry* Entry = Entries.Find(Class);
+	// 类被 GC 后地址可能被复用，弱指针校验失败时重建
+	if (Entry && Entry->Class.Get() != Class)
+	{
+		Entries.Remove(Class);
+		Entry = nullptr;
+	}
+	if (!Entry)
+	{
+		Entry = &Entries.Add(Class);
+		Entry->Class = Class;
+	}
+	return *Entry;
+}
+
+void FUAL_PropertyPathCache::CompileInto(const UClass* Class, const FString& Path, FUAL_CompiledPropertyPath& Out)
+{
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("."), true);
+	if (Segments.Num() == 0)
+	{
+		return;
+	}
+
+	const UStruct* CurrentStruct = Class;
+	int32 Offset = 0;
+
+	for (int32 Index = 0; Index < Segments.Num(); ++Index)
+	{
+		FProperty* Prop = FindFProperty<FProperty>(CurrentStruct, *Segments[Index]);
+		if (!Prop)
+		{
+			Out.Chain.Reset();
+			return;
+		}
+		Out.Chain.Add(Prop);
+
+		const bool bIsLast = Index == Segments.Num() - 1;
+		if (bIsLast)
+		{
+			break;
+		}
+
+		if (FStructProperty* StructProp = CastField<FStructProperty>(Prop))
+		{
+			Offset += StructProp->GetOffset_ForInternal();
+			CurrentStruct = StructProp->Struct;
+			continue;
+		}
+
+		if (CastField<FObjectPropertyBase>(Prop))
+		{
+			// 对象引用：运行时解引用后在目标对象的实际类上继续编译剩余路径
+			Out.bHop = true;
+			for (int32 RestIndex = Index + 1; RestIndex < Segments.Num(); ++RestIndex)
+			{
+				if (!Out.Remainder.IsEmpty())
+				{
+					Out.Remainder += TEXT(".");
+				}
+				Out.Remainder += Segments[RestIndex];
+			}
+			break;
+		}
+
+		// 其他类型（数组、Map 等）不支持继续向下寻址
+		Out.Chain.Reset();
+		return;
+	}
+
+	Out.LeafContainerOffset = Offset;
+
+	// 每一段（包括结构体成员与对象引用属性）都必须满足访问条件
+	Out.bReadable = true;
+	Out.bWritable = true;
+	for (const FProperty* Prop : Out.Chain)
+	{
+		Out.bReadable &= !Prop->HasAnyPropertyFlags(UALHiddenPropertyFlags);
+		Out.bWritable &= Prop->HasAnyPropertyFlags(UALEditablePropertyFlags);
+	}
+	Out.bWritable &= Out.bReadable;
+}
+
+const FUAL_CompiledPropertyPath& FUAL_PropertyPathCache::Compile(const UClass* Class, const FString& Path)
+{
+	FClassEntry& Entry = FindOrAddEntry(Class);
+	if (const FUAL_CompiledPropertyPath* Existing = Entry.Paths.Find(Path))
+	{
+		return *Existing;
+	}
+
+	FUAL_CompiledPropertyPath Compiled;
+	CompileInto(Class, Path, Compiled);
+
+	// 未命中的路径同样缓存（Chain 为空），避免重复的失败查找；数量有上限
+	if (!Compiled.IsValid())
+	{
+		if (Entry.NegativePaths >= UALMaxNegativePathsPerClass)
+		{
+			static const FUAL_CompiledPropertyPath Invalid;
+			return Invalid;
+		}
+		++Entry.NegativePaths;
+	}
+	return Entry.Paths.Add(Path, MoveTemp(Compiled));
+}
+
+bool FUAL_PropertyPathCache::Resolve(UObject* Root, const FString& Path, EAccess Access, FUAL_ResolvedProperty& Out)
+{
+	Out = FUAL_ResolvedProperty();
+	if (!Root || Path.IsEmpty())
+	{
+		return false;
+	}
+
+	UObject* CurrentObj = Root;
+	FString CurrentPath = Path;
+
+	for (int32 Hop = 0; Hop < UALMaxPropertyPathHops; ++Hop)
+	{
+		const FUAL_CompiledPropertyPath& Compiled = Compile(CurrentObj->GetClass(), CurrentPath);
+		if (!Compiled.IsValid())
+		{
+			return false;
+		}
+
+		// 对象引用属性本身也要满足访问条件（可读即可跳转，写入时同样要求可编辑）
+		const bool bAllowed = Access == EAccess::Write ? Compiled.bWritable : Compiled.bReadable;
+		if (!bAllowed)
+		{
+			return false;
+		}
+
+		uint8* LeafContainer = reinterpret_cast<uint8*>(CurrentObj) + Compiled.LeafContainerOffset;
+		FProperty* LastProp = Compiled.Chain.Last();
+
+		if (Compiled.bHop)
+		{
+			const FObjectPropertyBase* ObjProp = CastFieldChecked<FObjectPropertyBase>(LastProp);
+			UObject* NextObj = ObjProp->GetObjectPropertyValue_InContainer(LeafContainer);
+			if (!NextObj)
+			{
+				return false;
+			}
+			// 写入只允许进入 Root 拥有的组件 / 实例化子对象，不能经由引用修改共享资产（网格、材质、数据资产等）
+			if (Access == EAccess::Write && !NextObj->IsIn(Root))
+			{
+				return false;
+			}
+			CurrentObj = NextObj;
+			CurrentPath = Compiled.Remainder;
+			continue;
+		}
+
+		Out.Property = LastProp;
+		Out.Container = LeafContainer;
+		Out.OwnerObject = CurrentObj;
+		Out.MemberProperty = Compiled.Chain[0];
+		return true;
+	}
+
+	UE_LOG(LogUALPropertyPath, Warning, TEXT("Property path '%s' exceeded %d object hops"), *Path, UALMaxPropertyPathHops);
+	return false;
+}
+
+const TArray<FString>& FUAL_PropertyPathCache::GetSuggestionCandidates(const UClass* Class)
+{
+	static const TArray<FString> Empty;
+	if (!Class)
+	{
+		return Empty;
+	}
+
+	FClassEntry& Entry = FindOrAddEntry(Class);
+	if (!Entry.bCandidatesBuilt)
+	{
+		for (TFieldIterator<FProperty> It(Class); It; ++It)
+		{
+			const FProperty* Prop = *It;
+			if (!Prop || Prop->HasAnyPropertyFlags(UALHiddenPropertyFlags))
+			{
+				continue;
+			}
+			if (!Prop->HasAnyPropertyFlags(UALEditablePropertyFlags))
+			{
+				continue;
+			}
+			Entry.Candidates.AddUnique(Prop->GetName());
+		}
+		Entry.bCandidatesBuilt = true;
+	}
+	return Entry.Candidates;
+}
@@ -0,0 +1,424 @@
+#include "UAL_PythonRuntime.h"
+
+#include "IPythonScriptPlugin.h"
+#include "Misc/Base64.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALPython, Log, All);
+
+namespace
+{
+	// C++ 侧记录的已编译脚本哈希上限，超出后清空（Python 侧缺失时会自动补传源码）
+	constexpr int32 UALMaxKnownHashes = 4096;
+
+	/**
+	 * 解释器内常驻的运行时，以 Private 作用域执行一次后注册为 sys.modules['_ual_runtime']；
+	 * 函数的 __globals__ 即该作用域，会话 / 编译缓存 / 模块表都保存在其中
+	 */
+	const TCHAR* UALPythonRuntimeSource = TEXT(R"PY(
+import base64
+import collections
+import importlib
+import json
+import sys
+import time
+import traceback
+import types
+
+_CODE_CACHE_MAX = 256
+_code_cache = collections.OrderedDict()
+_sessions = {}
+_modules = {}
+_counters = {'hits': 0, 'misses': 0}
+
+
+def _decode(text_b64):
+    return base64.b64decode(text_b64).decode('utf-8') if text_b64 else ''
+
+
+def _encode(payload):
+    try:
+        text = json.dumps(payload, default=repr, allow_nan=False)
+    except Exception:
+        text = json.dumps({'ok': False, 'error': 'Result is not JSON serializable:\n' + traceback.format_exc()})
+    return base64.b64encode(text.encode('utf-8')).decode('ascii')
+
+
+def _session(name):
+    namespace = _sessions.get(name)
+    if namespace is None:
+        namespace = {'__name__': '__ual_session__', '__builtins__': __builtins__}
+        _sessions[name] = namespace
+    return namespace
+
+
+def _get_code(key, source_b64, filename):
+    code = _code_cache.get(key)
+    if code is not None:
+        _code_cache.move_to_end(key)
+        _counters['hits'] += 1
+        return code, True
+    if not source_b64:
+        return None, False
+    code = compile(_decode(source_b64), filename, 'exec')
+    _counters['misses'] += 1
+    _code_cache[key] = code
+    while len(_code_cache) > _CODE_CACHE_MAX:
+        _code_cache.popitem(last=False)
+    return code, False
+
+
+def _exec_cached(key, source_b64, filename, namespace):
+    start = time.perf_counter()
+    try:
+        code, hit = _get_code(key, source_b64, filename)
+    except SyntaxError:
+        return {'ok': False, 'error': traceback.format_exc(), 'compile_ms': (time.perf_counter() - start) * 1000.0}
+    if code is None:
+        return {'ok': False, 'missing': True}
+    compiled = time.perf_counter()
+    try:
+        exec(code, namespace)
+        payload = {'ok': True}
+    except Exception:
+        payload = {'ok': False, 'error': traceback.format_exc()}
+    payload['cache_hit'] = hit
+    payload['compile_ms'] = (compiled - start) * 1000.0
+    payload['exec_ms'] = (time.perf_counter() - compiled) * 1000.0
+    return payload
+
+
+def run(session, key, source_b64):
+    namespace = _session(session)
+    namespace.pop('__result__', None)
+    payload = _exec_cached(key, source_b64, '<ual:%s>' % session, namespace)
+    if '__result__' in namespace:
+        payload['result'] = namespace.pop('__result__')
+    return _encode(payload)
+
+
+def register_module(name, key, source_b64):
+    module = types.ModuleType(name)
+    module.__file__ = '<ual:%s>' % name
+    payload = _exec_cached(key, source_b64, module.__file__, module.__dict__)
+    if payload.get('ok'):
+        sys.modules[name] = module
+        _modules[name] = key
+        payload['functions'] = sorted(
+            attr for attr, value in module.__dict__.items()
+            if callable(value) and not attr.startswith('_') and getattr(value, '__module__', None) == name)
+    return _encode(payload)
+
+
+def _resolve(session, function):
+    if '.' in function:
+        module_name, attr = function.rsplit('.', 1)
+        module = sys.modules.get(module_name) or importlib.import_module(module_name)
+        return getattr(module, attr)
+    return _session(session)[function]
+
+
+def call(session, function, args_b64):
+    start = time.perf_counter()
+    try:
+        target = _resolve(session, function)
+        args = json.loads(_decode(args_b64))[0] if args_b64 else None
+        if isinstance(args, dict):
+            value = target(**args)
+        elif isinstance(args, list):
+            value = target(*args)
+        elif args is None:
+            value = target()
+        else:
+            value = target(args)
+        payload = {'ok': True, 'result': value}
+    except Exception:
+        payload = {'ok': False, 'error': traceback.format_exc()}
+    payload['exec_ms'] = (time.perf_counter() - start) * 1000.0
+    return _encode(payload)
+
+
+def reset_session(session):
+    return _encode({'ok': True, 'existed': _sessions.pop(session, None) is not None})
+
+
+def stats():
+    return _encode({
+        'ok': True,
+        'sessions': sorted(_sessions.keys()),
+        'modules': sorted(_modules.keys()),
+        'cached_scripts': len(_code_cache),
+        'cache_hits': _counters['hits'],
+        'cache_misses': _counters['misses'],
+    })
+
+
+_runtime = types.ModuleType('_ual_runtime')
+for _name in ('run', 'register_module', 'call', 'reset_session', 'stats'):
+    setattr(_runtime, _name, globals()[_name])
+sys.modules['_ual_runtime'] = _runtime
+)PY");
+}
+
+FUAL_PythonRuntime& FUAL_PythonRuntime::Get()
+{
+	static FUAL_PythonRuntime Instance;
+	return Instance;
+}
+
+bool FUAL_PythonRuntime::IsAvailable()
+{
+#if defined(WITH_PYTHON) && WITH_PYTHON
+	return IPythonScriptPlugin::IsAvailable() && IPythonScriptPlugin::Get()->IsPythonAvailable();
+#else
+	return false;
+#endif
+}
+
+FString FUAL_PythonRuntime::HashSource(const FString& Source)
+{
+	const auto Utf8 = StringCast<UTF8CHAR>(*Source, Source.Len());
+	uint8 Hash[FSHA1::DigestSize];
+	FSHA1::HashBuffer(Utf8.Get(), Utf8.Length(), Hash);
+	return BytesToHex(Hash, FSHA1::DigestSize);
+}
+
+FString FUAL_PythonRuntime::ToBase64(const FString& Text)
+{
+	if (Text.IsEmpty())
+	{
+		return FString();
+	}
+	const auto Utf8 = StringCast<UTF8CHAR>(*Text, Text.Len());
+	return FBase64::Encode((const uint8*)Utf8.Get(), (uint32)Utf8.Length());
+}
+
+FString FUAL_PythonRuntime::ToPyLiteral(const FString& Text)
+{
+	FString Escaped = Text.Replace(TEXT("\\"), TEXT("\\\\"));
+	Escaped.ReplaceInline(TEXT("'"), TEXT("\\'"));
+	Escaped.ReplaceInline(TEXT("\n"), TEXT("\\n"));
+	Escaped.ReplaceInline(TEXT("\r"), TEXT("\\r"));
+	return FString::Printf(TEXT("'%s'"), *Escaped);
+}
+
+bool FUAL_PythonRuntime::EnsureInstalled(FString& OutError)
+{
+	if (bInstalled)
+	{
+		return true;
+	}
+
+#if defined(WITH_PYTHON) && WITH_PYTHON
+	if (!IsAvailable())
+	{
+		OutError = TEXT("Python is not available");
+		return false;
+	}
+
+	FPythonCommandEx PythonCommand;
+	PythonCommand.Command = UALPythonRuntimeSource;
+	PythonCommand.ExecutionMode = EPythonCommandExecutionMode::ExecuteFile;
+	PythonCommand.FileExecutionScope = EPythonFileExecutionScope::Private;
+	if (!IPythonScriptPlugin::Get()->ExecPythonCommandEx(PythonCommand))
+	{
+		OutError = FString::Printf(TEXT("Failed to install Python runtime: %s"), *PythonCommand.CommandResult);
+		return false;
+	}
+
+	bInstalled = true;
+	KnownHashes.Reset();
+	RegisteredModules.Reset();
+	UE_LOG(LogUALPython, Log, TEXT("Python runtime installed"));
+	return true;
+#else
+	OutError = TEXT("WITH_PYTHON is not enabled");
+	return false;
+#endif
+}
+
+bool FUAL_PythonRuntime::Evaluate(const FString& Statement, FUAL_PythonCallResult& OutResult)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		OutResult.TotalMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	};
+
+	if (!EnsureInstalled(OutResult.Error))
+	{
+		return false;
+	}
+
+#if defined(WITH_PYTHON) && WITH_PYTHON
+	FPythonCommandEx PythonCommand;
+	PythonCommand.Command = Statement;
+	PythonCommand.ExecutionMode = EPythonCommandExecutionMode::EvaluateStatement;
+	bool bExecuted = IPythonScriptPlugin::Get()->ExecPythonCommandEx(PythonCommand);
+
+	// 运行时模块丢失（解释器被重置）时重新安装一次
+	if (!bExecuted && PythonCommand.CommandResult.Contains(TEXT("_ual_runtime")))
+	{
+		bInstalled = false;
+		if (!EnsureInstalled(OutResult.Error))
+		{
+			return false;
+		}
+		PythonCommand.CommandResult.Reset();
+		PythonCommand.LogOutput.Reset();
+		bExecuted = IPythonScriptPlugin::Get()->ExecPythonCommandEx(PythonCommand);
+	}
+
+	for (const FPythonLogOutputEntry& Entry : PythonCommand.LogOutput)
+	{
+		TSharedPtr<FJsonObject> LogEntry = MakeShared<FJsonObject>();
+		LogEntry->SetStringField(TEXT("type"), LexToString(Entry.Type));
+		LogEntry->SetStringField(TEXT("message"), Entry.Output);
+		OutResult.Logs.Add(MakeShared<FJsonValueObject>(LogEntry));
+	}
+
+	if (!bExecuted)
+	{
+		OutResult.Error = PythonCommand.CommandResult;
+		return false;
+	}
+
+	// 求值结果为 str 的 repr：'<base64>'
+	FString Encoded = PythonCommand.CommandResult.TrimStartAndEnd();
+	Encoded.TrimCharInline(TEXT('\''), nullptr);
+
+	TArray<uint8> Bytes;
+	TSharedPtr<FJsonObject> Data;
+	if (FBase64::Decode(Encoded, Bytes))
+	{
+		const auto Json = StringCast<TCHAR>((const UTF8CHAR*)Bytes.GetData(), Bytes.Num());
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Json.Length(), Json.Get()));
+		FJsonSerializer::Deserialize(Reader, Data);
+	}
+	if (!Data.IsValid())
+	{
+		OutResult.Error = FString::Printf(TEXT("Invalid runtime response: %s"), *PythonCommand.CommandResult.Left(256));
+		return false;
+	}
+
+	OutResult.Data = Data;
+	OutResult.bSuccess = Data->GetBoolField(TEXT("ok"));
+	return true;
+#else
+	OutResult.Error = TEXT("WITH_PYTHON is not enabled");
+	return false;
+#endif
+}
+
+FUAL_PythonCallResult FUAL_PythonRuntime::RunCached(const FString& Function, const FString& Target, const FString& Source)
+{
+	FUAL_PythonCallResult Result;
+
+	const FString Key = HashSource(Source);
+	bool bSendSource = !KnownHashes.Contains(Key);
+	for (int32 Attempt = 0; Attempt < 2; ++Attempt)
+	{
+		const FString Statement = FString::Printf(TEXT("__import__('_ual_runtime').%s(%s, '%s', '%s')"),
+			*Function, *ToPyLiteral(Target), *Key, bSendSource ? *ToBase64(Source) : TEXT(""));
+		if (!Evaluate(Statement, Result))
+		{
+			return Result;
+		}
+
+		// Python 侧缓存已淘汰：补传源码重试
+		if (!bSendSource && Result.Data->HasField(TEXT("missing")))
+		{
+			KnownHashes.Remove(Key);
+			bSendSource = true;
+			Result.Logs.Reset();
+			continue;
+		}
+		break;
+	}
+
+	// 编译成功（有 cache_hit 字段）才记为已知，语法错误的脚本下次仍携带源码
+	if (Result.Data.IsValid() && Result.Data->HasField(TEXT("cache_hit")))
+	{
+		if (KnownHashes.Num() >= UALMaxKnownHashes)
+		{
+			KnownHashes.Reset();
+		}
+		KnownHashes.Add(Key);
+	}
+	Result.Data->SetStringField(TEXT("script_hash"), Key);
+	return Result;
+}
+
+FUAL_PythonCallResult FUAL_PythonRuntime::Run(const FString& Session, const FString& Source)
+{
+	return RunCached(TEXT("run"), Session, Source);
+}
+
+FUAL_PythonCallResult FUAL_PythonRuntime::RegisterModule(const FString& ModuleName, const FString& Source)
+{
+	const FString* Registered = RegisteredModules.Find(ModuleName);
+	if (bInstalled && Registered && *Registered == HashSource(Source))
+	{
+		FUAL_PythonCallResult Result;
+		Result.bSuccess = true;
+		Result.Data = MakeShared<FJsonObject>();
+		Result.Data->SetBoolField(TEXT("ok"), true);
+		Result.Data->SetBoolField(TEXT("unchanged"), true);
+		Result.Data->SetStringField(TEXT("script_hash"), *Registered);
+		return Result;
+	}
+
+	FUAL_PythonCallResult Result = RunCached(TEXT("register_module"), ModuleName, Source);
+	if (Result.bSuccess)
+	{
+		RegisteredModules.Add(ModuleName, Result.Data->GetStringField(TEXT("script_hash")));
+	}
+	return Result;
+}
+
+FUAL_PythonCallResult FUAL_PythonRuntime::Call(const FString& Session, const FString& Function, const TSharedPtr<FJsonValue>& Args)
+{
+	// 参数包在单元素数组中序列化，Python 侧取 [0]，可承载任意 JSON 值
+	FString ArgsBase64;
+	if (Args.IsValid() && Args->Type != EJson::Null)
+	{
+		FString ArgsJson;
+		TArray<TSharedPtr<FJsonValue>> Wrapped;
+		Wrapped.Add(Args);
+		const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ArgsJson);
+		FJsonSerializer::Serialize(Wrapped, Writer);
+		ArgsBase64 = ToBase64(ArgsJson);
+	}
+
+	FUAL_PythonCallResult Result;
+	Evaluate(FString::Printf(TEXT("__import__('_ual_runtime').call(%s, %s, '%s')"),
+		*ToPyLiteral(Session), *ToPyLiteral(Function), *ArgsBase64), Result);
+	return Result;
+}
+
+FUAL_PythonCallResult FUAL_PythonRuntime::ResetSession(const FString& Session)
+{
+	FUAL_PythonCallResult Result;
+	Evaluate(FString::Printf(TEXT("__import__('_ual_runtime').reset_session(%s)"), *ToPyLiteral(Session)), Result);
+	return Result;
+}
+
+FUAL_PythonCallResult FUAL_PythonRuntime::GetStats()
+{
+	FUAL_PythonCallResult Result;
+	Evaluate(TEXT("__import__('_ual_runtime').stats()"), Result);
+	return Result;
+}
+
+void FUAL_PythonRuntime::Shutdown()
+{
+	bInstalled = false;
+	KnownHashes.Empty();
+	RegisteredModules.Empty();
+}
@@ -0,0 +1,492 @@
+#include "UAL_ResponseCache.h"
+#include "UAL_AdmissionController.h"
+#include "UAL_CommandUtils.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Editor.h"
+#include "Selection.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Interfaces/IPluginManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALResponseCache, Log, All);
+
+static TAutoConsoleVariable<int32> CVarResponseCache(
+	TEXT("ual.ResponseCache"),
+	1,
+	TEXT("Serve repeated read-only queries (project.info, *.describe, ...) from the response cache"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarResponseCacheMaxEntries(
+	TEXT("ual.ResponseCacheMaxEntries"),
+	256,
+	TEXT("Maximum number of cached responses; the least recently used entry is evicted first"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarResponseCacheMaxEntryKB(
+	TEXT("ual.ResponseCacheMaxEntryKB"),
+	512,
+	TEXT("Responses larger than this (serialized, in KB) are not cached"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarResponseCacheMaxAgeSec(
+	TEXT("ual.ResponseCacheMaxAgeSec"),
+	300.0f,
+	TEXT("Upper bound in seconds on how long any cached response is served, even without invalidating events"),
+	ECVF_Default);
+
+namespace
+{
+	// 缓存未命中后等待回复的最长时间，超时视为处理器未回复（或异步回复过慢）
+	constexpr double UALPendingCaptureTimeoutSec = 60.0;
+}
+
+FUAL_ResponseCache& FUAL_ResponseCache::Get()
+{
+	static FUAL_ResponseCache Instance;
+	return Instance;
+}
+
+const FUAL_ResponseCache::FMethodPolicy* FUAL_ResponseCache::FindPolicy(const FString& Method)
+{
+	static const TMap<FString, FMethodPolicy> Policies = []()
+	{
+		TMap<FString, FMethodPolicy> Map;
+		// 项目信息：遍历插件与配置，随插件挂载 / 设置修改 / 修改类命令变化；结果含当前关卡，地图切换也失效
+		Map.Add(TEXT("project.info"), { (uint8)(Scope_Project | Scope_Map), 60.0f });
+		Map.Add(TEXT("editor.get_project_info"), { (uint8)(Scope_Project | Scope_Map), 60.0f });
+		Map.Add(TEXT("system.get_project_info"), { (uint8)(Scope_Project | Scope_Map), 60.0f });
+		// 配置：手动改 ini 文件没有事件可监听，TTL 很短
+		Map.Add(TEXT("project.get_config"), { Scope_Project, 5.0f });
+		Map.Add(TEXT("project.analyze_uproject"), { Scope_Project, 60.0f });
+		// 编辑器焦点：标签页切换没有事件可监听，TTL 很短，只用于合并连续的重复查询
+		Map.Add(TEXT("editor.get_focus_context"), { (uint8)(Scope_Focus | Scope_Map | Scope_Assets), 2.0f });
+		// 资产描述：随资产保存 / 修改失效
+		Map.Add(TEXT("content.describe"), { Scope_Assets, 0.0f });
+		Map.Add(TEXT("blueprint.describe"), { Scope_Assets, 0.0f });
+		Map.Add(TEXT("blueprint.list_graphs"), { Scope_Assets, 0.0f });
+		Map.Add(TEXT("blueprint.get_graph"), { Scope_Assets, 0.0f });
+		Map.Add(TEXT("material.describe"), { Scope_Assets, 0.0f });
+		Map.Add(TEXT("material.get_graph"), { Scope_Assets, 0.0f });
+		Map.Add(TEXT("niagara.describe_system"), { Scope_Assets, 0.0f });
+		Map.Add(TEXT("widget.get_hierarchy"), { Scope_Assets, 0.0f });
+		return Map;
+	}();
+	return Policies.Find(Method);
+}
+
+// ============================================================================
+// 规范化参数
+// ============================================================================
+
+void FUAL_ResponseCache::AppendCanonicalJson(const TSharedPtr<FJsonValue>& Value, FString& Out)
+{
+	if (!Value.IsValid())
+	{
+		Out += TEXT("null");
+		return;
+	}
+
+	switch (Value->Type)
+	{
+	case EJson::String:
+	{
+		Out += TEXT('"');
+		for (const TCHAR Ch : Value->AsString())
+		{
+			if (Ch == TEXT('"') || Ch == TEXT('\\'))
+			{
+				Out += TEXT('\\');
+			}
+			Out += Ch;
+		}
+		Out += TEXT('"');
+		break;
+	}
+	case EJson::Number:
+		Out += FString::Printf(TEXT("%.17g"), Value->AsNumber());
+		break;
+	case EJson::Boolean:
+		Out += Value->AsBool() ? TEXT("true") : TEXT("false");
+		break;
+	case EJson::Array:
+	{
+		Out += TEXT('[');
+		bool bFirst = true;
+		for (const TSharedPtr<FJsonValue>& Item : Value->AsArray())
+		{
+			if (!bFirst)
+			{
+				Out += TEXT(',');
+			}
+			bFirst = false;
+			AppendCanonicalJson(Item, Out);
+		}
+		Out += TEXT(']');
+		break;
+	}
+	case EJson::Object:
+	{
+		const TSharedPtr<FJsonObject> Obj = Value->AsObject();
+		TArray<FString> Keys;
+		if (Obj.IsValid())
+		{
+			Obj->Values.GetKeys(Keys);
+		}
+		Keys.Sort();
+
+		Out += TEXT('{');
+		bool bFirst = true;
+		for (const FString& Key : Keys)
+		{
+			if (!bFirst)
+			{
+				Out += TEXT(',');
+			}
+			bFirst = false;
+			AppendCanonicalJson(MakeShared<FJsonValueString>(Key), Out);
+			Out += TEXT(':');
+			AppendCanonicalJson(Obj->Values[Key], Out);
+		}
+		Out += TEXT('}');
+		break;
+	}
+	default:
+		Out += TEXT("null");
+		break;
+	}
+}
+
+// ============================================================================
+// 失效
+// ============================================================================
+
+void FUAL_ResponseCache::EnsureBound()
+{
+	if (bBound)
+	{
+		return;
+	}
+	bBound = true;
+
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FUAL_ResponseCache::OnPackageSaved);
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FUAL_ResponseCache::OnObjectModified);
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FUAL_ResponseCache::OnObjectPropertyChanged);
+	MapChangeHandle = FEditorDelegates::MapChange.AddRaw(this, &FUAL_ResponseCache::OnMapChanged);
+	SelectionChangedHandle = USelection::SelectionChangedEvent.AddRaw(this, &FUAL_ResponseCache::OnSelectionChanged);
+	SelectObjectHandle = USelection::SelectObjectEvent.AddRaw(this, &FUAL_ResponseCache::OnSelectionChanged);
+	PluginMountedHandle = IPluginManager::Get().OnNewPluginMounted().AddRaw(this, &FUAL_ResponseCache::OnPluginMounted);
+
+	if (GEditor)
+	{
+		if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+		{
+			AssetEditorOpenedHandle = AssetEditorSubsystem->OnAssetEditorOpened().AddRaw(this, &FUAL_ResponseCache::OnAssetEditorOpened);
+		}
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddLambda([this](const FAssetData&) { Invalidate(Scope_Assets); });
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddLambda([this](const FAssetData&) { Invalidate(Scope_Assets); });
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddLambda([this](const FAssetData&, const FString&) { Invalidate(Scope_Assets); });
+}
+
+void FUAL_ResponseCache::Invalidate(uint8 Scopes)
+{
+	for (int32 Index = 0; Index < NumScopes; ++Index)
+	{
+		if (Scopes & (1 << Index))
+		{
+			++ScopeGenerations[Index];
+			++ScopeInvalidations[Index];
+		}
+	}
+}
+
+void FUAL_ResponseCache::SnapshotGenerations(uint32* OutGenerations) const
+{
+	for (int32 Index = 0; Index < NumScopes; ++Index)
+	{
+		OutGenerations[Index] = ScopeGenerations[Index];
+	}
+}
+
+bool FUAL_ResponseCache::IsCurrent(uint8 Scopes, const uint32* Generations) const
+{
+	for (int32 Index = 0; Index < NumScopes; ++Index)
+	{
+		if ((Scopes & (1 << Index)) && Generations[Index] != ScopeGenerations[Index])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FUAL_ResponseCache::OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	Invalidate(Scope_Assets);
+}
+
+void FUAL_ResponseCache::OnMapChanged(uint32 MapChangeFlags)
+{
+	Invalidate(Scope_Map | Scope_Focus);
+}
+
+void FUAL_ResponseCache::OnSelectionChanged(UObject* Object)
+{
+	Invalidate(Scope_Focus);
+}
+
+void FUAL_ResponseCache::OnAssetEditorOpened(UObject* Asset)
+{
+	Invalidate(Scope_Focus);
+}
+
+void FUAL_ResponseCache::OnObjectModified(UObject* Object)
+{
+	Invalidate(Scope_Assets);
+}
+
+void FUAL_ResponseCache::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	// 项目设置界面修改的是设置类的 CDO，随后写回 ini
+	if (Object && Object->HasAnyFlags(RF_ClassDefaultObject))
+	{
+		Invalidate(Scope_Project | Scope_Assets);
+		return;
+	}
+	Invalidate(Scope_Assets);
+}
+
+void FUAL_ResponseCache::OnPluginMounted(IPlugin& Plugin)
+{
+	Invalidate(Scope_Project);
+}
+
+// ============================================================================
+// 查找与存储
+// ============================================================================
+
+void FUAL_ResponseCache::Execute(const FString& Method, const TSharedPtr<FJsonObject>& Params, const FString& RequestId, TFunctionRef<void()> Invoke)
+{
+	const FMethodPolicy* Policy = CVarResponseCache.GetValueOnGameThread() != 0 ? FindPolicy(Method) : nullptr;
+	if (!Policy)
+	{
+		Invoke();
+		// 修改类命令可能改变任何已缓存的结果；异步完成的修改另由编辑器事件失效
+		if (!FUAL_AdmissionController::Get().IsReadOnlyMethod(Method))
+		{
+			Invalidate(Scope_All);
+		}
+		return;
+	}
+
+	EnsureBound();
+
+	FString Key = Method;
+	Key += TEXT('|');
+	AppendCanonicalJson(MakeShared<FJsonValueObject>(Params), Key);
+
+	FMethodStats& Stats = MethodStats.FindOrAdd(Method);
+	const double Now = FPlatformTime::Seconds();
+
+	if (FEntry* Entry = Entries.Find(Key))
+	{
+		if (Now < Entry->ExpireTime && IsCurrent(Entry->Scopes, Entry->Generations))
+		{
+			++Hits;
+			++Stats.Hits;
+			++Entry->Hits;
+			Entry->LastUsedTime = Now;
+			UAL_CommandUtils::SendRawResponse(RequestId, 200, Entry->ResultJson);
+			return;
+		}
+		CachedBytes -= Entry->ResultJson.Len() * sizeof(TCHAR);
+		Entries.Remove(Key);
+		++StaleDrops;
+	}
+
+	++Misses;
+	++Stats.Misses;
+
+	if (!RequestId.IsEmpty())
+	{
+		// 清理长时间未回复的等待项
+		if (PendingCaptures.Num() > 64)
+		{
+			for (auto It = PendingCaptures.CreateIterator(); It; ++It)
+			{
+				if (Now - It.Value().StartTime > UALPendingCaptureTimeoutSec)
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+
+		FPendingCapture& Pending = PendingCaptures.Add(RequestId);
+		Pending.Key = MoveTemp(Key);
+		Pending.Method = Method;
+		Pending.Scopes = Policy->Scopes;
+		Pending.TtlSec = Policy->TtlSec;
+		Pending.StartTime = Now;
+		SnapshotGenerations(Pending.Generations);
+	}
+
+	Invoke();
+}
+
+void FUAL_ResponseCache::Capture(const FString& RequestId, int32 Code, const TSharedPtr<FJsonObject>& Data)
+{
+	FPendingCapture Pending;
+	if (!PendingCaptures.RemoveAndCopyValue(RequestId, Pending))
+	{
+		return;
+	}
+	if (Code != 200 || !Data.IsValid())
+	{
+		return;
+	}
+	// 处理期间状态已变化：结果可能基于旧状态，不存入
+	if (!IsCurrent(Pending.Scopes, Pending.Generations))
+	{
+		++StaleDrops;
+		return;
+	}
+
+	FString ResultJson;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ResultJson);
+	FJsonSerializer::Serialize(Data.ToSharedRef(), Writer);
+
+	if (ResultJson.Len() * sizeof(TCHAR) > (SIZE_T)FMath::Max(0, CVarResponseCacheMaxEntryKB.GetValueOnGameThread()) * 1024)
+	{
+		return;
+	}
+	Store(MoveTemp(Pending), MoveTemp(ResultJson));
+}
+
+void FUAL_ResponseCache::Store(FPendingCapture&& Pending, FString&& ResultJson)
+{
+	const int32 MaxEntries = FMath::Max(1, CVarResponseCacheMaxEntries.GetValueOnGameThread());
+	while (Entries.Num() >= MaxEntries)
+	{
+		// 淘汰最久未使用的条目（条目数有限，线性扫描即可）
+		const FString* OldestKey = nullptr;
+		double OldestTime = TNumericLimits<double>::Max();
+		for (const TPair<FString, FEntry>& Pair : Entries)
+		{
+			if (Pair.Value.LastUsedTime < OldestTime)
+			{
+				OldestTime = Pair.Value.LastUsedTime;
+				OldestKey = &Pair.Key;
+			}
+		}
+		const FString KeyToRemove = *OldestKey;
+		CachedBytes -= Entries[KeyToRemove].ResultJson.Len() * sizeof(TCHAR);
+		Entries.Remove(KeyToRemove);
+		++Evictions;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const float MaxAge = FMath::Max(0.0f, CVarResponseCacheMaxAgeSec.GetValueOnGameThread());
+	const float Ttl = Pending.TtlSec > 0.0f ? FMath::Min(Pending.TtlSec, MaxAge) : MaxAge;
+
+	FEntry& Entry = Entries.Add(Pending.Key);
+	Entry.Method = MoveTemp(Pending.Method);
+	Entry.ResultJson = MoveTemp(ResultJson);
+	Entry.Scopes = Pending.Scopes;
+	FMemory::Memcpy(Entry.Generations, Pending.Generations, sizeof(Entry.Generations));
+	Entry.StoreTime = Now;
+	Entry.ExpireTime = Now + Ttl;
+	Entry.LastUsedTime = Now;
+	CachedBytes += Entry.ResultJson.Len() * sizeof(TCHAR);
+	++Stores;
+
+	UE_LOG(LogUALResponseCache, Verbose, TEXT("Cached %s (%d chars, ttl %.0f s)"), *Entry.Method, Entry.ResultJson.Len(), Ttl);
+}
+
+// ============================================================================
+// 统计与清理
+// ============================================================================
+
+TSharedPtr<FJsonObject> FUAL_ResponseCache::GetStats() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField(TEXT("enabled"), CVarResponseCache.GetValueOnGameThread() != 0);
+	Obj->SetNumberField(TEXT("entries"), Entries.Num());
+	Obj->SetNumberField(TEXT("bytes"), (double)CachedBytes);
+	Obj->SetNumberField(TEXT("hits"), (double)Hits);
+	Obj->SetNumberField(TEXT("misses"), (double)Misses);
+	Obj->SetNumberField(TEXT("hit_rate"), Hits + Misses > 0 ? (double)Hits / (Hits + Misses) : 0.0);
+	Obj->SetNumberField(TEXT("stores"), (double)Stores);
+	Obj->SetNumberField(TEXT("evictions"), (double)Evictions);
+	Obj->SetNumberField(TEXT("stale_drops"), (double)StaleDrops);
+
+	static const TCHAR* const ScopeNames[NumScopes] = { TEXT("project"), TEXT("map"), TEXT("focus"), TEXT("assets") };
+	TSharedPtr<FJsonObject> Invalidations = MakeShared<FJsonObject>();
+	for (int32 Index = 0; Index < NumScopes; ++Index)
+	{
+		Invalidations->SetNumberField(ScopeNames[Index], (double)ScopeInvalidations[Index]);
+	}
+	Obj->SetObjectField(TEXT("invalidations"), Invalidations);
+
+	TSharedPtr<FJsonObject> Methods = MakeShared<FJsonObject>();
+	for (const TPair<FString, FMethodStats>& Pair : MethodStats)
+	{
+		const int64 Total = Pair.Value.Hits + Pair.Value.Misses;
+		TSharedPtr<FJsonObject> MethodObj = MakeShared<FJsonObject>();
+		MethodObj->SetNumberField(TEXT("hits"), (double)Pair.Value.Hits);
+		MethodObj->SetNumberField(TEXT("misses"), (double)Pair.Value.Misses);
+		MethodObj->SetNumberField(TEXT("hit_rate"), Total > 0 ? (double)Pair.Value.Hits / Total : 0.0);
+		Methods->SetObjectField(Pair.Key, MethodObj);
+	}
+	Obj->SetObjectField(TEXT("methods"), Methods);
+	return Obj;
+}
+
+void FUAL_ResponseCache::Clear()
+{
+	Entries.Empty();
+	PendingCaptures.Empty();
+	CachedBytes = 0;
+}
+
+void FUAL_ResponseCache::Shutdown()
+{
+	if (bBound)
+	{
+		UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+		FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+		FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+		FEditorDelegates::MapChange.Remove(MapChangeHandle);
+		USelection::SelectionChangedEvent.Remove(SelectionChangedHandle);
+		USelection::SelectObjectEvent.Remove(SelectObjectHandle);
+		IPluginManager::Get().OnNewPluginMounted().Remove(PluginMountedHandle);
+
+		if (GEditor)
+		{
+			if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+			{
+				AssetEditorSubsystem->OnAssetEditorOpened().Remove(AssetEditorOpenedHandle);
+			}
+		}
+
+		if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+		{
+			IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+			AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+			AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+			AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+		}
+		bBound = false;
+	}
+
+	Clear();
+	MethodStats.Empty();
+}
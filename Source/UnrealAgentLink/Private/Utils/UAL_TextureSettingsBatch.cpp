@@ -0,0 +1,211 @@
+#include "UAL_TextureSettingsBatch.h"
+#include "UAL_CommandUtils.h"
+
+#include "Engine/Texture.h"
+#include "TextureCompiler.h"
+#include "DerivedDataCacheInterface.h"
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+#include "DerivedDataCacheUsageStats.h"
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALTextureBatch, Log, All);
+
+FUAL_TextureSettingsBatch& FUAL_TextureSettingsBatch::Get()
+{
+	static FUAL_TextureSettingsBatch Instance;
+	return Instance;
+}
+
+bool FUAL_TextureSettingsBatch::ApplySettings(UTexture* Texture, const FUAL_TextureSettingsRequest& Request, bool bFirstEdit)
+{
+	const bool bSRGBChanged = Request.bSRGB.IsSet() && Texture->SRGB != Request.bSRGB.GetValue();
+	const bool bCompressionChanged = Request.Compression.IsSet() && Texture->CompressionSettings != Request.Compression.GetValue();
+	const bool bLODGroupChanged = Request.LODGroup.IsSet() && Texture->LODGroup != Request.LODGroup.GetValue();
+	if (!bSRGBChanged && !bCompressionChanged && !bLODGroupChanged)
+	{
+		return false;
+	}
+
+	// 只写属性，PostEditChange 在全部属性写完后每张纹理调用一次；
+	// 同一纹理的后续请求不再调用 PreEditChange，保持与 PostEditChange 配对
+	if (bFirstEdit)
+	{
+		Texture->Modify();
+		Texture->PreEditChange(nullptr);
+	}
+	if (bSRGBChanged)
+	{
+		Texture->SRGB = Request.bSRGB.GetValue();
+	}
+	if (bCompressionChanged)
+	{
+		Texture->CompressionSettings = Request.Compression.GetValue();
+	}
+	if (bLODGroupChanged)
+	{
+		Texture->LODGroup = Request.LODGroup.GetValue();
+	}
+	return true;
+}
+
+FUAL_TextureSettingsBatch::FDDCCounters FUAL_TextureSettingsBatch::GatherDDCCounters()
+{
+	FDDCCounters Counters;
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+	// 资源统计按资产类型汇总：Load 为从 DDC 取回（命中），Build 为重新构建（未命中）
+	TArray<FDerivedDataCacheResourceStat> Stats;
+	GetDerivedDataCacheRef().GatherResourceStats(Stats);
+	for (const FDerivedDataCacheResourceStat& Stat : Stats)
+	{
+		if (Stat.AssetType.Contains(TEXT("Texture")))
+		{
+			Counters.Hits += Stat.LoadCount;
+			Counters.Misses += Stat.BuildCount;
+		}
+	}
+	Counters.bAvailable = true;
+#endif
+	return Counters;
+}
+
+FUAL_TextureSettingsBatch::FSubmitResult FUAL_TextureSettingsBatch::Submit(const TArray<FUAL_TextureSettingsRequest>& Requests)
+{
+	FSubmitResult Result;
+	Result.Total = Requests.Num();
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// 1. 一次性写入全部属性，同一纹理的多项修改合并为一次重建
+	TArray<UTexture*> Changed;
+	Changed.Reserve(Requests.Num());
+	for (const FUAL_TextureSettingsRequest& Request : Requests)
+	{
+		UTexture* Texture = Request.Texture.Get();
+		if (!Texture)
+		{
+			++Result.Invalid;
+			continue;
+		}
+		const bool bFirstEdit = !Changed.Contains(Texture);
+		if (ApplySettings(Texture, Request, bFirstEdit))
+		{
+			if (bFirstEdit)
+			{
+				Changed.Add(Texture);
+			}
+		}
+		else
+		{
+			++Result.Unchanged;
+		}
+	}
+	Result.Changed = Changed.Num();
+
+	if (Changed.Num() == 0)
+	{
+		return Result;
+	}
+
+	// 2. 集中提交构建：PostEditChange 重建资源并通知引用它的材质刷新采样器类型；
+	//    启用异步纹理编译时重建只排队，构建在线程池并行执行
+	const FDDCCounters DDCBefore = GatherDDCCounters();
+	Result.bAsyncCompilation = FTextureCompilingManager::Get().IsAsyncCompilationAllowed(Changed[0]);
+
+	FJob& Job = Jobs.AddDefaulted_GetRef();
+	Job.JobId = FString::Printf(TEXT("texbuild_%d"), NextJobSerial++);
+	Job.StartTime = StartTime;
+	Job.DDCBefore = DDCBefore;
+	Job.Building.Reserve(Changed.Num());
+	for (UTexture* Texture : Changed)
+	{
+		Texture->PostEditChange();
+		Texture->MarkPackageDirty();
+		Job.Building.Add(Texture);
+	}
+	Job.SubmitMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	Result.JobId = Job.JobId;
+
+	UE_LOG(LogUALTextureBatch, Log, TEXT("Texture settings batch %s: %d changed, %d unchanged, %d invalid (submit %.1f ms, async=%d)"),
+		*Job.JobId, Result.Changed, Result.Unchanged, Result.Invalid, Job.SubmitMs, Result.bAsyncCompilation ? 1 : 0);
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_TextureSettingsBatch::Tick), 0.1f);
+	}
+	return Result;
+}
+
+bool FUAL_TextureSettingsBatch::Tick(float DeltaTime)
+{
+	for (int32 Index = 0; Index < Jobs.Num(); ++Index)
+	{
+		FJob& Job = Jobs[Index];
+
+		Job.Completed = 0;
+		for (const TWeakObjectPtr<UTexture>& Texture : Job.Building)
+		{
+			if (!Texture.IsValid() || !Texture->IsCompiling())
+			{
+				++Job.Completed;
+			}
+		}
+
+		if (Job.Completed != Job.LastReported)
+		{
+			Job.LastReported = Job.Completed;
+
+			TSharedPtr<FJsonObject> Progress = MakeShared<FJsonObject>();
+			Progress->SetStringField(TEXT("job_id"), Job.JobId);
+			Progress->SetNumberField(TEXT("total"), Job.Building.Num());
+			Progress->SetNumberField(TEXT("completed"), Job.Completed);
+			Progress->SetNumberField(TEXT("remaining_textures"), FTextureCompilingManager::Get().GetNumRemainingTextures());
+			Progress->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - Job.StartTime) * 1000.0);
+			UAL_CommandUtils::SendEvent(TEXT("content.texture_build_progress"), Progress);
+		}
+
+		if (Job.Completed < Job.Building.Num())
+		{
+			continue;
+		}
+
+		// 同时进行的其它纹理构建也会计入 DDC 计数，多批次重叠时为近似值
+		const FDDCCounters DDCAfter = GatherDDCCounters();
+		const double BuildMs = (FPlatformTime::Seconds() - Job.StartTime) * 1000.0;
+
+		TSharedPtr<FJsonObject> CompletedEvent = MakeShared<FJsonObject>();
+		CompletedEvent->SetStringField(TEXT("job_id"), Job.JobId);
+		CompletedEvent->SetNumberField(TEXT("textures"), Job.Building.Num());
+		CompletedEvent->SetNumberField(TEXT("build_ms"), BuildMs);
+		CompletedEvent->SetNumberField(TEXT("submit_ms"), Job.SubmitMs);
+		CompletedEvent->SetBoolField(TEXT("ddc_stats_available"), DDCAfter.bAvailable);
+		if (DDCAfter.bAvailable)
+		{
+			CompletedEvent->SetNumberField(TEXT("ddc_hits"), DDCAfter.Hits - Job.DDCBefore.Hits);
+			CompletedEvent->SetNumberField(TEXT("ddc_misses"), DDCAfter.Misses - Job.DDCBefore.Misses);
+		}
+		UAL_CommandUtils::SendEvent(TEXT("content.texture_build_completed"), CompletedEvent);
+
+		UE_LOG(LogUALTextureBatch, Log, TEXT("Texture settings batch %s finished: %d textures in %.0f ms (DDC hits %lld, misses %lld)"),
+			*Job.JobId, Job.Building.Num(), BuildMs,
+			DDCAfter.Hits - Job.DDCBefore.Hits, DDCAfter.Misses - Job.DDCBefore.Misses);
+
+		Jobs.RemoveAt(Index--);
+	}
+
+	if (Jobs.Num() == 0)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FUAL_TextureSettingsBatch::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		UAL_CORE_TICKER.RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	Jobs.Empty();
+}
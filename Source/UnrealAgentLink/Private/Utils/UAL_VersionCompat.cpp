@@ -1,6 +1,8 @@
 #include "UAL_VersionCompat.h"
 
 #include "Modules/ModuleManager.h"
+#include "RHICommandList.h"
+#include "RHIGPUReadback.h"
 
 namespace UALCompat
 {
@@ -9,6 +11,11 @@ namespace UALCompat
 	 * 兼容 UE 5.0-5.7：统一使用 GetCompressed(Quality) 返回值
 	 */
 	bool GetCompressedPNG(const TSharedPtr<IImageWrapper>& Wrapper, int32 Quality, TArray<uint8>& OutData)
+	{
+		return GetCompressedImage(Wrapper, Quality, OutData);
+	}
+
+	bool GetCompressedImage(const TSharedPtr<IImageWrapper>& Wrapper, int32 Quality, TArray<uint8>& OutData)
 	{
 		if (!Wrapper.IsValid())
 		{
@@ -21,5 +28,17 @@ namespace UALCompat
 		OutData.Append(CompressedRef.GetData(), CompressedRef.Num());
 		return OutData.Num() > 0;
 	}
-}
 
+	void* LockTextureReadback(FRHIGPUTextureReadback& Readback, int32& OutRowPitchInPixels)
+	{
+		check(IsInRenderingThread());
+		OutRowPitchInPixels = 0;
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+		return Readback.Lock(OutRowPitchInPixels);
+#else
+		void* Data = nullptr;
+		Readback.LockTexture(FRHICommandListExecutor::GetImmediateCommandList(), Data, OutRowPitchInPixels);
+		return Data;
+#endif
+	}
+}
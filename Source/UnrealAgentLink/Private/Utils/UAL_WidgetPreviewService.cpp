@@ -0,0 +1,587 @@
+#include "UAL_WidgetPreviewService.h"
+#include "UAL_BlueprintCompileScheduler.h"
+#include "UAL_VersionCompat.h"
+#include "UAL_BulkChannel.h"
+
+#include "Editor.h"
+#include "WidgetBlueprint.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/Widget.h"
+#include "Slate/WidgetRenderer.h"
+#include "Layout/ArrangedChildren.h"
+#include "Layout/Geometry.h"
+#include "Widgets/SWidget.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Async/Async.h"
+#include "RHI.h"
+#include "RHIGPUReadback.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogUALWidgetPreview, Log, All);
+
+static TAutoConsoleVariable<int32> CVarWidgetPreviewPerTick(
+	TEXT("ual.WidgetPreviewPerTick"),
+	4,
+	TEXT("widget.preview 每帧最多实例化并绘制的 Widget 数量"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarWidgetPreviewPoolSize(
+	TEXT("ual.WidgetPreviewPoolSize"),
+	8,
+	TEXT("widget.preview 空闲 RenderTarget 池的最大数量（所有尺寸合计）"),
+	ECVF_Default);
+
+namespace
+{
+	constexpr int32 UALMaxLayoutDepth = 64;
+
+	void AppendArrangedLayout(
+		const TSharedRef<SWidget>& SlateWidget,
+		const FGeometry& Geometry,
+		int32 Depth,
+		const TMap<const SWidget*, UWidget*>& SlateToWidget,
+		TArray<TSharedPtr<FJsonValue>>& OutEntries)
+	{
+		if (Depth > UALMaxLayoutDepth)
+		{
+			return;
+		}
+
+		int32 ChildDepth = Depth;
+		if (UWidget* const* Found = SlateToWidget.Find(&SlateWidget.Get()))
+		{
+			const FVector2D Position = Geometry.GetAbsolutePosition();
+			const FVector2D Size = Geometry.GetLocalSize();
+
+			TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetStringField(TEXT("name"), (*Found)->GetName());
+			Entry->SetStringField(TEXT("class"), (*Found)->GetClass()->GetName());
+			Entry->SetNumberField(TEXT("depth"), Depth);
+			Entry->SetNumberField(TEXT("x"), Position.X);
+			Entry->SetNumberField(TEXT("y"), Position.Y);
+			Entry->SetNumberField(TEXT("width"), Size.X);
+			Entry->SetNumberField(TEXT("height"), Size.Y);
+			Entry->SetBoolField(TEXT("is_visible"), (*Found)->IsVisible());
+			OutEntries.Add(MakeShared<FJsonValueObject>(Entry));
+			ChildDepth = Depth + 1;
+		}
+
+		FArrangedChildren ArrangedChildren(EVisibility::Visible);
+		SlateWidget->ArrangeChildren(Geometry, ArrangedChildren);
+		for (int32 Index = 0; Index < ArrangedChildren.Num(); ++Index)
+		{
+			const FArrangedWidget& Child = ArrangedChildren[Index];
+			AppendArrangedLayout(Child.Widget, Child.Geometry, ChildDepth, SlateToWidget, OutEntries);
+		}
+	}
+
+	TSharedPtr<FJsonObject> MakeErrorResult(const FString& AssetPath, const FString& Error)
+	{
+		TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetBoolField(TEXT("ok"), false);
+		Result->SetStringField(TEXT("asset"), AssetPath);
+		Result->SetStringField(TEXT("error"), Error);
+		return Result;
+	}
+}
+
+struct FUAL_WidgetPreviewService::FPreviewReadback
+{
+	// 仅在渲染线程创建、轮询与释放
+	TUniquePtr<FRHIGPUTextureReadback> Readback;
+	FIntPoint Size = FIntPoint::ZeroValue;
+	bool bSwapRedBlue = false;
+
+	// 渲染线程写入，bDone 置位后 GameThread 读取；回读失败时为空
+	TArray<FColor> Pixels;
+
+	// 已有尚未执行的轮询命令，避免每帧堆积
+	std::atomic<bool> bPollQueued{false};
+	std::atomic<bool> bDone{false};
+};
+
+FUAL_WidgetPreviewService& FUAL_WidgetPreviewService::Get()
+{
+	static FUAL_WidgetPreviewService Instance;
+	return Instance;
+}
+
+bool FUAL_WidgetPreviewService::CanRender()
+{
+	return FApp::CanEverRender() && !GUsingNullRHI;
+}
+
+void FUAL_WidgetPreviewService::Submit(TArray<FUAL_WidgetPreviewJob>&& Jobs, FOnBatchComplete OnComplete)
+{
+	if (Jobs.Num() == 0)
+	{
+		if (OnComplete)
+		{
+			OnComplete({});
+		}
+		return;
+	}
+
+	if (!ImageWrapperModule && CanRender())
+	{
+		// 模块加载必须在 GameThread 完成，编码线程只使用指针
+		ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+	}
+
+	TSharedPtr<FBatch> Batch = MakeShared<FBatch>();
+	Batch->Results.SetNum(Jobs.Num());
+	Batch->Remaining = Jobs.Num();
+	Batch->OnComplete = MoveTemp(OnComplete);
+
+	for (int32 Index = 0; Index < Jobs.Num(); ++Index)
+	{
+		FQueuedJob& Queued = Queue.AddDefaulted_GetRef();
+		Queued.Job = MoveTemp(Jobs[Index]);
+		Queued.Batch = Batch;
+		Queued.Index = Index;
+	}
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = UAL_CORE_TICKER.AddTicker(FTickerDelegateType::CreateRaw(this, &FUAL_WidgetPreviewService::Tick), 0.0f);
+	}
+}
+
+bool FUAL_WidgetPreviewService::Tick(float DeltaTime)
+{
+	ReadbackDrawn();
+	CompleteEncoded();
+	DrawQueued();
+
+	// 先读计数再查结果队列：编码任务先入队再递减计数
+	if (Queue.Num() == 0 && Drawn.Num() == 0 && EncodesInFlight.GetValue() == 0)
+	{
+		FScopeLock Lock(&EncodedLock);
+		if (Encoded.Num() > 0)
+		{
+			return true;
+		}
+
+		TickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FUAL_WidgetPreviewService::ReadbackDrawn()
+{
+	const FString OutputDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Screenshots/UAL"));
+	bool bMadeDir = false;
+
+	// 按绘制顺序收取已就绪的回读；未就绪的只排队一次轮询，GameThread 不等待 GPU
+	for (int32 Index = 0; Index < Drawn.Num();)
+	{
+		if (!Drawn[Index].Readback->bDone)
+		{
+			PollReadback(Drawn[Index].Readback);
+			++Index;
+			continue;
+		}
+
+		FDrawnJob Ready = MoveTemp(Drawn[Index]);
+		Drawn.RemoveAt(Index);
+
+		const FIntPoint Size = Ready.Readback->Size;
+		TArray<FColor> Bitmap = MoveTemp(Ready.Readback->Pixels);
+
+		Ready.Widget.Reset();
+		ReleaseRenderTarget(Ready.RenderTarget.Get());
+		Ready.RenderTarget.Reset();
+
+		if (Bitmap.Num() != Size.X * Size.Y || Bitmap.Num() == 0)
+		{
+			CompleteJob(Ready.Queued, MakeErrorResult(Ready.Queued.Job.AssetPath, TEXT("Failed to read back render target")));
+			continue;
+		}
+
+		if (!bMadeDir)
+		{
+			IFileManager::Get().MakeDirectory(*OutputDir, true);
+			bMadeDir = true;
+		}
+		const FString Filename = FString::Printf(TEXT("widget_preview_%s_%lld.png"),
+			*FPaths::GetBaseFilename(Ready.Queued.Job.AssetPath), FDateTime::Now().GetTicks());
+		StartEncode(MoveTemp(Ready.Queued), MoveTemp(Bitmap), Size, FPaths::Combine(OutputDir, Filename));
+	}
+}
+
+void FUAL_WidgetPreviewService::PollReadback(const FPreviewReadbackPtr& Readback)
+{
+	if (Readback->bPollQueued.exchange(true))
+	{
+		return;
+	}
+
+	ENQUEUE_RENDER_COMMAND(UALWidgetPreviewPoll)([Readback](FRHICommandListImmediate& RHICmdList)
+	{
+		Readback->bPollQueued = false;
+		if (!Readback->Readback.IsValid() || !Readback->Readback->IsReady())
+		{
+			return;
+		}
+
+		const FIntPoint Size = Readback->Size;
+		int32 RowPitchInPixels = 0;
+		if (const uint8* Data = static_cast<const uint8*>(UALCompat::LockTextureReadback(*Readback->Readback, RowPitchInPixels)))
+		{
+			if (RowPitchInPixels >= Size.X)
+			{
+				Readback->Pixels.SetNumUninitialized(Size.X * Size.Y);
+				for (int32 Y = 0; Y < Size.Y; ++Y)
+				{
+					FMemory::Memcpy(Readback->Pixels.GetData() + Y * Size.X, Data + static_cast<int64>(Y) * RowPitchInPixels * sizeof(FColor), Size.X * sizeof(FColor));
+				}
+			}
+			Readback->Readback->Unlock();
+		}
+		Readback->Readback.Reset();
+
+		// RGBA 渲染目标：FColor 为 BGRA 排列，交换 R / B
+		if (Readback->bSwapRedBlue)
+		{
+			for (FColor& Pixel : Readback->Pixels)
+			{
+				Swap(Pixel.R, Pixel.B);
+			}
+		}
+		Readback->bDone = true;
+	});
+}
+
+void FUAL_WidgetPreviewService::StartEncode(FQueuedJob&& Queued, TArray<FColor>&& Bitmap, FIntPoint Size, const FString& OutputPath)
+{
+	EncodesInFlight.Increment();
+	Async(EAsyncExecution::ThreadPool, [this, Queued = MoveTemp(Queued), Bitmap = MoveTemp(Bitmap), Size, OutputPath]() mutable
+	{
+		FEncodedJob Result;
+		TSharedPtr<IImageWrapper> Wrapper = ImageWrapperModule ? ImageWrapperModule->CreateImageWrapper(EImageFormat::PNG) : nullptr;
+		if (Wrapper.IsValid() && Wrapper->SetRaw(Bitmap.GetData(), Bitmap.Num() * sizeof(FColor), Size.X, Size.Y, ERGBFormat::BGRA, 8))
+		{
+			TArray<uint8> PNGData;
+			if (UALCompat::GetCompressedPNG(Wrapper, 0, PNGData) && PNGData.Num() > 0)
+			{
+				if (Queued.Job.bBulk)
+				{
+					Result.BulkHandle = FUAL_BulkChannel::Get().Publish(PNGData.GetData(), PNGData.Num(), TEXT("image/png"));
+				}
+				Result.bSaved = Result.BulkHandle.IsValid() || FFileHelper::SaveArrayToFile(PNGData, *OutputPath);
+			}
+		}
+		Result.Queued = MoveTemp(Queued);
+		Result.OutputPath = OutputPath;
+		Result.Size = Size;
+
+		// 结果交给 Ticker 在 GameThread 上回调；不投递 GameThread 任务，Shutdown 等待计数归零即可
+		{
+			FScopeLock Lock(&EncodedLock);
+			Encoded.Add(MoveTemp(Result));
+		}
+		EncodesInFlight.Decrement();
+	});
+}
+
+void FUAL_WidgetPreviewService::CompleteEncoded()
+{
+	TArray<FEncodedJob> Finished;
+	{
+		FScopeLock Lock(&EncodedLock);
+		Finished = MoveTemp(Encoded);
+		Encoded.Reset();
+	}
+
+	for (const FEncodedJob& Job : Finished)
+	{
+		if (!Job.bSaved)
+		{
+			CompleteJob(Job.Queued, MakeErrorResult(Job.Queued.Job.AssetPath, FString::Printf(TEXT("Failed to write preview image: %s"), *Job.OutputPath)));
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetBoolField(TEXT("ok"), true);
+		Result->SetStringField(TEXT("asset"), Job.Queued.Job.AssetPath);
+		Result->SetStringField(TEXT("mode"), TEXT("image"));
+		if (Job.BulkHandle.IsValid())
+		{
+			Result->SetObjectField(TEXT("bulk"), Job.BulkHandle);
+		}
+		else
+		{
+			Result->SetStringField(TEXT("path"), Job.OutputPath);
+		}
+		Result->SetNumberField(TEXT("width"), Job.Size.X);
+		Result->SetNumberField(TEXT("height"), Job.Size.Y);
+		CompleteJob(Job.Queued, Result);
+	}
+}
+
+void FUAL_WidgetPreviewService::DrawQueued()
+{
+	const int32 Budget = FMath::Max(1, CVarWidgetPreviewPerTick.GetValueOnGameThread());
+
+	// 回读跟不上时不再继续绘制，限制同时占用的 RenderTarget 数量与在途回读
+	if (Drawn.Num() >= Budget)
+	{
+		return;
+	}
+
+	const bool bCanRender = CanRender();
+	int32 Processed = 0;
+	while (Processed < Budget && Queue.Num() > 0)
+	{
+		FQueuedJob Queued = MoveTemp(Queue[0]);
+		Queue.RemoveAt(0);
+		++Processed;
+
+		FString Error;
+		UUserWidget* Widget = CreatePreviewWidget(Queued, Error);
+		if (!Widget)
+		{
+			CompleteJob(Queued, MakeErrorResult(Queued.Job.AssetPath, Error));
+			continue;
+		}
+
+		if (Queued.Job.bLayoutOnly || !bCanRender)
+		{
+			TSharedPtr<FJsonObject> Result = BuildLayoutJson(Widget, Queued.Job.Size);
+			Result->SetStringField(TEXT("asset"), Queued.Job.AssetPath);
+			++LayoutsBuilt;
+			CompleteJob(Queued, Result);
+			continue;
+		}
+
+		if (!Renderer.IsValid())
+		{
+			Renderer = MakeShared<FWidgetRenderer>(true);
+		}
+
+		UTextureRenderTarget2D* RenderTarget = AcquireRenderTarget(Queued.Job.Size);
+		Renderer->DrawWidget(RenderTarget, Widget->TakeWidget(), FVector2D(Queued.Job.Size), 0.0f);
+		++WidgetsRendered;
+
+		FPreviewReadbackPtr Readback = MakeShared<FPreviewReadback, ESPMode::ThreadSafe>();
+		Readback->Size = FIntPoint(RenderTarget->SizeX, RenderTarget->SizeY);
+		Readback->bSwapRedBlue = RenderTarget->GetFormat() == PF_R8G8B8A8;
+
+		// 渲染命令按序执行：拷贝排在绘制之后，只在 GPU 上排队，不等待完成
+		FTextureRenderTargetResource* RTResource = RenderTarget->GameThread_GetRenderTargetResource();
+		ENQUEUE_RENDER_COMMAND(UALWidgetPreviewCopy)([Readback, RTResource](FRHICommandListImmediate& RHICmdList)
+		{
+			Readback->Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("UALWidgetPreview"));
+			Readback->Readback->EnqueueCopy(RHICmdList, RTResource->GetRenderTargetTexture());
+		});
+
+		FDrawnJob& DrawnJob = Drawn.AddDefaulted_GetRef();
+		DrawnJob.Queued = MoveTemp(Queued);
+		DrawnJob.Widget.Reset(Widget);
+		DrawnJob.RenderTarget.Reset(RenderTarget);
+		DrawnJob.Readback = MoveTemp(Readback);
+	}
+}
+
+UUserWidget* FUAL_WidgetPreviewService::CreatePreviewWidget(const FQueuedJob& Queued, FString& OutError)
+{
+	UWidgetBlueprint* WidgetBP = Queued.Job.WidgetBlueprint.Get();
+	if (!WidgetBP)
+	{
+		OutError = FString::Printf(TEXT("Widget Blueprint was unloaded: %s"), *Queued.Job.AssetPath);
+		return nullptr;
+	}
+
+	// 图表未变化且已是最新状态时调度器会跳过编译
+	FUAL_BlueprintCompileScheduler::Get().CompileNow(WidgetBP, false, false);
+
+	UClass* WidgetClass = WidgetBP->GeneratedClass;
+	if (!WidgetClass || !WidgetClass->IsChildOf(UUserWidget::StaticClass()))
+	{
+		OutError = TEXT("Widget Blueprint has no valid generated class");
+		return nullptr;
+	}
+
+	UWorld* World = PreviewWorld.Get();
+	if ((!World || World->bIsTearingDown) && GEditor)
+	{
+		World = GEditor->GetEditorWorldContext().World();
+		PreviewWorld = World;
+	}
+	if (!World)
+	{
+		OutError = TEXT("No editor world available for preview");
+		return nullptr;
+	}
+
+	UUserWidget* Widget = CreateWidget<UUserWidget>(World, WidgetClass);
+	if (!Widget)
+	{
+		OutError = TEXT("Failed to create widget instance for preview");
+		return nullptr;
+	}
+
+	// 强制布局计算
+	Widget->ForceLayoutPrepass();
+	return Widget;
+}
+
+UTextureRenderTarget2D* FUAL_WidgetPreviewService::AcquireRenderTarget(FIntPoint Size)
+{
+	if (TArray<TStrongObjectPtr<UTextureRenderTarget2D>>* Free = FreeTargets.Find(Size))
+	{
+		while (Free->Num() > 0)
+		{
+			TStrongObjectPtr<UTextureRenderTarget2D> Pooled = Free->Pop();
+			--PooledTargetCount;
+			if (Pooled.IsValid())
+			{
+				++RenderTargetsReused;
+				return Pooled.Get();
+			}
+		}
+	}
+
+	// 8 位 sRGB 格式：回读结果直接就是 PNG 编码所需的 BGRA8
+	UTextureRenderTarget2D* RenderTarget = NewObject<UTextureRenderTarget2D>(GetTransientPackage());
+	RenderTarget->InitCustomFormat(Size.X, Size.Y, PF_B8G8R8A8, false);
+	RenderTarget->UpdateResourceImmediate();
+	++RenderTargetsCreated;
+	return RenderTarget;
+}
+
+void FUAL_WidgetPreviewService::ReleaseRenderTarget(UTextureRenderTarget2D* RenderTarget)
+{
+	if (!RenderTarget || PooledTargetCount >= FMath::Max(0, CVarWidgetPreviewPoolSize.GetValueOnGameThread()))
+	{
+		// 池已满：交给 GC 回收
+		return;
+	}
+
+	FreeTargets.FindOrAdd(FIntPoint(RenderTarget->SizeX, RenderTarget->SizeY)).Emplace(RenderTarget);
+	++PooledTargetCount;
+}
+
+void FUAL_WidgetPreviewService::CompleteJob(const FQueuedJob& Queued, const TSharedPtr<FJsonObject>& Result)
+{
+	FBatch& Batch = *Queued.Batch;
+	Batch.Results[Queued.Index] = Result;
+	if (--Batch.Remaining > 0)
+	{
+		return;
+	}
+
+	if (Batch.OnComplete)
+	{
+		Batch.OnComplete(Batch.Results);
+	}
+}
+
+TSharedPtr<FJsonObject> FUAL_WidgetPreviewService::BuildLayoutJson(UUserWidget* Widget, FIntPoint Size)
+{
+	TSharedRef<SWidget> RootWidget = Widget->TakeWidget();
+	RootWidget->SlatePrepass(1.0f);
+
+	TMap<const SWidget*, UWidget*> SlateToWidget;
+	if (Widget->WidgetTree)
+	{
+		Widget->WidgetTree->ForEachWidget([&SlateToWidget](UWidget* Child)
+		{
+			TSharedPtr<SWidget> Cached = Child ? Child->GetCachedWidget() : nullptr;
+			if (Cached.IsValid())
+			{
+				SlateToWidget.Add(Cached.Get(), Child);
+			}
+		});
+	}
+
+	// 不经过 RHI，直接按根尺寸排布整棵 Slate 树
+	const FGeometry RootGeometry = FGeometry::MakeRoot(FVector2D(Size), FSlateLayoutTransform());
+	TArray<TSharedPtr<FJsonValue>> Entries;
+	AppendArrangedLayout(RootWidget, RootGeometry, 0, SlateToWidget, Entries);
+
+	const FVector2D DesiredSize = RootWidget->GetDesiredSize();
+
+	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetBoolField(TEXT("ok"), true);
+	Result->SetStringField(TEXT("mode"), TEXT("layout"));
+	Result->SetNumberField(TEXT("width"), Size.X);
+	Result->SetNumberField(TEXT("height"), Size.Y);
+	Result->SetNumberField(TEXT("desired_width"), DesiredSize.X);
+	Result->SetNumberField(TEXT("desired_height"), DesiredSize.Y);
+	Result->SetArrayField(TEXT("widgets"), Entries);
+	return Result;
+}
+
+TSharedPtr<FJsonObject> FUAL_WidgetPreviewService::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Stats = MakeShared<FJsonObject>();
+	Stats->SetBoolField(TEXT("can_render"), CanRender());
+	Stats->SetNumberField(TEXT("queued"), Queue.Num());
+	Stats->SetNumberField(TEXT("widgets_rendered"), WidgetsRendered);
+	Stats->SetNumberField(TEXT("layouts_built"), LayoutsBuilt);
+	Stats->SetNumberField(TEXT("render_targets_created"), RenderTargetsCreated);
+	Stats->SetNumberField(TEXT("render_targets_reused"), RenderTargetsReused);
+	Stats->SetNumberField(TEXT("render_targets_pooled"), PooledTargetCount);
+	return Stats;
+}
+
+void FUAL_WidgetPreviewService::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		UAL_CORE_TICKER.RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	// 在途回读在渲染线程上释放，再等绘制与回读命令全部执行完（它们引用 RenderTarget 资源）
+	for (const FDrawnJob& DrawnJob : Drawn)
+	{
+		ENQUEUE_RENDER_COMMAND(UALWidgetPreviewRelease)([Readback = DrawnJob.Readback](FRHICommandListImmediate& RHICmdList)
+		{
+			Readback->Readback.Reset();
+		});
+	}
+	FlushRenderingCommands();
+
+	// 编码任务持有 this：等其结束，已完成的照常回调
+	while (EncodesInFlight.GetValue() > 0)
+	{
+		FPlatformProcess::Sleep(0.001f);
+	}
+	CompleteEncoded();
+
+	// 其余任务以错误结果完成，等待中的 widget.preview 请求都会收到响应
+	const FString Error = TEXT("Widget preview service shut down");
+	TArray<FDrawnJob> PendingDrawn = MoveTemp(Drawn);
+	Drawn.Reset();
+	TArray<FQueuedJob> PendingQueue = MoveTemp(Queue);
+	Queue.Reset();
+	for (const FDrawnJob& DrawnJob : PendingDrawn)
+	{
+		CompleteJob(DrawnJob.Queued, MakeErrorResult(DrawnJob.Queued.Job.AssetPath, Error));
+	}
+	for (const FQueuedJob& Queued : PendingQueue)
+	{
+		CompleteJob(Queued, MakeErrorResult(Queued.Job.AssetPath, Error));
+	}
+
+	FreeTargets.Reset();
+	PooledTargetCount = 0;
+	Renderer.Reset();
+	PreviewWorld.Reset();
+
+	UE_LOG(LogUALWidgetPreview, Log, TEXT("Widget preview service shut down: %d rendered, %d render targets created, %d reused"),
+		WidgetsRendered, RenderTargetsCreated, RenderTargetsReused);
+}
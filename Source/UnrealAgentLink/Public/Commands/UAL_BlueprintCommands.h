@@ -39,7 +39,7 @@ public:
 	// blueprint.add_variable - 添加蓝图成员变量
 	static void Handle_AddVariableToBlueprint(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 
-	// blueprint.get_graph - 获取蓝图图表（节点、引脚等）
+	// blueprint.get_graph - 获取蓝图图表（节点、引脚等），支持 since_version 增量读取
 	static void Handle_GetBlueprintGraph(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 	static void Handle_ListBlueprintGraphs(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 
@@ -55,9 +55,12 @@ public:
 	// blueprint.create_function - 创建蓝图函数图表（可选定义输入输出参数）
 	static void Handle_CreateFunctionGraph(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 
-	// blueprint.compile - 编译蓝图并可选保存
+	// blueprint.compile - 编译蓝图并可选保存（deferred=true 时进入编译队列合并执行）
 	static void Handle_CompileBlueprint(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 
+	// blueprint.flush_compiles - 立即编译延迟队列中的全部蓝图
+	static void Handle_FlushCompiles(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
 	// blueprint.set_pin_value - 设置节点 Pin 的默认值
 	static void Handle_SetPinValue(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 
@@ -94,6 +97,28 @@ public:
 	 */
 	static void Handle_CreateGraphDeclarative(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 
+	/**
+	 * blueprint.apply_ops - 对已有图表批量执行编辑操作
+	 *
+	 * 按顺序执行 add_node / connect / disconnect / set_pin_value / move_node / delete_node，
+	 * 全部操作在同一个事务中完成，结束后每个图表只通知一次、蓝图只标记一次，compile=true 时最多编译一次。
+	 * 节点引用既可以是已有节点 GUID，也可以是本批次 add_node 定义的 alias。
+	 *
+	 * 参数格式：
+	 * {
+	 *   "blueprint_path": "/Game/Blueprints/BP_Test",
+	 *   "graph_name": "EventGraph",   // 可选，op 内可单独覆盖
+	 *   "atomic": true,               // 可选，任一操作失败则整体回滚
+	 *   "compile": false,             // 可选
+	 *   "ops": [
+	 *     { "op": "add_node", "alias": "print", "type": "Function", "name": "KismetSystemLibrary.PrintString" },
+	 *     { "op": "connect", "from": "GUID-of-BeginPlay.then", "to": "print.execute" },
+	 *     { "op": "set_pin_value", "node_id": "print", "pin_name": "InString", "value": "Hi" }
+	 *   ]
+	 * }
+	 */
+	static void Handle_ApplyGraphOps(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
 	// ============================================================================
 	// 辅助函数
 	// ============================================================================
@@ -12,8 +12,8 @@ class FUAL_CommandHandler
 public:
 	FUAL_CommandHandler();
 
-	// 必须在 GameThread 调用
-	void ProcessMessage(const FString& JsonPayload);
+	// 必须在 GameThread 调用；ClientId 非 0 表示来自监听模式下的本地客户端，响应会路由回该客户端
+	void ProcessMessage(const FString& JsonPayload, int32 ClientId = 0);
 
 	// 构建项目信息（代理到 FUAL_EditorCommands::BuildProjectInfo）
 	TSharedPtr<FJsonObject> BuildProjectInfo() const;
@@ -113,4 +113,16 @@ public:
 	 * @param RequestId 请求 ID
 	 */
 	static void Handle_RescanAssets(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+	
+	/**
+	 * content.configure_textures - 批量配置纹理设置（sRGB / 压缩 / LOD 组）
+	 * 属性一次性写入后集中提交构建，不逐张触发 PostEditChange
+	 * 进度推送 content.texture_build_progress，完成推送 content.texture_build_completed（含 DDC 命中 / 未命中）
+	 * 
+	 * @param Payload 请求参数:
+	 *   - paths: 纹理资产路径数组
+	 *   - srgb / compression / lod_group: 可选，显式设置；均未指定时按 PBR 命名约定自动推断
+	 * @param RequestId 请求 ID
+	 */
+	static void Handle_ConfigureTextures(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 };
@@ -5,7 +5,7 @@
 
 /**
  * 编辑器命令处理器
- * 包含: editor.screenshot, take_screenshot, project.info, editor.get_project_info(兼容别名)
+ * 包含: editor.screenshot, take_screenshot, editor.capture_stream, project.info, editor.get_project_info(兼容别名)
  * 
  * 对应文档: 编辑器工具接口文档.md
  */
@@ -34,6 +34,9 @@ public:
 	// project.analyze_uproject - 分析 .uproject 文件，返回模块和插件信息
 	static void Handle_AnalyzeUProject(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 
+	// project.export_snapshot - 导出项目快照（资产 / 依赖 / 蓝图结构 / 材质参数）供离线索引
+	static void Handle_ExportSnapshot(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
 	// editor.capture_app_window - 截取整个编辑器应用窗口（Slate）
 	static void Handle_CaptureAppWindow(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 
@@ -52,6 +55,12 @@ public:
 	// editor.reveal_path - Reveal an asset path in the Content Browser or a disk path in Explorer/Finder.
 	static void Handle_RevealPath(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 
+	// editor.capture_stream - 开始/更新/停止视口帧流（二进制 WebSocket 帧推送）
+	static void Handle_CaptureStream(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
+	// editor.capture_stream_ack - 确认已收到的帧序号（背压窗口）
+	static void Handle_CaptureStreamAck(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
 	// 构建项目信息（公开给外部使用）
 public:
 	static TSharedPtr<FJsonObject> BuildProjectInfo();
@@ -141,11 +141,16 @@ public:
 	 * 请求参数：
 	 * - path: 材质资产路径（必填）
 	 * - include_values: 是否包含节点当前值（可选，默认 true）
+	 * - since_version / epoch: 增量模式，只返回该版本之后的变化（可选）
+	 * - refresh: 忽略变更计数强制重新扫描（可选，默认 false）
 	 * 
 	 * 响应数据：
-	 * - nodes: 节点列表（node_id, class, pins, position 等）
-	 * - connections: 连接列表（from -> to）
+	 * - version / epoch: 图表快照版本
+	 * - nodes: 节点列表（node_id, class, pins, position 等）；增量时为 added/modified/removed_nodes
+	 * - connections: 连接列表（from -> to）；增量时为 added/removed_connections
 	 * - material_pins: 材质主节点可用引脚
+	 *
+	 * add_node / connect_pins / set_node_value / delete_node 的响应附带 graph_version、graph_epoch、graph_delta
 	 */
 	static void Handle_GetMaterialGraph(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 	
@@ -162,6 +167,7 @@ public:
 	 * - node_name: 参数名称（参数节点时使用）
 	 * - position: 节点位置（可选）
 	 * - initial_value: 初始值（可选）
+	 * - defer_compile: 只标记待编译，静默期后合并编译并推送 material.compiled（可选，默认 false）
 	 * - texture_path: 贴图路径（TextureSample 时使用）
 	 * 
 	 * 响应数据：
@@ -183,6 +189,7 @@ public:
 	 * - source_pin: 源引脚名称（必填）
 	 * - target_node: 目标节点 ID（必填）
 	 * - target_pin: 目标引脚名称（必填）
+	 * - defer_compile: 只标记待编译，静默期后合并编译并推送 material.compiled（可选，默认 false）
 	 * 
 	 * 响应数据：
 	 * - connection: 连接信息
@@ -199,13 +206,31 @@ public:
 	 * 请求参数：
 	 * - path: 材质资产路径（必填）
 	 * - force_recompile: 是否强制重新编译（可选）
+	 * - deferred: 为 true 时只加入延迟编译队列，静默期后与其它编辑合并编译（可选，默认 false）
 	 * 
 	 * 响应数据：
-	 * - compiled: 是否编译成功
-	 * - errors: 错误列表
+	 * - compiled: 是否已提交编译（着色器在后台异步编译，不阻塞 GameThread）
+	 * - deferred / pending_count / in_flight_count: 队列状态
+	 * - errors: 错误列表（图表静态检查）
 	 * - warnings: 警告列表
+	 * 
+	 * 编译完成后推送事件 material.compiled：
+	 * - material_path, ok, errors
+	 * - compile_ms / submit_ms / queued_ms: 着色器编译耗时 / 提交耗时 / 排队时长
+	 * - shader_jobs: 本次提交的着色器任务数（近似）
+	 * - coalesced_edits: 合并的编辑次数
 	 */
 	static void Handle_CompileMaterial(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
+	/**
+	 * material.flush_compiles - 立即提交延迟编译队列中的全部材质
+	 * 
+	 * 响应数据：
+	 * - pending_count: 提交前队列中的材质数
+	 * - submitted_count: 实际提交的材质数
+	 * - in_flight_count: 正在编译的材质数
+	 */
+	static void Handle_FlushMaterialCompiles(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 	
 	/**
 	 * material.set_node_value - 设置材质节点值
@@ -219,6 +244,7 @@ public:
 	 * - material_path: 材质资产路径（必填）
 	 * - node_id: 节点 ID（必填）
 	 * - value: 要设置的值（必填）
+	 * - defer_compile: 只标记待编译，静默期后合并编译并推送 material.compiled（可选，默认 false）
 	 * - property_name: 属性名称（可选）
 	 * 
 	 * 响应数据：
@@ -238,6 +264,7 @@ public:
 	 * 请求参数：
 	 * - material_path: 材质资产路径（必填）
 	 * - node_id: 要删除的节点 ID（必填）
+	 * - defer_compile: 只标记待编译，静默期后合并编译并推送 material.compiled（可选，默认 false）
 	 * - disconnect_first: 是否先断开连接（可选，默认 true）
 	 * 
 	 * 响应数据：
@@ -372,15 +399,27 @@ private:
 	/**
 	 * material.list - 列出材质资产
 	 * 
+	 * 基于材质目录索引（FUAL_MaterialCatalog）：名称 / 父材质 / 混合模式取自资产注册表标签，
+	 * 参数只需加载根材质一次，之后随注册表事件与保存增量更新。
+	 * 
 	 * 请求参数：
 	 * - search_path: 搜索路径（可选，默认 /Game）
 	 * - name_filter: 名称过滤器（可选，支持 * 通配符）
 	 * - material_type: 类型过滤（all/material/instance）
-	 * - max_results: 最大返回数量（可选，默认50）
+	 * - blend_mode: 混合模式过滤（可选，如 Translucent / BLEND_Translucent）
+	 * - parent: 父材质路径过滤（可选）；parent_recursive: 是否匹配任意祖先（可选，默认 true）
+	 * - param_name / param_type: 按参数名 / 参数类型（scalar/vector/texture）过滤（可选）
+	 * - include_params: 是否返回父链与参数列表（可选，默认 false）
+	 * - cursor: 上一页返回的 next_cursor（可选）
+	 * - max_results: 每页数量（可选，默认50，最大1000）
+	 * - max_loads: 本次最多加载的根材质数量（可选，默认 ual.MaterialCatalogLoadBudget）
 	 * 
 	 * 响应数据：
-	 * - materials: 材质列表
-	 * - total_count: 总数量
+	 * - materials: 材质列表（path, name, type, blend_mode, parent[, parent_chain, parameters, overridden_parameters]）
+	 * - total_count: 全部匹配数量；returned_count: 本页数量
+	 * - next_cursor / has_more: 分页游标
+	 * - unresolved_count: 因加载预算用完而无法判断参数 / 混合模式的条目数（可再次请求）
+	 * - catalog: 目录统计
 	 */
 	static void Handle_ListMaterials(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 	
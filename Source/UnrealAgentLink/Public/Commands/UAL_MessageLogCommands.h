@@ -12,7 +12,14 @@
  * - messagelog.get: 读取指定类别的消息
  * - messagelog.subscribe: 订阅类别变化（实时推送）
  * - messagelog.unsubscribe: 取消订阅
+ * - messagelog.resync: 获取已订阅类别的完整快照并重置增量基线
+ *
+ * 订阅推送：变化在 ual.MessageLogDebounceMs 窗口内合并，messagelog.changed 只携带上次推送后新增的消息，
+ * 每个类别的 seq 逐次加 1，客户端发现序号不连续时调用 messagelog.resync；
+ * 列表被清空或换页时事件带 reset=true 并从头发送。
  */
+struct FUAL_MessageLogSubscription;
+
 class FUAL_MessageLogCommands
 {
 public:
@@ -43,7 +50,27 @@ public:
 	 */
 	static void Handle_Unsubscribe(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 
+	/**
+	 * 获取已订阅类别的完整快照（最后 limit 条，默认 1000），返回当前 seq
+	 */
+	static void Handle_Resync(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
+	/**
+	 * 模块卸载时解绑全部订阅并移除 Ticker
+	 */
+	static void Shutdown();
+
 private:
+	/**
+	 * 合并窗口到期的类别发送增量事件
+	 */
+	static bool TickPendingChanges(float DeltaTime);
+
+	/**
+	 * 发送上次推送后新增的消息
+	 */
+	static void SendDelta(const FName& CategoryName, FUAL_MessageLogSubscription& Subscription);
+
 	/**
 	 * 将单条 FTokenizedMessage 序列化为 JSON
 	 */
@@ -5,7 +5,7 @@
 
 /**
  * 系统命令处理器
- * 包含: system.run_console_command, system.get_performance_stats, cmd.run_python, cmd.exec_console
+ * 包含: system.run_console_command, system.get_performance_stats, cmd.run_python, cmd.exec_console, python.*, job.*, log.query, bulk.*
  * 
  * 对应文档: 系统工具接口文档.md
  */
@@ -19,8 +19,20 @@ public:
 	static void RegisterCommands(TMap<FString, TFunction<void(const TSharedPtr<FJsonObject>&, const FString)>>& CommandMap);
 
 	// Public Handlers called by Dispatcher
-	// cmd.run_python - 执行 Python 脚本
+	// cmd.run_python - 执行 Python 脚本（带 session 时在命名会话中执行并缓存字节码）
 	static void Handle_RunPython(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
+	// python.register_module - 注册可复用的辅助模块（源码未变化时不重复执行）
+	static void Handle_PythonRegisterModule(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
+	// python.call - 按名称调用函数，args 为 JSON 数组（位置参数）或对象（关键字参数）
+	static void Handle_PythonCall(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
+	// python.reset_session - 删除命名会话
+	static void Handle_PythonResetSession(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
+	// python.stats - 会话、字节码缓存与已注册模块概况
+	static void Handle_PythonStats(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 	
 	// cmd.exec_console / system.run_console_command - 执行控制台指令
 	static void Handle_ExecConsole(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
@@ -33,4 +45,22 @@ public:
 
 	// system.get_project_info - 获取项目信息(路径、Content目录等)
 	static void Handle_GetProjectInfo(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
+	// job.list - 列出运行中的任务（include_finished 时附带最近结束的任务）
+	static void Handle_ListJobs(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
+	// job.status - 查询任务状态与结果
+	static void Handle_JobStatus(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
+	// job.cancel - 取消运行中的任务
+	static void Handle_CancelJob(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
+	// log.query - 查询插件内保存的最近日志（时间范围 / 分类 / 级别 / 子串 / 整词 / 正则）
+	static void Handle_QueryLog(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
+	// bulk.open - 打开同机大块数据通道，返回共享内存名称与布局
+	static void Handle_BulkOpen(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
+
+	// bulk.release - 客户端读取完毕后释放句柄（ids 数组）
+	static void Handle_BulkRelease(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
 };
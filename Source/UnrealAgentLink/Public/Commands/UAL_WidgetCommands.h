@@ -140,12 +140,14 @@ public:
 	// ========================================================================
 	
 	/**
-	 * widget.preview - 渲染预览截图
+	 * widget.preview - 渲染预览截图（由 FUAL_WidgetPreviewService 跨帧批量处理）
 	 * 
 	 * @param Payload 请求参数:
-	 *   - path: Widget Blueprint 路径（必填）
+	 *   - path: Widget Blueprint 路径（与 paths 二选一）
+	 *   - paths: Widget Blueprint 路径数组（批量，返回 results 数组，顺序与请求一致）
 	 *   - width: 渲染宽度（可选，默认 1920）
 	 *   - height: 渲染高度（可选，默认 1080）
+	 *   - mode: "image"（默认）| "layout"（只输出排布后的控件位置/尺寸；-nullrhi 下自动使用）
 	 * @param RequestId 请求 ID
 	 */
 	static void Handle_Preview(const TSharedPtr<FJsonObject>& Payload, const FString RequestId);
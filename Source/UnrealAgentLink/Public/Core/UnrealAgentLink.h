@@ -29,6 +29,7 @@ private:
 
 	void HandleSocketMessage(const FString& Data);
 	void HandleSocketConnected();
+	void HandleLocalMessage(const FString& Data, int32 ClientId);
 	void RegisterMenus();
 
 
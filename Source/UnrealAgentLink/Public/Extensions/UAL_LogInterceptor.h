@@ -1,16 +1,93 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
 
 /**
  * 日志拦截并上报到 Agent
+ *
+ * - 日志线程只做过滤与入队：写入无锁环形缓冲区（多生产者 / 单消费者），满时丢弃并计数
+ * - 后台线程按固定间隔（ual.ForwardLogsFlushMs）批量取出：
+ *   写入本地日志存储（FUAL_LogStore，供 log.query 查询，未连接时同样记录）；
+ *   需要转发的按分类过滤、限速后合并为 log.entries 消息，发给已连接的 WebSocket 与已握手的本地客户端，
+ *   两者都没有时不转发；消息中附带丢弃计数
  */
-class FUAL_LogInterceptor : public FOutputDevice
+class FUAL_LogInterceptor : public FOutputDevice, public FRunnable
 {
 public:
+	FUAL_LogInterceptor();
+	virtual ~FUAL_LogInterceptor() override;
+
 	virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category) override;
 
+	// FRunnable：后台批量发送
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+	/** 停止后台线程（模块卸载时在移除输出设备之后调用） */
+	void Shutdown();
+
 	// 是否开启拦截
 	bool bIsCaptureEnabled = true;
-};
 
+private:
+	struct FSlot
+	{
+		std::atomic<uint64> Sequence{0};
+		FString Text;
+		FName Category;
+		double Time = 0.0;
+		ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+		bool bStore = false;
+		bool bForward = false;
+	};
+
+	struct FEntry
+	{
+		FString Text;
+		FName Category;
+		double Time = 0.0;
+		ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+		bool bStore = false;
+		bool bForward = false;
+	};
+
+	bool TryEnqueue(const TCHAR* Text, ELogVerbosity::Type Verbosity, const FName& Category, bool bStore, bool bForward);
+	bool TryDequeue(FEntry& OutEntry);
+
+	/** 取出缓冲区内容：写入本地存储，过滤、限速后转发 */
+	void Flush();
+	/** 发送一条 log.entries 消息（附带自上次发送以来的丢弃计数），按参数发给 WebSocket 和 / 或本地客户端 */
+	void SendBatch(const TArray<FEntry>& Batch, double Now, bool bToServer, bool bToLocalClients);
+	void RefreshCategoryFilters();
+
+	TUniquePtr<FSlot[]> Slots;
+	uint64 Capacity = 0;
+	std::atomic<uint64> EnqueuePos{0};
+	uint64 DequeuePos = 0;
+
+	// 丢弃计数：缓冲区满 / 超出限速（累计值，每批附带自上一批以来的增量）
+	std::atomic<uint64> OverflowDrops{0};
+	uint64 RateLimitedDrops = 0;
+	uint64 ReportedOverflowDrops = 0;
+	uint64 ReportedRateLimitedDrops = 0;
+
+	// 令牌桶（仅后台线程访问）
+	double RateTokens = 0.0;
+	double LastRefillTime = 0.0;
+
+	// 分类过滤（仅后台线程访问，CVar 变化时重新解析）
+	FString IncludeCategoriesSource;
+	FString ExcludeCategoriesSource;
+	TSet<FName> IncludeCategories;
+	TSet<FName> ExcludeCategories;
+
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	std::atomic<bool> bStopping{false};
+};
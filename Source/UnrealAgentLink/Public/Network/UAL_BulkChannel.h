@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * 同机大块数据通道（截图、预览图等二进制数据）
+ *
+ * 数据写入命名共享内存环形缓冲区，JSON 响应中只携带句柄（名称 / 偏移 / 大小），
+ * 同机的 Agent 进程直接映射读取，不经过 Base64 编码与磁盘往返。
+ *
+ * - 共享内存区在首次使用时创建，大小为 ual.BulkChannelMB；名称含进程 ID，同机多个编辑器互不干扰
+ * - 区域布局（小端）：
+ *   头部 64 字节：char[4] "UALB" | uint32 version | uint64 region_size | uint64 data_offset | uint32 pid
+ *   数据块：char[4] "UALK" | uint32 reserved | uint64 id | uint64 size | uint64 reserved，随后为数据，按 64 字节对齐
+ *   句柄中的 offset 指向数据本身（块头位于 offset - 32）；块头最后写入，读取前后比对块头中的 id 可确认数据未被覆盖
+ * - 块按写入顺序分配；客户端读完后 bulk.release 释放，未释放的块在 ual.BulkLeaseSec 后回收
+ * - 无法创建共享内存时退化为 Saved/UAL/Bulk 下的临时文件（kind = file，可按文件映射读取），释放或过期时删除
+ *
+ * Publish 可在任意线程调用。
+ */
+class FUAL_BulkChannel
+{
+public:
+	static FUAL_BulkChannel& Get();
+
+	/** ual.BulkChannel 是否开启 */
+	static bool IsEnabled();
+
+	/**
+	 * 写入一块数据并返回句柄
+	 * @return 通道关闭或空间不足时返回 nullptr，调用方改用原来的 Base64 / 文件路径
+	 */
+	TSharedPtr<FJsonObject> Publish(const uint8* Data, int64 Size, const FString& ContentType);
+
+	/** 释放句柄；返回是否找到仍有效的块 */
+	bool Release(uint64 Id);
+
+	/** 打开（必要时创建）共享内存区，返回名称、大小与布局说明（bulk.open） */
+	TSharedPtr<FJsonObject> Open();
+
+	/** 区域使用量与写入 / 释放 / 过期 / 退化计数 */
+	TSharedPtr<FJsonObject> GetStats() const;
+
+	/** 关闭共享内存区并删除临时文件 */
+	void Shutdown();
+
+private:
+	FUAL_BulkChannel() = default;
+
+	struct FBlock
+	{
+		uint64 Id = 0;
+		// 相对数据区起点
+		int64 Offset = 0;
+		int64 AllocSize = 0;
+		double ExpireTime = 0.0;
+		bool bReleased = false;
+	};
+
+	struct FFileBlock
+	{
+		uint64 Id = 0;
+		FString Path;
+		int64 Size = 0;
+		double ExpireTime = 0.0;
+	};
+
+	/** 创建并映射共享内存区（调用方持有 Mutex）；失败后不再重试 */
+	bool EnsureRegion();
+	void CloseRegion();
+
+	/** 回收已释放或过期的块（调用方持有 Mutex） */
+	void Reclaim(double Now);
+
+	/** 在环形缓冲区中分配 Need 字节（调用方持有 Mutex） */
+	bool Allocate(int64 Need, int64& OutOffset) const;
+
+	TSharedPtr<FJsonObject> PublishToFile(uint64 Id, const uint8* Data, int64 Size, const FString& ContentType);
+
+	mutable FCriticalSection Mutex;
+
+	uint8* RegionBase = nullptr;
+	int64 RegionSize = 0;
+	FString RegionName;
+	bool bRegionFailed = false;
+	void* RegionHandle = nullptr;
+
+	// 共享内存中的块，按分配顺序排列（[0] 最旧）
+	TArray<FBlock> Blocks;
+	TArray<FFileBlock> FileBlocks;
+	uint64 NextId = 0;
+
+	int64 Published = 0;
+	int64 PublishedBytes = 0;
+	int64 Released = 0;
+	int64 Expired = 0;
+	int64 FileFallbacks = 0;
+	int64 Rejected = 0;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "UAL_NetworkManager.h"
+
+class FSocket;
+class FTcpListener;
+struct FIPv4Endpoint;
+
+// 本地客户端消息（GameThread 触发）：消息文本、客户端 ID
+DECLARE_MULTICAST_DELEGATE_TwoParams(FUALOnLocalMessageReceived, const FString&, int32);
+
+/**
+ * 编辑器内监听模式：本地工具（Agent、性能面板、测试脚本等）直接连接编辑器，无需经过外部服务器
+ *
+ * - TCP 监听 ual.LocalServerPort（0 关闭，默认只绑定 127.0.0.1），支持多个客户端同时连接
+ * - 每次启动监听生成随机令牌并写入 Saved/UnrealAgentLink/LocalServerToken.txt；客户端必须先发送
+ *   client.hello（params.token）完成握手，之前的其它消息回复 401 并断开，不会进入命令分发、也收不到事件
+ * - 帧格式：每行一条 UTF-8 JSON（NDJSON），协议与 WebSocket 连接相同
+ * - 请求 ID 在进入命令分发前改写为带客户端编号的路由 ID，响应按路由 ID 发回发起请求的客户端
+ *   （异步完成的响应同样适用），客户端看到的仍是自己的原始 ID
+ * - 事件按客户端订阅分发（client.subscribe，默认全部事件）
+ * - 接收与发送缓冲都在 GameThread 的 Ticker 中轮询；发送可在任意线程调用
+ */
+class FUAL_LocalServer
+{
+public:
+	static FUAL_LocalServer& Get();
+
+	/** 模块启动时调用：此后按配置启动监听，并随 ual.LocalServerPort 变化启停 */
+	void Init();
+
+	/** 按 ual.LocalServerPort 启动 / 停止监听（端口变化时重启） */
+	void ApplyConfig();
+
+	/** 关闭监听与全部客户端 */
+	void Shutdown();
+
+	bool IsRunning() const { return Listener.IsValid(); }
+
+	/** 客户端消息回调（GameThread） */
+	FUALOnLocalMessageReceived& OnMessageReceived() { return MessageReceivedDelegate; }
+
+	/** 生成路由 ID：命令处理器用它替换本地客户端请求的原始 ID */
+	static FString MakeRoutedId(int32 ClientId, const FString& RequestId);
+
+	/** 解析路由 ID；不是本地客户端的请求时返回 false */
+	static bool ParseRoutedId(const FString& RoutedId, int32& OutClientId, FString& OutRequestId);
+
+	/** 发送给指定客户端（线程安全）；客户端已断开时丢弃 */
+	void SendToClient(int32 ClientId, const FString& Json);
+
+	/** 是否有已完成握手的客户端（线程安全） */
+	bool HasClients() const;
+
+	/** 按订阅把事件发给本地客户端（线程安全） */
+	void BroadcastEvent(const FString& Method, const FString& Json);
+
+	/**
+	 * 处理客户端自身的控制命令（client.subscribe / client.unsubscribe / client.info，握手后重复的 client.hello）
+	 * @return true 表示已处理
+	 */
+	bool HandleClientRequest(int32 ClientId, const FString& Method, const TSharedPtr<FJsonObject>& Params, const FString& RoutedId);
+
+	/** 监听状态与各客户端收发统计 */
+	TSharedPtr<FJsonObject> GetStats() const;
+
+private:
+	FUAL_LocalServer() = default;
+
+	struct FClient
+	{
+		int32 Id = 0;
+		FSocket* Socket = nullptr;
+		FString Address;
+		// 未读完的一行
+		TArray<uint8> RecvBuffer;
+		// 未发出的数据（Socket 发送缓冲已满时暂存）
+		TArray<uint8> SendBuffer;
+		// 事件订阅：* / 前缀.* / 完整方法名
+		TArray<FString> Subscriptions;
+		// 已通过 client.hello 握手
+		bool bAuthenticated = false;
+		bool bClosing = false;
+		double ConnectedTime = 0.0;
+		int64 MessagesIn = 0;
+		int64 MessagesOut = 0;
+		int64 BytesIn = 0;
+		int64 BytesOut = 0;
+	};
+
+	void Start(int32 Port);
+	void Stop();
+
+	/** 监听线程回调：暂存新连接，由 Ticker 在 GameThread 接管 */
+	bool HandleConnectionAccepted(FSocket* Socket, const FIPv4Endpoint& Endpoint);
+
+	bool Tick(float DeltaTime);
+	void ReceiveFrom(FClient& Client, TArray<TPair<int32, FString>>& OutMessages);
+	/** 处理握手前收到的消息：令牌正确时标记为已认证，否则回复 401 并断开（调用方持有 ClientsMutex） */
+	void HandleHandshake(FClient& Client, const FString& Message);
+	/** 尽量发送 SendBuffer（调用方持有 ClientsMutex） */
+	void FlushClient(FClient& Client);
+	void CloseClient(FClient& Client);
+	void AppendFrame(FClient& Client, const FString& Json);
+
+	static bool MatchesSubscription(const FClient& Client, const FString& Method);
+
+	bool bInitialized = false;
+	TUniquePtr<FTcpListener> Listener;
+	// 监听 Socket 由本类创建与销毁（FTcpListener 不持有）
+	FSocket* ListenSocket = nullptr;
+	int32 ListenPort = 0;
+	// 本次监听的握手令牌
+	FString Token;
+
+	mutable FCriticalSection ClientsMutex;
+	TMap<int32, TSharedPtr<FClient>> Clients;
+	int32 NextClientId = 1;
+
+	FCriticalSection AcceptMutex;
+	TArray<TPair<FSocket*, FString>> PendingAccepts;
+
+	int64 ClientsAccepted = 0;
+	int64 ClientsRejected = 0;
+
+	FTickerHandleType TickerHandle;
+	FUALOnLocalMessageReceived MessageReceivedDelegate;
+};
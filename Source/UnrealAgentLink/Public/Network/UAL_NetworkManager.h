@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
 #include "IWebSocket.h"
 #include "Runtime/Launch/Resources/Version.h"
 
@@ -15,6 +16,15 @@ using FTickerDelegateType = FTickerDelegate;
 
 /**
  * 维护 WebSocket 连接、心跳、重连
+ *
+ * - 心跳：预先序列化的 system.heartbeat（payload 含 seq 与发送时间），服务端回 system.pong 时测量 RTT；
+ *   服务端发来 system.ping 时立即回 system.pong。收到过 pong 的连接若超过 ual.HeartbeatTimeoutSec
+ *   未再收到 pong，视为断线并重连
+ * - 重连：指数退避加随机抖动（ual.ReconnectBaseSec 起，翻倍至 ual.ReconnectMaxSec），连接成功后复位
+ * - 可靠投递：响应与事件带递增的 seq 写入有界重放缓冲区；断线期间产生的消息暂存，
+ *   重连后先发送 system.resume（会话 ID + 序号范围），服务端回 system.resume_ack 确认已收到的序号后
+ *   按序重放其余消息；服务端不支持时超时后只重放断线期间未发出的消息。服务端用 system.ack 累计确认
+ * - 链路统计（RTT 分位数、重连次数、收发量、重放缓冲）由 GetLinkStats 返回
  */
 class FUAL_NetworkManager
 {
@@ -27,8 +37,11 @@ public:
 	// 关闭连接并释放资源
 	void Shutdown();
 
-	// 发送消息（线程安全）
-	void SendMessage(const FString& JsonData);
+	// 发送消息（线程安全）；bReliable 为 false 时不编号、不缓冲（心跳、日志转发等可丢弃的消息）
+	void SendMessage(const FString& JsonData, bool bReliable = true);
+
+	// 发送二进制帧（线程安全，用于截图流等大块数据）
+	void SendBinary(const void* Data, SIZE_T Size);
 
 	// 接收消息回调（在 Socket 线程触发，外部需切到 GameThread）
 	FUALOnMessageReceived& OnMessageReceived() { return MessageReceivedDelegate; }
@@ -36,9 +49,12 @@ public:
 	// 连接成功回调（在 Socket 线程触发，外部需切到 GameThread）
 	FUALOnConnected& OnConnected() { return ConnectedDelegate; }
 
-	// 当前是否已连接
+	// 当前是否已连接（线程安全）
 	bool IsConnected() const;
 
+	// 链路统计（system.get_performance_stats 使用）
+	TSharedPtr<FJsonObject> GetLinkStats() const;
+
 private:
 	FUAL_NetworkManager() = default;
 
@@ -46,13 +62,29 @@ private:
 	void BindSocketEvents();
 	void CleanupSocket();
 
-	void StartReconnectTimer();
+	/** 按退避策略安排下一次重连（已安排时忽略） */
+	void ScheduleReconnect();
 	void StopReconnectTimer();
 	bool TickReconnect(float DeltaTime);
 
 	void StartHeartbeatTimer();
 	void StopHeartbeatTimer();
 	bool TickHeartbeat(float DeltaTime);
+	void SendPing();
+
+	/** 处理 system.ping / system.pong，返回 true 表示已消费（不再转发给命令处理） */
+	bool HandleLinkMessage(const FString& Data);
+	void RecordRtt(double RttMs);
+
+	/** 连接建立后发送 system.resume；有待重放消息时暂停发送新消息直到握手完成 */
+	void BeginResume();
+	bool TickResumeTimeout(float DeltaTime);
+	/** 握手完成：bServerAck 表示服务端确认了 AckSeq，否则按旧服务端只重放未发出的消息 */
+	void FinishResume(bool bServerAck, int64 AckSeq);
+	/** 丢弃已确认的消息（调用方持有 SendMutex） */
+	void TrimAcked(int64 AckSeq);
+	/** 写入重放缓冲区并按上限淘汰最早的消息（调用方持有 SendMutex） */
+	void AppendReplay(int64 Seq, FString&& Framed, bool bSent);
 
 	void HandleOnMessage(const FString& Data);
 	void HandleOnConnected();
@@ -60,7 +92,8 @@ private:
 	void HandleOnConnectionError(const FString& Error);
 
 private:
-	FCriticalSection SendMutex;
+	// 保护 Socket 指针与发送状态：Socket 只在 GameThread 上替换，任何线程读取都要持有该锁
+	mutable FCriticalSection SendMutex;
 	TSharedPtr<IWebSocket> Socket;
 	FString TargetUrl;
 
@@ -69,6 +102,57 @@ private:
 	bool bIsConnecting = false;
 	bool bWantsReconnect = false;
 
+	// 链路统计（Socket 回调与 GameThread 都会访问）
+	mutable FCriticalSection StatsMutex;
+	// 连续失败次数，决定下一次重连的退避时长
+	int32 ConsecutiveFailures = 0;
+	int32 ConnectAttempts = 0;
+	int32 ReconnectCount = 0;
+	int32 ConnectionCount = 0;
+	double ConnectedSince = 0.0;
+	double NextReconnectTime = 0.0;
+	FString LastDisconnectReason;
+
+	int64 PingSeq = 0;
+	// 最近发出的心跳：seq -> 发送时间
+	TMap<int64, double> PingsInFlight;
+	int64 PingsSent = 0;
+	int64 PongsReceived = 0;
+	int64 PongsMissed = 0;
+	double LastPongTime = 0.0;
+	bool bPongSeenThisConnection = false;
+	// 最近 RTT 样本（环形）
+	TArray<float> RttSamples;
+	int32 RttWriteIndex = 0;
+	double LastRttMs = 0.0;
+
+	int64 MessagesIn = 0;
+	int64 MessagesOut = 0;
+	int64 BytesIn = 0;
+	int64 BytesOut = 0;
+	int64 BinaryBytesOut = 0;
+	int64 SendsSkipped = 0;
+
+	// 重放缓冲（受 SendMutex 保护）
+	struct FReplayEntry
+	{
+		int64 Seq = 0;
+		FString Json;
+		bool bSent = false;
+	};
+	TArray<FReplayEntry> ReplayBuffer;
+	int64 ReplayBytes = 0;
+	// 本次编辑器会话的 ID，服务端据此判断 seq 是否连续
+	FString SessionId;
+	int64 NextOutSeq = 1;
+	int64 AckedSeq = 0;
+	// 服务端是否发送过 ack / resume_ack；支持时已发送的消息也保留到确认为止
+	bool bServerAcks = false;
+	bool bResumePending = false;
+	FTickerHandleType ResumeTickerHandle;
+	int64 MessagesReplayed = 0;
+	int64 ReplayDropped = 0;
+
 	FUALOnMessageReceived MessageReceivedDelegate;
 	FUALOnConnected ConnectedDelegate;
 };
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "UAL_NetworkManager.h"
+
+/**
+ * 命令准入控制（FUAL_CommandHandler 分发前调用）
+ *
+ * - 方法可按类别限流：每个类别一个令牌桶（ual.RateLimit<类别>PerSec / ual.RateLimit<类别>Burst），
+ *   令牌不足的请求进入等待队列，领到令牌后按到达顺序执行，不会被拒绝
+ * - 全局帧预算：同一帧内已分发命令的 GameThread 耗时超过 ual.CommandFrameBudgetMs 后，
+ *   后续请求进入等待队列，由 Ticker 在之后的帧按预算依次执行（保持到达顺序）；
+ *   队列超过 ual.CommandQueueMax 时回复 429（details.retry_after_ms 给出建议的等待时间）
+ * - control 类（job.*、性能统计等）不受限流和帧预算约束，负载高时仍可查询与取消；
+ *   但同一连接（服务器连接或某个本地客户端）还有请求在排队时，control 请求排在它们之后，保持该连接内的顺序
+ * - 各类别的放行 / 排队 / 拒绝次数与耗时计入统计，由 system.get_performance_stats 返回
+ *
+ * 仅在 GameThread 使用。
+ */
+class FUAL_AdmissionController
+{
+public:
+	static FUAL_AdmissionController& Get();
+
+	/**
+	 * 提交一个请求：放行时立即调用 Dispatch，帧预算用尽或被限流时排队稍后调用，队列满时回复 429 且不调用
+	 */
+	void Submit(const FString& Method, const FString& RequestId, TFunction<void()>&& Dispatch);
+
+	/** 方法是否为只读（read / control 类） */
+	bool IsReadOnlyMethod(const FString& Method);
+
+	/** 各类别计数、令牌余量与队列状态 */
+	TSharedPtr<FJsonObject> GetStats() const;
+
+	/** 丢弃排队中的请求并移除 Ticker */
+	void Shutdown();
+
+private:
+	FUAL_AdmissionController() = default;
+
+	enum class EMethodClass : uint8
+	{
+		Control,
+		Read,
+		Write,
+		Heavy,
+		Num,
+	};
+
+	struct FBucket
+	{
+		double Tokens = -1.0;
+		double LastRefillTime = 0.0;
+	};
+
+	struct FClassStats
+	{
+		int64 Admitted = 0;
+		int64 Queued = 0;
+		// 因令牌不足在队列中等待过的请求数
+		int64 RateLimited = 0;
+		int64 RejectedQueueFull = 0;
+		double BusyMs = 0.0;
+		double MaxMs = 0.0;
+	};
+
+	struct FPending
+	{
+		FString Method;
+		FString RequestId;
+		EMethodClass Class = EMethodClass::Write;
+		// 来源连接：0 为服务器连接，其余为本地客户端编号
+		int32 ClientId = 0;
+		double EnqueueTime = 0.0;
+		bool bHasToken = false;
+		bool bCountedRateLimited = false;
+		TFunction<void()> Dispatch;
+	};
+
+	EMethodClass Classify(const FString& Method);
+
+	/** 补充令牌后尝试取一个；失败时给出下一个令牌的等待时间 */
+	bool TryConsumeToken(EMethodClass Class, double Now, double& OutRetryAfterMs);
+	void GetBucketConfig(EMethodClass Class, double& OutRate, double& OutBurst) const;
+
+	/** 帧预算是否已用尽（跨帧时自动清零） */
+	bool IsFrameBudgetExhausted();
+	void Execute(EMethodClass Class, const TFunction<void()>& Dispatch);
+	void Reject(const FString& Method, const FString& RequestId, EMethodClass Class, const TCHAR* Reason, double RetryAfterMs);
+
+	bool Tick(float DeltaTime);
+
+	/** 请求来源连接：本地客户端的路由 ID 取客户端编号，其余为 0 */
+	static int32 GetClientId(const FString& RequestId);
+	bool HasPendingFromClient(int32 ClientId) const;
+
+	static const TCHAR* ClassToString(EMethodClass Class);
+
+	FBucket Buckets[(int32)EMethodClass::Num];
+	FClassStats Stats[(int32)EMethodClass::Num];
+	TMap<FString, EMethodClass> ClassCache;
+
+	// 等待帧预算或令牌的请求（按到达顺序，长度不超过 ual.CommandQueueMax）
+	TArray<FPending> Pending;
+	int32 MaxQueueDepth = 0;
+	double MaxQueueWaitMs = 0.0;
+
+	uint64 BudgetFrame = 0;
+	double FrameBusyMs = 0.0;
+	int64 DeferredFrames = 0;
+
+	FTickerHandleType TickerHandle;
+};
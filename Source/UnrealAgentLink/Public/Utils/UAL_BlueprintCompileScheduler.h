@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Engine/Blueprint.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "UAL_NetworkManager.h"
+
+class FCompilerResultsLog;
+
+/**
+ * 单个蓝图的编译结果
+ */
+struct FUAL_BlueprintCompileResult
+{
+	FString BlueprintPath;
+	FString Status;
+	bool bSuccess = false;
+
+	// 图表自上次成功编译后未变化，直接复用上次结果
+	bool bSkipped = false;
+
+	bool bSaved = false;
+	double DurationMs = 0.0;
+	TArray<TSharedPtr<FJsonValue>> Diagnostics;
+
+	TSharedPtr<FJsonObject> ToJson() const;
+};
+
+/**
+ * 蓝图编译调度器
+ *
+ * - Enqueue：同一蓝图的多次编译请求在静默期（ual.BlueprintCompileDelay）内合并为一次
+ * - Flush：按依赖关系拓扑排序（被依赖的蓝图先编译），批次内只在最后一个蓝图执行 GC
+ * - 图表指纹与上次成功编译时一致且状态为 UpToDate 时跳过编译，复用上次的 diagnostics
+ * - 完成后回复挂起的请求，并广播 blueprint.compiled 事件；蓝图失效或队列关闭时同样以失败结果回调
+ *
+ * 仅在 GameThread 使用。
+ */
+class FUAL_BlueprintCompileScheduler
+{
+public:
+	/** 编译完成回调（每个蓝图一次） */
+	using FOnCompiled = TFunction<void(const FUAL_BlueprintCompileResult&)>;
+
+	static FUAL_BlueprintCompileScheduler& Get();
+
+	/**
+	 * 立即编译（同步），仍然遵循"未变化则跳过"规则
+	 * @param bForce 忽略指纹强制编译
+	 * @param bSave 编译成功后保存
+	 */
+	FUAL_BlueprintCompileResult CompileNow(UBlueprint* Blueprint, bool bForce, bool bSave);
+
+	/**
+	 * 加入延迟编译队列
+	 * @param bIncludeDependents 同时加入已加载的依赖此蓝图的蓝图
+	 * @param OnCompiled 该蓝图完成编译后回调（可为空）
+	 * @return 当前队列中的蓝图数量
+	 */
+	int32 Enqueue(UBlueprint* Blueprint, bool bForce, bool bSave, bool bIncludeDependents, FOnCompiled OnCompiled = nullptr);
+
+	/** 立即编译队列中的全部蓝图，返回编译（含跳过）的蓝图数量 */
+	int32 Flush();
+
+	int32 GetPendingCount() const { return Pending.Num(); }
+
+	/** 将编译日志转换为 diagnostics 数组（best-effort 绑定 node_id） */
+	static TArray<TSharedPtr<FJsonValue>> BuildDiagnostics(const FCompilerResultsLog& ResultsLog);
+
+	static FString StatusToString(EBlueprintStatus Status);
+
+	/** 模块卸载时移除 Ticker，未完成的队列以 Cancelled 结果回调后丢弃 */
+	void Shutdown();
+
+private:
+	FUAL_BlueprintCompileScheduler() = default;
+
+	struct FPendingCompile
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+		// 蓝图失效后仍能在失败结果中报告路径
+		FString BlueprintPath;
+		bool bForce = false;
+		bool bSave = false;
+		TArray<FOnCompiled> Callbacks;
+	};
+
+	struct FLastCompile
+	{
+		uint64 Fingerprint = 0;
+		FUAL_BlueprintCompileResult Result;
+	};
+
+	FUAL_BlueprintCompileResult CompileInternal(UBlueprint* Blueprint, bool bForce, bool bSave, bool bSkipGarbageCollection);
+	void AddPending(UBlueprint* Blueprint, bool bForce, bool bSave, FOnCompiled OnCompiled);
+	void SortByDependencies(TArray<FPendingCompile>& InOutBatch) const;
+	static uint64 ComputeFingerprint(UBlueprint* Blueprint);
+	static bool SaveBlueprint(UBlueprint* Blueprint);
+
+	void ScheduleFlush();
+	bool TickFlush(float DeltaTime);
+
+	TMap<TWeakObjectPtr<UBlueprint>, FPendingCompile> Pending;
+	TMap<TWeakObjectPtr<UBlueprint>, FLastCompile> LastCompiles;
+
+	FTickerHandleType FlushTickerHandle;
+	double LastEnqueueTime = 0.0;
+};
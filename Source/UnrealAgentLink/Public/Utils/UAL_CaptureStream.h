@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "UAL_NetworkManager.h"
+#include <atomic>
+
+class IImageWrapperModule;
+
+/**
+ * 视口帧流（editor.capture_stream）
+ *
+ * GameThread 按设定帧率在渲染线程排队一次视口渲染目标的异步回读（拷贝 + GPU 栅栏），
+ * 回读就绪后由工作线程缩放 + JPEG 编码，编码结果交回 GameThread 以 WebSocket 二进制帧推送。
+ * - 回读或编码未完成时直接跳过本次采集，GameThread 不等待 GPU
+ * - 视口没有独立渲染目标或像素格式不是 8 位 RGBA 时退回同步 ReadPixels
+ * - 画面与上一帧完全一致时不发送（skip_unchanged）
+ * - 客户端通过 editor.capture_stream_ack 确认帧序号；未确认帧达到上限时只保留最新一帧，旧帧丢弃
+ *
+ * 二进制帧格式（小端，头部 20 字节）：
+ *   char[4] "UALF" | uint32 seq | uint16 width | uint16 height | uint8 format(1=JPEG) | uint8[3] reserved | uint32 timestamp_ms
+ */
+class FUAL_CaptureStream
+{
+public:
+	struct FSettings
+	{
+		float Fps = 5.0f;
+		int32 MaxWidth = 640;
+		int32 Quality = 70;
+		// 允许未确认的帧数；0 表示不需要客户端确认
+		int32 MaxUnacked = 2;
+		bool bSkipUnchanged = true;
+	};
+
+	static FUAL_CaptureStream& Get();
+
+	/** 开始推流（已在运行时按新参数重启） */
+	bool Start(const FSettings& InSettings, FString& OutError);
+
+	void Stop();
+
+	/** 客户端确认已收到 Seq（含）之前的帧；超过已发送序号的确认按已发送序号处理 */
+	void Ack(uint32 Seq);
+
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+
+	const FSettings& GetSettings() const { return Settings; }
+
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+	/** 模块卸载时停止推流，并等待渲染线程上的回读命令与工作线程上的编码任务结束 */
+	void Shutdown();
+
+private:
+	FUAL_CaptureStream() = default;
+
+	/** 一次异步回读；渲染线程写入，完成后置位 bDone，GameThread 据此释放 */
+	struct FCaptureReadback;
+	using FCaptureReadbackPtr = TSharedPtr<FCaptureReadback, ESPMode::ThreadSafe>;
+
+	bool TickCapture(float DeltaTime);
+	void CaptureFrame();
+	void PollReadback(const FCaptureReadbackPtr& Readback);
+	void StartEncode(TArray<FColor>&& Pixels, FIntPoint SourceSize, uint32 Seq, uint32 TimestampMs, int32 InGeneration, const FSettings& FrameSettings);
+	void EncodeFrame(TArray<FColor> Pixels, FIntPoint SourceSize, uint32 Seq, uint32 TimestampMs, int32 InGeneration, const FSettings& FrameSettings);
+	/** 发送或按背压暂存一帧（GameThread） */
+	void SubmitFrame(TArray<uint8>&& Frame, uint32 Seq);
+
+	FSettings Settings;
+	FTickerHandleType TickerHandle;
+	IImageWrapperModule* ImageWrapperModule = nullptr;
+	double StartTime = 0.0;
+	// Ticker 每帧运行（轮询回读），按该时间控制采集帧率
+	double NextCaptureTime = 0.0;
+
+	// 在途的回读（仅 GameThread 访问该指针）
+	FCaptureReadbackPtr InFlightReadback;
+
+	// 每次 Start / Stop 递增，丢弃旧会话中仍在编码的帧
+	std::atomic<int32> Generation{0};
+
+	uint32 NextSeq = 0;
+	std::atomic<uint32> LastSentSeq{0};
+	std::atomic<uint32> LastAckedSeq{0};
+	FThreadSafeCounter EncodesInFlight;
+
+	// 仅在编码线程访问（同一时刻最多一个编码任务）
+	uint64 LastFrameHash = 0;
+
+	// 编码线程写入、等待 Ticker 发送的帧（受 PendingLock 保护）
+	TArray<uint8> EncodedFrame;
+	uint32 EncodedSeq = 0;
+
+	// 背压：窗口已满时暂存的最新一帧
+	FCriticalSection PendingLock;
+	TArray<uint8> PendingFrame;
+	uint32 PendingSeq = 0;
+
+	FThreadSafeCounter FramesCaptured;
+	FThreadSafeCounter FramesSent;
+	FThreadSafeCounter FramesSkippedBusy;
+	FThreadSafeCounter FramesSkippedUnchanged;
+	FThreadSafeCounter FramesDropped;
+	std::atomic<int64> BytesSent{0};
+};
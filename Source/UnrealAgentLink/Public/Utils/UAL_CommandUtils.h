@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 
+struct FUAL_ResolvedProperty;
+
 class UAL_CommandUtils
 {
 public:
@@ -79,7 +81,7 @@ public:
 	 */
 	static bool CheckPropertyMatch(AActor* Actor, const FString& PropName, const FString& ExpectedValue);
 
-	static bool ApplyStructValue(FStructProperty* StructProp, UObject* Target, const TSharedPtr<FJsonValue>& JsonValue);
+	static bool ApplyStructValue(FStructProperty* StructProp, void* Container, const TSharedPtr<FJsonValue>& JsonValue);
 
 	static const TArray<FString>& GetDefaultInspectProps();
 	
@@ -92,15 +94,24 @@ public:
 	static FProperty* FindWritableProperty(UObject* Obj, const FString& PropName);
 	static FProperty* FindWritablePropertyOnActorHierarchy(AActor* Actor, const FString& PropName, UObject*& OutTargetObj);
 
-	static bool SetNumericProperty(FNumericProperty* NumProp, UObject* Obj, const TSharedPtr<FJsonValue>& Value, FString& OutError);
-	static bool SetStructProperty(FStructProperty* StructProp, UObject* Obj, const TSharedPtr<FJsonValue>& Value, FString& OutError);
-	static bool SetSimpleProperty(FProperty* Prop, UObject* Obj, const TSharedPtr<FJsonValue>& Value, FString& OutError);
+	/**
+	 * 在 Actor -> RootComponent -> 其他组件上解析可写属性路径（支持 "RootComponent.RelativeLocation.X" 等嵌套路径）
+	 * 解析结果中的 Container 可直接传给 SetSimpleProperty
+	 */
+	static bool ResolveWritablePropertyOnActorHierarchy(AActor* Actor, const FString& PropPath, FUAL_ResolvedProperty& OutResolved);
+
+	static bool SetNumericProperty(FNumericProperty* NumProp, void* Container, const TSharedPtr<FJsonValue>& Value, FString& OutError);
+	static bool SetStructProperty(FStructProperty* StructProp, void* Container, const TSharedPtr<FJsonValue>& Value, FString& OutError);
+	// Container 为属性所在容器：UObject 本身，或嵌套路径解析出的结构体内存
+	static bool SetSimpleProperty(FProperty* Prop, void* Container, const TSharedPtr<FJsonValue>& Value, FString& OutError);
 
 	static FString JsonValueToString(const TSharedPtr<FJsonValue>& Value);
 	static TSharedPtr<FJsonObject> BuildSelectedProps(AActor* Actor, const TArray<FString>& WantedProps);
 
 	// Network Helpers
 	static void SendResponse(const FString& RequestId, int32 Code, const TSharedPtr<FJsonObject>& Data = nullptr);
+	// ResultJson 为已序列化的 result 对象（响应缓存命中时使用）
+	static void SendRawResponse(const FString& RequestId, int32 Code, const FString& ResultJson);
 	static void SendError(const FString& RequestId, int32 Code, const FString& Message);
 	// 带结构化 details 的错误（更“有人情味”，便于 Agent 自修复）
 	static void SendError(const FString& RequestId, int32 Code, const FString& Message, const TSharedPtr<FJsonObject>& Details);
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 模糊匹配（"did you mean" 建议、相似资产名、纹理名相似度共用）
+ *
+ * - 模式串 <= 64 字符时使用 Myers 位并行编辑距离（O(n) 次字运算），超长时退化为带状 DP
+ * - 支持最大距离截断：长度差预过滤 + 逐列下界提前退出
+ * - 比较不区分大小写
+ *
+ * 同一输入需要对大量候选打分时，构造一次 FUAL_FuzzyMatcher 复用其预处理表。
+ * 控制台命令 ual.BenchmarkFuzzyMatch [Count] 可对比旧版 DP 实现的耗时。
+ */
+class FUAL_FuzzyMatcher
+{
+public:
+	explicit FUAL_FuzzyMatcher(const FString& InPattern);
+
+	/**
+	 * 计算与 Text 的编辑距离
+	 * @param Text 候选字符串
+	 * @param MaxDistance 截断阈值；实际距离超过阈值时提前返回 MaxDistance + 1
+	 * @return 编辑距离（或 MaxDistance + 1）
+	 */
+	int32 Distance(const FString& Text, int32 MaxDistance = MAX_int32) const;
+
+	/** 长度差预过滤：长度差本身就是编辑距离的下界 */
+	bool PassesLengthFilter(const FString& Text, int32 MaxDistance) const
+	{
+		return FMath::Abs(Text.Len() - Pattern.Len()) <= MaxDistance;
+	}
+
+	/** 归一化相似度 [0, 1]，1 表示完全相同 */
+	float Similarity(const FString& Text) const;
+
+	const FString& GetPattern() const { return Pattern; }
+
+	/** 一次性计算两个字符串的编辑距离 */
+	static int32 EditDistance(const FString& A, const FString& B, int32 MaxDistance = MAX_int32);
+
+	/** 一次性计算两个字符串的归一化相似度 */
+	static float NameSimilarity(const FString& A, const FString& B);
+
+	/**
+	 * 从候选中选出距离最小的若干项（距离相同按名称升序），结果与逐个计算后全排序一致
+	 * 已选满时以当前第 K 名的距离作为截断阈值，绝大多数候选在预过滤或前几列即被淘汰
+	 */
+	static void FindClosest(const FString& Input, const TArray<FString>& Candidates, int32 MaxResults, TArray<FString>& OutMatches, int32 MaxDistance = MAX_int32);
+
+	/** 同 FindClosest，但返回候选下标（候选有重名时可区分来源） */
+	static void FindClosestIndices(const FString& Input, const TArray<FString>& Candidates, int32 MaxResults, TArray<int32>& OutIndices, int32 MaxDistance = MAX_int32);
+
+private:
+	uint64 GetPeq(TCHAR C) const;
+	int32 MyersDistance(const FString& Text, int32 MaxDistance) const;
+	int32 BandedDistance(const FString& Text, int32 MaxDistance) const;
+
+	// 小写化后的模式串
+	FString Pattern;
+
+	// 字符 -> 该字符在模式串中出现位置的位掩码（ASCII 直接查表，其余线性查找）
+	uint64 AsciiPeq[128];
+	TArray<TPair<TCHAR, uint64>> ExtendedPeq;
+
+	bool bBitParallel = false;
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "UAL_NetworkManager.h"
+
+/**
+ * 任务执行状态（由步进函数读写）
+ */
+struct FUAL_JobProgress
+{
+	int32 Completed = 0;
+	int32 Total = 0;
+	// 当前阶段说明，随进度事件发送
+	FString Message;
+	// 完成时的结果；失败时设置 Error
+	TSharedPtr<FJsonObject> Result;
+	FString Error;
+	// 本步只是在等待外部状态（如资产注册表扫描），本帧不再调度该任务；RunInline 不处理，步进函数需自行等待
+	bool bWaiting = false;
+};
+
+/**
+ * 任务定义：一个可反复调用的步进函数，每次只处理一个工作单元
+ */
+struct FUAL_JobSpec
+{
+	// 任务类型（通常为发起命令名，如 content.audit_optimization）
+	FString Type;
+	/** 执行一个工作单元，返回 true 表示全部完成（失败时设置 Error 后返回 true） */
+	TFunction<bool(FUAL_JobProgress&)> Step;
+	/** 取消时清理（可为空） */
+	TFunction<void()> OnCancelled;
+};
+
+/**
+ * 长任务框架（job.list / job.status / job.cancel）
+ *
+ * - Start 立即返回 job_id，任务在 GameThread 的 Ticker 中按时间预算（ual.JobBudgetMs）分片执行，
+ *   多个任务轮转，单步超出预算时也至少执行一步，编辑器不会被长任务卡住
+ * - 进度变化时按 ual.JobProgressIntervalMs 节流推送 job.progress，结束时推送 job.completed
+ * - 取消在两步之间生效；已结束的任务保留最近若干条，供 job.status 取结果
+ * - RunInline 用同一个步进函数同步执行到完成，命令可同时支持同步与 async 两种调用方式
+ *
+ * 仅在 GameThread 使用。
+ */
+class FUAL_JobManager
+{
+public:
+	static FUAL_JobManager& Get();
+
+	/** 启动任务，返回 job_id */
+	FString Start(FUAL_JobSpec&& Spec);
+
+	/** 取消运行中的任务；任务不存在或已结束时返回 false */
+	bool Cancel(const FString& JobId);
+
+	/** 任务状态（含结果），不存在时返回 nullptr */
+	TSharedPtr<FJsonObject> DescribeJob(const FString& JobId, bool bIncludeResult) const;
+
+	/** 运行中的任务（可附带最近结束的任务） */
+	TArray<TSharedPtr<FJsonValue>> ListJobs(bool bIncludeFinished) const;
+
+	/** 同步执行到完成（不经过 Ticker、不发送事件） */
+	static void RunInline(FUAL_JobSpec& Spec, FUAL_JobProgress& Progress);
+
+	/** 取消全部任务并移除 Ticker */
+	void Shutdown();
+
+private:
+	FUAL_JobManager() = default;
+
+	enum class EStatus : uint8
+	{
+		Running,
+		Succeeded,
+		Failed,
+		Cancelled,
+	};
+
+	struct FJob
+	{
+		FString JobId;
+		FUAL_JobSpec Spec;
+		FUAL_JobProgress Progress;
+		EStatus Status = EStatus::Running;
+		double StartTime = 0.0;
+		double EndTime = 0.0;
+		// 实际占用 GameThread 的时间与步数
+		double BusyMs = 0.0;
+		int32 Steps = 0;
+		double LastProgressTime = 0.0;
+		int32 LastReportedCompleted = -1;
+	};
+
+	bool Tick(float DeltaTime);
+	void Finish(const TSharedPtr<FJob>& Job, EStatus Status);
+	void SendProgress(FJob& Job);
+	TSharedPtr<FJsonObject> ToJson(const FJob& Job, bool bIncludeResult) const;
+	static const TCHAR* StatusToString(EStatus Status);
+
+	TArray<TSharedPtr<FJob>> Running;
+	TArray<TSharedPtr<FJob>> History;
+	int32 NextJobSerial = 1;
+	int32 RoundRobinCursor = 0;
+	FTickerHandleType TickerHandle;
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/LogVerbosity.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * 服务端日志存储（log.query）
+ *
+ * - 由 FUAL_LogInterceptor 的后台线程批量写入，与是否开启日志转发无关
+ * - 条目定长 16 字节：相对时间戳（毫秒）、驻留分类 ID、级别、文本在环形字节区中的偏移 / 长度；
+ *   文本以 UTF-8 存放在固定大小的环形字节区，条目数或字节数超限时淘汰最旧条目
+ * - 倒排索引：分类 / 级别 / 文本单词（小写、长度 >= 3）-> 序号列表，序号单调递增，
+ *   查询取最短的候选列表倒序遍历，其余条件逐条校验；淘汰后的过期序号惰性裁剪
+ *
+ * 写入与查询均在内部加锁，可跨线程使用。
+ */
+class FUAL_LogStore
+{
+public:
+	struct FIncoming
+	{
+		FString Text;
+		FName Category;
+		// FPlatformTime::Seconds() 时钟
+		double Time = 0.0;
+		ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+	};
+
+	struct FQuery
+	{
+		// Unix 毫秒，<= 0 表示不限
+		int64 SinceUnixMs = 0;
+		int64 UntilUnixMs = 0;
+		TArray<FName> Categories;
+		// 只返回该级别及更严重的日志
+		ELogVerbosity::Type MaxVerbosity = ELogVerbosity::VeryVerbose;
+		// 子串匹配（不区分大小写）
+		FString Contains;
+		// 整词匹配（不区分大小写，需全部出现）；不短于 3 个字符的词先走单词索引，全部在原文中校验
+		TArray<FString> Words;
+		// 正则匹配（ICU 语法，非法表达式不匹配任何条目）
+		FString Regex;
+		// 只返回序号小于该值的日志（向前翻页），0 表示不限
+		uint32 BeforeSeq = 0;
+		int32 Limit = 200;
+	};
+
+	struct FResultEntry
+	{
+		uint32 Seq = 0;
+		int64 UnixMs = 0;
+		FName Category;
+		ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+		FString Text;
+	};
+
+	struct FQueryResult
+	{
+		// 按时间从旧到新
+		TArray<FResultEntry> Entries;
+		// 是否还有更早的匹配（用 Entries[0].Seq 作为 before_seq 继续查询）
+		bool bHasMore = false;
+		// 实际校验过的条目数（评估索引效果）
+		int32 Scanned = 0;
+		FString IndexUsed;
+	};
+
+	static FUAL_LogStore& Get();
+
+	/** 是否启用（ual.LogStore），日志线程据此决定是否入队 */
+	static bool IsEnabled();
+
+	/** 存储的最低严重级别（ual.LogStoreVerbosity） */
+	static ELogVerbosity::Type GetMaxVerbosity();
+
+	/** 批量写入（后台线程调用） */
+	void AddBatch(TArray<FIncoming>& Batch);
+
+	/** 查询，返回最近的 Limit 条匹配 */
+	FQueryResult Query(const FQuery& InQuery);
+
+	/** 存储统计：条目数、字节占用、分类数、索引词数、淘汰数 */
+	void WriteStats(const TSharedPtr<class FJsonObject>& Out);
+
+	/** 释放全部内存 */
+	void Shutdown();
+
+	static const TCHAR* VerbosityToString(ELogVerbosity::Type Verbosity);
+	static bool ParseVerbosity(const FString& Name, ELogVerbosity::Type& OutVerbosity);
+
+private:
+	FUAL_LogStore() = default;
+
+	struct FRecord
+	{
+		// 相对 BaseUnixMs 的毫秒数
+		uint32 TimeMs = 0;
+		uint32 TextOffset = 0;
+		uint16 TextLen = 0;
+		uint16 CategoryId = 0;
+		uint8 Verbosity = 0;
+	};
+
+	void EnsureAllocated();
+	void AddLocked(const FIncoming& Item);
+	void EvictOldest();
+	/** 在文本环形区预留 Len 字节（空间不足时淘汰最旧条目），返回偏移 */
+	uint32 ReserveText(uint32 Len);
+	uint16 InternCategory(const FName& Category);
+
+	const FRecord& GetRecord(uint32 Seq) const { return Records[Seq & (RecordCapacity - 1)]; }
+	FString GetText(const FRecord& Record) const;
+
+	/** 文本拆分为小写单词哈希（字母数字与下划线，长度 >= 3），结果去重 */
+	static void Tokenize(const FString& Text, TArray<uint32>& OutTokens);
+	/** 查询子串中必然是完整单词的部分（两端可能被截断的单词不用于索引） */
+	static void TokenizeQueryInterior(const FString& Text, TArray<uint32>& OutTokens);
+
+	/** 取出未过期部分（必要时裁剪前缀） */
+	TArrayView<const uint32> LivePostings(TArray<uint32>& Postings);
+	void SweepPostings();
+
+	uint32 FindFirstSeqAtOrAfter(uint32 TimeMs) const;
+
+	FCriticalSection Lock;
+
+	TArray<FRecord> Records;
+	uint32 RecordCapacity = 0;
+	uint32 FirstSeq = 1;
+	uint32 NextSeq = 1;
+
+	// UTF-8 文本环形区：有效数据为 [TextReadPos, TextWritePos)，可能回绕
+	TArray<uint8> TextArena;
+	uint32 TextWritePos = 0;
+	uint32 TextReadPos = 0;
+	uint32 LiveTextBytes = 0;
+	uint32 LastTimeMs = 0;
+
+	// 驻留分类：ID -> 名称 / 名称 -> ID
+	TArray<FName> Categories;
+	TMap<FName, uint16> CategoryIds;
+
+	// 倒排索引
+	TArray<TArray<uint32>> CategoryPostings;
+	TArray<uint32> LevelPostings[ELogVerbosity::NumVerbosity];
+	TMap<uint32, TArray<uint32>> TokenPostings;
+	uint32 EvictionsSinceSweep = 0;
+
+	int64 BaseUnixMs = 0;
+	double BaseSeconds = 0.0;
+	uint64 TotalAdded = 0;
+	uint64 TotalEvicted = 0;
+};
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class UMaterialInterface;
+class UPackage;
+class FObjectPostSaveContext;
+
+/**
+ * 材质目录索引（material.list）
+ *
+ * - 名称、类型、父材质、混合模式取自资产注册表标签，不加载资产
+ * - 参数（名称 / 类型）只属于根材质：材质实例不能新增参数，实例的可用参数沿父链取根材质的参数，
+ *   因此只需加载根材质一次；已在内存中的材质实例额外记录其覆盖的参数与混合模式
+ * - 通过资产注册表的增 / 删 / 改名 / 更新事件与包保存事件保持同步
+ * - 条目按路径排序，游标为上一页最后一个路径，插入删除不会导致翻页错位
+ * - 只为当前页的条目按需加载根材质；按参数名过滤时由倒排索引给出候选，不扫描整个目录
+ *
+ * 仅在 GameThread 使用。
+ */
+class FUAL_MaterialCatalog
+{
+public:
+	enum class EParamType : uint8
+	{
+		Scalar,
+		Vector,
+		Texture,
+	};
+
+	struct FParam
+	{
+		FName Name;
+		EParamType Type = EParamType::Scalar;
+	};
+
+	struct FEntry
+	{
+		FString Path;
+		FName Name;
+		bool bIsInstance = false;
+		bool bRemoved = false;
+
+		// 直接父材质（仅实例）
+		FString ParentPath;
+		// 注册表标签或已加载对象中的混合模式；实例未覆盖时为空，沿父链取根材质
+		FString BlendMode;
+
+		// 根材质：全部参数；实例：覆盖的参数（仅当对象曾被加载时可知）
+		TArray<FParam> Params;
+		bool bParamsIndexed = false;
+
+		// 父链解析缓存（INDEX_NONE 表示父材质不在目录中）
+		int32 RootIndex = INDEX_NONE;
+	};
+
+	struct FQuery
+	{
+		FString SearchPath;
+		FString NameFilter;
+		bool bIncludeMaterials = true;
+		bool bIncludeInstances = true;
+		FString BlendMode;
+		FString ParentPath;
+		bool bParentRecursive = true;
+		FName ParamName;
+		FString ParamType;
+		FString Cursor;
+		int32 MaxResults = 50;
+		// 本次查询最多加载的根材质数量（参数未建立索引时）
+		int32 LoadBudget = 0;
+		bool bNeedParams = false;
+		// 统计全部匹配条目数（需扫描整个目录，页外条目不加载，根材质未索引的条目不计入）
+		bool bCountMatches = false;
+	};
+
+	struct FQueryResult
+	{
+		TArray<int32> Indices;
+		// 仅 bCountMatches 时有效
+		int32 MatchedCount = 0;
+		FString NextCursor;
+		// 参数仍未知（加载预算用完）而无法判断的条目数
+		int32 UnresolvedCount = 0;
+		int32 LoadCount = 0;
+	};
+
+	static FUAL_MaterialCatalog& Get();
+
+	/** 按条件查询（首次调用时从资产注册表建立目录） */
+	FQueryResult Query(const FQuery& Query);
+
+	const FEntry& GetEntry(int32 Index) const { return Entries[Index]; }
+
+	/** 父链（不含自身），从直接父材质到根材质 */
+	TArray<FString> GetParentChain(int32 Index) const;
+
+	/** 有效混合模式：实例覆盖优先，否则取根材质 */
+	FString GetEffectiveBlendMode(int32 Index) const;
+
+	/** 有效参数：根材质的参数；参数未建立索引时返回 nullptr */
+	const TArray<FParam>* GetEffectiveParams(int32 Index) const;
+
+	static const TCHAR* ParamTypeToString(EParamType Type);
+
+	/** 目录统计（条目数 / 已索引根材质数 / 累计加载次数） */
+	void WriteStats(const TSharedPtr<class FJsonObject>& Out) const;
+
+	/** 模块卸载时注销委托并清空目录 */
+	void Shutdown();
+
+private:
+	FUAL_MaterialCatalog() = default;
+
+	void EnsureBuilt();
+	void BindDelegates();
+
+	void UpsertFromAssetData(const FAssetData& AssetData);
+	void UpsertFromObject(UMaterialInterface* Material);
+	void RemovePath(const FString& Path);
+	void IndexParams(FEntry& Entry, UMaterialInterface* Material);
+	bool EnsureRootParams(int32 RootIndex, int32& InOutLoadBudget, int32& OutLoadCount);
+
+	void RebuildOrder();
+	void RebuildChains();
+	void RebuildParamIndex();
+
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext);
+
+	static bool IsCatalogClass(const FAssetData& AssetData, bool& bOutIsInstance);
+	static FString GetObjectPathString(const FAssetData& AssetData);
+	static FString NormalizeBlendMode(const FString& BlendMode);
+
+	TArray<FEntry> Entries;
+	TMap<FString, int32> ByPath;
+	TArray<int32> SortedIndices;
+	// 参数名 -> 含该参数的根材质索引
+	TMap<FName, TArray<int32>> ParamToRoots;
+	// 根材质索引 -> 以其为根的条目（含自身），随父链重建
+	TMap<int32, TArray<int32>> RootToEntries;
+
+	bool bBuilt = false;
+	bool bOrderDirty = true;
+	bool bChainsDirty = true;
+	bool bParamIndexDirty = true;
+	int32 TotalLoadCount = 0;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+	FDelegateHandle PackageSavedHandle;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Dom/JsonObject.h"
+#include "UAL_NetworkManager.h"
+
+class UMaterialInterface;
+
+/**
+ * 材质编译合并器
+ *
+ * - MarkDirty：材质编辑后只标记为脏，静默期（ual.MaterialCompileDelay）内的多次编辑合并为一次编译
+ * - Flush / CompileNow：一次 PreEditChange + PostEditChange 提交着色器编译，不在 GameThread 上等待
+ * - 跟踪已提交的编译，着色器全部完成后广播 material.compiled 事件
+ *   （编译耗时、着色器任务数、错误列表、合并的编辑次数）
+ *
+ * 仅在 GameThread 使用。
+ */
+class FUAL_MaterialCompileScheduler
+{
+public:
+	static FUAL_MaterialCompileScheduler& Get();
+
+	/** 标记材质待编译，返回当前队列中的材质数量 */
+	int32 MarkDirty(UMaterialInterface* Material);
+
+	/** 立即提交编译（若已在队列中则一并移出）；bForceRecompile 时先 ForceRecompileForRendering */
+	void CompileNow(UMaterialInterface* Material, bool bForceRecompile = false);
+
+	/** 立即提交队列中的全部材质，返回提交数量 */
+	int32 Flush();
+
+	int32 GetPendingCount() const { return Pending.Num(); }
+	int32 GetInFlightCount() const { return InFlight.Num(); }
+
+	/** 模块卸载时移除 Ticker，丢弃队列与跟踪状态 */
+	void Shutdown();
+
+private:
+	FUAL_MaterialCompileScheduler() = default;
+
+	struct FPendingCompile
+	{
+		TWeakObjectPtr<UMaterialInterface> Material;
+		double FirstDirtyTime = 0.0;
+		int32 EditCount = 0;
+	};
+
+	struct FInFlightCompile
+	{
+		TWeakObjectPtr<UMaterialInterface> Material;
+		FString MaterialPath;
+		double FirstDirtyTime = 0.0;
+		double SubmitTime = 0.0;
+		double SubmitMs = 0.0;
+		int32 EditCount = 0;
+		int32 ShaderJobs = 0;
+	};
+
+	void Submit(UMaterialInterface* Material, double FirstDirtyTime, int32 EditCount, bool bForceRecompile = false);
+	static bool IsCompilationFinished(UMaterialInterface* Material);
+
+	void ScheduleFlush();
+	bool TickFlush(float DeltaTime);
+	bool TickInFlight(float DeltaTime);
+
+	TMap<TWeakObjectPtr<UMaterialInterface>, FPendingCompile> Pending;
+	TArray<FInFlightCompile> InFlight;
+
+	FTickerHandleType FlushTickerHandle;
+	FTickerHandleType InFlightTickerHandle;
+	double LastDirtyTime = 0.0;
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+class UMaterial;
+class FTransactionObjectEvent;
+struct FPropertyChangedEvent;
+
+/**
+ * 材质图表快照缓存（material.get_graph / 材质节点编辑命令）
+ *
+ * - 每个材质维护版本号与节点指纹，未变化的节点复用缓存的 JSON
+ * - 变更计数：材质及其表达式上的 Modify / PostEditChange / 撤销重做会递增计数，
+ *   计数未变化时直接返回缓存，不再遍历表达式
+ * - since_version 请求只返回新增 / 修改 / 删除的节点与连线（字段与 blueprint.get_graph 一致）
+ *
+ * 节点以表达式对象名为稳定键，node_id、连线端点与 removed_nodes 都使用该名称（与 display_name 相同）；
+ * 删除节点不会改变其它节点的 node_id。材质节点命令仍接受旧的 类名_序号 格式。
+ *
+ * 仅在 GameThread 使用。
+ */
+class FUAL_MaterialGraphCache
+{
+public:
+	struct FNodeEntry
+	{
+		uint64 Fingerprint = 0;
+		int32 AddedVersion = 0;
+		int32 ModifiedVersion = 0;
+		TSharedPtr<FJsonObject> Json;
+	};
+
+	struct FLinkEntry
+	{
+		int32 AddedVersion = 0;
+		TSharedPtr<FJsonObject> Json;
+	};
+
+	struct FTombstone
+	{
+		int32 RemovedVersion = 0;
+		TSharedPtr<FJsonValue> Json;
+	};
+
+	struct FSnapshot
+	{
+		TWeakObjectPtr<UMaterial> Material;
+		// 快照纪元：编辑器重启或缓存重建后变化，客户端据此判断 since_version 是否仍然有效
+		FGuid Epoch;
+		int32 Version = 0;
+		int32 OldestDeltaVersion = 0;
+
+		// 变更计数（委托递增）与上次扫描时的计数
+		uint32 ChangeCount = 0;
+		uint32 ScannedChangeCount = 0;
+
+		TMap<FName, FNodeEntry> Nodes;
+		TArray<FName> NodeOrder;
+		TMap<FString, FLinkEntry> Links;
+		TArray<FString> LinkOrder;
+
+		TMap<FName, FTombstone> RemovedNodes;
+		TMap<FString, FTombstone> RemovedLinks;
+
+		int32 TextureSampleCount = 0;
+	};
+
+	static FUAL_MaterialGraphCache& Get();
+
+	/**
+	 * 获取最新快照；变更计数未变化时不遍历表达式
+	 * @param bForceScan 忽略变更计数，强制重新扫描（指纹未变化的节点仍复用 JSON）
+	 */
+	const FSnapshot& Refresh(UMaterial* Material, bool bForceScan = false);
+
+	/** 全量：按表达式顺序输出缓存的节点 / 连线 JSON */
+	static void WriteFull(const FSnapshot& Snapshot, const TSharedPtr<FJsonObject>& Result);
+
+	/** 增量：只输出 SinceVersion 之后新增 / 修改 / 删除的节点与连线 */
+	static void WriteDelta(const FSnapshot& Snapshot, int32 SinceVersion, const TSharedPtr<FJsonObject>& Result);
+
+	/**
+	 * 编辑命令完成后调用：强制扫描并写入 graph_version / graph_epoch / graph_delta，
+	 * 客户端据此直接更新本地图表，无需再次 get_graph
+	 */
+	void WriteEditResult(UMaterial* Material, int32 BaseVersion, const TSharedPtr<FJsonObject>& Data);
+
+	/** 模块卸载时注销委托并清空缓存 */
+	void Shutdown();
+
+private:
+	FUAL_MaterialGraphCache() = default;
+
+	void EnsureDelegates();
+	void NotifyObjectChanged(UObject* Object);
+	void OnObjectModified(UObject* Object);
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+	void OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event);
+
+	void Scan(UMaterial* Material, FSnapshot& Snapshot);
+	static void PruneTombstones(FSnapshot& Snapshot);
+
+	TMap<const UMaterial*, FSnapshot> Snapshots;
+
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle ObjectPropertyChangedHandle;
+	FDelegateHandle ObjectTransactedHandle;
+};
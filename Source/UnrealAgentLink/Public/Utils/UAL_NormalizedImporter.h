@@ -172,6 +172,17 @@ struct FUALImportRuleSet
 class UNREALAGENTLINK_API FUALNormalizedImporter
 {
 public:
+    /**
+     * 导入阶段（长任务逐阶段执行，阶段之间编辑器继续 Tick）
+     */
+    enum class EStage : uint8
+    {
+        Plan,   // 依赖闭包、目标信息、冲突重命名、重定向映射
+        Copy,   // 复制文件
+        Remap,  // 注册重定向、加载修复引用、保存并清理
+        Done,
+    };
+
     FUALNormalizedImporter();
     ~FUALNormalizedImporter();
 
@@ -188,6 +199,17 @@ public:
         FUALNormalizedImportSession& OutSession
     );
 
+    /**
+     * 执行单个导入阶段（调用方需从 Plan 开始按顺序执行，会话由调用方重置）
+     * @return 该阶段是否成功；失败时应停止后续阶段
+     */
+    bool ExecuteStage(
+        EStage Stage,
+        const TArray<FString>& SourceFiles,
+        const FUALImportRuleSet& RuleSet,
+        FUALNormalizedImportSession& Session
+    );
+
     /**
      * 收集资产的依赖闭包
      * @param RootAssetPaths - 根资产路径列表
@@ -224,6 +246,15 @@ public:
     static bool IsSkeletalMesh(const FString& FilePath);
 
 private:
+    /**
+     * 步骤0：收集依赖闭包并生成目标信息与重定向映射
+     */
+    void PlanImport(
+        const TArray<FString>& SourceFiles,
+        const FUALImportRuleSet& RuleSet,
+        FUALNormalizedImportSession& OutSession
+    );
+
     /**
      * 步骤1：复制文件到目标位置
      */
@@ -21,6 +21,7 @@
 #include "Materials/Material.h"
 #include "Materials/MaterialInstanceConstant.h"
 #include "Engine/StaticMesh.h"
+#include "UAL_TextureSettingsBatch.h"
 
 /**
  * 纹理类型枚举
@@ -52,6 +53,18 @@ struct FUAL_TextureGroup
 	bool IsValid() const { return Textures.Num() > 0; }
 };
 
+/**
+ * 纹理名称分析结果
+ * 每个名称只分词 / 转小写一次，分类与分组共用
+ */
+struct FUAL_TextureNameInfo
+{
+	FString Name;                                                  // 原始纹理名称
+	EUAL_PBRTextureType Type = EUAL_PBRTextureType::Unknown;       // 识别的纹理类型
+	FString BaseName;                                              // 资产基础名称（用于组名 / 材质名）
+	FString BucketKey;                                             // 归一化基础名（小写、去分隔符），用于哈希分桶
+};
+
 /**
  * PBR材质创建选项
  */
@@ -93,6 +106,24 @@ public:
 	 */
 	static FString ExtractBaseName(const FString& TextureName);
 	
+	/**
+	 * 分析单个纹理名称：类型、基础名称、分桶键
+	 * 纯字符串运算，可在任意线程调用
+	 */
+	static FUAL_TextureNameInfo AnalyzeTextureName(const FString& TextureName);
+	
+	/**
+	 * 批量分析纹理名称（数量较多时使用 ParallelFor 并行分类）
+	 */
+	static TArray<FUAL_TextureNameInfo> AnalyzeTextureNames(const TArray<FString>& TextureNames);
+	
+	/**
+	 * 按归一化基础名分桶：返回每组在 Infos 中的下标（组按首次出现顺序排列）
+	 * 同一桶内同类型纹理重复时，仅在桶内用名称相似度挑选最接近组名的一张
+	 * 未知类型的纹理不参与分组
+	 */
+	static TArray<TArray<int32>> BucketTextureNames(const TArray<FUAL_TextureNameInfo>& Infos);
+	
 	/**
 	 * 将纹理数组按资产分组
 	 * 智能识别哪些纹理属于同一个资产
@@ -139,6 +170,11 @@ public:
 	 */
 	static FString StandardizeAssetName(const FString& BaseName, const FString& AssetType);
 	
+	/**
+	 * 获取纹理类型对应的推荐设置（sRGB、压缩、法线贴图的 LOD 组）
+	 */
+	static FUAL_TextureSettingsRequest MakeTextureSettingsRequest(UTexture2D* Texture, EUAL_PBRTextureType Type);
+	
 	/**
 	 * 配置纹理设置
 	 * 根据纹理类型自动配置压缩、sRGB等设置
@@ -148,6 +184,15 @@ public:
 	 */
 	static void ConfigureTextureSettings(UTexture2D* Texture, EUAL_PBRTextureType Type);
 	
+	/**
+	 * 批量配置纹理设置
+	 * 先统一写入属性，再集中提交构建（异步纹理编译并行执行），进度与 DDC 统计通过事件推送
+	 * 
+	 * @param Textures 纹理与其类型
+	 * @return 构建任务 ID（没有纹理需要重建时为空）
+	 */
+	static FString ConfigureTextureSettingsBatch(const TArray<TPair<UTexture2D*, EUAL_PBRTextureType>>& Textures);
+	
 	/**
 	 * 批量处理：为导入的资产自动创建PBR材质
 	 * Agent友好的一站式处理函数
@@ -168,9 +213,9 @@ public:
 
 private:
 	/**
-	 * 检查字符串是否包含任意关键词（不区分大小写）
+	 * 对已转小写的名称做关键词分类（关键词表为静态常量，不再逐次构建）
 	 */
-	static bool ContainsAnyKeyword(const FString& Text, const TArray<FString>& Keywords);
+	static EUAL_PBRTextureType ClassifyLowerName(const FString& LowerName);
 	
 	/**
 	 * 计算两个字符串的相似度（用于纹理分组）
@@ -14,6 +14,15 @@
 class UNREALAGENTLINK_API FUALPackageReader : public FArchiveUObject
 {
 public:
+    /** 导出表条目 */
+    struct FExportInfo
+    {
+        FName ObjectName;
+        FName ClassName;
+        /** Outer 在导出表中的下标，顶层对象为 INDEX_NONE */
+        int32 OuterExport = INDEX_NONE;
+    };
+
     FUALPackageReader();
     ~FUALPackageReader();
 
@@ -38,6 +47,13 @@ public:
      */
     bool GetAssetClass(FString& OutClassName);
 
+    /**
+     * 读取导出表（对象名与类名），不加载包
+     * @param OutExports - 输出导出对象，顺序与导出表一致
+     * @return 成功返回 true
+     */
+    bool ReadExports(TArray<FExportInfo>& OutExports);
+
     // FArchive 接口实现
     virtual void Serialize(void* V, int64 Length) override;
     virtual void Seek(int64 InPos) override;
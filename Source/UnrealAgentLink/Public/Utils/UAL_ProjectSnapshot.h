@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UAL_JobManager.h"
+
+/**
+ * 项目快照导出（project.export_snapshot）
+ *
+ * 一次性导出 Agent 理解项目所需的结构化数据，替代大量 content.search / blueprint.describe /
+ * material.describe / level.query_assets 调用：
+ * - GameThread 分批从资产注册表收集资产、类、硬 / 软依赖、蓝图标签，从材质目录取父材质、混合模式与参数（不加载资产）
+ * - 工作线程并行检查包文件（修改时间 + 大小 → 保存哈希），对蓝图包用 FUALPackageReader 读取导出表，
+ *   得到图表 / 函数名与节点、组件数量；注册表尚未扫描完成时同样从包头补全类与依赖
+ * - 增量：保存哈希与上次快照一致的包直接复用上次的包头数据，不再读文件
+ * - 输出为列式二进制文件，可整体映射后按列读取
+ *
+ * 文件格式（小端）：
+ *   头部 24 字节：char[4] "UALS" | uint32 version | int64 created_unix_ms | uint32 table_count | uint32 reserved
+ *   字符串表：uint32 count | uint32 offsets[count + 1] | UTF-8 数据（0 号为空串）
+ *   每个表：uint32 name | uint32 row_count | uint32 column_count，随后每列：
+ *     uint32 name | uint8 type | uint8[3] reserved | 数据（row_count 个值）
+ *     type：'S' = uint32 字符串下标，'U' = uint32，'Q' = uint64
+ *   表与列：
+ *     packages        name S, stamp Q, size Q, flags U, dep_begin U, dep_count U, header_class S,
+ *                     graphs U, functions U, nodes U, components U, member_begin U, member_count U
+ *     dependencies    target S, kind U（0 硬引用 / 1 软引用 / 2 包头读取）
+ *     members         kind U（0 图表 / 1 函数）, name S
+ *     assets          path S, name S, class S, package U
+ *     classes         name S, assets U
+ *     blueprints      asset U, parent S, native_parent S, type S, generated_class S, interfaces S
+ *     materials       asset U, parent S, blend_mode S, instance U, params_indexed U, param_begin U, param_count U
+ *     material_params name S, type S
+ */
+class FUAL_ProjectSnapshot
+{
+public:
+	struct FOptions
+	{
+		// 绝对路径；默认 Saved/UAL/Snapshot/ProjectSnapshot.uals
+		FString OutputPath;
+		// 导出的内容路径，默认 /Game
+		TArray<FString> PackagePaths;
+		// 忽略上次快照，重新读取全部包头
+		bool bFull = false;
+		bool bIncludeSoftReferences = true;
+	};
+
+	/** 默认输出路径；相对路径基于 Saved/UAL/Snapshot */
+	static FString ResolveOutputPath(const FString& Path);
+
+	/** 创建导出任务（可交给 FUAL_JobManager::Start 或 RunInline） */
+	static FUAL_JobSpec CreateJob(const FOptions& Options);
+
+	/** 格式版本，结构变化时递增（旧版本快照不参与增量复用） */
+	static constexpr uint32 FormatVersion = 1;
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+/**
+ * 已编译的属性路径（单个 UObject 内的一段）
+ *
+ * 例如在 AActor 上编译 "RootComponent.RelativeLocation.X"：
+ * - 第一段只包含 RootComponent（对象引用，bHop = true），Remainder = "RelativeLocation.X"
+ * - 运行时解引用后，在 USceneComponent 上继续编译 "RelativeLocation.X"：
+ *   Chain = [RelativeLocation, X]，LeafContainerOffset = RelativeLocation 的偏移
+ */
+struct FUAL_CompiledPropertyPath
+{
+	// 当前对象内的属性链（顶层属性 -> 内嵌结构体成员 -> 叶属性 / 对象引用属性）
+	TArray<FProperty*> Chain;
+
+	// 从对象起始地址到 Chain 最后一个属性所在容器的累计偏移
+	int32 LeafContainerOffset = 0;
+
+	// 路径是否经过对象引用，需要在目标对象上继续解析 Remainder
+	bool bHop = false;
+	FString Remainder;
+
+	// 链上每一段是否都满足读 / 写条件（规则与 TryCollectProperty / FindWritableProperty 的旧规则一致）
+	bool bReadable = false;
+	bool bWritable = false;
+
+	bool IsValid() const { return Chain.Num() > 0; }
+};
+
+/**
+ * 路径解析结果
+ */
+struct FUAL_ResolvedProperty
+{
+	// 叶属性
+	FProperty* Property = nullptr;
+
+	// 叶属性所在容器（UObject 本身或内嵌结构体内存）
+	void* Container = nullptr;
+
+	// 叶属性所属的 UObject（写入前 Modify，写入后 PostEditChangeProperty）
+	UObject* OwnerObject = nullptr;
+
+	// OwnerObject 上的顶层属性（用于 FPropertyChangedEvent::MemberProperty）
+	FProperty* MemberProperty = nullptr;
+
+	void* GetValuePtr() const
+	{
+		return Property && Container ? Property->ContainerPtrToValuePtr<void>(Container) : nullptr;
+	}
+};
+
+/**
+ * 按 UClass 缓存的属性路径编译结果
+ *
+ * 替代每次调用都 FindFProperty 的字符串查找：同一类的 Actor 在批量读写时只编译一次，
+ * 并预先缓存 "did you mean" 候选列表。蓝图重编译 / 对象重实例化时整体失效。
+ * 仅在 GameThread 使用。
+ */
+class FUAL_PropertyPathCache
+{
+public:
+	enum class EAccess : uint8
+	{
+		Read,
+		Write
+	};
+
+	static FUAL_PropertyPathCache& Get();
+
+	/**
+	 * 解析点分属性路径（支持 "Prop"、"Struct.Member"、"ObjRef.Prop.Member"）
+	 * @param Root 起始对象
+	 * @param Path 属性路径
+	 * @param Access 访问方式，决定每一段属性的标志过滤；写入时对象引用只能跳转到 Root 拥有的子对象
+	 * @param Out 解析结果
+	 * @return 路径存在且满足访问条件时返回 true
+	 */
+	bool Resolve(UObject* Root, const FString& Path, EAccess Access, FUAL_ResolvedProperty& Out);
+
+	/**
+	 * 获取某个类上可编辑属性名列表（用于 SuggestProperties 的候选）
+	 */
+	const TArray<FString>& GetSuggestionCandidates(const UClass* Class);
+
+	/** 清空所有缓存 */
+	void Invalidate();
+
+	/** 模块卸载时解绑编辑器委托 */
+	void Shutdown();
+
+private:
+	FUAL_PropertyPathCache() = default;
+
+	struct FClassEntry
+	{
+		TWeakObjectPtr<const UClass> Class;
+		TMap<FString, FUAL_CompiledPropertyPath> Paths;
+		TArray<FString> Candidates;
+		bool bCandidatesBuilt = false;
+		// Paths 中未命中（Chain 为空）的条目数
+		int32 NegativePaths = 0;
+	};
+
+	FClassEntry& FindOrAddEntry(const UClass* Class);
+	const FUAL_CompiledPropertyPath& Compile(const UClass* Class, const FString& Path);
+	static void CompileInto(const UClass* Class, const FString& Path, FUAL_CompiledPropertyPath& Out);
+
+	void BindInvalidationDelegates();
+	void UnbindInvalidationDelegates();
+	void HandleObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap);
+
+	TMap<const UClass*, FClassEntry> Entries;
+
+	bool bDelegatesBound = false;
+	FDelegateHandle BlueprintCompiledHandle;
+	FDelegateHandle ObjectsReplacedHandle;
+};
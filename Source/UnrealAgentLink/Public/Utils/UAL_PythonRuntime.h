@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+/**
+ * 单次 Python 调用结果
+ */
+struct FUAL_PythonCallResult
+{
+	// Python 层执行成功（脚本 / 函数未抛异常）
+	bool bSuccess = false;
+	// 运行时返回的 JSON（result / error / 计时等）
+	TSharedPtr<FJsonObject> Data;
+	// print()、unreal.log() 等输出
+	TArray<TSharedPtr<FJsonValue>> Logs;
+	// 调用本身失败（Python 不可用、运行时安装失败等）
+	FString Error;
+	// 含参数编码与结果解码的总耗时
+	double TotalMs = 0.0;
+};
+
+/**
+ * Python 常驻运行时（cmd.run_python 会话 / python.*）
+ *
+ * - 首次使用时在解释器内安装 _ual_runtime 模块，之后每次调用只执行一条很短的求值语句
+ * - 命名会话：每个会话有独立的全局命名空间，变量与 import 在调用之间保留
+ * - 字节码缓存：脚本以 UTF-8 的 SHA1 为键在 Python 侧编译一次，之后只传哈希；
+ *   Python 侧缓存淘汰后自动回传源码重新编译
+ * - 辅助模块：注册后写入 sys.modules，可被任意会话 import，或用 "模块.函数" 直接调用
+ * - 参数与结果均以 base64(JSON) 传递，避免源码转义问题
+ *
+ * 仅在 GameThread 使用。
+ */
+class FUAL_PythonRuntime
+{
+public:
+	static FUAL_PythonRuntime& Get();
+
+	static bool IsAvailable();
+
+	/** 在会话中执行脚本；脚本可给 __result__ 赋值作为 JSON 结果返回 */
+	FUAL_PythonCallResult Run(const FString& Session, const FString& Source);
+
+	/** 注册（或更新）辅助模块；源码未变化时直接返回 */
+	FUAL_PythonCallResult RegisterModule(const FString& ModuleName, const FString& Source);
+
+	/**
+	 * 按名称调用函数："模块.函数" 取已注册 / 可 import 的模块，否则取会话命名空间中的函数
+	 * @param Args 数组按位置参数传入，对象按关键字参数传入，空则无参数
+	 */
+	FUAL_PythonCallResult Call(const FString& Session, const FString& Function, const TSharedPtr<FJsonValue>& Args);
+
+	/** 删除会话命名空间 */
+	FUAL_PythonCallResult ResetSession(const FString& Session);
+
+	/** 会话、缓存与已注册模块概况 */
+	FUAL_PythonCallResult GetStats();
+
+	/** 模块卸载时清空本地状态（解释器内的运行时随解释器释放） */
+	void Shutdown();
+
+private:
+	FUAL_PythonRuntime() = default;
+
+	bool EnsureInstalled(FString& OutError);
+
+	/** 执行一条 _ual_runtime 求值语句，解码返回的 base64(JSON) */
+	bool Evaluate(const FString& Statement, FUAL_PythonCallResult& OutResult);
+
+	/** 带缓存的编译执行：已知哈希只传哈希，Python 侧缓存缺失时补传源码 */
+	FUAL_PythonCallResult RunCached(const FString& Function, const FString& Target, const FString& Source);
+
+	static FString HashSource(const FString& Source);
+	static FString ToBase64(const FString& Text);
+	static FString ToPyLiteral(const FString& Text);
+
+	bool bInstalled = false;
+	// Python 侧已编译过的脚本哈希
+	TSet<FString> KnownHashes;
+	// 辅助模块名 -> 源码哈希
+	TMap<FString, FString> RegisteredModules;
+};
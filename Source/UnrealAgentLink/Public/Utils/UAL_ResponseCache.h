@@ -0,0 +1,141 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+class UPackage;
+class FObjectPostSaveContext;
+class IPlugin;
+struct FPropertyChangedEvent;
+
+/**
+ * 只读查询响应缓存（project.info、editor.get_focus_context、*.describe 等）
+ *
+ * - 键为方法名 + 规范化参数（对象键排序、数值统一格式），参数顺序不同的相同请求命中同一条目
+ * - 每个可缓存方法声明依赖的作用域；作用域失效只递增代数，条目在查找时比对代数，失效为 O(1)：
+ *   Project（插件挂载）、Map（地图切换）、Focus（选择变化、打开资产编辑器）、
+ *   Assets（包保存、对象修改 / 属性变化、资产增删改名）
+ * - 任何会修改编辑器状态的命令（非 read / control 类）执行后使全部作用域失效
+ * - 只缓存 200 响应；缓存未命中时由 UAL_CommandUtils::SendResponse 回调 Capture 存入结果，
+ *   处理期间发生失效的结果不会存入
+ * - 各方法另有 TTL 兜底（编辑器焦点等无事件可监听的状态）
+ *
+ * 仅在 GameThread 使用。
+ */
+class FUAL_ResponseCache
+{
+public:
+	static FUAL_ResponseCache& Get();
+
+	/**
+	 * 分发请求：可缓存且命中时直接回复缓存结果，否则调用 Invoke 并在回复时记录结果
+	 */
+	void Execute(const FString& Method, const TSharedPtr<FJsonObject>& Params, const FString& RequestId, TFunctionRef<void()> Invoke);
+
+	/** SendResponse 回调：记录等待中的缓存未命中请求的结果 */
+	void Capture(const FString& RequestId, int32 Code, const TSharedPtr<FJsonObject>& Data);
+
+	/** 命中率、条目数与各方法统计 */
+	TSharedPtr<FJsonObject> GetStats() const;
+
+	/** 清空缓存（不影响统计） */
+	void Clear();
+
+	/** 解绑编辑器事件并清空缓存 */
+	void Shutdown();
+
+	/** 参数的规范化 JSON 文本（对象键排序） */
+	static void AppendCanonicalJson(const TSharedPtr<FJsonValue>& Value, FString& Out);
+
+private:
+	FUAL_ResponseCache() = default;
+
+	enum EScope : uint8
+	{
+		Scope_Project = 1 << 0,
+		Scope_Map     = 1 << 1,
+		Scope_Focus   = 1 << 2,
+		Scope_Assets  = 1 << 3,
+		Scope_All     = Scope_Project | Scope_Map | Scope_Focus | Scope_Assets,
+	};
+	static constexpr int32 NumScopes = 4;
+
+	struct FMethodPolicy
+	{
+		uint8 Scopes = 0;
+		// 0 表示只受 ual.ResponseCacheMaxAgeSec 约束
+		float TtlSec = 0.0f;
+	};
+
+	struct FEntry
+	{
+		FString Method;
+		FString ResultJson;
+		uint8 Scopes = 0;
+		uint32 Generations[NumScopes] = {};
+		double StoreTime = 0.0;
+		double ExpireTime = 0.0;
+		double LastUsedTime = 0.0;
+		int32 Hits = 0;
+	};
+
+	struct FPendingCapture
+	{
+		FString Key;
+		FString Method;
+		uint8 Scopes = 0;
+		uint32 Generations[NumScopes] = {};
+		float TtlSec = 0.0f;
+		double StartTime = 0.0;
+	};
+
+	struct FMethodStats
+	{
+		int64 Hits = 0;
+		int64 Misses = 0;
+	};
+
+	static const FMethodPolicy* FindPolicy(const FString& Method);
+
+	void EnsureBound();
+	void Invalidate(uint8 Scopes);
+	bool IsCurrent(uint8 Scopes, const uint32* Generations) const;
+	void SnapshotGenerations(uint32* OutGenerations) const;
+	void Store(FPendingCapture&& Pending, FString&& ResultJson);
+
+	void OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext);
+	void OnMapChanged(uint32 MapChangeFlags);
+	void OnSelectionChanged(UObject* Object);
+	void OnAssetEditorOpened(UObject* Asset);
+	void OnObjectModified(UObject* Object);
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+	void OnPluginMounted(IPlugin& Plugin);
+
+	bool bBound = false;
+
+	TMap<FString, FEntry> Entries;
+	int64 CachedBytes = 0;
+	TMap<FString, FPendingCapture> PendingCaptures;
+	uint32 ScopeGenerations[NumScopes] = {};
+
+	TMap<FString, FMethodStats> MethodStats;
+	int64 Hits = 0;
+	int64 Misses = 0;
+	int64 Stores = 0;
+	int64 Evictions = 0;
+	int64 StaleDrops = 0;
+	int64 ScopeInvalidations[NumScopes] = {};
+
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle MapChangeHandle;
+	FDelegateHandle SelectionChangedHandle;
+	FDelegateHandle SelectObjectHandle;
+	FDelegateHandle AssetEditorOpenedHandle;
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle ObjectPropertyChangedHandle;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle PluginMountedHandle;
+};
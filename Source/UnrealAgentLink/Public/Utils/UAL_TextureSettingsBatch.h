@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Engine/TextureDefines.h"
+#include "UAL_NetworkManager.h"
+
+class UTexture;
+
+/**
+ * 单张纹理的目标设置（未设置的字段保持不变）
+ */
+struct FUAL_TextureSettingsRequest
+{
+	TWeakObjectPtr<UTexture> Texture;
+	TOptional<bool> bSRGB;
+	TOptional<TextureCompressionSettings> Compression;
+	TOptional<TextureGroup> LODGroup;
+};
+
+/**
+ * 批量纹理设置
+ *
+ * - 先对全部纹理一次性写入属性（Modify 记录撤销），设置未变化的纹理直接跳过
+ * - 每张纹理只重建一次：属性写完后集中 PostEditChange（含材质采样器类型刷新），
+ *   启用异步纹理编译时构建在线程池上并行进行，不逐张阻塞 GameThread
+ * - Ticker 跟踪构建进度，推送 content.texture_build_progress / content.texture_build_completed
+ *   （完成事件包含本批次的 DDC 命中 / 未命中次数，UE 5.1+ 可用）
+ *
+ * 仅在 GameThread 使用。
+ */
+class FUAL_TextureSettingsBatch
+{
+public:
+	struct FSubmitResult
+	{
+		FString JobId;
+		int32 Total = 0;
+		int32 Changed = 0;
+		int32 Unchanged = 0;
+		int32 Invalid = 0;
+		bool bAsyncCompilation = false;
+	};
+
+	static FUAL_TextureSettingsBatch& Get();
+
+	/** 应用设置并提交构建；没有纹理需要重建时不创建任务（JobId 为空） */
+	FSubmitResult Submit(const TArray<FUAL_TextureSettingsRequest>& Requests);
+
+	int32 GetActiveJobCount() const { return Jobs.Num(); }
+
+	/** 模块卸载时移除 Ticker 并丢弃跟踪状态（已提交的构建由引擎继续完成） */
+	void Shutdown();
+
+private:
+	FUAL_TextureSettingsBatch() = default;
+
+	struct FDDCCounters
+	{
+		int64 Hits = 0;
+		int64 Misses = 0;
+		bool bAvailable = false;
+	};
+
+	struct FJob
+	{
+		FString JobId;
+		TArray<TWeakObjectPtr<UTexture>> Building;
+		int32 Completed = 0;
+		int32 LastReported = -1;
+		double StartTime = 0.0;
+		double SubmitMs = 0.0;
+		FDDCCounters DDCBefore;
+	};
+
+	/** 写入请求中的属性；bFirstEdit 为该纹理在本批中首次被修改，此时调用 Modify / PreEditChange */
+	static bool ApplySettings(UTexture* Texture, const FUAL_TextureSettingsRequest& Request, bool bFirstEdit);
+	static FDDCCounters GatherDDCCounters();
+
+	bool Tick(float DeltaTime);
+
+	TArray<FJob> Jobs;
+	FTickerHandleType TickerHandle;
+	int32 NextJobSerial = 1;
+};
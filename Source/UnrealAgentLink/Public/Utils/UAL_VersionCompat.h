@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "IImageWrapper.h"
 
+class FRHIGPUTextureReadback;
+
 /**
  * 版本兼容适配层，集中处理 5.0 - 5.7 API 差异
  */
@@ -12,5 +14,17 @@ namespace UALCompat
 	 * PNG 压缩兼容：5.1+ 支持双参 GetCompressed，5.0 仅有返回引用的单参版本。
 	 */
 	bool GetCompressedPNG(const TSharedPtr<IImageWrapper>& Wrapper, int32 Quality, TArray<uint8>& OutData);
+
+	/**
+	 * 通用压缩（JPEG / PNG 等任意格式的 Wrapper），与 GetCompressedPNG 共用实现
+	 */
+	bool GetCompressedImage(const TSharedPtr<IImageWrapper>& Wrapper, int32 Quality, TArray<uint8>& OutData);
+
+	/**
+	 * 锁定已就绪的纹理回读（仅渲染线程）：5.1+ 为 Lock(RowPitch)，5.0 为 LockTexture(RHICmdList, ...)
+	 * @param OutRowPitchInPixels 每行像素数（可能大于纹理宽度）
+	 * @return 映射后的数据，失败时为 nullptr；成功后需调用 Readback.Unlock()
+	 */
+	void* LockTextureReadback(FRHIGPUTextureReadback& Readback, int32& OutRowPitchInPixels);
 }
 
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "UObject/WeakObjectPtr.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "UAL_NetworkManager.h"
+
+class FWidgetRenderer;
+class IImageWrapperModule;
+class UWidgetBlueprint;
+
+/**
+ * 单个 Widget 预览任务
+ */
+struct FUAL_WidgetPreviewJob
+{
+	TWeakObjectPtr<UWidgetBlueprint> WidgetBlueprint;
+	FString AssetPath;
+	FIntPoint Size = FIntPoint(1920, 1080);
+
+	// 只输出布局 JSON，不渲染（-nullrhi 下强制开启）
+	bool bLayoutOnly = false;
+
+	// PNG 写入同机大块数据通道而不是 Saved 目录（通道不可用时仍写盘）
+	bool bBulk = false;
+};
+
+/**
+ * Widget 批量预览服务（widget.preview）
+ *
+ * 流水线，每帧推进：
+ * - 第 N 帧：编译（未变化则跳过）→ 实例化 → 绘制到池化的 RenderTarget，随后在渲染线程排队 GPU 异步回读
+ * - 之后的帧：轮询回读（不等待 GPU），就绪后归还 RenderTarget，工作线程编码 PNG 并写盘（或写入大块数据通道）
+ * - 编码结果由 Ticker 在 GameThread 上收取；所有任务完成后一次性回调整个批次
+ *
+ * FWidgetRenderer 与预览 World 在批次间复用；RenderTarget 按尺寸池化。
+ * 无法渲染时（-nullrhi）退化为布局 JSON：控件名称、类型、排布后的位置与尺寸。
+ *
+ * 除编码任务外仅在 GameThread 使用。
+ */
+class FUAL_WidgetPreviewService
+{
+public:
+	/** 批次完成回调，Results 与提交顺序一致 */
+	using FOnBatchComplete = TFunction<void(const TArray<TSharedPtr<FJsonObject>>& Results)>;
+
+	static FUAL_WidgetPreviewService& Get();
+
+	/** 当前进程能否渲染（-nullrhi / 无 RHI 时为 false） */
+	static bool CanRender();
+
+	void Submit(TArray<FUAL_WidgetPreviewJob>&& Jobs, FOnBatchComplete OnComplete);
+
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+	/** 模块卸载时等待渲染命令与编码任务结束，未完成的任务以错误结果回调，再释放渲染器与 RenderTarget 池 */
+	void Shutdown();
+
+private:
+	FUAL_WidgetPreviewService() = default;
+
+	struct FBatch
+	{
+		TArray<TSharedPtr<FJsonObject>> Results;
+		int32 Remaining = 0;
+		FOnBatchComplete OnComplete;
+	};
+
+	struct FQueuedJob
+	{
+		FUAL_WidgetPreviewJob Job;
+		TSharedPtr<FBatch> Batch;
+		int32 Index = 0;
+	};
+
+	/** 一次异步回读；渲染线程写入，完成后置位 bDone，GameThread 据此收取像素 */
+	struct FPreviewReadback;
+	using FPreviewReadbackPtr = TSharedPtr<FPreviewReadback, ESPMode::ThreadSafe>;
+
+	struct FDrawnJob
+	{
+		FQueuedJob Queued;
+		TStrongObjectPtr<UUserWidget> Widget;
+		TStrongObjectPtr<UTextureRenderTarget2D> RenderTarget;
+		FPreviewReadbackPtr Readback;
+	};
+
+	/** 编码完成、等待 GameThread 回调的任务 */
+	struct FEncodedJob
+	{
+		FQueuedJob Queued;
+		FString OutputPath;
+		FIntPoint Size = FIntPoint::ZeroValue;
+		bool bSaved = false;
+		TSharedPtr<FJsonObject> BulkHandle;
+	};
+
+	bool Tick(float DeltaTime);
+	void ReadbackDrawn();
+	void CompleteEncoded();
+	void DrawQueued();
+	static void PollReadback(const FPreviewReadbackPtr& Readback);
+	void StartEncode(FQueuedJob&& Queued, TArray<FColor>&& Bitmap, FIntPoint Size, const FString& OutputPath);
+
+	UUserWidget* CreatePreviewWidget(const FQueuedJob& Queued, FString& OutError);
+	UTextureRenderTarget2D* AcquireRenderTarget(FIntPoint Size);
+	void ReleaseRenderTarget(UTextureRenderTarget2D* RenderTarget);
+	void CompleteJob(const FQueuedJob& Queued, const TSharedPtr<FJsonObject>& Result);
+
+	static TSharedPtr<FJsonObject> BuildLayoutJson(UUserWidget* Widget, FIntPoint Size);
+
+	TArray<FQueuedJob> Queue;
+
+	// 已绘制、等待回读就绪
+	TArray<FDrawnJob> Drawn;
+
+	// 工作线程中的编码任务数（编码结果入队后才递减）
+	FThreadSafeCounter EncodesInFlight;
+	FCriticalSection EncodedLock;
+	TArray<FEncodedJob> Encoded;
+
+	TSharedPtr<FWidgetRenderer> Renderer;
+	TWeakObjectPtr<UWorld> PreviewWorld;
+	IImageWrapperModule* ImageWrapperModule = nullptr;
+
+	TMap<FIntPoint, TArray<TStrongObjectPtr<UTextureRenderTarget2D>>> FreeTargets;
+	int32 PooledTargetCount = 0;
+
+	FTickerHandleType TickerHandle;
+
+	int32 WidgetsRendered = 0;
+	int32 LayoutsBuilt = 0;
+	int32 RenderTargetsCreated = 0;
+	int32 RenderTargetsReused = 0;
+};
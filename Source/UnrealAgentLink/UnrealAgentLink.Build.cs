@@ -86,13 +86,17 @@ public class UnrealAgentLink : ModuleRules
 				"MaterialEditor", // Added for FMaterialEditorUtilities
 				"MediaAssets", // Added for FileMediaSource support
 				"ImageWrapper",  // Added for screenshot support
+				"ImageWriteQueue", // Added for screenshot completion (write queue fence)
 				"UMG", // Added for FWidgetRenderer
 				"UMGEditor", // Added for UWidgetBlueprint support
 				"LevelEditor", // Added for SLevelViewport and FLevelEditorViewportClient
 				"EngineSettings", // Added for UGameMapsSettings
 				"MessageLog", // Added for FMessageLogModule (MessageLog commands)
 				"Niagara", // Added for UNiagaraSystem, UNiagaraComponent, UNiagaraFunctionLibrary
-				"NiagaraEditor" // Added for UNiagaraSystemFactoryNew::InitializeSystem (NIAGARAEDITOR_API)
+				"NiagaraEditor", // Added for UNiagaraSystemFactoryNew::InitializeSystem (NIAGARAEDITOR_API)
+				"DerivedDataCache", // Added for DDC resource stats (bulk texture configuration)
+				"Sockets", // Added for the in-editor local server (FUAL_LocalServer)
+				"Networking" // Added for FTcpListener / FTcpSocketBuilder
 			}
 			);
 